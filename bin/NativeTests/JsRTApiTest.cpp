@@ -3,6 +3,7 @@
 // Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
 //-------------------------------------------------------------------------------------------------------
 #include "stdafx.h"
+#include "ChakraCore.h"
 #include "catch.hpp"
 #include <process.h>
 
@@ -1613,4 +1614,213 @@ namespace JsRTApiTest
     {
         JsRTApiTest::RunWithAttributes(JsRTApiTest::ScriptTerminationTest);
     }
+
+    void ParseJsonUtf8Test(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        // "caf\u00e9" and U+1F600 (a surrogate pair) encoded as UTF-8, next to escapes. The buffers need not be
+        // null terminated: anything past the length handed to the parser must be ignored, even in the middle of a number.
+        const char json[] = "{\"name\":\"caf\xC3\xA9\",\"smile\":\"\xF0\x9F\x98\x80\\n\\u0041\",\"list\":[1,-2.5e1,12345678901234567890]}";
+        const char jsonWithGarbage[] = "[true, null, 1.5]garbage";
+        const size_t jsonWithGarbageLength = strlen("[true, null, 1.5]");
+
+        JsValueRef result = JS_INVALID_REFERENCE;
+        REQUIRE(JsParseJsonUtf8(json, strlen(json), &result) == JsNoError);
+
+        JsPropertyIdRef property = JS_INVALID_REFERENCE;
+        JsValueRef value = JS_INVALID_REFERENCE;
+        const wchar_t *str = nullptr;
+        size_t length;
+        double dbl;
+
+        REQUIRE(JsGetPropertyIdFromName(_u("name"), &property) == JsNoError);
+        REQUIRE(JsGetProperty(result, property, &value) == JsNoError);
+        REQUIRE(JsStringToPointer(value, &str, &length) == JsNoError);
+        CHECK(length == 4);
+        CHECK(wcscmp(_u("caf\u00e9"), str) == 0);
+
+        REQUIRE(JsGetPropertyIdFromName(_u("smile"), &property) == JsNoError);
+        REQUIRE(JsGetProperty(result, property, &value) == JsNoError);
+        REQUIRE(JsStringToPointer(value, &str, &length) == JsNoError);
+        CHECK(length == 4);
+        CHECK(wcscmp(_u("\xD83D\xDE00\nA"), str) == 0);
+
+        REQUIRE(JsGetPropertyIdFromName(_u("list"), &property) == JsNoError);
+        REQUIRE(JsGetProperty(result, property, &value) == JsNoError);
+        JsValueRef index = JS_INVALID_REFERENCE;
+        JsValueRef element = JS_INVALID_REFERENCE;
+        REQUIRE(JsIntToNumber(1, &index) == JsNoError);
+        REQUIRE(JsGetIndexedProperty(value, index, &element) == JsNoError);
+        REQUIRE(JsNumberToDouble(element, &dbl) == JsNoError);
+        CHECK(-25 == dbl);
+        REQUIRE(JsIntToNumber(2, &index) == JsNoError);
+        REQUIRE(JsGetIndexedProperty(value, index, &element) == JsNoError);
+        REQUIRE(JsNumberToDouble(element, &dbl) == JsNoError);
+        CHECK(12345678901234567890.0 == dbl);
+
+        REQUIRE(JsParseJsonUtf8(jsonWithGarbage, jsonWithGarbageLength, &result) == JsNoError);
+        REQUIRE(JsIntToNumber(2, &index) == JsNoError);
+        REQUIRE(JsGetIndexedProperty(result, index, &element) == JsNoError);
+        REQUIRE(JsNumberToDouble(element, &dbl) == JsNoError);
+        CHECK(1.5 == dbl);
+
+        REQUIRE(JsParseJsonUtf8("42.2512", 5, &result) == JsNoError);
+        REQUIRE(JsNumberToDouble(result, &dbl) == JsNoError);
+        CHECK(42.25 == dbl);
+
+        // Invalid JSON throws a SyntaxError
+        JsValueRef exception = JS_INVALID_REFERENCE;
+        REQUIRE(JsParseJsonUtf8(jsonWithGarbage, strlen(jsonWithGarbage), &result) == JsErrorScriptException);
+        REQUIRE(JsGetAndClearException(&exception) == JsNoError);
+        REQUIRE(JsParseJsonUtf8("{\"a\":", 5, &result) == JsErrorScriptException);
+        REQUIRE(JsGetAndClearException(&exception) == JsNoError);
+    }
+
+    TEST_CASE("ApiTest_ParseJsonUtf8Test", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::ParseJsonUtf8Test);
+    }
+
+    struct StringifyChunks
+    {
+        std::string json;
+        int chunkCount;
+        int maxChunkCount;
+    };
+
+    bool CALLBACK StringifyUtf8Callback(const char *chunk, size_t length, void *callbackState)
+    {
+        StringifyChunks *chunks = static_cast<StringifyChunks *>(callbackState);
+        chunks->json.append(chunk, length);
+        chunks->chunkCount++;
+        return chunks->chunkCount < chunks->maxChunkCount;
+    }
+
+    void StringifyToUtf8CallbackTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        JsValueRef value = JS_INVALID_REFERENCE;
+        StringifyChunks chunks = { std::string(), 0, INT_MAX };
+
+        REQUIRE(JsRunScript(_u("({ a: [1, 'caf\\u00e9', null], b: undefined, c: '\\ud83d\\ude00\\n' })"), JS_SOURCE_CONTEXT_NONE, _u(""), &value) == JsNoError);
+        REQUIRE(JsStringifyToUtf8Callback(value, StringifyUtf8Callback, &chunks) == JsNoError);
+        CHECK(chunks.json == "{\"a\":[1,\"caf\xC3\xA9\",null],\"c\":\"\xF0\x9F\x98\x80\\n\"}");
+
+        // Values without a JSON representation produce no output
+        chunks.json.clear();
+        chunks.chunkCount = 0;
+        REQUIRE(JsGetUndefinedValue(&value) == JsNoError);
+        REQUIRE(JsStringifyToUtf8Callback(value, StringifyUtf8Callback, &chunks) == JsNoError);
+        CHECK(chunks.chunkCount == 0);
+
+        // Large output is split in several chunks, surrogate pairs are never split across them
+        chunks.json.clear();
+        chunks.chunkCount = 0;
+        REQUIRE(JsRunScript(_u("new Array(2000).join('x\\ud83d\\ude00')"), JS_SOURCE_CONTEXT_NONE, _u(""), &value) == JsNoError);
+        REQUIRE(JsStringifyToUtf8Callback(value, StringifyUtf8Callback, &chunks) == JsNoError);
+        CHECK(chunks.chunkCount > 1);
+        std::string expected = "\"";
+        for (int i = 0; i < 1999; i++)
+        {
+            expected += "x\xF0\x9F\x98\x80";
+        }
+        expected += "\"";
+        CHECK(chunks.json == expected);
+
+        // Returning false from the callback stops the conversion
+        chunks.json.clear();
+        chunks.chunkCount = 0;
+        chunks.maxChunkCount = 1;
+        REQUIRE(JsStringifyToUtf8Callback(value, StringifyUtf8Callback, &chunks) == JsErrorCallbackCanceled);
+        CHECK(chunks.chunkCount == 1);
+
+        // No getters run once the callback has returned false
+        JsValueRef getterRan = JS_INVALID_REFERENCE;
+        bool ran = true;
+        chunks.json.clear();
+        chunks.chunkCount = 0;
+        REQUIRE(JsRunScript(_u("var getterRan = false; ({ a: new Array(2000).join('x'), get b() { getterRan = true; return 1; } })"), JS_SOURCE_CONTEXT_NONE, _u(""), &value) == JsNoError);
+        REQUIRE(JsStringifyToUtf8Callback(value, StringifyUtf8Callback, &chunks) == JsErrorCallbackCanceled);
+        CHECK(chunks.chunkCount == 1);
+        REQUIRE(JsRunScript(_u("getterRan"), JS_SOURCE_CONTEXT_NONE, _u(""), &getterRan) == JsNoError);
+        REQUIRE(JsBooleanToBool(getterRan, &ran) == JsNoError);
+        CHECK(!ran);
+
+        // Exceptions are reported as script exceptions
+        JsValueRef exception = JS_INVALID_REFERENCE;
+        REQUIRE(JsRunScript(_u("var circular = {}; circular.self = circular; circular"), JS_SOURCE_CONTEXT_NONE, _u(""), &value) == JsNoError);
+        REQUIRE(JsStringifyToUtf8Callback(value, StringifyUtf8Callback, &chunks) == JsErrorScriptException);
+        REQUIRE(JsGetAndClearException(&exception) == JsNoError);
+    }
+
+    TEST_CASE("ApiTest_StringifyToUtf8CallbackTest", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::StringifyToUtf8CallbackTest);
+    }
+
+    struct GcStatisticsThreadArgs
+    {
+        JsRuntimeHandle runtime;
+        JsErrorCode error;
+        JsGcStatistics statistics;
+    };
+
+    static unsigned int CALLBACK GcStatisticsThreadProc(LPVOID lpParameter)
+    {
+        GcStatisticsThreadArgs * args = (GcStatisticsThreadArgs *)lpParameter;
+        args->error = JsGetRuntimeGcStatistics(args->runtime, &args->statistics, nullptr, 0, nullptr);
+        return 0;
+    }
+
+    void GcStatisticsTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        JsValueRef result = JS_INVALID_REFERENCE;
+        JsGcStatistics statistics = {};
+        unsigned int requiredBucketCount = 0;
+
+        REQUIRE(JsRunScript(_u("var a = []; for (var i = 0; i < 10000; i++) { a.push({ x: i }); } a = null;"), JS_SOURCE_CONTEXT_NONE, _u(""), &result) == JsNoError);
+        REQUIRE(JsCollectGarbage(runtime) == JsNoError);
+
+        REQUIRE(JsGetRuntimeGcStatistics(runtime, &statistics, nullptr, 0, &requiredBucketCount) == JsNoError);
+        CHECK(statistics.collectionCount >= 1);
+        CHECK(statistics.maxPauseMicroseconds >= statistics.lastPauseMicroseconds);
+        CHECK(statistics.totalPauseMicroseconds >= statistics.maxPauseMicroseconds);
+        CHECK(statistics.lastHeapBlockCount > 0);
+        CHECK(statistics.lastLiveBytes <= statistics.lastCapacityBytes);
+        REQUIRE(requiredBucketCount > 0);
+
+        JsGcBucketStatistics * buckets = new JsGcBucketStatistics[requiredBucketCount];
+        REQUIRE(JsGetRuntimeGcStatistics(runtime, &statistics, buckets, requiredBucketCount, nullptr) == JsNoError);
+        size_t capacityBytes = 0;
+        unsigned int heapBlockCount = 0;
+        for (unsigned int i = 0; i < requiredBucketCount; i++)
+        {
+            CHECK(buckets[i].liveBytes <= buckets[i].capacityBytes);
+            capacityBytes += buckets[i].capacityBytes;
+            heapBlockCount += buckets[i].heapBlockCount;
+        }
+        CHECK(capacityBytes == statistics.lastCapacityBytes);
+        CHECK(heapBlockCount == statistics.lastHeapBlockCount);
+        delete[] buckets;
+
+        // The statistics can be read from a thread the runtime isn't active on
+        GcStatisticsThreadArgs threadArgs = {};
+        threadArgs.runtime = runtime;
+        HANDLE threadHandle = reinterpret_cast<HANDLE>(_beginthreadex(nullptr, 0, &GcStatisticsThreadProc, &threadArgs, 0, nullptr));
+        REQUIRE(threadHandle != nullptr);
+        if (threadHandle == nullptr)
+        {
+            // This is to satisfy preFAST, above REQUIRE call ensuring that it will report exception when threadHandle is null.
+            return;
+        }
+        WaitForSingleObject(threadHandle, INFINITE);
+        CloseHandle(threadHandle);
+        REQUIRE(threadArgs.error == JsNoError);
+        CHECK(threadArgs.statistics.collectionCount == statistics.collectionCount);
+        CHECK(threadArgs.statistics.totalPauseMicroseconds == statistics.totalPauseMicroseconds);
+        CHECK(threadArgs.statistics.lastCapacityBytes == statistics.lastCapacityBytes);
+    }
+
+    TEST_CASE("ApiTest_GcStatisticsTest", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::GcStatisticsTest);
+    }
 }
@@ -33,6 +33,8 @@ PRINT_USAGE() {
     echo "      --cc=PATH        Path to Clang   (see example below)"
     echo "  -d, --debug          Debug build (by default Release build)"
     echo "      --embed-icu      Download and embed ICU-57 statically"
+    echo "      --enable-concurrent-gc  Enable concurrent/partial GC (Linux, experimental)"
+    echo "      --enable-computed-goto  Use threaded dispatch in the interpreter (experimental)"
     echo "  -h, --help           Show help"
     echo "      --icu=PATH       Path to ICU include folder (see example below)"
     echo "  -j [N], --jobs[=N]   Multicore build, allow N jobs at once"
@@ -67,6 +69,8 @@ STATIC_LIBRARY="-DSHARED_LIBRARY_SH=1"
 WITHOUT_FEATURES=""
 CREATE_DEB=0
 ARCH="-DCC_TARGETS_AMD64_SH=1"
+ENABLE_CONCURRENT_GC=""
+ENABLE_COMPUTED_GOTO=""
 OS_LINUX=0
 OS_APT_GET=0
 OS_UNIX=0
@@ -155,6 +159,14 @@ while [[ $# -gt 0 ]]; do
         ;;
 
 
+    --enable-concurrent-gc)
+        ENABLE_CONCURRENT_GC="-DCC_ENABLE_CONCURRENT_GC_SH=1"
+        ;;
+
+    --enable-computed-goto)
+        ENABLE_COMPUTED_GOTO="-DCC_ENABLE_COMPUTED_GOTO_SH=1"
+        ;;
+
     -t | --test-build)
         BUILD_TYPE="Test"
         ;;
@@ -237,6 +249,8 @@ if [[ ${#_VERBOSE} > 0 ]]; then
     echo "BUILD_TYPE=${BUILD_TYPE}"
     echo "MULTICORE_BUILD=${MULTICORE_BUILD}"
     echo "ICU_PATH=${ICU_PATH}"
+    echo "ENABLE_CONCURRENT_GC=${ENABLE_CONCURRENT_GC}"
+    echo "ENABLE_COMPUTED_GOTO=${ENABLE_COMPUTED_GOTO}"
     echo "CMAKE_GEN=${CMAKE_GEN}"
     echo "MAKE=${MAKE}"
     echo ""
@@ -306,7 +320,7 @@ else
 fi
 
 echo Generating $BUILD_TYPE makefiles
-cmake $CMAKE_GEN $CC_PREFIX $ICU_PATH $STATIC_LIBRARY $ARCH -DCMAKE_BUILD_TYPE=$BUILD_TYPE $WITHOUT_FEATURES ../..
+cmake $CMAKE_GEN $CC_PREFIX $ICU_PATH $STATIC_LIBRARY $ARCH $ENABLE_CONCURRENT_GC $ENABLE_COMPUTED_GOTO -DCMAKE_BUILD_TYPE=$BUILD_TYPE $WITHOUT_FEATURES ../..
 
 _RET=$?
 if [[ $? == 0 ]]; then
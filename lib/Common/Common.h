@@ -106,6 +106,7 @@ template<> struct IntMath<int64> { using Type = Int64Math; };
 #include "DataStructures/LeafValueDictionary.h"
 #include "DataStructures/Dictionary.h"
 #include "DataStructures/List.h"
+#include "DataStructures/TimSort.h"
 #include "DataStructures/Stack.h"
 #include "DataStructures/Queue.h"
 #include "DataStructures/CharacterBuffer.h"
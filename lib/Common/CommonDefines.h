@@ -91,6 +91,17 @@
 #if defined(_WIN32) || defined(HAS_REAL_ICU)
 #define ENABLE_UNICODE_API 1                        // Enable use of Unicode-related APIs
 #endif
+
+// Interpreter
+// Threaded dispatch with computed goto (labels as values) is a GCC/Clang extension.
+// Build with -DENABLE_INTERPRETER_COMPUTED_GOTO=1 (build.sh --enable-computed-goto) to try it.
+#ifndef ENABLE_INTERPRETER_COMPUTED_GOTO
+#define ENABLE_INTERPRETER_COMPUTED_GOTO 0
+#endif
+#if ENABLE_INTERPRETER_COMPUTED_GOTO && !defined(__GNUC__) && !defined(__clang__)
+#error "ENABLE_INTERPRETER_COMPUTED_GOTO requires a compiler that supports labels as values"
+#endif
+
 // Language features
 // xplat-todo: revisit these features
 #ifdef _WIN32
@@ -120,10 +131,11 @@
 
 // GC features
 
-// Concurrent and Partial GC are disabled on non-Windows builds
+// Concurrent and Partial GC are disabled by default on non-Windows builds
 // xplat-todo: re-enable this in the future
-// These are disabled because these GC features depend on hardware
-// write-watch support that the Windows Memory Manager provides.
+// These GC features depend on the write-watch support that the Windows
+// Memory Manager provides. The PAL emulates it with userfaultfd on Linux;
+// build with -DENABLE_CONCURRENT_GC=1 (build.sh --enable-concurrent-gc) to try it.
 #ifdef _WIN32
 #define SYSINFO_IMAGE_BASE_AVAILABLE 1
 #define ENABLE_CONCURRENT_GC 1
@@ -133,10 +145,14 @@
 #define ENABLE_RECYCLER_TYPE_TRACKING 1
 #else
 #define SYSINFO_IMAGE_BASE_AVAILABLE 0
+#ifndef ENABLE_CONCURRENT_GC
 #define ENABLE_CONCURRENT_GC 0
-#define ENABLE_PARTIAL_GC 0
-#define ENABLE_BACKGROUND_PAGE_ZEROING 0
-#define ENABLE_BACKGROUND_PAGE_FREEING 0
+#endif
+#define ENABLE_PARTIAL_GC ENABLE_CONCURRENT_GC
+// Queued pages are zeroed and released by the concurrent GC thread, so these are opt-in along with
+// concurrent GC. Without it, freed pages are zeroed in place (large runs are dropped with MEM_RESET).
+#define ENABLE_BACKGROUND_PAGE_ZEROING ENABLE_CONCURRENT_GC
+#define ENABLE_BACKGROUND_PAGE_FREEING ENABLE_CONCURRENT_GC
 #define ENABLE_RECYCLER_TYPE_TRACKING 0
 #endif
 
@@ -150,16 +166,17 @@
 #define RECYCLER_WRITE_BARRIER                      // Write Barrier support
 #define IDLE_DECOMMIT_ENABLED 1                     // Idle Decommit
 #define RECYCLER_PAGE_HEAP                          // PageHeap support
+#define ENABLE_RECYCLER_GC_STATISTICS 1             // Per-collection GC statistics (JsGetRuntimeGcStatistics)
+
+// Background jobs (used by both the JIT and the parser, so available with the JIT disabled too)
+#define ENABLE_BACKGROUND_JOB_PROCESSOR 1
+#define ENABLE_BACKGROUND_PARSING 1
 
 // JIT features
 
 #if DISABLE_JIT
 #define ENABLE_NATIVE_CODEGEN 0
 #define ENABLE_PROFILE_INFO 0
-#define ENABLE_BACKGROUND_JOB_PROCESSOR 0
-#define ENABLE_BACKGROUND_PARSING 0                 // Disable background parsing in this mode
-                                                    // We need to decouple the Jobs infrastructure out of
-                                                    // Backend to make background parsing work with JIT disabled
 #define DYNAMIC_INTERPRETER_THUNK 0
 #define DISABLE_DYNAMIC_PROFILE_DEFER_PARSE
 #define ENABLE_COPYONACCESS_ARRAY 0
@@ -171,8 +188,6 @@
 #define ENABLE_NATIVE_CODEGEN 1
 #define ENABLE_PROFILE_INFO 1
 
-#define ENABLE_BACKGROUND_JOB_PROCESSOR 1
-#define ENABLE_BACKGROUND_PARSING 1
 #define ENABLE_COPYONACCESS_ARRAY 1
 #ifndef DYNAMIC_INTERPRETER_THUNK
 #if defined(_M_IX86_OR_ARM32) || defined(_M_X64_OR_ARM64)
@@ -183,6 +198,22 @@
 #endif
 #endif
 
+// The fused opcodes (e.g. IncrBr_A) are only understood by the interpreter, so the
+// byte code writer only emits them when there is no JIT to consume the byte code.
+#if ENABLE_NATIVE_CODEGEN
+#define ENABLE_BYTECODE_SUPERINSTRUCTIONS 0
+#else
+#define ENABLE_BYTECODE_SUPERINSTRUCTIONS 1
+#endif
+
+// Hot regex programs are compiled to x64 machine code by a small emitter of their own, so
+// this works with or without the JIT.
+#if defined(_M_X64)
+#define ENABLE_REGEX_NATIVE_CODEGEN 1
+#else
+#define ENABLE_REGEX_NATIVE_CODEGEN 0
+#endif
+
 // Other features
 // #define CHAKRA_CORE_DOWN_COMPAT 1
 
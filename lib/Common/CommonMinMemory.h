@@ -42,8 +42,10 @@ class FinalizableObject;
 #include "Memory/HeapBlockMap.h"
 #include "Memory/RecyclerObjectDumper.h"
 #include "Memory/RecyclerWeakReference.h"
+#include "Memory/RecyclerEphemeronTable.h"
 #include "Memory/RecyclerSweep.h"
 #include "Memory/RecyclerHeuristic.h"
 #include "Memory/MarkContext.h"
 #include "Memory/RecyclerWatsonTelemetry.h"
+#include "Memory/RecyclerGCStatistics.h"
 #include "Memory/Recycler.h"
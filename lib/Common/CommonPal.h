@@ -351,9 +351,98 @@ typedef union _SLIST_HEADER {
 
 #endif
 
-PALIMPORT VOID PALAPI InitializeSListHead(IN OUT PSLIST_HEADER ListHead);
-PALIMPORT PSLIST_ENTRY PALAPI InterlockedPushEntrySList(IN OUT PSLIST_HEADER ListHead, IN OUT PSLIST_ENTRY  ListEntry);
-PALIMPORT PSLIST_ENTRY PALAPI InterlockedPopEntrySList(IN OUT PSLIST_HEADER ListHead);
+//
+// xplat-todo: The Windows SLIST routines are lock-free and rely on the kernel to
+// recover when a pop reads the link of an entry that was concurrently removed and
+// unmapped. We can't do that here, so the header is guarded by a spin lock kept in
+// the low (always zero) bit of the first entry pointer. Lists are short-lived queues
+// of pages (see PageAllocator) with very little contention.
+//
+#if defined(_AMD64_)
+#define SLIST_LOCK_WORD(ListHead)       ((ListHead)->DUMMYSTRUCTNAME.Region)
+#define SLIST_ENTRY_MASK                (~(ULONGLONG)0xF)
+#else
+#define SLIST_LOCK_WORD(ListHead)       ((ListHead)->Alignment)
+#define SLIST_ENTRY_MASK                ((ULONGLONG)(~(ULONG)0x1))
+#endif
+
+inline ULONGLONG SListAcquire(IN OUT PSLIST_HEADER ListHead)
+{
+    ULONGLONG volatile * lockWord = &SLIST_LOCK_WORD(ListHead);
+    ULONGLONG value;
+    while ((value = __sync_fetch_and_or(lockWord, (ULONGLONG)1)) & 1)
+    {
+        while (*lockWord & 1)
+        {
+            YieldProcessor();
+        }
+    }
+    return value;
+}
+
+inline void SListRelease(IN OUT PSLIST_HEADER ListHead, PSLIST_ENTRY first, WORD depth, ULONGLONG value)
+{
+#if defined(_AMD64_)
+    ListHead->HeaderX64.Depth = depth;
+    ListHead->HeaderX64.Sequence++;
+    __atomic_store_n(&SLIST_LOCK_WORD(ListHead), (ULONGLONG)first, __ATOMIC_RELEASE);
+#else
+    value = (value & ~(ULONGLONG)0xFFFFFFFF) | (ULONG)(ULONG_PTR)first;
+    value = (value & ~((ULONGLONG)0xFFFF << 32)) | ((ULONGLONG)depth << 32);
+    __atomic_store_n(&SLIST_LOCK_WORD(ListHead), value, __ATOMIC_RELEASE);
+#endif
+}
+
+inline WORD SListDepth(IN PSLIST_HEADER ListHead)
+{
+#if defined(_AMD64_)
+    return (WORD)ListHead->HeaderX64.Depth;
+#else
+    return ListHead->DUMMYSTRUCTNAME.Depth;
+#endif
+}
+
+inline VOID InitializeSListHead(IN OUT PSLIST_HEADER ListHead)
+{
+    memset(ListHead, 0, sizeof(SLIST_HEADER));
+}
+
+inline USHORT QueryDepthSList(IN PSLIST_HEADER ListHead)
+{
+    return SListDepth(ListHead);
+}
+
+inline PSLIST_ENTRY InterlockedPushEntrySList(IN OUT PSLIST_HEADER ListHead, IN OUT PSLIST_ENTRY ListEntry)
+{
+    ULONGLONG value = SListAcquire(ListHead);
+    PSLIST_ENTRY first = (PSLIST_ENTRY)(ULONG_PTR)(value & SLIST_ENTRY_MASK);
+    ListEntry->Next = first;
+    SListRelease(ListHead, ListEntry, SListDepth(ListHead) + 1, value);
+    return first;
+}
+
+inline PSLIST_ENTRY InterlockedPopEntrySList(IN OUT PSLIST_HEADER ListHead)
+{
+    ULONGLONG value = SListAcquire(ListHead);
+    PSLIST_ENTRY first = (PSLIST_ENTRY)(ULONG_PTR)(value & SLIST_ENTRY_MASK);
+    if (first == nullptr)
+    {
+        SListRelease(ListHead, nullptr, 0, value);
+        return nullptr;
+    }
+    SListRelease(ListHead, first->Next, SListDepth(ListHead) - 1, value);
+    return first;
+}
+
+inline PSLIST_ENTRY InterlockedFlushSList(IN OUT PSLIST_HEADER ListHead)
+{
+    ULONGLONG value = SListAcquire(ListHead);
+    SListRelease(ListHead, nullptr, 0, value);
+    return (PSLIST_ENTRY)(ULONG_PTR)(value & SLIST_ENTRY_MASK);
+}
+
+#undef SLIST_LOCK_WORD
+#undef SLIST_ENTRY_MASK
 
 
 template <class T>
@@ -25,6 +25,7 @@ PHASE(All)
         PHASE(DisableStackFuncOnDeferredEscape)
         PHASE(DelayCapture)
         PHASE(DebuggerScope)
+        PHASE(SuperInstructions)
         PHASE(ByteCodeSerialization)
             PHASE(VariableIntEncoding)
         PHASE(NativeCodeSerialization)
@@ -293,6 +294,7 @@ PHASE(All)
             PHASE(ObjectHeaderInliningForObjectLiterals)
             PHASE(ObjectHeaderInliningForEmptyObjects)
         PHASE(OptUnknownElementName)
+        PHASE(MegamorphicPropertyCache)
 #if DBG_DUMP
         PHASE(TypePropertyCache)
         PHASE(InlineSlots)
@@ -389,6 +391,8 @@ PHASE(All)
 #define DEFAULT_CONFIG_ForceCleanPropertyOnCollect (false)
 #define DEFAULT_CONFIG_ForceCleanCacheOnCollect (false)
 #define DEFAULT_CONFIG_ForceGCAfterJSONParse (false)
+#define DEFAULT_CONFIG_StreamingJSONStringify (true)
+#define DEFAULT_CONFIG_OneByteStrings (true)
 #define DEFAULT_CONFIG_ForceSerialized      (false)
 #define DEFAULT_CONFIG_ForceES5Array        (false)
 #define DEFAULT_CONFIG_ForceAsmJsLinkFail   (false)
@@ -462,7 +466,11 @@ PHASE(All)
 #define DEFAULT_CONFIG_RegexProfile         (false)
 #define DEFAULT_CONFIG_RegexDebug           (false)
 #define DEFAULT_CONFIG_RegexOptimize        (true)
+#define DEFAULT_CONFIG_RegexAutomaton       (true)
+#define DEFAULT_CONFIG_RegexNativeCode      (true)
+#define DEFAULT_CONFIG_RegexNativeCodeThreshold (16)
 #define DEFAULT_CONFIG_DynamicRegexMruListSize (16)
+#define DEFAULT_CONFIG_RegexProgramCacheSize (128)
 #define DEFAULT_CONFIG_GoptCleanupThreshold  (25)
 #define DEFAULT_CONFIG_AsmGoptCleanupThreshold  (500)
 #define DEFAULT_CONFIG_OptimizeForManyInstances (false)
@@ -1199,6 +1207,7 @@ FLAGNR(Number,  FuncObjectInlineCacheThreshold  , "Maximum number of inline cach
 FLAGNR(Boolean, NoDeferParse          , "Disable deferred parsing", false)
 FLAGNR(Boolean, NoLogo                , "No logo, which we don't display anyways", false)
 FLAGNR(Boolean, OOPJITMissingOpts     , "Use optimizations that are missing from OOP JIT", DEFAULT_CONFIG_OOPJITMissingOpts)
+FLAGNR(Boolean, OneByteStrings        , "Store JSON.parse string values whose characters all fit in one byte (Latin-1) with one byte per character until a char16 buffer is needed", DEFAULT_CONFIG_OneByteStrings)
 #ifdef _ARM64_
 FLAGR (Boolean, NoNative              , "Disable native codegen", true)
 #else
@@ -1315,6 +1324,7 @@ FLAGNR(Phases,  Stats                 , "Stats the given phase", )
 #if EXCEPTION_RECOVERY
 FLAGNR(Boolean, SwallowExceptions     , "Force a try/catch around every statement", false)
 #endif
+FLAGNR(Boolean, StreamingJSONStringify, "Write the JSON.stringify result out in order instead of building a concat string tree", DEFAULT_CONFIG_StreamingJSONStringify)
 FLAGNR(Boolean, PrintSystemException  , "Always print a message when there's OOM or OOS", false)
 FLAGNR(Number,  SwitchOptHolesThreshold,  "Maximum percentage of holes (missing case values in a switch statement) with which a jump table can be created",DEFAULT_CONFIG_SwitchOptHolesThreshold)
 FLAGR (Number,  TempMin                  , "Temp number switch which code can temporarily use for debugging", DEFAULT_CONFIG_TempMin)
@@ -1377,7 +1387,11 @@ FLAGR (Boolean, RegexTracing          , "Trace all Regex invocations to the outp
 FLAGR (Boolean, RegexProfile          , "Collect usage statistics on all Regex invocations.", DEFAULT_CONFIG_RegexProfile)
 FLAGR (Boolean, RegexDebug            , "Trace compilation of UnifiedRegex expressions.", DEFAULT_CONFIG_RegexDebug)
 FLAGR (Boolean, RegexOptimize         , "Optimize regular expressions in the unified Regex system (default: true)", DEFAULT_CONFIG_RegexOptimize)
+FLAGR (Boolean, RegexAutomaton        , "Match regular expressions that could backtrack excessively with a lazy DFA and Pike VM instead (default: true)", DEFAULT_CONFIG_RegexAutomaton)
+FLAGR (Boolean, RegexNativeCode       , "Compile hot regular expressions to machine code where supported (default: true)", DEFAULT_CONFIG_RegexNativeCode)
+FLAGR (Number,  RegexNativeCodeThreshold, "Number of matches a regular expression runs in the interpreter before it is compiled to machine code", DEFAULT_CONFIG_RegexNativeCodeThreshold)
 FLAGR (Number,  DynamicRegexMruListSize, "Size of the MRU list for dynamic regexes", DEFAULT_CONFIG_DynamicRegexMruListSize)
+FLAGR (Number,  RegexProgramCacheSize , "Size of the MRU list of compiled regexes shared by the script contexts of a thread (0 to disable)", DEFAULT_CONFIG_RegexProgramCacheSize)
 #endif
 
 FLAGR (Boolean, OptimizeForManyInstances, "Optimize script engine for many instances (low memory footprint per engine, assume low spare CPU cycles) (default: false)", DEFAULT_CONFIG_OptimizeForManyInstances)
@@ -1429,6 +1443,7 @@ FLAGNR(NumberSet, RejitTraceFilter, "Filter the rejit trace messages to specific
 FLAGNR(Number,  MaxBackgroundFinishMarkCount, "Maximum number of background finish mark", 1)
 FLAGNR(Number,  BackgroundFinishMarkWaitTime, "Millisecond to wait for background finish mark", 15)
 FLAGNR(Number,  MinBackgroundRepeatMarkRescanBytes, "Minimum number of bytes rescan to trigger background finish mark",  -1)
+FLAGNR(Number,  MaxParallelMarkCount  , "Maximum number of threads marking in parallel (default: one per processor, up to 16)", -1)
 
 #if defined(_M_IX86) || defined(_M_X64)
 FLAGNR(Boolean, ZeroMemoryWithNonTemporalStore, "Zero free memory with non-temporal stores to avoid evicting other content from processor cache", DEFAULT_CONFIG_ZeroMemoryWithNonTemporalStore)
@@ -111,6 +111,7 @@ namespace PerfCounter
     MACRO(JavascriptNumber); \
     MACRO(ConcatString); \
     MACRO(LiteralString); \
+    MACRO(OneByteString); \
     MACRO(SubString); \
     MACRO(PropertyString); \
     MACRO(PropertyRecord); \
@@ -23,6 +23,9 @@ public:
 #if defined(_M_IX86) || defined(_M_X64)
     bool VirtualSseAvailable(const int sseLevel) const;
 #endif
+    // The vectorized runtime helpers (JSON scanning, string search, native array search and fill) are written against
+    // SSE2 only. There is no AVX/AVX2 detection here, nor per-function target attributes in the xplat build, so wider
+    // kernels couldn't be selected safely at runtime.
     BOOL SSE2Available() const;
 #if defined(_M_IX86) || defined(_M_X64)
     BOOL SSE3Available() const;
@@ -15,6 +15,30 @@ private:
     static const size_t EntriesPerChunk = (AutoSystemInfo::PageSize - sizeof(Chunk)) / sizeof(T);
 
 public:
+    // Full chunks given up by busy stacks so that idle stacks processed in parallel can take them.
+    // Busy stacks only give work away when a worker is idle, and only when they move between chunks,
+    // so the Push/Pop fast paths are unaffected.
+    class WorkPool
+    {
+    public:
+        WorkPool() : chunks(nullptr), workerCount(0), idleCount(0) {}
+        ~WorkPool() { Assert(chunks == nullptr); }
+
+        void Start(uint workerCount);
+        void RemoveWorker();
+        void Stop();
+
+    private:
+        friend class PageStack<T>;
+
+        bool HasIdleWorker() const { return idleCount != 0; }
+
+        CriticalSection cs;
+        Chunk * volatile chunks;
+        LONG volatile workerCount;
+        LONG volatile idleCount;
+    };
+
     PageStack(PagePool * pagePool);
     ~PageStack();
 
@@ -26,6 +50,10 @@ public:
 
     uint Split(uint targetCount, __in_ecount(targetCount) PageStack<T> ** targetStacks);
 
+    void SetWorkPool(WorkPool * workPool) { this->workPool = workPool; }
+    void GiveAllWork();
+    bool TakeWork();
+
     void Abort();
     void Release();
 
@@ -44,11 +72,12 @@ public:
     }
 #endif
 
-    static const uint MaxSplitTargets = 3;     // Not counting original stack, so this supports 4-way parallel
+    static const uint MaxSplitTargets = 15;    // Not counting original stack, so this supports 16-way parallel
 
 private:
     Chunk * CreateChunk();
     void FreeChunk(Chunk * chunk);
+    void GiveWork(Chunk * chunks);
 
 private:
     T * nextEntry;
@@ -56,6 +85,7 @@ private:
     T * chunkEnd;
     Chunk * currentChunk;
     PagePool * pagePool;
+    WorkPool * workPool;
     bool usesReservedPages;
 
 #if DBG
@@ -91,6 +121,11 @@ bool PageStack<T>::Pop(T * item)
         chunkStart = currentChunk->entries;
         chunkEnd = &currentChunk->entries[EntriesPerChunk];
         nextEntry = chunkEnd;
+
+        if (workPool != nullptr && workPool->HasIdleWorker() && currentChunk->nextChunk != nullptr)
+        {
+            GiveWork(currentChunk->nextChunk);
+        }
     }
 
     Assert(nextEntry > chunkStart && nextEntry <= chunkEnd);
@@ -118,12 +153,19 @@ bool PageStack<T>::Push(T item)
             return false;
         }
 
+        Chunk * fullChunk = currentChunk;
         newChunk->nextChunk = currentChunk;
         currentChunk = newChunk;
 
         chunkStart = currentChunk->entries;
         chunkEnd = &currentChunk->entries[EntriesPerChunk];
         nextEntry = chunkStart;
+
+        if (fullChunk != nullptr && workPool != nullptr && workPool->HasIdleWorker())
+        {
+            // The previous chunk is full; let an idle worker have it and the ones below it
+            GiveWork(fullChunk);
+        }
     }
 
     Assert(nextEntry >= chunkStart && nextEntry < chunkEnd);
@@ -143,6 +185,7 @@ bool PageStack<T>::Push(T item)
 template <typename T>
 PageStack<T>::PageStack(PagePool * pagePool) :
     pagePool(pagePool),
+    workPool(nullptr),
     currentChunk(nullptr),
     nextEntry(nullptr),
     chunkStart(nullptr),
@@ -353,6 +396,158 @@ uint PageStack<T>::Split(uint targetCount, __in_ecount(targetCount) PageStack<T>
 }
 
 
+template <typename T>
+void PageStack<T>::GiveWork(Chunk * chunks)
+{
+    // Hand [chunks] and everything linked below it over to the work pool.
+    // Only chunks below the current one are given away, and those are always full.
+    Assert(workPool != nullptr);
+    Assert(chunks != nullptr && chunks != currentChunk);
+
+    Chunk * last = chunks;
+    size_t chunkCount = 1;
+    while (last->nextChunk != nullptr)
+    {
+        last = last->nextChunk;
+        chunkCount++;
+    }
+
+    if (currentChunk != nullptr && currentChunk->nextChunk == chunks)
+    {
+        currentChunk->nextChunk = nullptr;
+    }
+
+#ifdef ENABLE_DEBUG_CONFIG_OPTIONS
+    this->pageCount -= chunkCount;
+#endif
+#if DBG
+    this->count -= chunkCount * EntriesPerChunk;
+#endif
+
+    AutoCriticalSection autocs(&workPool->cs);
+    last->nextChunk = workPool->chunks;
+    workPool->chunks = chunks;
+}
+
+template <typename T>
+void PageStack<T>::GiveAllWork()
+{
+    // Give the whole stack to the work pool. Used when the thread that was supposed
+    // to process this stack couldn't be started.
+    // The stack must have come from Split, so its current chunk is full as well.
+    Assert(workPool != nullptr);
+
+    if (IsEmpty())
+    {
+        return;
+    }
+
+    Assert(nextEntry == chunkEnd);
+    Chunk * chunks = currentChunk;
+    currentChunk = nullptr;
+    nextEntry = nullptr;
+    chunkStart = nullptr;
+    chunkEnd = nullptr;
+
+    GiveWork(chunks);
+    Assert(count == 0);
+}
+
+template <typename T>
+bool PageStack<T>::TakeWork()
+{
+    // Called when this stack has run out of work. Wait until either a chunk shows up in the
+    // work pool (return true) or every worker is idle and there is no work left (return false).
+    Assert(IsEmpty());
+
+    if (workPool == nullptr)
+    {
+        return false;
+    }
+
+    ::InterlockedIncrement(&workPool->idleCount);
+
+    uint spinCount = 0;
+    while (true)
+    {
+        if (workPool->chunks != nullptr || workPool->idleCount == workPool->workerCount)
+        {
+            AutoCriticalSection autocs(&workPool->cs);
+
+            Chunk * chunk = workPool->chunks;
+            if (chunk != nullptr)
+            {
+                workPool->chunks = chunk->nextChunk;
+                ::InterlockedDecrement(&workPool->idleCount);
+
+                chunk->nextChunk = nullptr;
+                if (currentChunk == nullptr)
+                {
+                    currentChunk = chunk;
+                    chunkStart = chunk->entries;
+                    chunkEnd = &chunk->entries[EntriesPerChunk];
+                    nextEntry = chunkEnd;
+                }
+                else
+                {
+                    // Keep our (empty) current chunk; Pop will move on to the new one.
+                    Assert(currentChunk->nextChunk == nullptr);
+                    currentChunk->nextChunk = chunk;
+                }
+
+#ifdef ENABLE_DEBUG_CONFIG_OPTIONS
+                this->pageCount++;
+#endif
+#if DBG
+                this->count += EntriesPerChunk;
+#endif
+                return true;
+            }
+
+            // Idle workers only become busy by taking a chunk under the lock, and only busy workers
+            // add chunks. So if every worker is idle and the pool is empty, we are done.
+            if (workPool->idleCount == workPool->workerCount)
+            {
+                return false;
+            }
+        }
+
+        if (++spinCount < 1000)
+        {
+            YieldProcessor();
+        }
+        else
+        {
+            SwitchToThread();
+        }
+    }
+}
+
+template <typename T>
+void PageStack<T>::WorkPool::Start(uint workerCount)
+{
+    Assert(this->chunks == nullptr);
+    this->workerCount = workerCount;
+    this->idleCount = 0;
+}
+
+template <typename T>
+void PageStack<T>::WorkPool::RemoveWorker()
+{
+    // A worker that never started can't go idle; take it out of the count.
+    AutoCriticalSection autocs(&this->cs);
+    Assert(this->workerCount > 0);
+    this->workerCount--;
+}
+
+template <typename T>
+void PageStack<T>::WorkPool::Stop()
+{
+    Assert(this->chunks == nullptr);
+    this->workerCount = 0;
+    this->idleCount = 0;
+}
+
 template <typename T>
 void PageStack<T>::Abort()
 {
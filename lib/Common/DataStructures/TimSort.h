@@ -0,0 +1,666 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+namespace JsUtil
+{
+    //
+    // Stable, adaptive merge sort (TimSort).
+    //
+    // The input is split into naturally ascending (or strictly descending, which are reversed) runs, short runs are
+    // extended with a binary insertion sort, and runs are merged pairwise while keeping the pending run lengths balanced.
+    // Merges switch to galloping (exponential search) when one run keeps winning, so already or mostly sorted input is
+    // sorted in close to n comparisons.
+    //
+    // comparer(a, b) returns <0, 0 or >0 like strcmp; only "less than" is used, which keeps equal elements in order.
+    // The comparer may be user code: it may return inconsistent results, and it may throw. In both cases the array is
+    // left as some permutation of its original elements.
+    //
+    // allocTemp(count) returns a buffer of at least count elements for merging; it is called lazily and only grows.
+    // Elements are moved with memcpy/memmove, so T must be trivially copyable. If T holds recycler pointers, the buffer
+    // must be a non-leaf recycler allocation so that elements only present in the buffer during a merge stay alive.
+    //
+    template <typename T, typename TComparer, typename TTempAllocator>
+    class TimSorter
+    {
+    private:
+        // Runs shorter than this are extended with binary insertion sort.
+        static const uint32 MinMerge = 64;
+        // Initial threshold for entering galloping mode.
+        static const uint32 MinGallop = 7;
+        // The run-length invariants make pending run lengths grow at least as fast as the Fibonacci numbers,
+        // so this is far more than enough for any uint32 length.
+        static const uint32 MaxPendingRuns = 85;
+
+        struct Run
+        {
+            T* base;
+            uint32 length;
+        };
+
+        const TComparer& comparer;
+        const TTempAllocator& allocTemp;
+        T* temp;
+        uint32 tempLength;
+        uint32 minGallop;
+        uint32 pendingCount;
+        Run pending[MaxPendingRuns];
+
+    public:
+        TimSorter(const TComparer& comparer, const TTempAllocator& allocTemp) :
+            comparer(comparer), allocTemp(allocTemp), temp(nullptr), tempLength(0), minGallop(MinGallop), pendingCount(0)
+        {
+        }
+
+        void Sort(__inout_ecount(length) T* elements, uint32 length)
+        {
+            if (length < 2)
+            {
+                return;
+            }
+
+            T* low = elements;
+            T* high = elements + length;
+            uint32 remaining = length;
+            const uint32 minRun = ComputeMinRun(length);
+
+            do
+            {
+                uint32 runLength = CountRunAndMakeAscending(low, high);
+                if (runLength < minRun)
+                {
+                    const uint32 force = remaining <= minRun ? remaining : minRun;
+                    BinaryInsertionSort(low, low + force, low + runLength);
+                    runLength = force;
+                }
+
+                Assert(pendingCount < MaxPendingRuns);
+                pending[pendingCount].base = low;
+                pending[pendingCount].length = runLength;
+                pendingCount++;
+                MergeCollapse();
+
+                low += runLength;
+                remaining -= runLength;
+            } while (remaining != 0);
+
+            MergeForceCollapse();
+            Assert(pendingCount == 1);
+            Assert(pending[0].base == elements && pending[0].length == length);
+        }
+
+    private:
+        bool IsLess(const T& a, const T& b) const
+        {
+            return comparer(a, b) < 0;
+        }
+
+        static uint32 ComputeMinRun(uint32 n)
+        {
+            // Take the 6 most significant bits of n, adding one if any of the remaining bits are set, so that
+            // n / minRun is a power of two or slightly less than one.
+            uint32 r = 0;
+            while (n >= MinMerge)
+            {
+                r |= n & 1;
+                n >>= 1;
+            }
+            return n + r;
+        }
+
+        static void Reverse(T* low, T* high)
+        {
+            --high;
+            while (low < high)
+            {
+                T t = *low;
+                *low++ = *high;
+                *high-- = t;
+            }
+        }
+
+        // Returns the length of the run starting at low. A descending run must be strictly descending so that
+        // reversing it in place keeps the sort stable.
+        uint32 CountRunAndMakeAscending(T* low, T* high) const
+        {
+            Assert(low < high);
+            T* runHigh = low + 1;
+            if (runHigh == high)
+            {
+                return 1;
+            }
+
+            if (IsLess(*runHigh, *low))
+            {
+                for (++runHigh; runHigh < high && IsLess(*runHigh, *(runHigh - 1)); ++runHigh);
+                Reverse(low, runHigh);
+            }
+            else
+            {
+                for (++runHigh; runHigh < high && !IsLess(*runHigh, *(runHigh - 1)); ++runHigh);
+            }
+            return (uint32)(runHigh - low);
+        }
+
+        // Sorts [low, high) given that [low, start) is already sorted. Nothing is moved until the comparisons for
+        // an element are done, so a throwing comparer leaves the range intact.
+        void BinaryInsertionSort(T* low, T* high, T* start) const
+        {
+            Assert(low <= start && start <= high);
+            if (low == start)
+            {
+                ++start;
+            }
+
+            for (; start < high; ++start)
+            {
+                T* left = low;
+                T* right = start;
+                const T pivot = *start;
+                while (left < right)
+                {
+                    T* middle = left + ((right - left) >> 1);
+                    if (IsLess(pivot, *middle))
+                    {
+                        right = middle;
+                    }
+                    else
+                    {
+                        left = middle + 1;
+                    }
+                }
+                memmove(left + 1, left, (start - left) * sizeof(T));
+                *left = pivot;
+            }
+        }
+
+        // Returns k such that a[k - 1] < key <= a[k], searching out from a[hint]. The leftmost position is used for
+        // keys equal to elements of a.
+        int64 GallopLeft(const T& key, const T* a, int64 n, int64 hint) const
+        {
+            Assert(n > 0 && hint >= 0 && hint < n);
+            int64 lastOffset = 0;
+            int64 offset = 1;
+
+            if (IsLess(a[hint], key))
+            {
+                // a[hint] < key: gallop right until a[hint + lastOffset] < key <= a[hint + offset]
+                const int64 maxOffset = n - hint;
+                while (offset < maxOffset && IsLess(a[hint + offset], key))
+                {
+                    lastOffset = offset;
+                    offset = (offset << 1) + 1;
+                }
+                if (offset > maxOffset)
+                {
+                    offset = maxOffset;
+                }
+                lastOffset += hint;
+                offset += hint;
+            }
+            else
+            {
+                // key <= a[hint]: gallop left until a[hint - offset] < key <= a[hint - lastOffset]
+                const int64 maxOffset = hint + 1;
+                while (offset < maxOffset && !IsLess(a[hint - offset], key))
+                {
+                    lastOffset = offset;
+                    offset = (offset << 1) + 1;
+                }
+                if (offset > maxOffset)
+                {
+                    offset = maxOffset;
+                }
+                const int64 k = lastOffset;
+                lastOffset = hint - offset;
+                offset = hint - k;
+            }
+
+            // a[lastOffset] < key <= a[offset]; binary search the gap.
+            Assert(-1 <= lastOffset && lastOffset < offset && offset <= n);
+            ++lastOffset;
+            while (lastOffset < offset)
+            {
+                const int64 middle = lastOffset + ((offset - lastOffset) >> 1);
+                if (IsLess(a[middle], key))
+                {
+                    lastOffset = middle + 1;
+                }
+                else
+                {
+                    offset = middle;
+                }
+            }
+            return offset;
+        }
+
+        // Returns k such that a[k - 1] <= key < a[k], searching out from a[hint]. The rightmost position is used for
+        // keys equal to elements of a.
+        int64 GallopRight(const T& key, const T* a, int64 n, int64 hint) const
+        {
+            Assert(n > 0 && hint >= 0 && hint < n);
+            int64 lastOffset = 0;
+            int64 offset = 1;
+
+            if (IsLess(key, a[hint]))
+            {
+                // key < a[hint]: gallop left until a[hint - offset] <= key < a[hint - lastOffset]
+                const int64 maxOffset = hint + 1;
+                while (offset < maxOffset && IsLess(key, a[hint - offset]))
+                {
+                    lastOffset = offset;
+                    offset = (offset << 1) + 1;
+                }
+                if (offset > maxOffset)
+                {
+                    offset = maxOffset;
+                }
+                const int64 k = lastOffset;
+                lastOffset = hint - offset;
+                offset = hint - k;
+            }
+            else
+            {
+                // a[hint] <= key: gallop right until a[hint + lastOffset] <= key < a[hint + offset]
+                const int64 maxOffset = n - hint;
+                while (offset < maxOffset && !IsLess(key, a[hint + offset]))
+                {
+                    lastOffset = offset;
+                    offset = (offset << 1) + 1;
+                }
+                if (offset > maxOffset)
+                {
+                    offset = maxOffset;
+                }
+                lastOffset += hint;
+                offset += hint;
+            }
+
+            // a[lastOffset] <= key < a[offset]; binary search the gap.
+            Assert(-1 <= lastOffset && lastOffset < offset && offset <= n);
+            ++lastOffset;
+            while (lastOffset < offset)
+            {
+                const int64 middle = lastOffset + ((offset - lastOffset) >> 1);
+                if (IsLess(key, a[middle]))
+                {
+                    offset = middle;
+                }
+                else
+                {
+                    lastOffset = middle + 1;
+                }
+            }
+            return offset;
+        }
+
+        T* EnsureTemp(uint32 count)
+        {
+            if (count > tempLength)
+            {
+                // Merges only ever need the shorter of two adjacent runs; grow geometrically to avoid
+                // reallocating for every merge on the way up.
+                uint32 newLength = tempLength * 2;
+                if (newLength < count)
+                {
+                    newLength = count;
+                }
+                temp = allocTemp(newLength);
+                tempLength = newLength;
+            }
+            return temp;
+        }
+
+        // Keeps the pending run lengths such that, for the top runs A, B, C (C on top):
+        //     A > B + C and B > C
+        // which bounds the stack depth and keeps merges balanced.
+        void MergeCollapse()
+        {
+            while (pendingCount > 1)
+            {
+                uint32 n = pendingCount - 2;
+                if ((n > 0 && pending[n - 1].length <= pending[n].length + pending[n + 1].length) ||
+                    (n > 1 && pending[n - 2].length <= pending[n - 1].length + pending[n].length))
+                {
+                    if (pending[n - 1].length < pending[n + 1].length)
+                    {
+                        --n;
+                    }
+                    MergeAt(n);
+                }
+                else if (pending[n].length <= pending[n + 1].length)
+                {
+                    MergeAt(n);
+                }
+                else
+                {
+                    break;
+                }
+            }
+        }
+
+        void MergeForceCollapse()
+        {
+            while (pendingCount > 1)
+            {
+                uint32 n = pendingCount - 2;
+                if (n > 0 && pending[n - 1].length < pending[n + 1].length)
+                {
+                    --n;
+                }
+                MergeAt(n);
+            }
+        }
+
+        // Merges the adjacent pending runs i and i + 1.
+        void MergeAt(uint32 i)
+        {
+            Assert(pendingCount >= 2 && i + 2 <= pendingCount);
+
+            T* baseA = pending[i].base;
+            uint32 lengthA = pending[i].length;
+            T* baseB = pending[i + 1].base;
+            uint32 lengthB = pending[i + 1].length;
+            Assert(lengthA > 0 && lengthB > 0 && baseA + lengthA == baseB);
+
+            pending[i].length = lengthA + lengthB;
+            if (i + 3 == pendingCount)
+            {
+                pending[i + 1] = pending[i + 2];
+            }
+            --pendingCount;
+
+            // Elements of A that are <= B[0] are already in place.
+            const uint32 k = (uint32)GallopRight(*baseB, baseA, lengthA, 0);
+            baseA += k;
+            lengthA -= k;
+            if (lengthA == 0)
+            {
+                return;
+            }
+
+            // Elements of B that are >= A[last] are already in place.
+            lengthB = (uint32)GallopLeft(baseA[lengthA - 1], baseB, lengthB, lengthB - 1);
+            if (lengthB == 0)
+            {
+                return;
+            }
+
+            if (lengthA <= lengthB)
+            {
+                MergeLow(baseA, lengthA, baseB, lengthB);
+            }
+            else
+            {
+                MergeHigh(baseA, lengthA, baseB, lengthB);
+            }
+        }
+
+        // Merges A and B front to back, with A (the shorter run) copied out to the temp buffer. Whatever is left of A
+        // when the merge stops, including when the comparer throws, is copied back into the gap by the guard; the gap
+        // always has exactly that size.
+        void MergeLow(T* baseA, uint32 lengthA, T* baseB, uint32 lengthB)
+        {
+            Assert(lengthA > 0 && lengthB > 0 && baseA + lengthA == baseB);
+
+            T* a = EnsureTemp(lengthA);
+            memcpy(a, baseA, lengthA * sizeof(T));
+            T* b = baseB;
+            T* dest = baseA;
+
+            struct Guard
+            {
+                T*& dest;
+                T*& a;
+                uint32& lengthA;
+                ~Guard()
+                {
+                    if (lengthA != 0)
+                    {
+                        memcpy(dest, a, lengthA * sizeof(T));
+                    }
+                }
+            } guard = { dest, a, lengthA };
+
+            *dest++ = *b++;
+            if (--lengthB == 0)
+            {
+                return;
+            }
+            if (lengthA == 1)
+            {
+                goto CopyB;
+            }
+
+            for (;;)
+            {
+                uint32 countA = 0; // times in a row A won
+                uint32 countB = 0; // times in a row B won
+
+                // Compare one element at a time until one run starts winning consistently.
+                do
+                {
+                    Assert(lengthA > 1 && lengthB > 0);
+                    if (IsLess(*b, *a))
+                    {
+                        *dest++ = *b++;
+                        ++countB;
+                        countA = 0;
+                        if (--lengthB == 0)
+                        {
+                            return;
+                        }
+                    }
+                    else
+                    {
+                        *dest++ = *a++;
+                        ++countA;
+                        countB = 0;
+                        if (--lengthA == 1)
+                        {
+                            goto CopyB;
+                        }
+                    }
+                } while (countA < minGallop && countB < minGallop);
+
+                // Gallop until neither run is winning consistently anymore.
+                ++minGallop;
+                do
+                {
+                    Assert(lengthA > 1 && lengthB > 0);
+                    minGallop -= minGallop > 1;
+
+                    countA = (uint32)GallopRight(*b, a, lengthA, 0);
+                    if (countA != 0)
+                    {
+                        memcpy(dest, a, countA * sizeof(T));
+                        dest += countA;
+                        a += countA;
+                        lengthA -= countA;
+                        if (lengthA == 1)
+                        {
+                            goto CopyB;
+                        }
+                        // Only possible with an inconsistent comparer.
+                        if (lengthA == 0)
+                        {
+                            return;
+                        }
+                    }
+                    *dest++ = *b++;
+                    if (--lengthB == 0)
+                    {
+                        return;
+                    }
+
+                    countB = (uint32)GallopLeft(*a, b, lengthB, 0);
+                    if (countB != 0)
+                    {
+                        memmove(dest, b, countB * sizeof(T));
+                        dest += countB;
+                        b += countB;
+                        lengthB -= countB;
+                        if (lengthB == 0)
+                        {
+                            return;
+                        }
+                    }
+                    *dest++ = *a++;
+                    if (--lengthA == 1)
+                    {
+                        goto CopyB;
+                    }
+                } while (countA >= MinGallop || countB >= MinGallop);
+
+                // Penalize leaving galloping mode.
+                ++minGallop;
+            }
+
+        CopyB:
+            // The last element of A belongs after all of the remaining elements of B.
+            Assert(lengthA == 1 && lengthB > 0);
+            memmove(dest, b, lengthB * sizeof(T));
+            dest[lengthB] = *a;
+            lengthA = 0;
+        }
+
+        // Merges A and B back to front, with B (the shorter run) copied out to the temp buffer. Whatever is left of B
+        // when the merge stops, including when the comparer throws, is copied back into the gap by the guard.
+        void MergeHigh(T* baseA, uint32 lengthA, T* baseB, uint32 lengthB)
+        {
+            Assert(lengthA > 0 && lengthB > 0 && baseA + lengthA == baseB);
+
+            T* const tempB = EnsureTemp(lengthB);
+            memcpy(tempB, baseB, lengthB * sizeof(T));
+            T* a = baseA + lengthA - 1;     // last remaining element of A
+            T* b = tempB + lengthB - 1;     // last remaining element of B
+            T* dest = baseB + lengthB - 1;  // last unfilled slot
+
+            struct Guard
+            {
+                T*& dest;
+                T* const tempB;
+                uint32& lengthB;
+                ~Guard()
+                {
+                    if (lengthB != 0)
+                    {
+                        memcpy(dest - (lengthB - 1), tempB, lengthB * sizeof(T));
+                    }
+                }
+            } guard = { dest, tempB, lengthB };
+
+            *dest-- = *a--;
+            if (--lengthA == 0)
+            {
+                return;
+            }
+            if (lengthB == 1)
+            {
+                goto CopyA;
+            }
+
+            for (;;)
+            {
+                uint32 countA = 0; // times in a row A won
+                uint32 countB = 0; // times in a row B won
+
+                // Compare one element at a time until one run starts winning consistently.
+                do
+                {
+                    Assert(lengthA > 0 && lengthB > 1);
+                    if (IsLess(*b, *a))
+                    {
+                        *dest-- = *a--;
+                        ++countA;
+                        countB = 0;
+                        if (--lengthA == 0)
+                        {
+                            return;
+                        }
+                    }
+                    else
+                    {
+                        *dest-- = *b--;
+                        ++countB;
+                        countA = 0;
+                        if (--lengthB == 1)
+                        {
+                            goto CopyA;
+                        }
+                    }
+                } while (countA < minGallop && countB < minGallop);
+
+                // Gallop until neither run is winning consistently anymore.
+                ++minGallop;
+                do
+                {
+                    Assert(lengthA > 0 && lengthB > 1);
+                    minGallop -= minGallop > 1;
+
+                    countA = lengthA - (uint32)GallopRight(*b, baseA, lengthA, lengthA - 1);
+                    if (countA != 0)
+                    {
+                        dest -= countA;
+                        a -= countA;
+                        memmove(dest + 1, a + 1, countA * sizeof(T));
+                        lengthA -= countA;
+                        if (lengthA == 0)
+                        {
+                            return;
+                        }
+                    }
+                    *dest-- = *b--;
+                    if (--lengthB == 1)
+                    {
+                        goto CopyA;
+                    }
+
+                    countB = lengthB - (uint32)GallopLeft(*a, tempB, lengthB, lengthB - 1);
+                    if (countB != 0)
+                    {
+                        dest -= countB;
+                        b -= countB;
+                        memcpy(dest + 1, b + 1, countB * sizeof(T));
+                        lengthB -= countB;
+                        if (lengthB == 1)
+                        {
+                            goto CopyA;
+                        }
+                        // Only possible with an inconsistent comparer.
+                        if (lengthB == 0)
+                        {
+                            return;
+                        }
+                    }
+                    *dest-- = *a--;
+                    if (--lengthA == 0)
+                    {
+                        return;
+                    }
+                } while (countA >= MinGallop || countB >= MinGallop);
+
+                // Penalize leaving galloping mode.
+                ++minGallop;
+            }
+
+        CopyA:
+            // The first element of B belongs before all of the remaining elements of A.
+            Assert(lengthB == 1 && lengthA > 0);
+            dest -= lengthA;
+            a -= lengthA;
+            memmove(dest + 1, a + 1, lengthA * sizeof(T));
+            *dest = *b;
+            lengthB = 0;
+        }
+    };
+
+    template <typename T, typename TComparer, typename TTempAllocator>
+    void TimSort(__inout_ecount(length) T* elements, uint32 length, const TComparer& comparer, const TTempAllocator& allocTemp)
+    {
+        TimSorter<T, TComparer, TTempAllocator> sorter(comparer, allocTemp);
+        sorter.Sort(elements, length);
+    }
+}
@@ -1040,6 +1040,10 @@ SmallHeapBlockT<TBlockAttributes>::Sweep(RecyclerSweep& recyclerSweep, bool queu
 
     Recycler * recycler = recyclerSweep.GetRecycler();
     RECYCLER_STATS_INC(recycler, heapBlockCount[this->GetHeapBlockType()]);
+#if ENABLE_RECYCLER_GC_STATISTICS
+    recycler->gcStatistics.RecordSweptBlock(this->objectSize, expectSweepCount * this->objectSize,
+        localMarkCount * this->objectSize, objectCount * this->objectSize);
+#endif
 
 #if ENABLE_PARTIAL_GC
     if (recyclerSweep.DoAdjustPartialHeuristics() && allocable)
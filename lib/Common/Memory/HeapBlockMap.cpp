@@ -1123,6 +1123,7 @@ HeapBlockMap32::Cleanup(bool concurrentFindImplicitRoot)
 HeapBlockMap64::HeapBlockMap64():
     list(nullptr)
 {
+    memset(directory, 0, sizeof(directory));
 }
 
 HeapBlockMap64::~HeapBlockMap64()
@@ -1136,6 +1137,15 @@ HeapBlockMap64::~HeapBlockMap64()
         NoMemProtectHeapDelete(node);
         node = next;
     }
+
+    for (uint i = 0; i < NodeDirectoryL1Count; i++)
+    {
+        if (directory[i] != nullptr)
+        {
+            NoMemProtectHeapDelete(directory[i]);
+            directory[i] = nullptr;
+        }
+    }
 }
 
 bool
@@ -1314,45 +1324,49 @@ HeapBlockMap64::TestAndSetMark(void * address)
 HeapBlockMap64::Node *
 HeapBlockMap64::FindOrInsertNode(void * address)
 {
-    Node * node = FindNode(address);
+    uint index = GetNodeIndex(address);
+    Node * node = FindNode(index);
 
     if (node == nullptr)
     {
+        if (index >= NodeIndexCount)
+        {
+            AssertMsg(false, "Heap address beyond the range of the node directory");
+            return nullptr;
+        }
+
+        NodeDirectoryChunk * chunk = directory[index >> NodeDirectoryL2BitCount];
+        if (chunk == nullptr)
+        {
+            chunk = NoMemProtectHeapNewNoThrowZ(NodeDirectoryChunk);
+            if (chunk == nullptr)
+            {
+                return nullptr;
+            }
+#ifdef _M_ARM64
+            // For ARM we need to make sure that the chunk is cleared before concurrent lookups can see it.
+            MemoryBarrier();
+#endif
+            directory[index >> NodeDirectoryL2BitCount] = chunk;
+        }
+
         node = NoMemProtectHeapNewNoThrowZ(Node, GetNodeStartAddress(address));
         if (node != nullptr)
         {
-            node->nodeIndex = GetNodeIndex(address);
+            node->nodeIndex = index;
             node->next = list;
 #ifdef _M_ARM64
-            // For ARM we need to make sure that the list remains traversable during this insert.
+            // For ARM we need to make sure that the list remains traversable and the node initialized during this insert.
             MemoryBarrier();
 #endif
             list = node;
+            chunk->nodes[index & (NodeDirectoryL2Count - 1)] = node;
         }
     }
 
     return node;
 }
 
-HeapBlockMap64::Node *
-HeapBlockMap64::FindNode(void * address) const
-{
-    uint index = GetNodeIndex(address);
-
-    Node * node = list;
-    while (node != nullptr)
-    {
-        if (node->nodeIndex == index)
-        {
-            return node;
-        }
-
-        node = node->next;
-    }
-
-    return nullptr;
-}
-
 void
 HeapBlockMap64::ResetMarks()
 {
@@ -1446,6 +1460,7 @@ HeapBlockMap64::Cleanup(bool concurrentFindImplicitRoot)
             // Concurrent traversals of the node list would result in a race and possible UAF.
             // Currently we simply defer node free for the lifetime of the heap (only affects MemProtect).
             *prevnext = node->next;
+            directory[node->nodeIndex >> NodeDirectoryL2BitCount]->nodes[node->nodeIndex & (NodeDirectoryL2Count - 1)] = nullptr;
             NoMemProtectHeapDelete(node);
         }
         else
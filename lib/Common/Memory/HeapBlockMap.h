@@ -292,6 +292,20 @@ private:
 
     static const uint PagesPer4GB = 1 << 20; // = 1M,  assume page size = 4K
 
+    // Nodes are found through a two level directory indexed by the bits of the address above the low 4GB,
+    // so that finding the node of a candidate pointer while marking costs the same however many nodes
+    // there are. User mode addresses fit in 48 bits on both x64 and ARM64, which leaves 16 bits of node index.
+    static const uint NodeIndexBitCount = 16;
+    static const uint NodeIndexCount = 1 << NodeIndexBitCount;
+    static const uint NodeDirectoryL2BitCount = 8;
+    static const uint NodeDirectoryL1Count = 1 << (NodeIndexBitCount - NodeDirectoryL2BitCount);
+    static const uint NodeDirectoryL2Count = 1 << NodeDirectoryL2BitCount;
+
+    struct NodeDirectoryChunk
+    {
+        Node * nodes[NodeDirectoryL2Count];
+    };
+
     static uint GetNodeIndex(void * address)
     {
         return GetNodeIndex((ULONG64)address);
@@ -303,12 +317,36 @@ private:
     }
 
     Node * FindOrInsertNode(void * address);
-    Node * FindNode(void * address) const;
+    Node * FindNode(void * address) const
+    {
+        return FindNode(GetNodeIndex(address));
+    }
+
+    // Called by the concurrent marking threads while the main thread may be adding nodes. A chunk or node
+    // is entered in the directory only once it is initialized, and chunks are never freed before the map is.
+    Node * FindNode(uint index) const
+    {
+        if (index >= NodeIndexCount)
+        {
+            // Not a user mode address; can't be in the heap
+            return nullptr;
+        }
+
+        NodeDirectoryChunk * chunk = directory[index >> NodeDirectoryL2BitCount];
+        if (chunk == nullptr)
+        {
+            return nullptr;
+        }
+
+        return chunk->nodes[index & (NodeDirectoryL2Count - 1)];
+    }
 
     template <class Fn>
     void ForEachNodeInAddressRange(void * address, size_t pageCount, Fn fn);
 
+    // All the nodes, for the operations that visit the whole heap
     Node * list;
+    NodeDirectoryChunk * directory[NodeDirectoryL1Count];
 
 public:
 #if DBG
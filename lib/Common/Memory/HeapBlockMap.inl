@@ -339,20 +339,13 @@ inline
 void
 HeapBlockMap64::Mark(void * candidate, MarkContext * markContext)
 {
-    uint index = GetNodeIndex(candidate);
-
-    Node * node = list;
-    while (node != nullptr)
+    Node * node = FindNode(candidate);
+    if (node != nullptr)
     {
-        if (node->nodeIndex == index)
-        {
-            // Found the correct Node.
-            // Process the mark and return.
-            node->map.Mark<interlocked>(candidate, markContext);
-            return;
-        }
-
-        node = node->next;
+        // Found the correct Node.
+        // Process the mark and return.
+        node->map.Mark<interlocked>(candidate, markContext);
+        return;
     }
 
     // No Node found; must be an invalid reference. Do nothing.
@@ -363,20 +356,13 @@ inline
 void
 HeapBlockMap64::MarkInterior(void * candidate, MarkContext * markContext)
 {
-    uint index = GetNodeIndex(candidate);
-
-    Node * node = list;
-    while (node != nullptr)
+    Node * node = FindNode(candidate);
+    if (node != nullptr)
     {
-        if (node->nodeIndex == index)
-        {
-            // Found the correct Node.
-            // Process the mark and return.
-            node->map.MarkInterior<interlocked>(candidate, markContext);
-            return;
-        }
-
-        node = node->next;
+        // Found the correct Node.
+        // Process the mark and return.
+        node->map.MarkInterior<interlocked>(candidate, markContext);
+        return;
     }
 
     // No Node found; must be an invalid reference. Do nothing.
@@ -1318,6 +1318,32 @@ LargeHeapBlock::Sweep(RecyclerSweep& recyclerSweep, bool queuePendingSweep)
     this->expectedSweepCount = allocCount - markCount;
 #endif
 
+#if ENABLE_RECYCLER_GC_STATISTICS
+    {
+        const HeapBlockMap& heapBlockMap = recycler->heapBlockMap;
+        size_t liveBytes = 0;
+        size_t freedBytes = 0;
+        for (uint i = 0; i < allocCount; i++)
+        {
+            LargeObjectHeader * header = this->GetHeader(i);
+            if (header == nullptr)
+            {
+                continue;
+            }
+            if (heapBlockMap.IsMarked(header->GetAddress()))
+            {
+                liveBytes += header->objectSize;
+            }
+            else
+            {
+                freedBytes += header->objectSize;
+            }
+        }
+        recycler->gcStatistics.RecordSweptBlock(HeapConstants::MaxMediumObjectSize + 1, freedBytes, liveBytes,
+            this->pageCount * AutoSystemInfo::PageSize);
+    }
+#endif
+
 #if ENABLE_CONCURRENT_GC
     Assert(!this->isPendingConcurrentSweep);
 #endif
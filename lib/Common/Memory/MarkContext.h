@@ -49,6 +49,11 @@ public:
 
     uint Split(uint targetCount, __in_ecount(targetCount) MarkContext ** targetContexts);
 
+    typedef PageStack<MarkCandidate>::WorkPool WorkPool;
+    void SetWorkPool(WorkPool * workPool) { markStack.SetWorkPool(workPool); }
+    void GiveAllMarkWork() { markStack.GiveAllWork(); }
+    bool TakeMarkWork() { return markStack.TakeWork(); }
+
     void Abort();
     void Release();
 
@@ -966,6 +966,11 @@ PageAllocatorBase<T>::FillFreePages(__in void * address, uint pageCount)
 #endif
     if (ZeroPages())
     {
+        if (TryResetZeroPages(address, pageCount))
+        {
+            return;
+        }
+
         //
         // Do memset via non-temporal store to avoid evicting existing processor cache.
         // This helps low-end machines with limited cache size.
@@ -985,6 +990,24 @@ PageAllocatorBase<T>::FillFreePages(__in void * address, uint pageCount)
 
 }
 
+template<typename T>
+bool
+PageAllocatorBase<T>::TryResetZeroPages(__in void * address, uint pageCount)
+{
+#ifndef _WIN32
+    //
+    // The PAL's MEM_RESET drops the pages (madvise(MADV_DONTNEED)) and they read back as zero.
+    // This also returns the memory to the OS until the pages are reused. This is used both when
+    // freed pages are zeroed right away and, with concurrent GC, when queued pages are zeroed
+    // in the background.
+    //
+    return pageCount >= MinResetZeroPageCount && this->processHandle == GetCurrentProcess() &&
+        ::VirtualAlloc(address, pageCount * AutoSystemInfo::PageSize, MEM_RESET, PAGE_READWRITE) != nullptr;
+#else
+    return false;
+#endif
+}
+
 template<typename T>
 template <bool notPageAligned>
 char *
@@ -1605,6 +1628,11 @@ PageAllocatorBase<T>::ZeroQueuedPages()
         PageSegmentBase<T> * segment = freePageEntry->segment;
         uint pageCount = freePageEntry->pageCount;
 
+        if (TryResetZeroPages(freePageEntry, pageCount))
+        {
+            Assert(freePageEntry->segment == nullptr && freePageEntry->pageCount == 0);
+        }
+        else
         //
         // Do memset via non-temporal store to avoid evicting existing processor cache.
         // This helps low-end machines with limited cache size.
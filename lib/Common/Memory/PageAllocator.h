@@ -416,6 +416,12 @@ public:
 #endif
 #endif
 
+#ifndef _WIN32
+    // Runs of at least this many freed pages are zeroed by discarding them (MEM_RESET)
+    // instead of a memset; smaller runs aren't worth the syscall and TLB shootdown
+    static uint const MinResetZeroPageCount = 16;            // 64K
+#endif
+
     PageAllocatorBase(AllocationPolicyManager * policyManager,
 #ifndef JD_PRIVATE
         Js::ConfigFlagsTable& flags = Js::Configuration::Global.flags,
@@ -540,6 +546,7 @@ protected:
 
     void FillAllocPages(__in void * address, uint pageCount);
     void FillFreePages(__in void * address, uint pageCount);
+    bool TryResetZeroPages(__in void * address, uint pageCount);
 
     struct FreePageEntry : public SLIST_ENTRY
     {
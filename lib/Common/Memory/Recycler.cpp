@@ -132,13 +132,8 @@ Recycler::Recycler(AllocationPolicyManager * policyManager, IdleDecommitPageAllo
 #endif
     threadPageAllocator(pageAllocator),
     markPagePool(configFlagsTable),
-    parallelMarkPagePool1(configFlagsTable),
-    parallelMarkPagePool2(configFlagsTable),
-    parallelMarkPagePool3(configFlagsTable),
     markContext(this, &this->markPagePool),
-    parallelMarkContext1(this, &this->parallelMarkPagePool1),
-    parallelMarkContext2(this, &this->parallelMarkPagePool2),
-    parallelMarkContext3(this, &this->parallelMarkPagePool3),
+    parallelMarkContextCount(0),
 #if ENABLE_PARTIAL_GC
     clientTrackedObjectAllocator(_u("CTO-List"), GetPageAllocator(), Js::Throw::OutOfMemory),
 #endif
@@ -166,8 +161,6 @@ Recycler::Recycler(AllocationPolicyManager * policyManager, IdleDecommitPageAllo
     concurrentThread(NULL),
     concurrentWorkReadyEvent(NULL),
     concurrentWorkDoneEvent(NULL),
-    parallelThread1(this, &Recycler::ParallelWorkFunc<0>),
-    parallelThread2(this, &Recycler::ParallelWorkFunc<1>),
     priorityBoost(false),
     isAborting(false),
 #if DBG
@@ -209,6 +202,7 @@ Recycler::Recycler(AllocationPolicyManager * policyManager, IdleDecommitPageAllo
     pinnedObjectMap(1024, HeapAllocator::GetNoMemProtectInstance()),
     weakReferenceMap(1024, HeapAllocator::GetNoMemProtectInstance()),
     weakReferenceCleanupId(0),
+    ephemeronTableList(nullptr),
     collectionWrapper(&DefaultRecyclerCollectionWrapper::Instance),
     isScriptActive(false),
     isInScript(false),
@@ -257,9 +251,6 @@ Recycler::Recycler(AllocationPolicyManager * policyManager, IdleDecommitPageAllo
 #ifdef RECYCLER_MARK_TRACK
     this->markMap = NoCheckHeapNew(MarkMap, &NoCheckHeapAllocator::Instance, 163, &markMapCriticalSection);
     markContext.SetMarkMap(markMap);
-    parallelMarkContext1.SetMarkMap(markMap);
-    parallelMarkContext2.SetMarkMap(markMap);
-    parallelMarkContext3.SetMarkMap(markMap);
 #endif
 
 #ifdef RECYCLER_MEMORY_VERIFY
@@ -326,9 +317,6 @@ Recycler::Recycler(AllocationPolicyManager * policyManager, IdleDecommitPageAllo
 #ifdef ENABLE_DEBUG_CONFIG_OPTIONS
     // recycler requires at least Recycler::PrimaryMarkStackReservedPageCount to function properly for the main mark context
     this->markContext.SetMaxPageCount(max(static_cast<size_t>(GetRecyclerFlagsTable().MaxMarkStackPageCount), static_cast<size_t>(Recycler::PrimaryMarkStackReservedPageCount)));
-    this->parallelMarkContext1.SetMaxPageCount(GetRecyclerFlagsTable().MaxMarkStackPageCount);
-    this->parallelMarkContext2.SetMaxPageCount(GetRecyclerFlagsTable().MaxMarkStackPageCount);
-    this->parallelMarkContext3.SetMaxPageCount(GetRecyclerFlagsTable().MaxMarkStackPageCount);
 
     if (GetRecyclerFlagsTable().IsEnabled(Js::GCMemoryThresholdFlag))
     {
@@ -510,9 +498,19 @@ Recycler::~Recycler()
 #endif
 
     markContext.Release();
-    parallelMarkContext1.Release();
-    parallelMarkContext2.Release();
-    parallelMarkContext3.Release();
+#if ENABLE_CONCURRENT_GC
+    for (uint i = 0; i < this->GetParallelThreadCount(); i++)
+    {
+        HeapDelete(parallelThreads[i]);
+    }
+#endif
+    for (uint i = 0; i < this->parallelMarkContextCount; i++)
+    {
+        parallelMarkContexts[i]->Release();
+        HeapDelete(parallelMarkContexts[i]);
+        HeapDelete(parallelMarkPagePools[i]);
+    }
+    this->parallelMarkContextCount = 0;
 
     // Clean up the weak reference map so that
     // objects being finalized can safely refer to weak references
@@ -827,13 +825,18 @@ Recycler::Initialize(const bool forceInThread, JsUtil::ThreadService *threadServ
 #if ENABLE_CONCURRENT_GC
     // Default to non-concurrent
     uint numProcs = (uint)AutoSystemInfo::Data.GetNumberOfPhysicalProcessors();
-    this->maxParallelism = (numProcs > 4) || CUSTOM_PHASE_FORCE1(GetRecyclerFlagsTable(), Js::ParallelMarkPhase) ? 4 : numProcs;
+    this->maxParallelism = min(RecyclerHeuristic::MaxParallelMarkCount(numProcs, GetRecyclerFlagsTable()), Recycler::MaxParallelism);
 
     if (forceInThread)
     {
         // Requested a non-concurrent recycler
         this->disableConcurrent = true;
     }
+    else if (!RecyclerPageAllocator::IsWriteWatchSupported())
+    {
+        // The platform can't track writes to recycler pages
+        this->disableConcurrent = true;
+    }
 #if ENABLE_DEBUG_CONFIG_OPTIONS
     else if (CUSTOM_PHASE_OFF1(GetRecyclerFlagsTable(), Js::ConcurrentCollectPhase))
     {
@@ -852,6 +855,8 @@ Recycler::Initialize(const bool forceInThread, JsUtil::ThreadService *threadServ
     {
         this->disableConcurrent = false;
 
+        this->InitializeParallelMark();
+
         if (deferThreadStartup || EnableConcurrent(threadService, false))
         {
             needWriteWatch = true;
@@ -860,6 +865,12 @@ Recycler::Initialize(const bool forceInThread, JsUtil::ThreadService *threadServ
 #endif
 
 #if ENABLE_PARTIAL_GC
+    if (this->enablePartialCollect && !RecyclerPageAllocator::IsWriteWatchSupported())
+    {
+        // Partial collection needs write watch to find the pages rescanned
+        this->enablePartialCollect = false;
+    }
+
     if (this->enablePartialCollect)
     {
         needWriteWatch = true;
@@ -878,6 +889,59 @@ Recycler::Initialize(const bool forceInThread, JsUtil::ThreadService *threadServ
 #endif
 }
 
+#if ENABLE_CONCURRENT_GC
+void
+Recycler::InitializeParallelMark()
+{
+    // Allocate one mark context (and page pool) per additional thread we may mark with, and the threads
+    // beyond the concurrent thread to run them. If we run out of memory, just mark with fewer threads.
+    Assert(this->parallelMarkContextCount == 0);
+
+    while (this->maxParallelism > 1 && this->parallelMarkContextCount < this->maxParallelism - 1)
+    {
+        uint index = this->parallelMarkContextCount;
+        PagePool * pagePool = HeapNewNoThrow(PagePool, this->recyclerFlagsTable);
+        MarkContext * context = pagePool != nullptr ? HeapNewNoThrow(MarkContext, this, pagePool) : nullptr;
+        RecyclerParallelThread * thread = nullptr;
+        if (context != nullptr && index != 0)
+        {
+            thread = HeapNewNoThrow(RecyclerParallelThread, this, &Recycler::ParallelWorkFunc, index - 1);
+        }
+
+        if (context == nullptr || (index != 0 && thread == nullptr))
+        {
+            if (context != nullptr)
+            {
+                HeapDelete(context);
+            }
+            if (pagePool != nullptr)
+            {
+                HeapDelete(pagePool);
+            }
+            this->maxParallelism = this->parallelMarkContextCount + 1;
+            break;
+        }
+
+#ifdef RECYCLER_MARK_TRACK
+        context->SetMarkMap(markMap);
+#endif
+#ifdef ENABLE_DEBUG_CONFIG_OPTIONS
+        context->SetMaxPageCount(GetRecyclerFlagsTable().MaxMarkStackPageCount);
+#endif
+
+        this->parallelMarkPagePools[index] = pagePool;
+        this->parallelMarkContexts[index] = context;
+        if (index != 0)
+        {
+            this->parallelThreads[index - 1] = thread;
+        }
+        this->parallelMarkContextCount++;
+    }
+
+    Assert(this->GetParallelThreadCount() <= _countof(this->parallelThreads));
+}
+#endif
+
 #if DBG
 BOOL
 Recycler::IsFreeObject(void * candidate)
@@ -2018,14 +2082,20 @@ Recycler::ProcessParallelMark(bool background, MarkContext * markContext)
 
     RECYCLER_PROFILE_EXEC_THREAD_BEGIN(background, this, Js::MarkPhase);
 
-    if (this->enableScanInteriorPointers)
-    {
-        this->ProcessMarkContext</* parallel */ true, /* interior */ true>(markContext);
-    }
-    else
+    // Once our own stack is empty, keep marking with work given up by the other contexts
+    // until all of them have run out.
+    do
     {
-        this->ProcessMarkContext</* parallel */ true, /* interior */ false>(markContext);
+        if (this->enableScanInteriorPointers)
+        {
+            this->ProcessMarkContext</* parallel */ true, /* interior */ true>(markContext);
+        }
+        else
+        {
+            this->ProcessMarkContext</* parallel */ true, /* interior */ false>(markContext);
+        }
     }
+    while (markContext->TakeMarkWork());
 
     RECYCLER_PROFILE_EXEC_THREAD_END(background, this, Js::MarkPhase);
 
@@ -2042,6 +2112,8 @@ Recycler::ProcessParallelMark(bool background, MarkContext * markContext)
 void
 Recycler::Mark()
 {
+    RECYCLER_GC_STATISTICS_PHASE_TIMER(this, markMicroseconds);
+
     // Marking in thread, we can just pre-mark them
     ResetMarks(this->enableScanImplicitRoots ? ResetMarkFlags_InThreadImplicitRoots : ResetMarkFlags_InThread);
     collectionState = CollectionStateFindRoots;
@@ -2118,9 +2190,11 @@ Recycler::ResetMarkCollectionState()
 
     // If we aborted after doing a background parallel Mark, we wouldn't have cleaned up the
     // parallel markContexts yet. Clean these up now.
-    // Note parallelMarkContext1 is not used in background parallel (see DoBackgroundParallelMark)
-    parallelMarkContext2.Cleanup();
-    parallelMarkContext3.Cleanup();
+    // Note parallelMarkContexts[0] is not used in background parallel (see DoBackgroundParallelMark)
+    for (uint i = 1; i < this->parallelMarkContextCount; i++)
+    {
+        parallelMarkContexts[i]->Cleanup();
+    }
 
     this->ClearNeedOOMRescan();
     DebugOnly(this->isProcessingRescan = false);
@@ -2239,6 +2313,8 @@ Recycler::RescanMark(DWORD waitTime)
 size_t
 Recycler::FinishMark(DWORD waitTime)
 {
+    RECYCLER_GC_STATISTICS_PHASE_TIMER(this, markMicroseconds);
+
     size_t scannedRootBytes = RescanMark(waitTime);
     Assert(waitTime != INFINITE || scannedRootBytes != Recycler::InvalidScanRootBytes);
     if (scannedRootBytes != Recycler::InvalidScanRootBytes)
@@ -2278,14 +2354,14 @@ void
 Recycler::DoParallelMark()
 {
     Assert(this->enableParallelMark);
-    Assert(this->maxParallelism > 1 && this->maxParallelism <= 4);
+    Assert(this->maxParallelism > 1 && this->maxParallelism <= Recycler::MaxParallelism);
+    Assert(this->parallelMarkContextCount == this->maxParallelism - 1);
 
     // Split the mark stack into [this->maxParallelism] equal pieces.
     // The actual # of splits is returned, in case the stack was too small to split that many ways.
-    MarkContext * splitContexts[3] = { &parallelMarkContext1, &parallelMarkContext2, &parallelMarkContext3 };
-    uint actualSplitCount = markContext.Split(this->maxParallelism - 1, splitContexts);
+    uint actualSplitCount = markContext.Split(this->parallelMarkContextCount, this->parallelMarkContexts);
 
-    Assert(actualSplitCount <= 3);
+    Assert(actualSplitCount <= this->parallelMarkContextCount);
 
     // If we failed to split at all, just mark in thread with no parallelism.
     if (actualSplitCount == 0)
@@ -2303,57 +2379,44 @@ Recycler::DoParallelMark()
         StartQueueTrackedObject();
     }
 
+    // The background thread marks markContext, this thread parallelMarkContexts[0], and the parallel
+    // threads the rest of the split. Set up the work pool between them before any of them starts.
+    this->StartParallelMarkWork(actualSplitCount + 1);
+
     // Kick off marking on the background thread
     bool concurrentSuccess = StartConcurrent(CollectionStateParallelMark);
 
     // If there's enough work to split, then kick off marking on parallel threads too.
     // If the threads haven't been created yet, this will create them (or fail).
-    bool parallelSuccess1 = false;
-    bool parallelSuccess2 = false;
-    if (concurrentSuccess && actualSplitCount >= 2)
+    bool parallelSuccess[MaxParallelism - 2];
+    uint parallelThreadCount = actualSplitCount - 1;
+    if (concurrentSuccess)
     {
-        parallelSuccess1 = parallelThread1.StartConcurrent();
-        if (parallelSuccess1 && actualSplitCount == 3)
-        {
-            parallelSuccess2 = parallelThread2.StartConcurrent();
-        }
+        this->StartParallelMarkThreads(parallelThreadCount, parallelSuccess);
+    }
+    else
+    {
+        // Nothing else is marking, so there is no one to share the work with.
+        this->StopParallelMarkWork();
     }
 
     // Process our portion of the split.
-    this->ProcessParallelMark(false, &parallelMarkContext1);
+    this->ProcessParallelMark(false, parallelMarkContexts[0]);
 
     // If we successfully launched parallel work, wait for it to complete.
     // If we failed, then process the work in-thread now.
     if (concurrentSuccess)
     {
         WaitForConcurrentThread(INFINITE);
+        this->WaitForParallelMarkThreads(parallelThreadCount, parallelSuccess);
+        this->StopParallelMarkWork();
     }
     else
     {
         this->ProcessParallelMark(false, &markContext);
-    }
-
-    if (actualSplitCount >= 2)
-    {
-        if (parallelSuccess1)
-        {
-            parallelThread1.WaitForConcurrent();
-        }
-        else
-        {
-            this->ProcessParallelMark(false, &parallelMarkContext2);
-        }
-
-        if (actualSplitCount == 3)
+        for (uint i = 1; i < actualSplitCount; i++)
         {
-            if (parallelSuccess2)
-            {
-                parallelThread2.WaitForConcurrent();
-            }
-            else
-            {
-                this->ProcessParallelMark(false, &parallelMarkContext3);
-            }
+            this->ProcessParallelMark(false, parallelMarkContexts[i]);
         }
     }
 
@@ -2382,19 +2445,18 @@ Recycler::DoBackgroundParallelMark()
 {
     // Split the mark stack into [this->maxParallelism - 1] equal pieces (thus, "- 2" below).
     // The actual # of splits is returned, in case the stack was too small to split that many ways.
-    // The parallel threads are hardwired to use parallelMarkContext2/3, so we split using those.
+    // parallelThreads[i] marks parallelMarkContexts[i + 1], so we split using those.
     uint actualSplitCount = 0;
-    MarkContext * splitContexts[2] = { &parallelMarkContext2, &parallelMarkContext3 };
     if (this->enableParallelMark)
     {
-        Assert(this->maxParallelism > 1 && this->maxParallelism <= 4);
+        Assert(this->maxParallelism > 1 && this->maxParallelism <= Recycler::MaxParallelism);
         if (this->maxParallelism > 2)
         {
-            actualSplitCount = markContext.Split(this->maxParallelism - 2, splitContexts);
+            actualSplitCount = markContext.Split(this->maxParallelism - 2, &this->parallelMarkContexts[1]);
         }
     }
 
-    Assert(actualSplitCount <= 2);
+    Assert(actualSplitCount <= this->GetParallelThreadCount());
 
     // If we failed to split at all, just mark in thread with no parallelism.
     if (actualSplitCount == 0)
@@ -2414,41 +2476,64 @@ Recycler::DoBackgroundParallelMark()
 
     // Kick off marking on parallel threads too, if there is work for them
     // If the threads haven't been created yet, this will create them (or fail).
-    bool parallelSuccess1 = false;
-    bool parallelSuccess2 = false;
-    parallelSuccess1 = parallelThread1.StartConcurrent();
-    if (parallelSuccess1 && actualSplitCount == 2)
-    {
-        parallelSuccess2 = parallelThread2.StartConcurrent();
-    }
+    bool parallelSuccess[MaxParallelism - 2];
+    this->StartParallelMarkWork(actualSplitCount + 1);
+    this->StartParallelMarkThreads(actualSplitCount, parallelSuccess);
 
     // Process our portion of the split.
     this->ProcessParallelMark(true, &markContext);
 
-    // If we successfully launched parallel work, wait for it to complete.
-    // If we failed, then process the work in-thread now.
-    if (parallelSuccess1)
-    {
-        parallelThread1.WaitForConcurrent();
-    }
-    else
-    {
-        this->ProcessParallelMark(true, &parallelMarkContext2);
-    }
+    // Wait for the parallel work to complete. The portions of threads that failed
+    // to start were given to the work pool and have been processed by now.
+    this->WaitForParallelMarkThreads(actualSplitCount, parallelSuccess);
+    this->StopParallelMarkWork();
+
+    this->collectionState = CollectionStateConcurrentMark;
+}
 
-    if (actualSplitCount == 2)
+void
+Recycler::StartParallelMarkWork(uint workerCount)
+{
+    this->parallelMarkWorkPool.Start(workerCount);
+    markContext.SetWorkPool(&this->parallelMarkWorkPool);
+    ForEachParallelMarkContext([&](MarkContext * context) { context->SetWorkPool(&this->parallelMarkWorkPool); });
+}
+
+void
+Recycler::StopParallelMarkWork()
+{
+    markContext.SetWorkPool(nullptr);
+    ForEachParallelMarkContext([](MarkContext * context) { context->SetWorkPool(nullptr); });
+    this->parallelMarkWorkPool.Stop();
+}
+
+void
+Recycler::StartParallelMarkThreads(uint threadCount, __out_ecount(threadCount) bool * threadStarted)
+{
+    Assert(threadCount <= this->GetParallelThreadCount());
+
+    for (uint i = 0; i < threadCount; i++)
     {
-        if (parallelSuccess2)
+        threadStarted[i] = parallelThreads[i]->StartConcurrent();
+        if (!threadStarted[i])
         {
-            parallelThread2.WaitForConcurrent();
+            // Let the contexts that are marking take this thread's portion instead.
+            parallelMarkContexts[i + 1]->GiveAllMarkWork();
+            this->parallelMarkWorkPool.RemoveWorker();
         }
-        else
+    }
+}
+
+void
+Recycler::WaitForParallelMarkThreads(uint threadCount, __in_ecount(threadCount) bool * threadStarted)
+{
+    for (uint i = 0; i < threadCount; i++)
+    {
+        if (threadStarted[i])
         {
-            this->ProcessParallelMark(true, &parallelMarkContext3);
+            parallelThreads[i]->WaitForConcurrent();
         }
     }
-
-    this->collectionState = CollectionStateConcurrentMark;
 }
 #endif
 
@@ -2554,10 +2639,16 @@ Recycler::EndMark()
 
     bool oomRescan = EndMarkCheckOOMRescan();
 
+    // Values only reachable from ephemeron tables must be marked before the callbacks decide what is dead
+    oomRescan |= EndMarkEphemeronTables();
+
     if (ProcessObjectBeforeCollectCallbacks())
     {
         // callbacks may trigger additional marking, need to check OOMRescan again
         oomRescan |= EndMarkCheckOOMRescan();
+
+        // and the objects they revived may be ephemeron keys
+        oomRescan |= EndMarkEphemeronTables();
     }
 
     // GC-CONSIDER: Consider keeping some page around
@@ -2566,21 +2657,127 @@ Recycler::EndMark()
     // Clean up mark contexts, which will release held free pages
     // Do this for all contexts before we decommit, to make sure all pages are freed
     markContext.Cleanup();
-    parallelMarkContext1.Cleanup();
-    parallelMarkContext2.Cleanup();
-    parallelMarkContext3.Cleanup();
+    ForEachParallelMarkContext([](MarkContext * context) { context->Cleanup(); });
 
     // Decommit all pages
     markContext.DecommitPages();
-    parallelMarkContext1.DecommitPages();
-    parallelMarkContext2.DecommitPages();
-    parallelMarkContext3.DecommitPages();
+    ForEachParallelMarkContext([](MarkContext * context) { context->DecommitPages(); });
 
     GCETW(GC_DECOMMIT_CONCURRENT_COLLECT_PAGE_ALLOCATOR_STOP, (this));
 
     return oomRescan;
 }
 
+bool
+Recycler::EndMarkEphemeronTables()
+{
+    bool oomRescan = false;
+    while (MarkEphemeronTables() && EndMarkCheckOOMRescan())
+    {
+        // The rescan may have marked more keys
+        oomRescan = true;
+    }
+    return oomRescan;
+}
+
+bool
+Recycler::MarkEphemeronTables()
+{
+    if (this->ephemeronTableList == nullptr)
+    {
+        return false;
+    }
+
+    // Marking a value may reach the key of another entry, or the owner of another table. Marking is
+    // finished after each value, so that an entry later in the same pass already sees the keys it reached,
+    // and the entries that can't be marked yet are kept in a worklist. Further passes only look at the
+    // worklist, and each of them marks at least one of its entries or is the last one.
+    struct PendingEntry
+    {
+        RecyclerEphemeronTable * table;
+        RecyclerEphemeronTable::Entry * entry;
+    };
+
+    bool markedAny = false;
+    bool markedInPass = false;
+    auto tryMarkEntry = [&](RecyclerEphemeronTable * table, RecyclerEphemeronTable::Entry * entry) -> bool
+    {
+        if (!this->IsObjectMarked(table->owner) || !this->IsObjectMarked(entry->key))
+        {
+            return false;
+        }
+
+        this->ScanMemory(&entry->value, sizeof(entry->value));
+        if (this->HasPendingMarkObjects())
+        {
+            this->ProcessMark(/*background*/false);
+            markedInPass = true;
+            markedAny = true;
+        }
+        return true;
+    };
+
+    size_t entryCount = 0;
+    for (RecyclerEphemeronTable * table = this->ephemeronTableList; table != nullptr; table = table->next)
+    {
+        entryCount += table->count;
+    }
+
+    // Without a worklist every pass has to go through all the tables again
+    PendingEntry * pendingEntries = entryCount != 0 ? HeapNewNoThrowArray(PendingEntry, entryCount) : nullptr;
+    size_t pendingCount = 0;
+    uint passCount = 0;
+    do
+    {
+        markedInPass = false;
+        for (RecyclerEphemeronTable * table = this->ephemeronTableList; table != nullptr; table = table->next)
+        {
+            for (uint i = 0; i < table->capacity; i++)
+            {
+                RecyclerEphemeronTable::Entry * entry = &table->entries[i];
+                if (RecyclerEphemeronTable::IsLiveKey(entry->key) && !tryMarkEntry(table, entry) && pendingEntries != nullptr)
+                {
+                    Assert(pendingCount < entryCount);
+                    pendingEntries[pendingCount].table = table;
+                    pendingEntries[pendingCount].entry = entry;
+                    pendingCount++;
+                }
+            }
+        }
+        passCount++;
+    }
+    while (pendingEntries == nullptr && markedInPass);
+
+    if (pendingEntries != nullptr)
+    {
+#if DBG
+        const size_t maxPassCount = pendingCount + 2;
+#endif
+        while (markedInPass && pendingCount != 0)
+        {
+            markedInPass = false;
+            size_t remainingCount = 0;
+            for (size_t i = 0; i < pendingCount; i++)
+            {
+                if (!tryMarkEntry(pendingEntries[i].table, pendingEntries[i].entry))
+                {
+                    pendingEntries[remainingCount++] = pendingEntries[i];
+                }
+            }
+            Assert(!markedInPass || remainingCount < pendingCount);
+            pendingCount = remainingCount;
+            passCount++;
+        }
+        Assert(passCount <= maxPassCount);
+        HeapDeleteArray(entryCount, pendingEntries);
+    }
+
+    RecyclerVerboseTrace(GetRecyclerFlagsTable(), _u("Ephemeron tables: %u entries, %u left in the worklist after %u passes\n"),
+        (uint)entryCount, (uint)pendingCount, passCount);
+
+    return markedAny;
+}
+
 void
 Recycler::EndMarkOnLowMemory()
 {
@@ -2661,9 +2858,7 @@ Recycler::EndMarkOnLowMemory()
     while (this->NeedOOMRescan());
 
     Assert(!markContext.GetPageAllocator()->DisableAllocationOutOfMemory());
-    Assert(!parallelMarkContext1.GetPageAllocator()->DisableAllocationOutOfMemory());
-    Assert(!parallelMarkContext2.GetPageAllocator()->DisableAllocationOutOfMemory());
-    Assert(!parallelMarkContext3.GetPageAllocator()->DisableAllocationOutOfMemory());
+    ForEachParallelMarkContext([](MarkContext * context) { Assert(!context->GetPageAllocator()->DisableAllocationOutOfMemory()); });
     CUSTOM_PHASE_PRINT_TRACE1(GetRecyclerFlagsTable(), Js::RecyclerPhase, _u("EndMarkOnLowMemory iterations: %d\n"), iterations);
 
 #if ENABLE_PARTIAL_GC
@@ -2688,7 +2883,9 @@ Recycler::EndMarkOnLowMemory()
 bool
 Recycler::IsMarkStackEmpty()
 {
-    return (markContext.IsEmpty() && parallelMarkContext1.IsEmpty() && parallelMarkContext2.IsEmpty() && parallelMarkContext3.IsEmpty());
+    bool isEmpty = markContext.IsEmpty();
+    ForEachParallelMarkContext([&](MarkContext * context) { isEmpty = isEmpty && context->IsEmpty(); });
+    return isEmpty;
 }
 #endif
 
@@ -2779,6 +2976,7 @@ Recycler::Sweep(bool concurrent)
 #if ENABLE_PARTIAL_GC && ENABLE_CONCURRENT_GC
     Assert(!this->hasBackgroundFinishPartial);
 #endif
+    RECYCLER_GC_STATISTICS_PHASE_TIMER(this, sweepMicroseconds);
 
 #if ENABLE_CONCURRENT_GC
     if (!this->enableConcurrentSweep)
@@ -2905,6 +3103,40 @@ Recycler::SweepWeakReference()
     RECYCLER_PROFILE_EXEC_END(this, Js::SweepWeakPhase);
 }
 
+void
+Recycler::SweepEphemeronTables()
+{
+    RecyclerEphemeronTable ** link = &this->ephemeronTableList;
+    while (*link != nullptr)
+    {
+        RecyclerEphemeronTable * table = *link;
+        if (!this->IsObjectMarked(table->owner))
+        {
+            // The table goes away with its owner
+            *link = table->next;
+            continue;
+        }
+
+        for (uint i = 0; i < table->capacity; i++)
+        {
+            void * key = table->entries[i].key;
+            if (RecyclerEphemeronTable::IsLiveKey(key) && !this->IsObjectMarked(key))
+            {
+                table->RemoveAt(i);
+            }
+        }
+        link = &table->next;
+    }
+}
+
+void
+Recycler::RegisterEphemeronTable(RecyclerEphemeronTable * table)
+{
+    Assert(table->next == nullptr);
+    table->next = this->ephemeronTableList;
+    this->ephemeronTableList = table;
+}
+
 void
 Recycler::SweepHeap(bool concurrent, RecyclerSweep& recyclerSweep)
 {
@@ -2932,6 +3164,7 @@ Recycler::SweepHeap(bool concurrent, RecyclerSweep& recyclerSweep)
     }
 
     this->SweepWeakReference();
+    this->SweepEphemeronTables();
 
 #if ENABLE_CONCURRENT_GC
     if (concurrent)
@@ -3576,6 +3809,9 @@ Recycler::DoCollect(CollectionFlags flags)
 
 #if DBG
         collectionCount++;
+#endif
+#if ENABLE_RECYCLER_GC_STATISTICS
+        gcStatistics.BeginCollection();
 #endif
         collectionState = Collection_PreCollection;
         collectionWrapper->PreCollectionCallBack(flags);
@@ -3933,6 +4169,12 @@ Recycler::CollectionBegin()
         gcTel.LogGCPauseStartTime();
     }
 #endif
+#if ENABLE_RECYCLER_GC_STATISTICS
+    if (GetCurrentThreadContextId() == mainThreadId)
+    {
+        gcStatistics.BeginPause();
+    }
+#endif
 }
 
 template <Js::Phase phase>
@@ -3945,6 +4187,12 @@ Recycler::CollectionEnd()
     {
         gcTel.LogGCPauseEndTime();
     }
+#endif
+#if ENABLE_RECYCLER_GC_STATISTICS
+    if (GetCurrentThreadContextId() == mainThreadId)
+    {
+        gcStatistics.EndPause();
+    }
 #endif
     RECYCLER_PROFILE_EXEC_END2(this, phase, Js::RecyclerPhase);
 }
@@ -4066,9 +4314,7 @@ Recycler::ProcessTrackedObjects()
 
     // If we did a parallel mark, we need to process any queued tracked objects from the parallel mark stack as well.
     // If we didn't, this will do nothing.
-    parallelMarkContext1.ProcessTracked();
-    parallelMarkContext2.ProcessTracked();
-    parallelMarkContext3.ProcessTracked();
+    ForEachParallelMarkContext([](MarkContext * context) { context->ProcessTracked(); });
 
     DebugOnly(this->isProcessingTrackedObjects = false);
 
@@ -4552,8 +4798,10 @@ Recycler::FinalizeConcurrent(bool restoreState)
 
     // Shutdown parallel threads and return the handle for them so the caller can
     // close it.
-    parallelThread1.Shutdown();
-    parallelThread2.Shutdown();
+    for (uint i = 0; i < this->GetParallelThreadCount(); i++)
+    {
+        parallelThreads[i]->Shutdown();
+    }
 
 #ifdef IDLE_DECOMMIT_ENABLED
     if (concurrentIdleDecommitEvent != nullptr)
@@ -4622,32 +4870,18 @@ Recycler::EnableConcurrent(JsUtil::ThreadService *threadService, bool startAllTh
     else
     {
         bool startConcurrentThread = true;
-        bool startedParallelThread1 = false;
-        bool startedParallelThread2 = false;
+        uint startedParallelThreadCount = 0;
 
-        if (startAllThreads)
+        if (startAllThreads && this->enableParallelMark)
         {
-            if (this->enableParallelMark && this->maxParallelism > 2)
+            while (startedParallelThreadCount < this->GetParallelThreadCount())
             {
-                if (!parallelThread1.EnableConcurrent(true))
+                if (!parallelThreads[startedParallelThreadCount]->EnableConcurrent(true))
                 {
                     startConcurrentThread = false;
+                    break;
                 }
-                else
-                {
-                    startedParallelThread1 = true;
-                    if (this->maxParallelism > 3)
-                    {
-                        if (!parallelThread2.EnableConcurrent(true))
-                        {
-                            startConcurrentThread = false;
-                        }
-                        else
-                        {
-                            startedParallelThread2 = true;
-                        }
-                    }
-                }
+                startedParallelThreadCount++;
             }
         }
 
@@ -4670,13 +4904,9 @@ Recycler::EnableConcurrent(JsUtil::ThreadService *threadService, bool startAllTh
             }
         }
 
-        if (startedParallelThread1)
+        for (uint i = 0; i < startedParallelThreadCount; i++)
         {
-            parallelThread1.Shutdown();
-            if (startedParallelThread2)
-            {
-                parallelThread2.Shutdown();
-            }
+            parallelThreads[i]->Shutdown();
         }
     }
 
@@ -5322,6 +5552,12 @@ Recycler::FinishConcurrentCollect(CollectionFlags flags)
             gcTel.LogGCPauseStartTime();
         }
 #endif
+#if ENABLE_RECYCLER_GC_STATISTICS
+        if (GetCurrentThreadContextId() == mainThreadId)
+        {
+            gcStatistics.BeginPause();
+        }
+#endif
 
 #ifdef RECYCLER_TRACE
 #if ENABLE_PARTIAL_GC
@@ -5357,6 +5593,12 @@ Recycler::FinishConcurrentCollect(CollectionFlags flags)
             {
                gcTel.LogGCPauseEndTime();
             }
+#endif
+#if ENABLE_RECYCLER_GC_STATISTICS
+            if (GetCurrentThreadContextId() == mainThreadId)
+            {
+                gcStatistics.EndPause();
+            }
 #endif
             // we timeout trying to mark.
             return false;
@@ -5392,6 +5634,12 @@ Recycler::FinishConcurrentCollect(CollectionFlags flags)
         {
             gcTel.LogGCPauseStartTime();
         }
+#endif
+#if ENABLE_RECYCLER_GC_STATISTICS
+        if (GetCurrentThreadContextId() == mainThreadId)
+        {
+            gcStatistics.BeginPause();
+        }
 #endif
         GCETW(GC_FLUSHZEROPAGE_START, (this));
 
@@ -5431,6 +5679,12 @@ Recycler::FinishConcurrentCollect(CollectionFlags flags)
         {
             gcTel.LogGCPauseEndTime();
         }
+#endif
+#if ENABLE_RECYCLER_GC_STATISTICS
+        if (GetCurrentThreadContextId() == mainThreadId)
+        {
+            gcStatistics.EndPause();
+        }
 #endif
     }
 
@@ -5488,19 +5742,24 @@ unsigned int
 Recycler::StaticThreadProc(LPVOID lpParameter)
 {
     DWORD ret = (DWORD)-1;
-    __try
-    {
-        Recycler * recycler = (Recycler *)lpParameter;
+    Recycler * recycler = (Recycler *)lpParameter;
 
 #if DBG
-        recycler->concurrentThreadExited = false;
+    recycler->concurrentThreadExited = false;
 #endif
+
+#ifdef DISABLE_SEH
+    ret = recycler->ThreadProc();
+#else
+    __try
+    {
         ret = recycler->ThreadProc();
     }
     __except(Recycler::ExceptFilter(GetExceptionInformation()))
     {
         Assert(false);
     }
+#endif
 
     return ret;
 }
@@ -5542,6 +5801,12 @@ Recycler::DoBackgroundWork(bool forceForeground)
         {
             gcTel.LogGCPauseStartTime();
         }
+#endif
+#if ENABLE_RECYCLER_GC_STATISTICS
+        if (GetCurrentThreadContextId() == mainThreadId)
+        {
+            gcStatistics.BeginPause();
+        }
 #endif
         DebugOnly(this->markContext.GetPageAllocator()->SetConcurrentThreadId(::GetCurrentThreadId()));
         Assert(this->enableConcurrentMark);
@@ -5580,6 +5845,12 @@ Recycler::DoBackgroundWork(bool forceForeground)
         {
             gcTel.LogGCPauseEndTime();
         }
+#endif
+#if ENABLE_RECYCLER_GC_STATISTICS
+        if (GetCurrentThreadContextId() == mainThreadId)
+        {
+            gcStatistics.EndPause();
+        }
 #endif
         RECYCLER_PROFILE_EXEC_BACKGROUND_END(this, this->collectionState == CollectionStateConcurrentFinishMark?
             Js::BackgroundFinishMarkPhase : Js::ConcurrentMarkPhase);
@@ -5596,6 +5867,12 @@ Recycler::DoBackgroundWork(bool forceForeground)
         {
             gcTel.LogGCPauseStartTime();
         }
+#endif
+#if ENABLE_RECYCLER_GC_STATISTICS
+        if (GetCurrentThreadContextId() == mainThreadId)
+        {
+            gcStatistics.BeginPause();
+        }
 #endif
         GCETW(GC_BACKGROUNDZEROPAGE_START, (this));
 
@@ -5637,6 +5914,12 @@ Recycler::DoBackgroundWork(bool forceForeground)
             gcTel.LogGCPauseEndTime();
         }
 #endif
+#if ENABLE_RECYCLER_GC_STATISTICS
+        if (GetCurrentThreadContextId() == mainThreadId)
+        {
+            gcStatistics.EndPause();
+        }
+#endif
 
         Assert(this->collectionState == CollectionStateConcurrentSweep);
         this->collectionState = CollectionStateTransferSweptWait;
@@ -5653,7 +5936,7 @@ Recycler::ThreadProc()
 {
     Assert(this->IsConcurrentEnabled());
 
-#if !defined(_UCRT)
+#if defined(_WIN32) && !defined(_UCRT)
     // We do this before we set the concurrentWorkDoneEvent because GetModuleHandleEx requires
     // getting the loader lock. We could have the following case:
     //    Thread A => Initialize Concurrent Thread (C)
@@ -5769,7 +6052,7 @@ Recycler::ThreadProc()
     while (true);
     SetEvent(this->concurrentWorkDoneEvent);
 
-#if !defined(_UCRT)
+#if defined(_WIN32) && !defined(_UCRT)
     if (dllHandle)
     {
         FreeLibraryAndExitThread(dllHandle, 0);
@@ -5873,6 +6156,10 @@ Recycler::FinishCollection()
     }
 #endif
 
+#if ENABLE_RECYCLER_GC_STATISTICS
+    gcStatistics.EndCollection();
+#endif
+
     RECORD_TIMESTAMP(currentCollectionEndTime);
 }
 
@@ -6114,13 +6401,12 @@ RecyclerParallelThread::EnableConcurrent(bool waitForThread)
 }
 
 
-template <uint parallelId>
 void
-Recycler::ParallelWorkFunc()
+Recycler::ParallelWorkFunc(uint parallelId)
 {
-    Assert(parallelId == 0 || parallelId == 1);
+    Assert(parallelId < this->GetParallelThreadCount());
 
-    MarkContext * markContext = (parallelId == 0 ? &this->parallelMarkContext2 : &this->parallelMarkContext3);
+    MarkContext * markContext = this->parallelMarkContexts[parallelId + 1];
 
     switch (this->collectionState)
     {
@@ -6194,74 +6480,82 @@ unsigned int
 RecyclerParallelThread::StaticThreadProc(LPVOID lpParameter)
 {
     DWORD ret = (DWORD)-1;
+    RecyclerParallelThread * parallelThread = (RecyclerParallelThread *)lpParameter;
+
+#ifdef DISABLE_SEH
+    ret = parallelThread->ThreadProc();
+#else
     __try
     {
-        RecyclerParallelThread * parallelThread = (RecyclerParallelThread *)lpParameter;
-        Recycler * recycler = parallelThread->recycler;
-        RecyclerParallelThread::WorkFunc workFunc = parallelThread->workFunc;
+        ret = parallelThread->ThreadProc();
+    }
+    __except(Recycler::ExceptFilter(GetExceptionInformation()))
+    {
+        Assert(false);
+    }
+#endif
 
-        Assert(recycler->IsConcurrentEnabled());
+    return ret;
+}
 
-#if !defined(_UCRT)
-        HMODULE dllHandle = NULL;
-        if (!GetModuleHandleEx(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS, (LPCTSTR)&RecyclerParallelThread::StaticThreadProc, &dllHandle))
-        {
-            dllHandle = NULL;
-        }
+unsigned int
+RecyclerParallelThread::ThreadProc()
+{
+    Assert(recycler->IsConcurrentEnabled());
+
+#if defined(_WIN32) && !defined(_UCRT)
+    HMODULE dllHandle = NULL;
+    if (!GetModuleHandleEx(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS, (LPCTSTR)&RecyclerParallelThread::StaticThreadProc, &dllHandle))
+    {
+        dllHandle = NULL;
+    }
 #endif
 #ifdef ENABLE_JS_ETW
-        // Create an ETW ActivityId for this thread, to help tools correlate ETW events we generate
-        GUID activityId = { 0 };
-        auto eventActivityIdControlResult = EventActivityIdControl(EVENT_ACTIVITY_CTRL_CREATE_SET_ID, &activityId);
-        Assert(eventActivityIdControlResult == ERROR_SUCCESS);
+    // Create an ETW ActivityId for this thread, to help tools correlate ETW events we generate
+    GUID activityId = { 0 };
+    auto eventActivityIdControlResult = EventActivityIdControl(EVENT_ACTIVITY_CTRL_CREATE_SET_ID, &activityId);
+    Assert(eventActivityIdControlResult == ERROR_SUCCESS);
 #endif
 
-        // If this thread is created on demand we already have work to process and do not need to wait
-        bool mustWait = parallelThread->synchronizeOnStartup;
+    // If this thread is created on demand we already have work to process and do not need to wait
+    bool mustWait = this->synchronizeOnStartup;
 
-        do
+    do
+    {
+        if (mustWait)
         {
-            if (mustWait)
-            {
-                // Signal completion and wait for next work
-                SetEvent(parallelThread->concurrentWorkDoneEvent);
-                DWORD result = WaitForSingleObject(parallelThread->concurrentWorkReadyEvent, INFINITE);
-                Assert(result == WAIT_OBJECT_0);
-            }
-
-            if (recycler->collectionState == CollectionStateExit)
-            {
-                // Exit thread
-                break;
-            }
-
-            // Invoke the workFunc to do real work
-            (recycler->*workFunc)();
-
-            // We always wait after the first time
-            mustWait = true;
+            // Signal completion and wait for next work
+            SetEvent(this->concurrentWorkDoneEvent);
+            DWORD result = WaitForSingleObject(this->concurrentWorkReadyEvent, INFINITE);
+            Assert(result == WAIT_OBJECT_0);
         }
-        while (true);
 
-        // Signal to main thread that we have stopped processing and will shut down.
-        // Note that after this point, we cannot access anything on the Recycler instance
-        // because the main thread may have torn it down already.
-        SetEvent(parallelThread->concurrentWorkDoneEvent);
-
-#if !defined(_UCRT)
-        if (dllHandle)
+        if (recycler->collectionState == CollectionStateExit)
         {
-            FreeLibraryAndExitThread(dllHandle, 0);
+            // Exit thread
+            break;
         }
-#endif
-        ret = 0;
+
+        // Invoke the workFunc to do real work
+        (recycler->*workFunc)(this->parallelId);
+
+        // We always wait after the first time
+        mustWait = true;
     }
-    __except(Recycler::ExceptFilter(GetExceptionInformation()))
+    while (true);
+
+    // Signal to main thread that we have stopped processing and will shut down.
+    // Note that after this point, we cannot access anything on the Recycler instance
+    // because the main thread may have torn it down already.
+    SetEvent(this->concurrentWorkDoneEvent);
+
+#if defined(_WIN32) && !defined(_UCRT)
+    if (dllHandle)
     {
-        Assert(false);
+        FreeLibraryAndExitThread(dllHandle, 0);
     }
-
-    return ret;
+#endif
+    return 0;
 }
 
 
@@ -6273,7 +6567,7 @@ RecyclerParallelThread::StaticBackgroundWorkCallback(void * callbackData)
     Recycler * recycler = parallelThread->recycler;
     RecyclerParallelThread::WorkFunc workFunc = parallelThread->workFunc;
 
-    (recycler->*workFunc)();
+    (recycler->*workFunc)(parallelThread->parallelId);
 
     SetEvent(parallelThread->concurrentWorkDoneEvent);
 }
@@ -544,11 +544,12 @@ struct CollectionParam
 class RecyclerParallelThread
 {
 public:
-    typedef void (Recycler::* WorkFunc)();
+    typedef void (Recycler::* WorkFunc)(uint parallelId);
 
-    RecyclerParallelThread(Recycler * recycler, WorkFunc workFunc) :
+    RecyclerParallelThread(Recycler * recycler, WorkFunc workFunc, uint parallelId) :
         recycler(recycler),
         workFunc(workFunc),
+        parallelId(parallelId),
         concurrentWorkReadyEvent(NULL),
         concurrentWorkDoneEvent(NULL),
         concurrentThread(NULL)
@@ -570,12 +571,14 @@ public:
 private:
     // Static entry point for thread creation
     static unsigned int CALLBACK StaticThreadProc(LPVOID lpParameter);
+    unsigned int ThreadProc();
 
     // Static entry point for thread service usage
     static void CALLBACK StaticBackgroundWorkCallback(void * callbackData);
 
 private:
     WorkFunc workFunc;
+    uint parallelId;
     Recycler * recycler;
     HANDLE concurrentWorkReadyEvent;// main thread uses this event to tell concurrent threads that the work is ready
     HANDLE concurrentWorkDoneEvent;// concurrent threads use this event to tell main thread that the work allocated is done
@@ -733,6 +736,8 @@ private:
     WeakReferenceHashTable<PrimePolicy> weakReferenceMap;
     uint weakReferenceCleanupId;
 
+    RecyclerEphemeronTable * ephemeronTableList;
+
     void * transientPinnedObject;
 #ifdef STACK_BACK_TRACE
 #if defined(CHECK_MEMORY_LEAK) || defined(LEAK_REPORT)
@@ -788,20 +793,44 @@ private:
     MarkContext markContext;
 
     // Contexts for parallel marking.
-    // We support up to 4 way parallelism, main context + 3 additional parallel contexts.
-    MarkContext parallelMarkContext1;
-    MarkContext parallelMarkContext2;
-    MarkContext parallelMarkContext3;
+    // We support up to MaxParallelism way parallelism, main context + (MaxParallelism - 1) additional
+    // parallel contexts. Only as many as the machine can use are allocated (see InitializeParallelMark).
+    // parallelMarkContexts[0] is used by the main thread in DoParallelMark, parallelMarkContexts[i + 1]
+    // by parallelThreads[i].
+    static const uint MaxParallelism = PageStack<void *>::MaxSplitTargets + 1;
+
+    uint parallelMarkContextCount;
+    MarkContext * parallelMarkContexts[MaxParallelism - 1];
 
     // Page pools for above markContexts
     PagePool markPagePool;
-    PagePool parallelMarkPagePool1;
-    PagePool parallelMarkPagePool2;
-    PagePool parallelMarkPagePool3;
+    PagePool * parallelMarkPagePools[MaxParallelism - 1];
+
+    // Work given up by busy parallel mark contexts for the ones that ran out
+    MarkContext::WorkPool parallelMarkWorkPool;
+
+    template <typename Fn>
+    void ForEachParallelMarkContext(Fn fn) const
+    {
+        for (uint i = 0; i < this->parallelMarkContextCount; i++)
+        {
+            fn(this->parallelMarkContexts[i]);
+        }
+    }
 
     bool IsMarkStackEmpty();
-    bool HasPendingMarkObjects() const { return markContext.HasPendingMarkObjects() || parallelMarkContext1.HasPendingMarkObjects() || parallelMarkContext2.HasPendingMarkObjects() || parallelMarkContext3.HasPendingMarkObjects(); }
-    bool HasPendingTrackObjects() const { return markContext.HasPendingTrackObjects() || parallelMarkContext1.HasPendingTrackObjects() || parallelMarkContext2.HasPendingTrackObjects() || parallelMarkContext3.HasPendingTrackObjects(); }
+    bool HasPendingMarkObjects() const
+    {
+        bool hasPending = markContext.HasPendingMarkObjects();
+        ForEachParallelMarkContext([&](MarkContext * context) { hasPending = hasPending || context->HasPendingMarkObjects(); });
+        return hasPending;
+    }
+    bool HasPendingTrackObjects() const
+    {
+        bool hasPending = markContext.HasPendingTrackObjects();
+        ForEachParallelMarkContext([&](MarkContext * context) { hasPending = hasPending || context->HasPendingTrackObjects(); });
+        return hasPending;
+    }
 
     RecyclerCollectionWrapper * collectionWrapper;
 
@@ -925,11 +954,11 @@ private:
     HANDLE concurrentWorkDoneEvent; // concurrent threads use this event to tell main thread that the work allocated is done
     HANDLE concurrentThread;
 
-    template <uint parallelId>
-    void ParallelWorkFunc();
+    void ParallelWorkFunc(uint parallelId);
 
-    RecyclerParallelThread parallelThread1;
-    RecyclerParallelThread parallelThread2;
+    // Threads for parallel marking, in addition to the concurrent thread
+    RecyclerParallelThread * parallelThreads[MaxParallelism - 2];
+    uint GetParallelThreadCount() const { return this->parallelMarkContextCount > 1 ? this->parallelMarkContextCount - 1 : 0; }
 
 #if DBG
     // Variable indicating if the concurrent thread has exited or not
@@ -1014,6 +1043,9 @@ private:
 #endif
     RecyclerWatsonTelemetryBlock localTelemetryBlock;
     RecyclerWatsonTelemetryBlock * telemetryBlock;
+#if ENABLE_RECYCLER_GC_STATISTICS
+    RecyclerGCStatistics gcStatistics;
+#endif
 
 #ifdef RECYCLER_STATS
     RecyclerCollectionStats collectionStats;
@@ -1076,6 +1108,9 @@ public:
 
     char* Realloc(void* buffer, DECLSPEC_GUARD_OVERFLOW size_t existingBytes, DECLSPEC_GUARD_OVERFLOW size_t requestedBytes, bool truncate = true);
     void SetTelemetryBlock(RecyclerWatsonTelemetryBlock * telemetryBlock) { this->telemetryBlock = telemetryBlock; }
+#if ENABLE_RECYCLER_GC_STATISTICS
+    void GetGCStatisticsSnapshot(RecyclerGCStatisticsSnapshot * snapshot) { gcStatistics.GetSnapshot(snapshot); }
+#endif
 
     void Prime();
 
@@ -1096,9 +1131,7 @@ public:
     {
         this->needOOMRescan = false;
         markContext.GetPageAllocator()->ResetDisableAllocationOutOfMemory();
-        parallelMarkContext1.GetPageAllocator()->ResetDisableAllocationOutOfMemory();
-        parallelMarkContext2.GetPageAllocator()->ResetDisableAllocationOutOfMemory();
-        parallelMarkContext3.GetPageAllocator()->ResetDisableAllocationOutOfMemory();
+        ForEachParallelMarkContext([](MarkContext * context) { context->GetPageAllocator()->ResetDisableAllocationOutOfMemory(); });
     }
 
     BOOL RequestConcurrentWrapperCallback();
@@ -1350,6 +1383,8 @@ public:
     template<typename T>
     bool TryGetWeakReferenceHandle(T* pStrongReference, RecyclerWeakReference<T> **weakReference);
 
+    void RegisterEphemeronTable(RecyclerEphemeronTable * table);
+
     template <ObjectInfoBits attributes>
     char* GetAddressOfAllocator(size_t sizeCat)
     {
@@ -1594,9 +1629,16 @@ private:
     bool EndMark();
     bool EndMarkCheckOOMRescan();
     void EndMarkOnLowMemory();
+    bool MarkEphemeronTables();
+    bool EndMarkEphemeronTables();
 #if ENABLE_CONCURRENT_GC
+    void InitializeParallelMark();
     void DoParallelMark();
     void DoBackgroundParallelMark();
+    void StartParallelMarkWork(uint workerCount);
+    void StopParallelMarkWork();
+    void StartParallelMarkThreads(uint threadCount, __out_ecount(threadCount) bool * threadStarted);
+    void WaitForParallelMarkThreads(uint threadCount, __in_ecount(threadCount) bool * threadStarted);
 #endif
 
     size_t RootMark(CollectionState markState);
@@ -1639,6 +1681,7 @@ private:
     bool Sweep(bool concurrent = false);
 #endif
     void SweepWeakReference();
+    void SweepEphemeronTables();
     void SweepHeap(bool concurrent, RecyclerSweep& recyclerSweep);
     void FinishSweep(RecyclerSweep& recyclerSweep);
 
@@ -0,0 +1,160 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#include "CommonMemoryPch.h"
+
+RecyclerEphemeronTable::RecyclerEphemeronTable(Recycler * recycler, void * owner) :
+    recycler(recycler),
+    owner(owner),
+    entries(nullptr),
+    capacity(0),
+    count(0),
+    deletedCount(0),
+    next(nullptr)
+{
+    Assert(recycler->IsValidObject(owner));
+    recycler->RegisterEphemeronTable(this);
+}
+
+int
+RecyclerEphemeronTable::FindIndex(void * key) const
+{
+    Assert(IsLiveKey(key));
+
+    if (capacity == 0)
+    {
+        return -1;
+    }
+
+    // Linear probing; the table is never full, so this always reaches an unused entry
+    for (uint i = GetBucket(key); ; i = (i + 1) & (capacity - 1))
+    {
+        void * entryKey = entries[i].key;
+        if (entryKey == key)
+        {
+            return (int)i;
+        }
+        if (entryKey == nullptr)
+        {
+            return -1;
+        }
+    }
+}
+
+bool
+RecyclerEphemeronTable::TryGetValue(void * key, void ** value) const
+{
+    int index = FindIndex(key);
+    if (index == -1)
+    {
+        return false;
+    }
+
+    *value = entries[index].value;
+    return true;
+}
+
+void
+RecyclerEphemeronTable::Set(void * key, void * value)
+{
+    int index = FindIndex(key);
+    if (index != -1)
+    {
+        entries[index].value = value;
+        return;
+    }
+
+    // Keep at least a quarter of the entries unused so that probes stay short
+    if ((count + deletedCount + 1) * 4 > capacity * 3)
+    {
+        uint newCapacity = MinCapacity;
+        while ((count + 1) * 2 > newCapacity)
+        {
+            newCapacity *= 2;
+        }
+        Resize(newCapacity);
+    }
+
+    uint i = GetBucket(key);
+    while (IsLiveKey(entries[i].key))
+    {
+        i = (i + 1) & (capacity - 1);
+    }
+
+    if (entries[i].key == DeletedKey())
+    {
+        deletedCount--;
+    }
+    entries[i].key = key;
+    entries[i].value = value;
+    count++;
+}
+
+bool
+RecyclerEphemeronTable::Remove(void * key)
+{
+    int index = FindIndex(key);
+    if (index == -1)
+    {
+        return false;
+    }
+
+    RemoveAt(index);
+    return true;
+}
+
+void
+RecyclerEphemeronTable::RemoveAt(uint index)
+{
+    Assert(IsLiveKey(entries[index].key));
+
+    // The entry can't be made unused as later entries in the same probe sequence would no longer be found
+    entries[index].key = DeletedKey();
+    entries[index].value = nullptr;
+    count--;
+    deletedCount++;
+}
+
+void
+RecyclerEphemeronTable::Clear()
+{
+    entries = nullptr;
+    capacity = 0;
+    count = 0;
+    deletedCount = 0;
+}
+
+void
+RecyclerEphemeronTable::Resize(uint newCapacity)
+{
+    Assert(::Math::IsPow2(newCapacity) && newCapacity >= MinCapacity);
+
+    // The allocation may collect, removing entries with dead keys from the current entries, so only look at
+    // them afterwards. The count can only go down, so the new capacity is still enough.
+    Entry * newEntries = RecyclerNewArrayLeafZ(recycler, Entry, newCapacity);
+    Assert((count + 1) * 2 <= newCapacity);
+
+    Entry * oldEntries = entries;
+    uint oldCapacity = capacity;
+
+    entries = newEntries;
+    capacity = newCapacity;
+    deletedCount = 0;
+
+    for (uint i = 0; i < oldCapacity; i++)
+    {
+        void * key = oldEntries[i].key;
+        if (!IsLiveKey(key))
+        {
+            continue;
+        }
+
+        uint j = GetBucket(key);
+        while (entries[j].key != nullptr)
+        {
+            j = (j + 1) & (capacity - 1);
+        }
+        entries[j] = oldEntries[i];
+    }
+}
@@ -0,0 +1,86 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+namespace Memory
+{
+class Recycler;
+
+///
+/// This class is a hash table from recycler objects to arbitrary values that the recycler
+/// treats as a set of ephemerons: an entry keeps its value alive only for as long as its key
+/// and the object owning the table are alive through other references.
+///
+/// The table is embedded in its owner, which must be a recycler object. The entries are kept
+/// in leaf memory so that marking the owner doesn't mark them. Instead, once everything else
+/// has been marked, the recycler marks the values of the entries whose keys were marked,
+/// repeating until no new key is reached (see Recycler::MarkEphemeronTables), and before
+/// sweeping it removes the entries whose keys were not marked. Keys are hashed by address,
+/// which is stable since the recycler doesn't move objects, and is never reused while an
+/// entry still refers to it since dead keys are removed before their memory is swept.
+///
+/// Tables are registered with the recycler when constructed and dropped by the recycler
+/// when their owner is collected, so the owner doesn't need to be finalizable.
+///
+class RecyclerEphemeronTable
+{
+    friend class Recycler;
+
+public:
+    // Leaves the table uninitialized, for owners that are only constructed to get their vtable
+    RecyclerEphemeronTable() { }
+    RecyclerEphemeronTable(Recycler * recycler, void * owner);
+
+    uint Count() const { return count; }
+
+    bool TryGetValue(void * key, void ** value) const;
+    bool Contains(void * key) const { return FindIndex(key) != -1; }
+    void Set(void * key, void * value);
+    bool Remove(void * key);
+    void Clear();
+
+    template <typename Fn>
+    void Map(Fn fn) const
+    {
+        for (uint i = 0; i < capacity; i++)
+        {
+            if (IsLiveKey(entries[i].key))
+            {
+                fn(entries[i].key, entries[i].value);
+            }
+        }
+    }
+
+private:
+    struct Entry
+    {
+        void * key;         // nullptr if the entry was never used, DeletedKey if it was removed
+        void * value;
+    };
+
+    static const uint MinCapacity = 8;
+
+    static void * DeletedKey() { return (void *)1; }
+    static bool IsLiveKey(void * key) { return key != nullptr && key != DeletedKey(); }
+
+    uint GetBucket(void * key) const
+    {
+        Assert(capacity != 0 && ::Math::IsPow2(capacity));
+        return (uint)(((size_t)key) >> HeapConstants::ObjectAllocationShift) & (capacity - 1);
+    }
+
+    int FindIndex(void * key) const;
+    void Resize(uint newCapacity);
+    void RemoveAt(uint index);
+
+    Recycler * recycler;
+    void * owner;
+    Entry * entries;
+    uint capacity;          // 0 or a power of 2
+    uint count;             // live entries
+    uint deletedCount;      // removed entries still taking up a slot
+    RecyclerEphemeronTable * next;  // next table registered with the recycler
+};
+}
@@ -0,0 +1,221 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+#if ENABLE_RECYCLER_GC_STATISTICS
+namespace Memory
+{
+    /*
+    * Per-collection GC statistics
+    *
+    * Unlike RECYCLER_STATS these are always collected (including release builds on all platforms)
+    * so that hosts can monitor GC behavior through JsGetRuntimeGcStatistics. Only cheap counters
+    * are kept: times are taken at phase boundaries and heap blocks are accounted for once per sweep.
+    *
+    * Sweep statistics are keyed by allocation size bucket: one bucket per small object size,
+    * one per medium object size and a final bucket shared by all large objects.
+    */
+    struct RecyclerGCBucketStatistics
+    {
+        size_t freedBytes;
+        size_t liveBytes;
+        size_t capacityBytes;
+        uint heapBlockCount;
+    };
+
+    struct RecyclerGCCollectionStatistics
+    {
+        static const uint SmallBucketCount = HeapConstants::BucketCount;
+#ifdef BUCKETIZE_MEDIUM_ALLOCATIONS
+        static const uint MediumBucketCount = HeapConstants::MediumBucketCount;
+#else
+        static const uint MediumBucketCount = 0;
+#endif
+        static const uint LargeBucketIndex = SmallBucketCount + MediumBucketCount;
+        static const uint BucketCount = LargeBucketIndex + 1;
+
+        uint64 pauseMicroseconds;
+        uint64 maxPauseMicroseconds;
+        uint64 markMicroseconds;
+        uint64 sweepMicroseconds;
+        RecyclerGCBucketStatistics buckets[BucketCount];
+
+        static uint GetBucketIndex(size_t objectSize)
+        {
+            Assert(objectSize != 0);
+            if (objectSize <= HeapConstants::MaxSmallObjectSize)
+            {
+                return (uint)(objectSize >> HeapConstants::ObjectAllocationShift) - 1;
+            }
+#ifdef BUCKETIZE_MEDIUM_ALLOCATIONS
+            if (objectSize <= HeapConstants::MaxMediumObjectSize)
+            {
+                return SmallBucketCount + (uint)((objectSize - HeapConstants::MaxSmallObjectSize - 1) / HeapConstants::MediumObjectGranularity);
+            }
+#endif
+            return LargeBucketIndex;
+        }
+
+        // Upper bound of the object sizes accounted for in a bucket (0 for the large object bucket)
+        static size_t GetBucketObjectSize(uint bucketIndex)
+        {
+            Assert(bucketIndex < BucketCount);
+            if (bucketIndex < SmallBucketCount)
+            {
+                return (size_t)(bucketIndex + 1) << HeapConstants::ObjectAllocationShift;
+            }
+            if (bucketIndex < LargeBucketIndex)
+            {
+                return HeapConstants::MaxSmallObjectSize + (size_t)(bucketIndex - SmallBucketCount + 1) * HeapConstants::MediumObjectGranularity;
+            }
+            return 0;
+        }
+    };
+
+    // The statistics published at the end of a collection, copied out together
+    struct RecyclerGCStatisticsSnapshot
+    {
+        uint64 collectionCount;
+        uint64 totalPauseMicroseconds;
+        uint64 maxPauseMicroseconds;
+        RecyclerGCCollectionStatistics lastCollection;
+    };
+
+    /*
+    * The statistics of the collection in progress are only touched by the recycler (the sweep of a heap
+    * block may be recorded on the concurrent thread). They are published at the end of the collection,
+    * on the main thread, under a lock so that hosts can take a consistent snapshot from any thread.
+    */
+    class RecyclerGCStatistics
+    {
+    public:
+        RecyclerGCStatistics() :
+            collectionCount(0),
+            totalPauseMicroseconds(0),
+            maxPauseMicroseconds(0),
+            pauseStart(0),
+            inCollection(false)
+        {
+            LARGE_INTEGER frequency;
+            ticksPerSecond = QueryPerformanceFrequency(&frequency) ? frequency.QuadPart : 0;
+            memset(&current, 0, sizeof(current));
+            memset(&last, 0, sizeof(last));
+        }
+
+        void BeginCollection()
+        {
+            if (inCollection)
+            {
+                // Nested DoCollect (e.g. a concurrent collection finished by an exhaustive one)
+                // is accounted for as part of the outer collection
+                return;
+            }
+            inCollection = true;
+            memset(&current, 0, sizeof(current));
+        }
+
+        void EndCollection()
+        {
+            if (!inCollection)
+            {
+                return;
+            }
+            inCollection = false;
+
+            AutoCriticalSection autoCS(&publishCriticalSection);
+            collectionCount++;
+            totalPauseMicroseconds += current.pauseMicroseconds;
+            maxPauseMicroseconds = max(maxPauseMicroseconds, current.maxPauseMicroseconds);
+            last = current;
+        }
+
+        void BeginPause()
+        {
+            pauseStart = GetTicks();
+        }
+
+        void EndPause()
+        {
+            if (pauseStart == 0)
+            {
+                return;
+            }
+            uint64 pause = ToMicroseconds(GetTicks() - pauseStart);
+            pauseStart = 0;
+            current.pauseMicroseconds += pause;
+            current.maxPauseMicroseconds = max(current.maxPauseMicroseconds, pause);
+        }
+
+        void RecordSweptBlock(size_t objectSize, size_t freedBytes, size_t liveBytes, size_t capacityBytes)
+        {
+            RecyclerGCBucketStatistics& bucket = current.buckets[RecyclerGCCollectionStatistics::GetBucketIndex(objectSize)];
+            bucket.heapBlockCount++;
+            bucket.freedBytes += freedBytes;
+            bucket.liveBytes += liveBytes;
+            bucket.capacityBytes += capacityBytes;
+        }
+
+        // Can be called from any thread
+        void GetSnapshot(RecyclerGCStatisticsSnapshot * snapshot)
+        {
+            AutoCriticalSection autoCS(&publishCriticalSection);
+            snapshot->collectionCount = collectionCount;
+            snapshot->totalPauseMicroseconds = totalPauseMicroseconds;
+            snapshot->maxPauseMicroseconds = maxPauseMicroseconds;
+            snapshot->lastCollection = last;
+        }
+
+        class AutoPhaseTimer
+        {
+        public:
+            AutoPhaseTimer(RecyclerGCStatistics * statistics, uint64 RecyclerGCCollectionStatistics::* field) :
+                statistics(statistics), field(field), start(statistics->GetTicks())
+            {
+            }
+            ~AutoPhaseTimer()
+            {
+                statistics->current.*field += statistics->ToMicroseconds(statistics->GetTicks() - start);
+            }
+        private:
+            RecyclerGCStatistics * statistics;
+            uint64 RecyclerGCCollectionStatistics::* field;
+            int64 start;
+        };
+
+    private:
+        int64 GetTicks() const
+        {
+            LARGE_INTEGER counter;
+            return QueryPerformanceCounter(&counter) ? counter.QuadPart : 0;
+        }
+
+        uint64 ToMicroseconds(int64 ticks) const
+        {
+            if (ticks <= 0 || ticksPerSecond == 0)
+            {
+                return 0;
+            }
+            return (uint64)((double)ticks * 1000000.0 / (double)ticksPerSecond);
+        }
+
+        RecyclerGCCollectionStatistics current;
+
+        // Published statistics, guarded by publishCriticalSection
+        CriticalSection publishCriticalSection;
+        RecyclerGCCollectionStatistics last;
+        uint64 collectionCount;
+        uint64 totalPauseMicroseconds;
+        uint64 maxPauseMicroseconds;
+        int64 ticksPerSecond;
+        int64 pauseStart;
+        bool inCollection;
+    };
+
+#define RECYCLER_GC_STATISTICS_PHASE_TIMER(recycler, Field) \
+    Memory::RecyclerGCStatistics::AutoPhaseTimer gcStatisticsTimer_##Field(&(recycler)->gcStatistics, &Memory::RecyclerGCCollectionStatistics::Field);
+};
+#else
+#define RECYCLER_GC_STATISTICS_PHASE_TIMER(recycler, Field)
+#endif
@@ -153,6 +153,25 @@ RecyclerHeuristic::PriorityBoostTimeout(Js::ConfigFlagsTable& flags)
 #endif
     return TickCountConcurrentPriorityBoost;
 }
+
+uint
+RecyclerHeuristic::MaxParallelMarkCount(uint numProcs, Js::ConfigFlagsTable& flags)
+{
+#ifdef ENABLE_DEBUG_CONFIG_OPTIONS
+    if (flags.IsEnabled(Js::MaxParallelMarkCountFlag) && flags.MaxParallelMarkCount > 0)
+    {
+        return flags.MaxParallelMarkCount;
+    }
+#endif
+    if (CUSTOM_PHASE_FORCE1(flags, Js::ParallelMarkPhase) && numProcs < DefaultForcedParallelMarkCount)
+    {
+        // Exercise parallel mark even on machines with few processors
+        return DefaultForcedParallelMarkCount;
+    }
+
+    // One mark context per processor
+    return numProcs;
+}
 #endif
 
 #if ENABLE_PARTIAL_GC && ENABLE_CONCURRENT_GC
@@ -42,6 +42,7 @@ public:
     static size_t MinBackgroundRepeatMarkRescanBytes(Js::ConfigFlagsTable&);
     static DWORD FinishConcurrentCollectWaitTime(Js::ConfigFlagsTable&);
     static DWORD PriorityBoostTimeout(Js::ConfigFlagsTable&);
+    static uint MaxParallelMarkCount(uint numProcs, Js::ConfigFlagsTable&);
 #endif
 #if ENABLE_PARTIAL_GC && ENABLE_CONCURRENT_GC
     static bool PartialConcurrentNextCollection(double ratio, Js::ConfigFlagsTable& flags);
@@ -75,6 +76,7 @@ private:
     static const uint DefaultMaxBackgroundFinishMarkCount = 1;
     static const DWORD DefaultBackgroundFinishMarkWaitTime = 15; // ms
     static const size_t DefaultMinBackgroundRepeatMarkRescanBytes = 1 MEGABYTES;
+    static const uint DefaultForcedParallelMarkCount = 4;
 #endif
 };
 }
@@ -42,6 +42,29 @@ RecyclerPageAllocator::EnableWriteWatch()
     allocFlags = MEM_WRITE_WATCH;
 }
 
+bool
+RecyclerPageAllocator::IsWriteWatchSupported()
+{
+#ifdef _WIN32
+    return true;
+#else
+    // xplat-todo: the PAL only implements write watch on kernels with userfaultfd
+    // async write-protect; probe once and fall back to in-thread GC without it.
+    // The static is initialized once even when recyclers on several threads get here together.
+    static const bool supported = []() -> bool
+    {
+        void * address = ::VirtualAlloc(NULL, AutoSystemInfo::PageSize, MEM_RESERVE | MEM_WRITE_WATCH, PAGE_READWRITE);
+        if (address == NULL)
+        {
+            return false;
+        }
+        ::VirtualFree(address, 0, MEM_RELEASE);
+        return true;
+    }();
+    return supported;
+#endif
+}
+
 bool
 RecyclerPageAllocator::ResetWriteWatch()
 {
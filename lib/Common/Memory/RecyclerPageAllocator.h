@@ -17,6 +17,7 @@ public:
 #if ENABLE_CONCURRENT_GC
     void EnableWriteWatch();
     bool ResetWriteWatch();
+    static bool IsWriteWatchSupported();
 #endif
 
     static uint const DefaultPrimePageCount = 0x1000; // 16MB
@@ -254,6 +254,10 @@ typedef UINT32 DWORD;
         ///     was disabled.
         /// </summary>
         JsErrorScriptEvalDisabled,
+        /// <summary>
+        ///     A callback passed to the API returned false to stop the operation.
+        /// </summary>
+        JsErrorCallbackCanceled,
 
         /// <summary>
         ///     Category of errors that are fatal and signify failure of the engine.
@@ -654,6 +658,21 @@ typedef UINT32 DWORD;
     /// </returns>
     typedef bool (CHAKRA_CALLBACK * JsSerializedScriptLoadUtf8SourceCallback)(_In_ JsSourceContext sourceContext, _Outptr_result_z_ const char** scriptBuffer);
 
+    /// <summary>
+    ///     Called by <c>JsStringifyToUtf8Callback</c> with each chunk of the JSON text.
+    /// </summary>
+    /// <remarks>
+    ///     The chunk is only valid for the duration of the call. Multi-byte sequences are never
+    ///     split across chunks.
+    /// </remarks>
+    /// <param name="chunk">The next chunk of the JSON text, encoded as utf8 (not null terminated).</param>
+    /// <param name="length">The length of the chunk in bytes.</param>
+    /// <param name="callbackState">The state passed to <c>JsStringifyToUtf8Callback</c>.</param>
+    /// <returns>
+    ///     true to keep receiving chunks, false to stop the conversion.
+    /// </returns>
+    typedef bool (CHAKRA_CALLBACK * JsStringifyUtf8Callback)(_In_reads_(length) const char *chunk, _In_ size_t length, _In_opt_ void *callbackState);
+
     /// <summary>
     ///     A finalizer callback.
     /// </summary>
@@ -1277,6 +1296,74 @@ typedef UINT32 DWORD;
             _In_ size_t stringLength,
             _Out_ JsValueRef *value);
 
+    /// <summary>
+    ///     Parses a JSON text into a value, as <c>JSON.parse</c> would without a reviver.
+    /// </summary>
+    /// <remarks>
+    ///     <para>
+    ///     The JSON text is parsed directly from the UTF-8 buffer, without first converting it
+    ///     to a string value. The buffer does not need to be null terminated.
+    ///     </para>
+    ///     <para>
+    ///     If the text is not valid JSON, a <c>SyntaxError</c> is set as the runtime's exception
+    ///     and <c>JsErrorScriptException</c> is returned.
+    ///     </para>
+    ///     <para>
+    ///     Requires an active script context.
+    ///
+    ///     Experimental. We may update the name or behavior until it is stable.
+    ///     </para>
+    /// </remarks>
+    /// <param name="json">The JSON text, encoded as Utf8.</param>
+    /// <param name="length">The length of the JSON text in bytes.</param>
+    /// <param name="result">The parsed value.</param>
+    /// <returns>
+    ///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+    /// </returns>
+    CHAKRA_API
+        JsParseJsonUtf8(
+            _In_reads_(length) const char *json,
+            _In_ size_t length,
+            _Out_ JsValueRef *result);
+
+    /// <summary>
+    ///     Converts a value to JSON text, as <c>JSON.stringify</c> would without a replacer or space,
+    ///     and hands the text to a callback in utf8 chunks.
+    /// </summary>
+    /// <remarks>
+    ///     <para>
+    ///     The JSON text is never materialized as a string value: it is encoded to utf8 and passed
+    ///     to the callback in small chunks as it is produced, e.g. to write it straight to a socket.
+    ///     If the value has no JSON representation (such as undefined or a function) the callback
+    ///     is not called.
+    ///     </para>
+    ///     <para>
+    ///     Exceptions thrown while converting the value (e.g. by a <c>toJSON</c> method, or for a
+    ///     circular structure) are set as the runtime's exception and <c>JsErrorScriptException</c>
+    ///     is returned; some chunks may have been passed to the callback by then.
+    ///     </para>
+    ///     <para>
+    ///     If the callback returns false, the conversion stops right away, without calling any more
+    ///     <c>toJSON</c> methods or getters, and <c>JsErrorCallbackCanceled</c> is returned.
+    ///     </para>
+    ///     <para>
+    ///     Requires an active script context.
+    ///
+    ///     Experimental. We may update the name or behavior until it is stable.
+    ///     </para>
+    /// </remarks>
+    /// <param name="value">The value to convert to JSON text.</param>
+    /// <param name="callback">The callback receiving the utf8 chunks of the JSON text.</param>
+    /// <param name="callbackState">User provided state that will be passed back to the callback.</param>
+    /// <returns>
+    ///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+    /// </returns>
+    CHAKRA_API
+        JsStringifyToUtf8Callback(
+            _In_ JsValueRef value,
+            _In_ JsStringifyUtf8Callback callback,
+            _In_opt_ void *callbackState);
+
     /// <summary>
     ///     Retrieves the string pointer of a string value.
     /// </summary>
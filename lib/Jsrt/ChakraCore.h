@@ -163,4 +163,120 @@ JsGetModuleHostInfo(
     _In_ JsModuleHostInfoKind moduleHostInfo,
     _Outptr_result_maybenull_ void** hostInfo);
 
+/// <summary>
+///     Statistics for the objects of one allocation size bucket, accumulated over the heap blocks
+///     swept during a garbage collection.
+/// </summary>
+typedef struct JsGcBucketStatistics
+{
+    /// <summary>
+    ///     The largest object size, in bytes, accounted for in this bucket, or 0 for the bucket
+    ///     that holds all large objects.
+    /// </summary>
+    size_t objectSize;
+    /// <summary>
+    ///     The number of bytes freed by the collection.
+    /// </summary>
+    size_t freedBytes;
+    /// <summary>
+    ///     The number of bytes held by live objects after the collection.
+    /// </summary>
+    size_t liveBytes;
+    /// <summary>
+    ///     The object capacity, in bytes, of the swept heap blocks.
+    /// </summary>
+    size_t capacityBytes;
+    /// <summary>
+    ///     The number of heap blocks swept.
+    /// </summary>
+    unsigned int heapBlockCount;
+} JsGcBucketStatistics;
+
+/// <summary>
+///     Garbage collection statistics for a runtime.
+/// </summary>
+/// <remarks>
+///     Pause times only include the work done on the runtime's thread; work done by a background
+///     (concurrent) collection thread is reported as mark or sweep time only.
+/// </remarks>
+typedef struct JsGcStatistics
+{
+    /// <summary>
+    ///     The number of collections completed by the runtime.
+    /// </summary>
+    unsigned long long collectionCount;
+    /// <summary>
+    ///     The total time, in microseconds, the runtime's thread was paused by all collections.
+    /// </summary>
+    unsigned long long totalPauseMicroseconds;
+    /// <summary>
+    ///     The longest single pause, in microseconds, of all collections.
+    /// </summary>
+    unsigned long long maxPauseMicroseconds;
+    /// <summary>
+    ///     The total pause time, in microseconds, of the last collection.
+    /// </summary>
+    unsigned long long lastPauseMicroseconds;
+    /// <summary>
+    ///     The longest single pause, in microseconds, of the last collection.
+    /// </summary>
+    unsigned long long lastMaxPauseMicroseconds;
+    /// <summary>
+    ///     The time, in microseconds, the last collection spent marking on the runtime's thread.
+    /// </summary>
+    unsigned long long lastMarkMicroseconds;
+    /// <summary>
+    ///     The time, in microseconds, the last collection spent sweeping on the runtime's thread.
+    /// </summary>
+    unsigned long long lastSweepMicroseconds;
+    /// <summary>
+    ///     The number of bytes freed by the last collection.
+    /// </summary>
+    size_t lastFreedBytes;
+    /// <summary>
+    ///     The number of bytes held by live objects after the last collection.
+    /// </summary>
+    size_t lastLiveBytes;
+    /// <summary>
+    ///     The object capacity, in bytes, of the heap blocks swept by the last collection.
+    /// </summary>
+    size_t lastCapacityBytes;
+    /// <summary>
+    ///     The number of heap blocks swept by the last collection.
+    /// </summary>
+    unsigned int lastHeapBlockCount;
+} JsGcStatistics;
+
+/// <summary>
+///     Gets the garbage collection statistics for a runtime.
+/// </summary>
+/// <remarks>
+///     <para>
+///     Statistics are collected in all builds. They are published at the end of each collection and
+///     can be retrieved from any thread, regardless of whether or not the runtime is active on another
+///     thread; the values returned always come from one completed collection. If a collection is in
+///     progress the statistics of the previous collection are returned.
+///     </para>
+///     <para>
+///     The per-bucket statistics of the last collection are copied to <paramref name="buckets" />, up to
+///     <paramref name="bucketCount" /> entries. Call with <paramref name="buckets" /> set to <c>nullptr</c>
+///     to get the number of buckets in <paramref name="requiredBucketCount" />.
+///     </para>
+/// </remarks>
+/// <param name="runtime">The runtime whose statistics are to be retrieved.</param>
+/// <param name="statistics">The runtime's garbage collection statistics.</param>
+/// <param name="buckets">Optional buffer that receives the per-bucket statistics of the last collection.</param>
+/// <param name="bucketCount">The number of entries in <paramref name="buckets" />.</param>
+/// <param name="requiredBucketCount">Optional. The number of buckets the runtime keeps statistics for.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+JsGetRuntimeGcStatistics(
+    _In_ JsRuntimeHandle runtime,
+    _Out_ JsGcStatistics* statistics,
+    _Out_writes_opt_(bucketCount) JsGcBucketStatistics* buckets,
+    _In_ unsigned int bucketCount,
+    _Out_opt_ unsigned int* requiredBucketCount);
+
 #endif // _CHAKRACORE_H_
@@ -209,3 +209,67 @@ JsGetModuleHostInfo(
     });
     return errorCode;
 }
+
+CHAKRA_API
+JsGetRuntimeGcStatistics(
+    _In_ JsRuntimeHandle runtimeHandle,
+    _Out_ JsGcStatistics* statistics,
+    _Out_writes_opt_(bucketCount) JsGcBucketStatistics* buckets,
+    _In_ unsigned int bucketCount,
+    _Out_opt_ unsigned int* requiredBucketCount)
+{
+    VALIDATE_INCOMING_RUNTIME_HANDLE(runtimeHandle);
+    PARAM_NOT_NULL(statistics);
+    memset(statistics, 0, sizeof(JsGcStatistics));
+
+    const uint statisticsBucketCount = Memory::RecyclerGCCollectionStatistics::BucketCount;
+    if (requiredBucketCount != nullptr)
+    {
+        *requiredBucketCount = statisticsBucketCount;
+    }
+    if (buckets != nullptr)
+    {
+        memset(buckets, 0, sizeof(JsGcBucketStatistics) * bucketCount);
+        for (uint i = 0; i < min(bucketCount, statisticsBucketCount); i++)
+        {
+            buckets[i].objectSize = Memory::RecyclerGCCollectionStatistics::GetBucketObjectSize(i);
+        }
+    }
+
+    ThreadContext * threadContext = JsrtRuntime::FromHandle(runtimeHandle)->GetThreadContext();
+    Recycler * recycler = threadContext->GetRecycler();
+    if (recycler == nullptr)
+    {
+        return JsNoError;
+    }
+
+    Memory::RecyclerGCStatisticsSnapshot snapshot;
+    recycler->GetGCStatisticsSnapshot(&snapshot);
+    Memory::RecyclerGCCollectionStatistics const& lastCollection = snapshot.lastCollection;
+    statistics->collectionCount = snapshot.collectionCount;
+    statistics->totalPauseMicroseconds = snapshot.totalPauseMicroseconds;
+    statistics->maxPauseMicroseconds = snapshot.maxPauseMicroseconds;
+    statistics->lastPauseMicroseconds = lastCollection.pauseMicroseconds;
+    statistics->lastMaxPauseMicroseconds = lastCollection.maxPauseMicroseconds;
+    statistics->lastMarkMicroseconds = lastCollection.markMicroseconds;
+    statistics->lastSweepMicroseconds = lastCollection.sweepMicroseconds;
+
+    for (uint i = 0; i < statisticsBucketCount; i++)
+    {
+        Memory::RecyclerGCBucketStatistics const& bucket = lastCollection.buckets[i];
+        statistics->lastFreedBytes += bucket.freedBytes;
+        statistics->lastLiveBytes += bucket.liveBytes;
+        statistics->lastCapacityBytes += bucket.capacityBytes;
+        statistics->lastHeapBlockCount += bucket.heapBlockCount;
+
+        if (buckets != nullptr && i < bucketCount)
+        {
+            buckets[i].freedBytes = bucket.freedBytes;
+            buckets[i].liveBytes = bucket.liveBytes;
+            buckets[i].capacityBytes = bucket.capacityBytes;
+            buckets[i].heapBlockCount = bucket.heapBlockCount;
+        }
+    }
+
+    return JsNoError;
+}
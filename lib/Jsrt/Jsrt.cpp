@@ -13,6 +13,7 @@
 #include "Common/ByteSwap.h"
 #include "Library/DataView.h"
 #include "Library/JavascriptSymbol.h"
+#include "Library/JSON.h"
 #include "Base/ThreadContextTlsEntry.h"
 #include "Codex/Utf8Helper.h"
 
@@ -1074,6 +1075,133 @@ CHAKRA_API JsPointerToStringUtf8(_In_reads_(stringLength) const char *stringValu
     return JsPointerToString(wstr, wstr.Length(), string);
 }
 
+CHAKRA_API JsParseJsonUtf8(_In_reads_(length) const char *json, _In_ size_t length, _Out_ JsValueRef *result)
+{
+    return ContextAPIWrapper<true>([&](Js::ScriptContext *scriptContext) -> JsErrorCode {
+        PARAM_NOT_NULL(json);
+        PARAM_NOT_NULL(result);
+        *result = nullptr;
+
+        if (!Js::IsValidCharCount(length))
+        {
+            Js::JavascriptError::ThrowOutOfMemoryError(scriptContext);
+        }
+
+        // The scanner decodes the UTF-8 text as it goes, so no UTF-16 copy of the document is made
+        *result = JSON::ParseUtf8(reinterpret_cast<const utf8char_t*>(json), static_cast<uint>(length), scriptContext);
+
+        return JsNoError;
+    });
+}
+
+// Thrown by JsrtUtf8StringifyWriter when the host's callback returns false, to abandon the stringify
+class JsrtStringifyCanceledException
+{
+};
+
+// Encodes the output of a streaming stringify to utf8 and hands it to the host in chunks
+class JsrtUtf8StringifyWriter : public JSON::StringifyWriter
+{
+public:
+    JsrtUtf8StringifyWriter(JsStringifyUtf8Callback callback, void *callbackState) :
+        callback(callback), callbackState(callbackState), pendingHighSurrogate(0)
+    {
+    }
+
+    void Finish()
+    {
+        FlushBuffer();
+        if (pendingHighSurrogate != 0)
+        {
+            // Lone high surrogate at the very end
+            Write(&pendingHighSurrogate, 1);
+            pendingHighSurrogate = 0;
+        }
+    }
+
+protected:
+    virtual void Flush(const char16 *chars, charcount_t length) override
+    {
+        // A surrogate pair must be encoded as a single 4-byte sequence, so a high surrogate that ends
+        // a chunk is held back until its low surrogate shows up
+        if (pendingHighSurrogate != 0)
+        {
+            char16 pair[2] = { pendingHighSurrogate, 0 };
+            charcount_t pairLength = 1;
+            if (length > 0 && Js::NumberUtilities::IsSurrogateLowerPart(chars[0]))
+            {
+                pair[pairLength++] = chars[0];
+                chars++;
+                length--;
+            }
+            pendingHighSurrogate = 0;
+            Write(pair, pairLength);
+        }
+
+        while (length > 0)
+        {
+            charcount_t count = min(length, ChunkLength);
+            if (Js::NumberUtilities::IsSurrogateUpperPart(chars[count - 1]))
+            {
+                if (count == length)
+                {
+                    pendingHighSurrogate = chars[count - 1];
+                    length--;
+                }
+                count--;
+            }
+            if (count > 0)
+            {
+                Write(chars, count);
+            }
+            chars += count;
+            length -= count;
+        }
+    }
+
+private:
+    static const charcount_t ChunkLength = 256;
+
+    void Write(const char16 *chars, charcount_t length)
+    {
+        Assert(length <= ChunkLength);
+        size_t byteLength = utf8::EncodeTrueUtf8IntoAndNullTerminate(chunk, chars, length);
+        if (!callback(reinterpret_cast<const char *>(chunk), byteLength, callbackState))
+        {
+            // Stop right away, so that no more toJSON methods or getters run for output nobody wants
+            throw JsrtStringifyCanceledException();
+        }
+    }
+
+    JsStringifyUtf8Callback callback;
+    void *callbackState;
+    char16 pendingHighSurrogate;
+    utf8char_t chunk[ChunkLength * 3 + 1];
+};
+
+CHAKRA_API JsStringifyToUtf8Callback(_In_ JsValueRef value, _In_ JsStringifyUtf8Callback callback, _In_opt_ void *callbackState)
+{
+    return ContextAPIWrapper<true>([&](Js::ScriptContext *scriptContext) -> JsErrorCode {
+        VALIDATE_INCOMING_REFERENCE(value, scriptContext);
+        PARAM_NOT_NULL(callback);
+
+        JsrtUtf8StringifyWriter writer(callback, callbackState);
+        try
+        {
+            if (JSON::StringifyToWriter(value, &writer, scriptContext))
+            {
+                writer.Finish();
+            }
+        }
+        catch (JsrtStringifyCanceledException)
+        {
+            return JsErrorCallbackCanceled;
+        }
+
+        return JsNoError;
+    });
+}
+
 // TODO: The annotation of stringPtr is wrong.  Need to fix definition in chakrart.h
 // The warning is '*stringPtr' could be '0' : this does not adhere to the specification for the function 'JsStringToPointer'.
 #pragma warning(suppress:6387)
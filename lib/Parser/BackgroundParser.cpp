@@ -7,7 +7,7 @@
 #define ASSERT_THREAD() AssertMsg(mainThreadId == GetCurrentThreadContextId(), \
     "Cannot use this member of BackgroundParser from thread other than the creating context's current thread")
 
-#if ENABLE_NATIVE_CODEGEN
+#if ENABLE_BACKGROUND_PARSING
 BackgroundParser::BackgroundParser(Js::ScriptContext *scriptContext)
     :   JsUtil::WaitableJobManager(scriptContext->GetThreadContext()->GetJobProcessor()),
         scriptContext(scriptContext),
@@ -18,6 +18,9 @@ BackgroundParser::BackgroundParser(Js::ScriptContext *scriptContext)
 {
     Processor()->AddManager(this);
 
+    PHASE_PRINT_TESTTRACE1(Js::ParallelParsePhase, _u("ParallelParse: function bodies are parsed %s\n"),
+        Processor()->ProcessesInBackground() ? _u("on background threads") : _u("on the main thread"));
+
 #if DBG
     this->mainThreadId = GetCurrentThreadContextId();
 #endif
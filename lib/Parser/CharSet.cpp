@@ -1830,6 +1830,13 @@ namespace UnifiedRegex
         return leaf->vec.Get(CharSetNode::leafIdx(k));
     }
 
+    _Success_(return)
+    bool RuntimeCharSet<char16>::GetNextNonDirectRange(Char searchCharStart, _Out_ Char *outLowerChar, _Out_ Char *outHigherChar) const
+    {
+        Assert(CTU(searchCharStart) >= CharSetNode::directSize);
+        return root != 0 && root->GetNextRange(CharSetNode::levels - 1, searchCharStart, outLowerChar, outHigherChar);
+    }
+
 #if ENABLE_REGEX_CONFIG_OPTIONS
     // CAUTION: This method is very slow.
     void RuntimeCharSet<char16>::Print(DebugWriter* w) const
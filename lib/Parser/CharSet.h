@@ -738,6 +738,12 @@ namespace UnifiedRegex
                 return Get_helper(CTU(kc));
         }
 
+        // For generated code: the entries for the first 256 characters form a bit string (bit k is character k),
+        // and the characters past them, if there is a trie, are given as ranges
+        inline const CharBitvec* GetDirect() const { return &direct; }
+        inline bool HasNonDirect() const { return root != 0; }
+        _Success_(return) bool GetNextNonDirectRange(Char searchCharStart, _Out_ Char *outLowerChar, _Out_ Char *outHigherChar) const;
+
 #if ENABLE_REGEX_CONFIG_OPTIONS
         void Print(DebugWriter* w) const;
 #endif
@@ -14,6 +14,7 @@
 #include "RegexStats.h"
 #include "StandardChars.h"
 #include "OctoquadIdentifier.h"
+#include "RegexAutomaton.h"
 #include "RegexCompileTime.h"
 #include "RegexParser.h"
 #include "RegexPattern.h"
@@ -27,3 +28,6 @@
 
 #include "Library/JavascriptFunction.h"
 #include "Language/JavascriptStackWalker.h"
+
+// Needs ThreadContext
+#include "RegexNativeCode.h"
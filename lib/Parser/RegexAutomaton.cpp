@@ -0,0 +1,896 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#include "ParserPch.h"
+
+namespace UnifiedRegex
+{
+    // ----------------------------------------------------------------------
+    // Automaton
+    // ----------------------------------------------------------------------
+
+    Automaton::Automaton(AutomatonInst* insts, int numInsts, int start, int numSlots, bool isAnchored)
+        : insts(insts)
+        , numInsts(numInsts)
+        , start(start)
+        , numSlots(numSlots)
+        , isAnchored(isAnchored)
+    {
+    }
+
+    void Automaton::FreeBody(ArenaAllocator* rtAllocator)
+    {
+        for (int i = 0; i < numInsts; i++)
+        {
+            if (insts[i].tag == AutomatonInst::MatchSet)
+                insts[i].set.FreeBody(rtAllocator);
+        }
+    }
+
+#if ENABLE_REGEX_CONFIG_OPTIONS
+    void Automaton::Print(DebugWriter* w) const
+    {
+        w->PrintEOL(_u("automaton:    %d instructions, %d capture slots%s"), numInsts, numSlots, isAnchored ? _u(", anchored") : _u(""));
+    }
+#endif
+
+    // ----------------------------------------------------------------------
+    // AutomatonCompiler
+    // ----------------------------------------------------------------------
+
+    AutomatonCompiler::AutomatonCompiler(Js::ScriptContext* scriptContext, ArenaAllocator* ctAllocator, ArenaAllocator* rtAllocator, Program* program, AutomatonInst* insts, int numInsts)
+        : scriptContext(scriptContext)
+        , ctAllocator(ctAllocator)
+        , rtAllocator(rtAllocator)
+        , program(program)
+        , insts(insts)
+        , numInsts(numInsts)
+        , nextInst(0)
+    {
+    }
+
+    bool AutomatonCompiler::CountInsts(Js::ScriptContext* scriptContext, Node* node, uint64& count)
+    {
+        PROBE_STACK(scriptContext, Js::Constants::MinStackRegex);
+
+        switch (node->tag)
+        {
+        case Node::Empty:
+            break;
+
+        case Node::BOL:
+        case Node::EOL:
+        case Node::WordBoundary:
+        case Node::MatchChar:
+        case Node::MatchSet:
+            count++;
+            break;
+
+        case Node::MatchLiteral:
+            count += ((MatchLiteralNode*)node)->length;
+            break;
+
+        case Node::Concat:
+            for (ConcatNode* curr = (ConcatNode*)node; curr != 0; curr = curr->tail)
+            {
+                if (!CountInsts(scriptContext, curr->head, count))
+                    return false;
+            }
+            break;
+
+        case Node::Alt:
+            for (AltNode* curr = (AltNode*)node; curr != 0; curr = curr->tail)
+            {
+                if (!CountInsts(scriptContext, curr->head, count))
+                    return false;
+                // Split between this item and the rest
+                if (curr->tail != 0)
+                    count++;
+            }
+            break;
+
+        case Node::DefineGroup:
+            // Save the start and end offsets
+            count += 2;
+            if (!CountInsts(scriptContext, ((DefineGroupNode*)node)->body, count))
+                return false;
+            break;
+
+        case Node::Loop:
+            {
+                LoopNode* loop = (LoopNode*)node;
+                const bool definesGroups = (loop->body->features & Node::HasDefineGroup) != 0;
+                if (definesGroups && loop->body->thisConsumes.CouldMatchEmpty())
+                    return false;
+
+                // Each iteration is a copy of the body, preceded by a ResetGroups if it defines groups
+                uint64 iteration = definesGroups ? 1 : 0;
+                if (!CountInsts(scriptContext, loop->body, iteration))
+                    return false;
+
+                // Each optional iteration is guarded by a Split. An unbounded loop has one optional iteration jumping back to
+                // its Split.
+                const uint64 optional = loop->repeats.IsUnbounded() ? 1 : (uint64)(loop->repeats.upper - loop->repeats.lower);
+                count += iteration * loop->repeats.lower + (iteration + 1) * optional;
+                break;
+            }
+
+        default:
+            // Backreferences and lookaheads need backtracking
+            return false;
+        }
+
+        return count <= MaxInsts;
+    }
+
+    void AutomatonCompiler::GroupRange(Node* node, int& minGroupId, int& maxGroupId)
+    {
+        PROBE_STACK(scriptContext, Js::Constants::MinStackRegex);
+
+        switch (node->tag)
+        {
+        case Node::Concat:
+            for (ConcatNode* curr = (ConcatNode*)node; curr != 0; curr = curr->tail)
+                GroupRange(curr->head, minGroupId, maxGroupId);
+            break;
+
+        case Node::Alt:
+            for (AltNode* curr = (AltNode*)node; curr != 0; curr = curr->tail)
+                GroupRange(curr->head, minGroupId, maxGroupId);
+            break;
+
+        case Node::DefineGroup:
+            {
+                DefineGroupNode* group = (DefineGroupNode*)node;
+                minGroupId = min(minGroupId, group->groupId);
+                maxGroupId = max(maxGroupId, group->groupId);
+                GroupRange(group->body, minGroupId, maxGroupId);
+                break;
+            }
+
+        case Node::Loop:
+            GroupRange(((LoopNode*)node)->body, minGroupId, maxGroupId);
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    AutomatonInst* AutomatonCompiler::NewInst(AutomatonInst::InstTag tag, int next, int& label)
+    {
+        AssertOrFailFast(nextInst < numInsts);
+        label = nextInst++;
+        AutomatonInst* inst = &insts[label];
+        inst->tag = tag;
+        inst->next = next;
+        return inst;
+    }
+
+    int AutomatonCompiler::NewMatchChar(const Char* cs, bool isEquivClass, int next)
+    {
+        int label;
+        AutomatonInst* inst = NewInst(AutomatonInst::MatchChar, next, label);
+        for (int i = 0; i < CaseInsensitive::EquivClassSize; i++)
+            inst->cs[i] = isEquivClass ? cs[i] : cs[0];
+        return label;
+    }
+
+    int AutomatonCompiler::NewSplit(int preferred, int other)
+    {
+        int label;
+        NewInst(AutomatonInst::Split, preferred, label)->alt = other;
+        return label;
+    }
+
+    int AutomatonCompiler::BuildIteration(Node* body, bool resetsGroups, int fromGroupId, int toGroupId, int next)
+    {
+        const int entry = Build(body, next);
+        if (!resetsGroups)
+            return entry;
+
+        int label;
+        AutomatonInst* inst = NewInst(AutomatonInst::ResetGroups, entry, label);
+        inst->fromGroupId = fromGroupId;
+        inst->toGroupId = toGroupId;
+        return label;
+    }
+
+    int AutomatonCompiler::Build(Node* node, int next)
+    {
+        PROBE_STACK(scriptContext, Js::Constants::MinStackRegex);
+
+        // Instructions are built back to front: each node is given the label to continue at once it has matched.
+        int label;
+        switch (node->tag)
+        {
+        case Node::Empty:
+            return next;
+
+        case Node::BOL:
+            NewInst((program->flags & MultilineRegexFlag) != 0 ? AutomatonInst::BOLTest : AutomatonInst::BOITest, next, label);
+            return label;
+
+        case Node::EOL:
+            NewInst((program->flags & MultilineRegexFlag) != 0 ? AutomatonInst::EOLTest : AutomatonInst::EOITest, next, label);
+            return label;
+
+        case Node::WordBoundary:
+            NewInst(AutomatonInst::WordBoundaryTest, next, label)->isNegation = ((WordBoundaryNode*)node)->isNegation;
+            return label;
+
+        case Node::MatchChar:
+            {
+                MatchCharNode* matchChar = (MatchCharNode*)node;
+                return NewMatchChar(matchChar->cs, matchChar->isEquivClass, next);
+            }
+
+        case Node::MatchLiteral:
+            {
+                MatchLiteralNode* literal = (MatchLiteralNode*)node;
+                const CharCount width = literal->isEquivClass ? CaseInsensitive::EquivClassSize : 1;
+                const Char* litbuf = program->rep.insts.litbuf + literal->offset;
+                for (CharCount i = literal->length; i > 0; i--)
+                    next = NewMatchChar(litbuf + (i - 1) * width, literal->isEquivClass, next);
+                return next;
+            }
+
+        case Node::MatchSet:
+            {
+                MatchSetNode* matchSet = (MatchSetNode*)node;
+                AutomatonInst* inst = NewInst(AutomatonInst::MatchSet, next, label);
+                inst->isNegation = matchSet->isNegation;
+                inst->set.CloneFrom(rtAllocator, matchSet->set);
+                return label;
+            }
+
+        case Node::Concat:
+            {
+                // Concatenations may be long, so don't recurse down the tail
+                int numItems = 0;
+                for (ConcatNode* curr = (ConcatNode*)node; curr != 0; curr = curr->tail)
+                    numItems++;
+                Node** items = AnewArray(ctAllocator, Node*, numItems);
+                int i = 0;
+                for (ConcatNode* curr = (ConcatNode*)node; curr != 0; curr = curr->tail)
+                    items[i++] = curr->head;
+
+                for (i = numItems - 1; i >= 0; i--)
+                    next = Build(items[i], next);
+                AdeleteArray(ctAllocator, numItems, items);
+                return next;
+            }
+
+        case Node::Alt:
+            {
+                // All items continue at next, so only the choice points are needed: (a|b|c) => Split(a, Split(b, c))
+                int numItems = 0;
+                for (AltNode* curr = (AltNode*)node; curr != 0; curr = curr->tail)
+                    numItems++;
+                Node** items = AnewArray(ctAllocator, Node*, numItems);
+                int i = 0;
+                for (AltNode* curr = (AltNode*)node; curr != 0; curr = curr->tail)
+                    items[i++] = curr->head;
+
+                int entry = Build(items[numItems - 1], next);
+                for (i = numItems - 2; i >= 0; i--)
+                {
+                    const int item = Build(items[i], next);
+                    entry = NewSplit(item, entry);
+                }
+                AdeleteArray(ctAllocator, numItems, items);
+                return entry;
+            }
+
+        case Node::DefineGroup:
+            {
+                DefineGroupNode* group = (DefineGroupNode*)node;
+                NewInst(AutomatonInst::Save, next, label)->slot = group->groupId * 2 + 1;
+                const int body = Build(group->body, label);
+                NewInst(AutomatonInst::Save, body, label)->slot = group->groupId * 2;
+                return label;
+            }
+
+        case Node::Loop:
+            {
+                LoopNode* loop = (LoopNode*)node;
+
+                // The groups defined by the body are reset at the start of every iteration
+                const bool resetsGroups = (loop->body->features & Node::HasDefineGroup) != 0;
+                int fromGroupId = INT_MAX;
+                int toGroupId = -1;
+                if (resetsGroups)
+                    GroupRange(loop->body, fromGroupId, toGroupId);
+
+                int entry = next;
+                if (loop->repeats.IsUnbounded())
+                {
+                    // L: Split(body then L, next), preferring to leave the loop if not greedy
+                    AutomatonInst* split = NewInst(AutomatonInst::Split, next, label);
+                    const int body = BuildIteration(loop->body, resetsGroups, fromGroupId, toGroupId, label);
+                    split->next = loop->isGreedy ? body : next;
+                    split->alt = loop->isGreedy ? next : body;
+                    entry = label;
+                }
+                else
+                {
+                    // Optional iterations nest: e{0,2} => (e(e)?)?
+                    for (CharCount i = loop->repeats.lower; i < (CharCount)loop->repeats.upper; i++)
+                    {
+                        const int body = BuildIteration(loop->body, resetsGroups, fromGroupId, toGroupId, entry);
+                        entry = loop->isGreedy ? NewSplit(body, next) : NewSplit(next, body);
+                    }
+                }
+
+                for (CharCount i = 0; i < loop->repeats.lower; i++)
+                    entry = BuildIteration(loop->body, resetsGroups, fromGroupId, toGroupId, entry);
+                return entry;
+            }
+
+        default:
+            Assert(false);
+            return next;
+        }
+    }
+
+    Automaton* AutomatonCompiler::Compile
+        ( Js::ScriptContext* scriptContext
+        , ArenaAllocator* ctAllocator
+        , ArenaAllocator* rtAllocator
+        , Program* program
+        , Node* root
+        )
+    {
+        if (root->isDeterministic || (root->features & (Node::HasMatchGroup | Node::HasAssertion)) != 0)
+            return nullptr;
+
+        // Overall pattern is wrapped by Save(0), Save(1) and Succ
+        uint64 count = 3;
+        if (!CountInsts(scriptContext, root, count))
+            return nullptr;
+
+        const int numInsts = (int)count;
+        const int numSlots = program->numGroups * 2;
+        if ((uint64)numInsts * numSlots > MaxThreadSlots)
+            return nullptr;
+
+        Recycler* recycler = scriptContext->GetRecycler();
+        AutomatonInst* insts = RecyclerNewArrayLeafZ(recycler, AutomatonInst, numInsts);
+        AutomatonCompiler compiler(scriptContext, ctAllocator, rtAllocator, program, insts, numInsts);
+
+        int succ;
+        compiler.NewInst(AutomatonInst::Succ, -1, succ);
+        int end;
+        compiler.NewInst(AutomatonInst::Save, succ, end)->slot = 1;
+        const int body = compiler.Build(root, end);
+        int start;
+        compiler.NewInst(AutomatonInst::Save, body, start)->slot = 0;
+        Assert(compiler.nextInst == numInsts);
+
+        return RecyclerNew(recycler, Automaton, insts, numInsts, start, numSlots, (program->flags & StickyRegexFlag) != 0);
+    }
+
+    // ----------------------------------------------------------------------
+    // AutomatonMatcher
+    // ----------------------------------------------------------------------
+
+    AutomatonMatcher::AutomatonMatcher(Recycler* recycler, const StandardChars<Char>* standardChars, const Automaton* automaton)
+        : automaton(automaton)
+        , standardChars(standardChars)
+        , recycler(recycler)
+        , stamp(0)
+        , contextMask(NoContext)
+        , dfaGaveUp(false)
+        , dfaStates(nullptr)
+        , numDfaStates(0)
+        , maxDfaStates(0)
+        , dfaTransitions(nullptr)
+        , dfaPcs(nullptr)
+        , numDfaPcs(0)
+        , maxDfaPcs(0)
+        , dfaStateTable(nullptr)
+        , dfaStateTableSize(0)
+        , kernelMarks(nullptr)
+    {
+        const int numInsts = automaton->numInsts;
+        const int numSlots = automaton->numSlots;
+
+        visited = RecyclerNewArrayLeafZ(recycler, uint32, numInsts);
+        jobPcs = RecyclerNewArrayLeaf(recycler, int, numInsts + 1);
+        jobCaps = RecyclerNewArrayLeaf(recycler, CharCount, (numInsts + 1) * numSlots);
+        for (int i = 0; i < 2; i++)
+        {
+            threadPcs[i] = RecyclerNewArrayLeaf(recycler, int, numInsts);
+            threadCaps[i] = RecyclerNewArrayLeaf(recycler, CharCount, numInsts * numSlots);
+            numThreads[i] = 0;
+        }
+        initialCaps = RecyclerNewArrayLeaf(recycler, CharCount, numSlots);
+        for (int i = 0; i < numSlots; i++)
+            initialCaps[i] = CharCountFlag;
+        matchCaps = RecyclerNewArrayLeaf(recycler, CharCount, numSlots);
+
+        // States only need to distinguish the previous character as far as the pattern's assertions look at it
+        for (int i = 0; i < numInsts; i++)
+        {
+            switch (automaton->insts[i].tag)
+            {
+            case AutomatonInst::BOITest:
+                contextMask |= AtBOI;
+                break;
+            case AutomatonInst::BOLTest:
+                contextMask |= AtBOI | PrevIsNewline;
+                break;
+            case AutomatonInst::WordBoundaryTest:
+                contextMask |= PrevIsWord;
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    AutomatonMatcher* AutomatonMatcher::New(Recycler* recycler, const StandardChars<Char>* standardChars, const Automaton* automaton)
+    {
+        return RecyclerNew(recycler, AutomatonMatcher, recycler, standardChars, automaton);
+    }
+
+    inline uint8 AutomatonMatcher::CharContext(const Char c) const
+    {
+        uint8 context = NoContext;
+        if (standardChars->IsWord(c))
+            context |= PrevIsWord;
+        if (standardChars->IsNewline(c))
+            context |= PrevIsNewline;
+        return context & contextMask;
+    }
+
+    inline uint8 AutomatonMatcher::ContextAt(const Char* const input, const CharCount inputOffset) const
+    {
+        return inputOffset == 0 ? (AtBOI & contextMask) : CharContext(input[inputOffset - 1]);
+    }
+
+    inline bool AutomatonMatcher::Test(const AutomatonInst& inst, const uint8 context, const Char* const input, const CharCount inputLength, const CharCount inputOffset) const
+    {
+        switch (inst.tag)
+        {
+        case AutomatonInst::BOITest:
+            return (context & AtBOI) != 0;
+
+        case AutomatonInst::EOITest:
+            return inputOffset >= inputLength;
+
+        case AutomatonInst::BOLTest:
+            return (context & (AtBOI | PrevIsNewline)) != 0;
+
+        case AutomatonInst::EOLTest:
+            return inputOffset >= inputLength || standardChars->IsNewline(input[inputOffset]);
+
+        case AutomatonInst::WordBoundaryTest:
+            {
+                const bool prev = (context & PrevIsWord) != 0;
+                const bool curr = inputOffset < inputLength && standardChars->IsWord(input[inputOffset]);
+                return inst.isNegation != (prev != curr);
+            }
+
+        default:
+            Assert(false);
+            return false;
+        }
+    }
+
+    inline void AutomatonMatcher::NextStamp()
+    {
+        if (++stamp == 0)
+        {
+            memset(visited, 0, automaton->numInsts * sizeof(uint32));
+            stamp = 1;
+        }
+    }
+
+    void AutomatonMatcher::AddThread(const int list, const int label, const CharCount* caps, const Char* const input, const CharCount inputLength, const CharCount inputOffset)
+    {
+        // Follow the empty transitions from label depth first, in priority order. Each pending label has its own copy of the
+        // capture slots. Labels already reached at this input offset were reached with higher priority, so are skipped.
+        const int numSlots = automaton->numSlots;
+        const AutomatonInst* const insts = automaton->insts;
+        const uint8 context = ContextAt(input, inputOffset);
+
+        int top = 0;
+        jobPcs[top] = label;
+        js_memcpy_s(jobCaps, numSlots * sizeof(CharCount), caps, numSlots * sizeof(CharCount));
+        top++;
+
+        while (top > 0)
+        {
+            // The popped entry's slots are reused in place by its first continuation
+            top--;
+            const int pc = jobPcs[top];
+            CharCount* const jobCap = jobCaps + top * numSlots;
+            if (visited[pc] == stamp)
+                continue;
+            visited[pc] = stamp;
+
+            const AutomatonInst& inst = insts[pc];
+            switch (inst.tag)
+            {
+            case AutomatonInst::Split:
+                // Push the lower priority alternative first so the preferred one is followed first
+                jobPcs[top++] = inst.alt;
+                jobPcs[top] = inst.next;
+                js_memcpy_s(jobCaps + top * numSlots, numSlots * sizeof(CharCount), jobCap, numSlots * sizeof(CharCount));
+                top++;
+                break;
+
+            case AutomatonInst::Save:
+                jobCap[inst.slot] = inputOffset;
+                jobPcs[top++] = inst.next;
+                break;
+
+            case AutomatonInst::ResetGroups:
+                for (int slot = inst.fromGroupId * 2; slot <= inst.toGroupId * 2 + 1; slot++)
+                    jobCap[slot] = CharCountFlag;
+                jobPcs[top++] = inst.next;
+                break;
+
+            case AutomatonInst::MatchChar:
+            case AutomatonInst::MatchSet:
+            case AutomatonInst::Succ:
+                {
+                    const int thread = numThreads[list]++;
+                    threadPcs[list][thread] = pc;
+                    js_memcpy_s(threadCaps[list] + thread * numSlots, numSlots * sizeof(CharCount), jobCap, numSlots * sizeof(CharCount));
+                    break;
+                }
+
+            default:
+                if (Test(inst, context, input, inputLength, inputOffset))
+                    jobPcs[top++] = inst.next;
+                break;
+            }
+        }
+    }
+
+    bool AutomatonMatcher::RunPikeVM(const Char* const input, const CharCount inputLength, const CharCount offset, GroupInfo* groupInfos, const int numGroups)
+    {
+        const int numSlots = automaton->numSlots;
+        const AutomatonInst* const insts = automaton->insts;
+        bool matched = false;
+
+        int curr = 0;
+        int next = 1;
+        NextStamp();
+        numThreads[curr] = 0;
+
+        CharCount inputOffset = offset;
+        while (true)
+        {
+            // A thread starting here has lower priority than all threads started earlier. Once a match is found there's no
+            // need to start any more.
+            if (!matched && (inputOffset == offset || !automaton->isAnchored))
+                AddThread(curr, automaton->start, initialCaps, input, inputLength, inputOffset);
+
+            if (numThreads[curr] == 0 && (matched || automaton->isAnchored || inputOffset >= inputLength))
+                break;
+
+            NextStamp();
+            numThreads[next] = 0;
+            for (int thread = 0; thread < numThreads[curr]; thread++)
+            {
+                const AutomatonInst& inst = insts[threadPcs[curr][thread]];
+                const CharCount* const caps = threadCaps[curr] + thread * numSlots;
+                if (inst.tag == AutomatonInst::Succ)
+                {
+                    // Lower priority threads could only find a less preferred match
+                    js_memcpy_s(matchCaps, numSlots * sizeof(CharCount), caps, numSlots * sizeof(CharCount));
+                    matched = true;
+                    break;
+                }
+                if (inputOffset < inputLength && inst.Matches(input[inputOffset]))
+                    AddThread(next, inst.next, caps, input, inputLength, inputOffset + 1);
+            }
+
+            if (inputOffset >= inputLength)
+                break;
+            inputOffset++;
+            curr = next;
+            next = 1 - next;
+        }
+
+        if (!matched)
+        {
+            groupInfos[0].Reset();
+            return false;
+        }
+
+        for (int groupId = 0; groupId < numGroups; groupId++)
+        {
+            const CharCount start = matchCaps[groupId * 2];
+            const CharCount end = matchCaps[groupId * 2 + 1];
+            if (start == CharCountFlag || end == CharCountFlag)
+                groupInfos[groupId].Reset();
+            else
+            {
+                groupInfos[groupId].offset = start;
+                groupInfos[groupId].length = end - start;
+            }
+        }
+        return true;
+    }
+
+    bool AutomatonMatcher::Closure(const int state, const Char* const input, const CharCount inputLength, const CharCount inputOffset, int& numConsuming)
+    {
+        // Collect the consuming instructions reachable from the state's labels into threadPcs[0], ignoring captures and
+        // priorities. Returns true if Succ is reachable.
+        const AutomatonInst* const insts = automaton->insts;
+        const DfaState& dfaState = dfaStates[state];
+        NextStamp();
+
+        int top = 0;
+        for (int i = 0; i < dfaState.numPcs; i++)
+        {
+            const int pc = dfaPcs[dfaState.pcsOffset + i];
+            visited[pc] = stamp;
+            jobPcs[top++] = pc;
+        }
+
+        numConsuming = 0;
+        while (top > 0)
+        {
+            const int pc = jobPcs[--top];
+            const AutomatonInst& inst = insts[pc];
+            int targets[2];
+            int numTargets = 0;
+            switch (inst.tag)
+            {
+            case AutomatonInst::MatchChar:
+            case AutomatonInst::MatchSet:
+                threadPcs[0][numConsuming++] = pc;
+                break;
+
+            case AutomatonInst::Succ:
+                return true;
+
+            case AutomatonInst::Split:
+                targets[numTargets++] = inst.next;
+                targets[numTargets++] = inst.alt;
+                break;
+
+            case AutomatonInst::Save:
+            case AutomatonInst::ResetGroups:
+                targets[numTargets++] = inst.next;
+                break;
+
+            default:
+                if (Test(inst, dfaState.flags, input, inputLength, inputOffset))
+                    targets[numTargets++] = inst.next;
+                break;
+            }
+
+            for (int i = 0; i < numTargets; i++)
+            {
+                if (visited[targets[i]] != stamp)
+                {
+                    visited[targets[i]] = stamp;
+                    jobPcs[top++] = targets[i];
+                }
+            }
+        }
+        return false;
+    }
+
+    bool AutomatonMatcher::EnsureDfaPcs()
+    {
+        const int needed = numDfaPcs + automaton->numInsts;
+        if (needed <= maxDfaPcs)
+            return true;
+        if (needed > MaxDfaPcs)
+            return false;
+
+        const int newMax = min(max(maxDfaPcs * 2, needed), (int)MaxDfaPcs);
+        int* newPcs = RecyclerNewArrayLeaf(recycler, int, newMax);
+        if (numDfaPcs > 0)
+            js_memcpy_s(newPcs, newMax * sizeof(int), dfaPcs, numDfaPcs * sizeof(int));
+        dfaPcs = newPcs;
+        maxDfaPcs = newMax;
+        return true;
+    }
+
+    int AutomatonMatcher::AddState(const uint8 flags, const int numPcs)
+    {
+        // The state's labels have been written just past the labels of existing states
+        const int* const pcs = dfaPcs + numDfaPcs;
+        uint hash = flags;
+        for (int i = 0; i < numPcs; i++)
+            hash = hash * 31 + (uint)pcs[i];
+
+        int index = (int)(hash & (dfaStateTableSize - 1));
+        while (dfaStateTable[index] != -1)
+        {
+            const DfaState& dfaState = dfaStates[dfaStateTable[index]];
+            if (dfaState.flags == flags &&
+                dfaState.numPcs == numPcs &&
+                memcmp(dfaPcs + dfaState.pcsOffset, pcs, numPcs * sizeof(int)) == 0)
+            {
+                return dfaStateTable[index];
+            }
+            index = (index + 1) & (dfaStateTableSize - 1);
+        }
+
+        if (numDfaStates >= MaxDfaStates)
+            return -1;
+
+        if (numDfaStates == maxDfaStates)
+        {
+            const int newMax = min(max(maxDfaStates * 2, 16), (int)MaxDfaStates);
+            DfaState* newStates = RecyclerNewArrayLeaf(recycler, DfaState, newMax);
+            uint16* newTransitions = RecyclerNewArrayLeafZ(recycler, uint16, newMax * DirectTransitions);
+            if (numDfaStates > 0)
+            {
+                js_memcpy_s(newStates, newMax * sizeof(DfaState), dfaStates, numDfaStates * sizeof(DfaState));
+                js_memcpy_s(newTransitions, newMax * DirectTransitions * sizeof(uint16), dfaTransitions, numDfaStates * DirectTransitions * sizeof(uint16));
+            }
+            dfaStates = newStates;
+            dfaTransitions = newTransitions;
+            maxDfaStates = newMax;
+        }
+
+        const int state = numDfaStates++;
+        DfaState& dfaState = dfaStates[state];
+        dfaState.pcsOffset = numDfaPcs;
+        dfaState.numPcs = numPcs;
+        dfaState.flags = flags;
+        dfaState.matchesAtEnd = -1;
+        numDfaPcs += numPcs;
+        dfaStateTable[index] = state;
+        return state;
+    }
+
+    uint16 AutomatonMatcher::ComputeTransition(const int state, const Char* const input, const CharCount inputLength, const CharCount inputOffset)
+    {
+        Assert(inputOffset < inputLength);
+
+        int numConsuming;
+        if (Closure(state, input, inputLength, inputOffset, numConsuming))
+            return MatchTransition;
+
+        if (!EnsureDfaPcs())
+            return UnknownTransition;
+
+        // The target state's labels, in label order so equal sets compare equal. A match may also start at the next
+        // character unless anchored.
+        const AutomatonInst* const insts = automaton->insts;
+        const Char c = input[inputOffset];
+        for (int i = 0; i < numConsuming; i++)
+        {
+            const AutomatonInst& inst = insts[threadPcs[0][i]];
+            if (inst.Matches(c))
+                kernelMarks[inst.next] = 1;
+        }
+        if (!automaton->isAnchored)
+            kernelMarks[automaton->start] = 1;
+
+        int* const pcs = dfaPcs + numDfaPcs;
+        int numPcs = 0;
+        for (int label = 0; label < automaton->numInsts; label++)
+        {
+            if (kernelMarks[label])
+            {
+                kernelMarks[label] = 0;
+                pcs[numPcs++] = label;
+            }
+        }
+
+        const int target = AddState(CharContext(c), numPcs);
+        return target < 0 ? UnknownTransition : (uint16)(target + FirstStateTransition);
+    }
+
+    bool AutomatonMatcher::MatchesAtEnd(const int state, const Char* const input, const CharCount inputLength)
+    {
+        if (dfaStates[state].matchesAtEnd < 0)
+        {
+            int numConsuming;
+            dfaStates[state].matchesAtEnd = Closure(state, input, inputLength, inputLength, numConsuming) ? 1 : 0;
+        }
+        return dfaStates[state].matchesAtEnd != 0;
+    }
+
+    AutomatonMatcher::DfaResult AutomatonMatcher::RunDFA(const Char* const input, const CharCount inputLength, const CharCount offset)
+    {
+        if (dfaStateTable == nullptr)
+        {
+            // Power of two, and at least twice the maximum number of states so the table never fills
+            dfaStateTableSize = 1;
+            while (dfaStateTableSize < MaxDfaStates * 2)
+                dfaStateTableSize *= 2;
+            dfaStateTable = RecyclerNewArrayLeaf(recycler, int, dfaStateTableSize);
+            for (int i = 0; i < dfaStateTableSize; i++)
+                dfaStateTable[i] = -1;
+            kernelMarks = RecyclerNewArrayLeafZ(recycler, uint8, automaton->numInsts);
+            for (int i = 0; i < NonAsciiCacheSize; i++)
+                nonAsciiKeys[i] = 0;
+        }
+
+        if (!EnsureDfaPcs())
+            return DfaGaveUp;
+        dfaPcs[numDfaPcs] = automaton->start;
+        int state = AddState(ContextAt(input, offset), 1);
+        if (state < 0)
+            return DfaGaveUp;
+
+        for (CharCount inputOffset = offset; inputOffset < inputLength; inputOffset++)
+        {
+            const Char c = input[inputOffset];
+            uint16 transition;
+            if (CTU(c) < DirectTransitions)
+            {
+                transition = dfaTransitions[state * DirectTransitions + CTU(c)];
+                if (transition == UnknownTransition)
+                {
+                    // May add a state and reallocate the transitions
+                    transition = ComputeTransition(state, input, inputLength, inputOffset);
+                    if (transition == UnknownTransition)
+                        return DfaGaveUp;
+                    dfaTransitions[state * DirectTransitions + CTU(c)] = transition;
+                }
+            }
+            else
+            {
+                const uint32 key = ((uint32)(state + 1) << 16) | CTU(c);
+                const int index = (int)((key ^ (key >> 8)) & (NonAsciiCacheSize - 1));
+                if (nonAsciiKeys[index] == key)
+                    transition = nonAsciiTransitions[index];
+                else
+                {
+                    transition = ComputeTransition(state, input, inputLength, inputOffset);
+                    if (transition == UnknownTransition)
+                        return DfaGaveUp;
+                    nonAsciiKeys[index] = key;
+                    nonAsciiTransitions[index] = transition;
+                }
+            }
+
+            if (transition == MatchTransition)
+                return DfaMatch;
+
+            state = transition - FirstStateTransition;
+            if (dfaStates[state].numPcs == 0)
+            {
+                // Anchored and no thread left
+                return DfaNoMatch;
+            }
+        }
+
+        return MatchesAtEnd(state, input, inputLength) ? DfaMatch : DfaNoMatch;
+    }
+
+    bool AutomatonMatcher::Match(const Char* const input, const CharCount inputLength, const CharCount offset, GroupInfo* groupInfos, const int numGroups)
+    {
+        Assert(offset <= inputLength);
+
+        if (!dfaGaveUp)
+        {
+            switch (RunDFA(input, inputLength, offset))
+            {
+            case DfaNoMatch:
+                groupInfos[0].Reset();
+                return false;
+
+            case DfaGaveUp:
+                // Too many states for this pattern. Drop the DFA and always use the Pike VM, which is still linear.
+                dfaGaveUp = true;
+                dfaStates = nullptr;
+                dfaTransitions = nullptr;
+                dfaPcs = nullptr;
+                dfaStateTable = nullptr;
+                kernelMarks = nullptr;
+                break;
+
+            case DfaMatch:
+                break;
+            }
+        }
+
+        return RunPikeVM(input, inputLength, offset, groupInfos, numGroups);
+    }
+}
@@ -0,0 +1,237 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+//
+// Backtracking-free matching for patterns without backreferences or lookaheads.
+//
+// Such patterns are also compiled to a Thompson NFA. Matching first runs a lazily built DFA over the input to decide
+// whether there is any match at all, and only if there is runs a Pike VM to find the match (and captures) the backtracking
+// matcher would have found. Threads are kept in priority order, so alternatives and greedy/non-greedy loops resolve exactly
+// as they would when backtracking. Both run in time linear in the length of the input, whatever the pattern.
+#pragma once
+
+namespace UnifiedRegex
+{
+    struct Node;
+
+    // ----------------------------------------------------------------------
+    // AutomatonInst
+    // ----------------------------------------------------------------------
+
+    struct AutomatonInst : private Chars<char16>
+    {
+        enum InstTag : uint8
+        {
+            MatchChar,          // consume one of cs, continue at next
+            MatchSet,           // consume a character in set (not in set if isNegation), continue at next
+            Split,              // continue at next, and with lower priority at alt
+            Save,               // record the input offset in capture slot, continue at next
+            ResetGroups,        // forget groups fromGroupId..toGroupId at the start of a loop iteration, continue at next
+            BOITest,            // continue at next if at beginning of input
+            EOITest,            // continue at next if at end of input
+            BOLTest,            // continue at next if at beginning of line
+            EOLTest,            // continue at next if at end of line
+            WordBoundaryTest,   // continue at next if at a word boundary (not at one if isNegation)
+            Succ                // match
+        };
+
+        InstTag tag;
+        bool isNegation;
+        Char cs[CaseInsensitive::EquivClassSize];
+        int next;
+        int alt;            // Split only
+        int slot;           // Save only
+        int fromGroupId;    // ResetGroups only
+        int toGroupId;      // ResetGroups only
+        RuntimeCharSet<Char> set;   // MatchSet only, in run-time allocator
+
+        inline bool IsConsuming() const
+        {
+            return tag == MatchChar || tag == MatchSet;
+        }
+
+        inline bool Matches(const Char c) const
+        {
+            Assert(IsConsuming());
+            if (tag == MatchChar)
+                return c == cs[0] || c == cs[1] || c == cs[2] || c == cs[3];
+            return set.Get(c) != isNegation;
+        }
+    };
+
+    // ----------------------------------------------------------------------
+    // Automaton
+    // ----------------------------------------------------------------------
+
+    class Automaton : private Chars<char16>
+    {
+        friend class AutomatonCompiler;
+        friend class AutomatonMatcher;
+
+    private:
+        // In recycler, owned by program. Sets are in the run-time allocator.
+        AutomatonInst* insts;
+        int numInsts;
+        int start;
+        // Two per group, including the implicit overall group
+        int numSlots;
+        // Only try to match at the given offset (sticky)
+        bool isAnchored;
+
+        Automaton(AutomatonInst* insts, int numInsts, int start, int numSlots, bool isAnchored);
+
+    public:
+        void FreeBody(ArenaAllocator* rtAllocator);
+
+#if ENABLE_REGEX_CONFIG_OPTIONS
+        void Print(DebugWriter* w) const;
+#endif
+    };
+
+    // ----------------------------------------------------------------------
+    // AutomatonCompiler
+    // ----------------------------------------------------------------------
+
+    class AutomatonCompiler : private Chars<char16>
+    {
+    public:
+        // Upper bounds on the automaton size, so that counted loops can't blow up the instruction count and the per-thread
+        // capture storage of the Pike VM stays small
+        static const int MaxInsts = 1024;
+        static const int MaxThreadSlots = 64 * 1024;
+
+    private:
+        Js::ScriptContext* scriptContext;
+        ArenaAllocator* ctAllocator;
+        ArenaAllocator* rtAllocator;
+        Program* program;
+        AutomatonInst* insts;
+        int numInsts;
+        int nextInst;
+
+        AutomatonCompiler(Js::ScriptContext* scriptContext, ArenaAllocator* ctAllocator, ArenaAllocator* rtAllocator, Program* program, AutomatonInst* insts, int numInsts);
+
+        // Number of instructions needed for node, or false if node can't be matched by the automaton or is too large
+        static bool CountInsts(Js::ScriptContext* scriptContext, Node* node, uint64& count);
+        void GroupRange(Node* node, int& minGroupId, int& maxGroupId);
+
+        AutomatonInst* NewInst(AutomatonInst::InstTag tag, int next, int& label);
+        int NewMatchChar(const Char* cs, bool isEquivClass, int next);
+        int NewSplit(int preferred, int other);
+        // Build the instructions for node, continuing at next when node matches. Returns the entry label.
+        int Build(Node* node, int next);
+        int BuildIteration(Node* body, bool resetsGroups, int fromGroupId, int toGroupId, int next);
+
+    public:
+        // Patterns are compiled to an automaton only if they are non-deterministic (otherwise the backtracking matcher never
+        // backtracks and is already linear and faster), have no backreferences or lookaheads, and no loop whose body could
+        // match empty while defining groups (the Pike VM can't reproduce the empty-iteration rule for their captures).
+        static Automaton* Compile
+            ( Js::ScriptContext* scriptContext
+            , ArenaAllocator* ctAllocator
+            , ArenaAllocator* rtAllocator
+            , Program* program
+            , Node* root
+            );
+    };
+
+    // ----------------------------------------------------------------------
+    // AutomatonMatcher
+    // ----------------------------------------------------------------------
+
+    class AutomatonMatcher : private Chars<char16>
+    {
+    private:
+        enum DfaResult
+        {
+            DfaNoMatch,
+            DfaMatch,
+            DfaGaveUp
+        };
+
+        // Context of the previous character, which together with the next character decides assertions
+        enum ContextFlags : uint8
+        {
+            NoContext = 0,
+            AtBOI = 1 << 0,
+            PrevIsWord = 1 << 1,
+            PrevIsNewline = 1 << 2
+        };
+
+        // Transitions: 0 if not computed yet, MatchTransition if a match ends before the character, otherwise the target
+        // state + FirstStateTransition
+        static const uint16 UnknownTransition = 0;
+        static const uint16 MatchTransition = 1;
+        static const uint16 FirstStateTransition = 2;
+        static const int DirectTransitions = 128;
+        static const int NonAsciiCacheSize = 256;
+        // Past this many states, or labels over all states, the DFA gives up for good and only the Pike VM is used
+        static const int MaxDfaStates = 1000;
+        static const int MaxDfaPcs = 64 * 1024;
+
+        struct DfaState
+        {
+            int pcsOffset;      // into dfaPcs
+            int numPcs;
+            uint8 flags;
+            int8 matchesAtEnd;  // -1 if not computed yet
+        };
+
+        const Automaton* automaton;
+        const StandardChars<Char>* standardChars;
+        Recycler* recycler;
+
+        // Scratch shared by the Pike VM and DFA construction, all in recycler
+        uint32* visited;        // label -> stamp of the thread list it was last added to
+        uint32 stamp;
+        uint8 contextMask;      // ContextFlags the pattern's assertions look at
+        int* jobPcs;            // stack of pending labels, numInsts + 1 entries
+        CharCount* jobCaps;     // capture slots for each pending label
+        int* threadPcs[2];      // runnable threads in priority order
+        CharCount* threadCaps[2];
+        int numThreads[2];
+        CharCount* initialCaps;
+        CharCount* matchCaps;
+
+        // Lazy DFA, all in recycler
+        bool dfaGaveUp;
+        DfaState* dfaStates;
+        int numDfaStates;
+        int maxDfaStates;
+        uint16* dfaTransitions; // DirectTransitions per state
+        int* dfaPcs;
+        int numDfaPcs;
+        int maxDfaPcs;
+        int* dfaStateTable;     // open addressing hash of states, -1 if empty
+        int dfaStateTableSize;
+        uint32 nonAsciiKeys[NonAsciiCacheSize];
+        uint16 nonAsciiTransitions[NonAsciiCacheSize];
+        uint8* kernelMarks;     // per label, while building a new state
+
+        AutomatonMatcher(Recycler* recycler, const StandardChars<Char>* standardChars, const Automaton* automaton);
+
+        inline uint8 CharContext(const Char c) const;
+        inline uint8 ContextAt(const Char* const input, const CharCount inputOffset) const;
+        inline bool Test(const AutomatonInst& inst, const uint8 context, const Char* const input, const CharCount inputLength, const CharCount inputOffset) const;
+        inline void NextStamp();
+
+        // Pike VM
+        void AddThread(const int list, const int label, const CharCount* caps, const Char* const input, const CharCount inputLength, const CharCount inputOffset);
+        bool RunPikeVM(const Char* const input, const CharCount inputLength, const CharCount offset, GroupInfo* groupInfos, const int numGroups);
+
+        // Lazy DFA
+        bool Closure(const int state, const Char* const input, const CharCount inputLength, const CharCount inputOffset, int& numConsuming);
+        bool EnsureDfaPcs();
+        int AddState(const uint8 flags, const int numPcs);
+        uint16 ComputeTransition(const int state, const Char* const input, const CharCount inputLength, const CharCount inputOffset);
+        bool MatchesAtEnd(const int state, const Char* const input, const CharCount inputLength);
+        DfaResult RunDFA(const Char* const input, const CharCount inputLength, const CharCount offset);
+
+    public:
+        static AutomatonMatcher* New(Recycler* recycler, const StandardChars<Char>* standardChars, const Automaton* automaton);
+
+        // Same contract as Matcher::Match: on success fills in groupInfos, otherwise resets group 0
+        bool Match(const Char* const input, const CharCount inputLength, const CharCount offset, GroupInfo* groupInfos, const int numGroups);
+    };
+}
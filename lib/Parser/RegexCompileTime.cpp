@@ -4604,6 +4604,12 @@ namespace UnifiedRegex
 
                     compiler.Emit<SuccInst>();
                     compiler.CaptureInsts();
+
+                    // Patterns which could backtrack excessively are matched by an automaton instead
+                    if (REGEX_CONFIG_FLAG(RegexAutomaton))
+                    {
+                        program->automaton = AutomatonCompiler::Compile(scriptContext, ctAllocator, rtAllocator, program, root);
+                    }
                 }
             }
             else
@@ -0,0 +1,1120 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#include "ParserPch.h"
+
+#if ENABLE_REGEX_NATIVE_CODEGEN
+
+namespace UnifiedRegex
+{
+    // ----------------------------------------------------------------------
+    // NativeCode
+    // ----------------------------------------------------------------------
+
+    NativeCode::NativeCode(ThreadContext* threadContext)
+        : threadContext(threadContext)
+        , allocation(nullptr)
+        , entryPoint(nullptr)
+        , codeSize(0)
+    {
+    }
+
+    void NativeCode::Free()
+    {
+        if (allocation == nullptr)
+            return;
+
+        threadContext->SetValidCallTargetForCFG(allocation->address, false);
+        threadContext->GetRegexCodeHeap()->Free(allocation);
+        allocation = nullptr;
+        entryPoint = nullptr;
+    }
+
+#if ENABLE_REGEX_CONFIG_OPTIONS
+    void NativeCode::Print(DebugWriter* w) const
+    {
+        w->PrintEOL(_u("nativeCode:   %u bytes"), (uint)codeSize);
+    }
+#endif
+
+    // ----------------------------------------------------------------------
+    // NativeCodeCompiler
+    // ----------------------------------------------------------------------
+
+    NativeCodeCompiler::NativeCodeCompiler(ArenaAllocator* allocator, Program* program)
+        : allocator(allocator)
+        , program(program)
+        , code(allocator)
+        , labelOffsets(allocator)
+        , fixups(allocator)
+        , instLabels(nullptr)
+        , failLabel(-1)
+        , noMatchLabel(-1)
+        , succLabel(-1)
+        , hasBadLabel(false)
+        , hasLargeSet(false)
+    {
+    }
+
+    size_t NativeCodeCompiler::InstSize(const Inst* inst)
+    {
+        switch (inst->tag)
+        {
+#define MBase(TagName, ClassName) \
+        case Inst::TagName: \
+            return sizeof(ClassName);
+#define M(TagName) MBase(TagName, TagName##Inst)
+#define MTemplate(TagName, TemplateDeclaration, GenericClassName, SpecializedClassName) MBase(TagName, SpecializedClassName)
+#include "RegexOpCodes.h"
+#undef MBase
+#undef M
+#undef MTemplate
+        default:
+            Assert(false);
+            __assume(false);
+        }
+    }
+
+    bool NativeCodeCompiler::IsSupported(const Inst* inst)
+    {
+        // Only instructions which never push a continuation (other than to reset a group, which a failing attempt does
+        // anyway), so that failing is always the end of an attempt
+        switch (inst->tag)
+        {
+        case Inst::Fail:
+        case Inst::Succ:
+        case Inst::Jump:
+        case Inst::JumpIfNotChar:
+        case Inst::MatchCharOrJump:
+        case Inst::JumpIfNotSet:
+        case Inst::MatchSetOrJump:
+        case Inst::Switch10:
+        case Inst::Switch20:
+        case Inst::SwitchAndConsume10:
+        case Inst::SwitchAndConsume20:
+        case Inst::BOITest:
+        case Inst::EOITest:
+        case Inst::BOLTest:
+        case Inst::EOLTest:
+        case Inst::WordBoundaryTest:
+        case Inst::MatchChar:
+        case Inst::MatchChar2:
+        case Inst::MatchChar3:
+        case Inst::MatchChar4:
+        case Inst::MatchSet:
+        case Inst::MatchNegatedSet:
+        case Inst::MatchLiteral:
+        case Inst::MatchLiteralEquiv:
+        case Inst::OptMatchChar:
+        case Inst::OptMatchSet:
+        case Inst::SyncToCharAndContinue:
+        case Inst::SyncToChar2SetAndContinue:
+        case Inst::SyncToSetAndContinue:
+        case Inst::SyncToNegatedSetAndContinue:
+        case Inst::SyncToCharAndConsume:
+        case Inst::SyncToChar2SetAndConsume:
+        case Inst::SyncToSetAndConsume:
+        case Inst::SyncToNegatedSetAndConsume:
+        case Inst::BeginDefineGroup:
+        case Inst::EndDefineGroup:
+        case Inst::DefineGroupFixed:
+        case Inst::ChompCharStar:
+        case Inst::ChompCharPlus:
+        case Inst::ChompSetStar:
+        case Inst::ChompSetPlus:
+        case Inst::ChompCharGroupStar:
+        case Inst::ChompCharGroupPlus:
+        case Inst::ChompSetGroupStar:
+        case Inst::ChompSetGroupPlus:
+        case Inst::ChompCharBounded:
+        case Inst::ChompSetBounded:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    //
+    // Encoding
+    //
+
+    void NativeCodeCompiler::Emit(uint8 b)
+    {
+        code.Add(b);
+    }
+
+    void NativeCodeCompiler::Emit16(uint16 v)
+    {
+        Emit((uint8)v);
+        Emit((uint8)(v >> 8));
+    }
+
+    void NativeCodeCompiler::Emit32(uint32 v)
+    {
+        Emit16((uint16)v);
+        Emit16((uint16)(v >> 16));
+    }
+
+    void NativeCodeCompiler::Emit64(uint64 v)
+    {
+        Emit32((uint32)v);
+        Emit32((uint32)(v >> 32));
+    }
+
+    void NativeCodeCompiler::EmitRex(bool w, int reg, int index, int base)
+    {
+        const uint8 rex =
+            0x40 |
+            (w ? 0x08 : 0) |
+            ((reg >> 3) & 1) << 2 |
+            (index == RegNone ? 0 : ((index >> 3) & 1) << 1) |
+            ((base >> 3) & 1);
+        if (rex != 0x40)
+            Emit(rex);
+    }
+
+    void NativeCodeCompiler::EmitOpcode(uint16 opcode)
+    {
+        // Two-byte opcodes are given with their 0x0F escape in the high byte
+        if (opcode > 0xff)
+            Emit((uint8)(opcode >> 8));
+        Emit((uint8)opcode);
+    }
+
+    void NativeCodeCompiler::EmitModRMMem(int reg, int base, int index, int scaleLog, int32 disp)
+    {
+        // Always [base + index * scale + disp32], which also sidesteps the special cases of rbp and r13 as a base
+        Assert(index != RegRSP);
+        if (index == RegNone && (base & 7) != RegRSP)
+        {
+            Emit((uint8)(0x80 | (reg & 7) << 3 | (base & 7)));
+        }
+        else
+        {
+            Emit((uint8)(0x84 | (reg & 7) << 3));
+            Emit((uint8)(scaleLog << 6 | ((index == RegNone ? RegRSP : index) & 7) << 3 | (base & 7)));
+        }
+        Emit32((uint32)disp);
+    }
+
+    void NativeCodeCompiler::EmitRegReg(uint16 opcode, int reg, int rm, bool w)
+    {
+        EmitRex(w, reg, RegNone, rm);
+        EmitOpcode(opcode);
+        Emit((uint8)(0xc0 | (reg & 7) << 3 | (rm & 7)));
+    }
+
+    void NativeCodeCompiler::EmitRegMem(uint16 opcode, int reg, int base, int index, int scaleLog, int32 disp, bool w)
+    {
+        EmitRex(w, reg, index, base);
+        EmitOpcode(opcode);
+        EmitModRMMem(reg, base, index, scaleLog, disp);
+    }
+
+    void NativeCodeCompiler::EmitRegImm(uint8 ext, int rm, uint32 imm)
+    {
+        // op r/m32, imm32 (0x81 /ext)
+        EmitRegReg(0x81, ext, rm);
+        Emit32(imm);
+    }
+
+    void NativeCodeCompiler::EmitRegImm8(uint8 ext, int rm, uint8 imm)
+    {
+        // op r/m64, imm8 (REX.W 0x83 /ext)
+        EmitRegReg(0x83, ext, rm, true);
+        Emit(imm);
+    }
+
+    void NativeCodeCompiler::EmitMovRegImm(int reg, uint32 imm)
+    {
+        EmitRex(false, 0, RegNone, reg);
+        Emit((uint8)(0xb8 + (reg & 7)));
+        Emit32(imm);
+    }
+
+    void NativeCodeCompiler::EmitMovRegImm64(int reg, uint64 imm)
+    {
+        EmitRex(true, 0, RegNone, reg);
+        Emit((uint8)(0xb8 + (reg & 7)));
+        Emit64(imm);
+    }
+
+    void NativeCodeCompiler::EmitMovMemImm(int base, int32 disp, uint32 imm)
+    {
+        EmitRegMem(0xc7, 0, base, RegNone, 0, disp);
+        Emit32(imm);
+    }
+
+    //
+    // Labels and branches
+    //
+
+    int NativeCodeCompiler::NewLabel()
+    {
+        return labelOffsets.Add(-1);
+    }
+
+    void NativeCodeCompiler::BindLabel(int label)
+    {
+        Assert(labelOffsets.Item(label) == -1);
+        labelOffsets.Item(label, code.Count());
+    }
+
+    void NativeCodeCompiler::EmitRel32(int label)
+    {
+        Fixup fixup;
+        fixup.codeOffset = code.Count();
+        fixup.label = label;
+        fixups.Add(fixup);
+        Emit32(0);
+    }
+
+    void NativeCodeCompiler::EmitJump(int label)
+    {
+        Emit(0xe9);
+        EmitRel32(label);
+    }
+
+    void NativeCodeCompiler::EmitJumpIf(CondCode cc, int label)
+    {
+        Emit(0x0f);
+        Emit((uint8)(0x80 | cc));
+        EmitRel32(label);
+    }
+
+    int NativeCodeCompiler::LabelFor(Label target)
+    {
+        if (target >= program->rep.insts.instsLen || instLabels[target] < 0)
+        {
+            // Not the start of an instruction
+            Assert(false);
+            hasBadLabel = true;
+            return failLabel;
+        }
+        return instLabels[target];
+    }
+
+    //
+    // Matcher state
+    //
+
+    void NativeCodeCompiler::EmitCmpOffsetToLength()
+    {
+        // cmp r8d, edx
+        EmitRegReg(0x39, InputLengthReg, InputOffsetReg);
+    }
+
+    void NativeCodeCompiler::EmitIncOffset()
+    {
+        // inc r8d
+        EmitRegReg(0xff, 0, InputOffsetReg);
+    }
+
+    void NativeCodeCompiler::EmitAddOffset(CharCount n)
+    {
+        EmitRegImm(0 /* add */, InputOffsetReg, n);
+    }
+
+    void NativeCodeCompiler::EmitLoadChar(int reg, int charDisp)
+    {
+        // movzx reg, word ptr [r10 + r8 * 2 + charDisp * 2]
+        EmitRegMem(0x0fb7, reg, InputReg, InputOffsetReg, 1, charDisp * (int32)sizeof(Char));
+    }
+
+    void NativeCodeCompiler::EmitCmpRegImm(int reg, uint32 imm)
+    {
+        EmitRegImm(7 /* cmp */, reg, imm);
+    }
+
+    void NativeCodeCompiler::EmitCheckRemaining(CharCount n)
+    {
+        if (n == 1)
+        {
+            EmitCmpOffsetToLength();
+            EmitJumpIf(CondAE, failLabel);
+            return;
+        }
+
+        // mov eax, edx; sub eax, r8d; cmp eax, n; jb fail
+        EmitRegReg(0x89, InputLengthReg, RegRAX);
+        EmitRegReg(0x29, InputOffsetReg, RegRAX);
+        EmitCmpRegImm(RegRAX, n);
+        EmitJumpIf(CondB, failLabel);
+    }
+
+    int32 NativeCodeCompiler::GroupOffsetDisp(int groupId)
+    {
+        return groupId * (int32)sizeof(GroupInfo) + (int32)offsetof(GroupInfo, offset);
+    }
+
+    int32 NativeCodeCompiler::GroupLengthDisp(int groupId)
+    {
+        return groupId * (int32)sizeof(GroupInfo) + (int32)offsetof(GroupInfo, length);
+    }
+
+    //
+    // Character tests. The character is in ecx.
+    //
+
+    void NativeCodeCompiler::EmitJumpIfChar(const Char* cs, int numChars, bool jumpIfMatch, int label)
+    {
+        Assert(numChars > 0);
+        if (jumpIfMatch)
+        {
+            for (int i = 0; i < numChars; i++)
+            {
+                EmitCmpRegImm(RegRCX, CTU(cs[i]));
+                EmitJumpIf(CondE, label);
+            }
+            return;
+        }
+
+        const int matched = NewLabel();
+        for (int i = 0; i < numChars - 1; i++)
+        {
+            EmitCmpRegImm(RegRCX, CTU(cs[i]));
+            EmitJumpIf(CondE, matched);
+        }
+        EmitCmpRegImm(RegRCX, CTU(cs[numChars - 1]));
+        EmitJumpIf(CondNE, label);
+        BindLabel(matched);
+    }
+
+    void NativeCodeCompiler::EmitJumpIfSet(const RuntimeCharSet<Char>& set, bool jumpIfIn, int label)
+    {
+        const int done = NewLabel();
+        const int notDirect = set.HasNonDirect() ? NewLabel() : (jumpIfIn ? done : label);
+
+        // cmp ecx, 256; jae notDirect
+        EmitCmpRegImm(RegRCX, CharSetNode::directSize);
+        EmitJumpIf(CondAE, notDirect);
+
+        // mov rax, &direct; bt dword ptr [rax], ecx
+        EmitMovRegImm64(RegRAX, (uint64)set.GetDirect());
+        EmitRegMem(0x0fa3, RegRCX, RegRAX, RegNone, 0, 0);
+        EmitJumpIf(jumpIfIn ? CondB : CondAE, label);
+
+        if (set.HasNonDirect())
+        {
+            EmitJump(done);
+            BindLabel(notDirect);
+
+            // The characters past the first 256 are tested against the ranges of the trie, which don't change once the
+            // program is compiled
+            const int in = jumpIfIn ? label : done;
+            int numRanges = 0;
+            Char lower, upper;
+            for (uint next = CharSetNode::directSize; next <= MaxUChar && set.GetNextNonDirectRange(UTC(next), &lower, &upper); next = CTU(upper) + 1)
+            {
+                if (++numRanges > MaxNonDirectSetRanges)
+                {
+                    hasLargeSet = true;
+                    break;
+                }
+
+                if (lower == upper)
+                {
+                    EmitCmpRegImm(RegRCX, CTU(lower));
+                    EmitJumpIf(CondE, in);
+                }
+                else
+                {
+                    // mov eax, ecx; sub eax, lower; cmp eax, upper - lower; jbe in
+                    EmitRegReg(0x89, RegRCX, RegRAX);
+                    EmitRegImm(5 /* sub */, RegRAX, CTU(lower));
+                    EmitCmpRegImm(RegRAX, CTU(upper) - CTU(lower));
+                    EmitJumpIf(CondBE, in);
+                }
+            }
+            if (!jumpIfIn)
+                EmitJump(label);
+        }
+
+        BindLabel(done);
+    }
+
+    void NativeCodeCompiler::EmitJumpIfNewline(int label)
+    {
+        // Same characters as StandardChars<char16>::IsNewline: \n, \r, U+2028 and U+2029
+        EmitCmpRegImm(RegRCX, '\n');
+        EmitJumpIf(CondE, label);
+        EmitCmpRegImm(RegRCX, '\r');
+        EmitJumpIf(CondE, label);
+        EmitRegReg(0x89, RegRCX, RegRAX);
+        EmitRegImm(4 /* and */, RegRAX, 0xfffe);
+        EmitCmpRegImm(RegRAX, 0x2028);
+        EmitJumpIf(CondE, label);
+    }
+
+    void NativeCodeCompiler::EmitJumpIfWord(int label)
+    {
+        // Same characters as StandardChars<char16>::IsWord: [0-9A-Z_a-z]
+        struct { Char first; Char last; } ranges[] = { { '0', '9' }, { 'A', 'Z' }, { '_', '_' }, { 'a', 'z' } };
+        for (size_t i = 0; i < _countof(ranges); i++)
+        {
+            // mov eax, ecx; sub eax, first; cmp eax, last - first; jbe label
+            EmitRegReg(0x89, RegRCX, RegRAX);
+            EmitRegImm(5 /* sub */, RegRAX, ranges[i].first);
+            EmitCmpRegImm(RegRAX, ranges[i].last - ranges[i].first);
+            EmitJumpIf(CondBE, label);
+        }
+    }
+
+    void NativeCodeCompiler::EmitJumpIfMatches(const CharPredicate& predicate, bool jumpIfMatch, int label)
+    {
+        if (predicate.set != nullptr)
+        {
+            // A character matches if it is in the set, or not in it for a negated set
+            EmitJumpIfSet(*predicate.set, jumpIfMatch != predicate.isNegation, label);
+        }
+        else
+        {
+            EmitJumpIfChar(predicate.cs, predicate.numChars, jumpIfMatch, label);
+        }
+    }
+
+    //
+    // Instructions
+    //
+
+    void NativeCodeCompiler::EmitConsume(const CharPredicate& predicate)
+    {
+        EmitCmpOffsetToLength();
+        EmitJumpIf(CondAE, failLabel);
+        EmitLoadChar(RegRCX, 0);
+        EmitJumpIfMatches(predicate, false, failLabel);
+        EmitIncOffset();
+    }
+
+    void NativeCodeCompiler::EmitOptConsume(const CharPredicate& predicate)
+    {
+        const int done = NewLabel();
+        EmitCmpOffsetToLength();
+        EmitJumpIf(CondAE, done);
+        EmitLoadChar(RegRCX, 0);
+        EmitJumpIfMatches(predicate, false, done);
+        EmitIncOffset();
+        BindLabel(done);
+    }
+
+    void NativeCodeCompiler::EmitMatchOrJump(const CharPredicate& predicate, Label targetLabel, bool consume)
+    {
+        const int target = LabelFor(targetLabel);
+        EmitCmpOffsetToLength();
+        EmitJumpIf(CondAE, target);
+        EmitLoadChar(RegRCX, 0);
+        EmitJumpIfMatches(predicate, false, target);
+        if (consume)
+            EmitIncOffset();
+    }
+
+    void NativeCodeCompiler::EmitChomp(const CharPredicate& predicate, ChompMode mode, int groupId)
+    {
+        if (groupId >= 0)
+        {
+            // mov [rsp + ChompStartLocal], r8d
+            EmitRegMem(0x89, InputOffsetReg, RegRSP, RegNone, 0, ChompStartLocal);
+        }
+
+        if (mode == ChompMode::Plus)
+            EmitConsume(predicate);
+
+        const int loop = NewLabel();
+        const int done = NewLabel();
+        BindLabel(loop);
+        EmitCmpOffsetToLength();
+        EmitJumpIf(CondAE, done);
+        EmitLoadChar(RegRCX, 0);
+        EmitJumpIfMatches(predicate, false, done);
+        EmitIncOffset();
+        EmitJump(loop);
+        BindLabel(done);
+
+        if (groupId >= 0)
+        {
+            // mov eax, [rsp + ChompStartLocal]; mov [group.offset], eax; mov ecx, r8d; sub ecx, eax; mov [group.length], ecx
+            EmitRegMem(0x8b, RegRAX, RegRSP, RegNone, 0, ChompStartLocal);
+            EmitRegMem(0x89, RegRAX, GroupInfosReg, RegNone, 0, GroupOffsetDisp(groupId));
+            EmitRegReg(0x89, InputOffsetReg, RegRCX);
+            EmitRegReg(0x29, RegRAX, RegRCX);
+            EmitRegMem(0x89, RegRCX, GroupInfosReg, RegNone, 0, GroupLengthDisp(groupId));
+        }
+    }
+
+    void NativeCodeCompiler::EmitChompBounded(const CharPredicate& predicate, const CountDomain& repeats)
+    {
+        // mov [rsp + ChompStartLocal], r8d
+        EmitRegMem(0x89, InputOffsetReg, RegRSP, RegNone, 0, ChompStartLocal);
+
+        // ecx = upper >= inputLength - inputOffset ? inputLength : inputOffset + upper
+        EmitRegReg(0x89, InputLengthReg, RegRCX);
+        if (repeats.upper != CharCountFlag)
+        {
+            const int endKnown = NewLabel();
+            EmitRegReg(0x89, InputLengthReg, RegRAX);
+            EmitRegReg(0x29, InputOffsetReg, RegRAX);
+            EmitCmpRegImm(RegRAX, repeats.upper);
+            EmitJumpIf(CondBE, endKnown);
+            EmitRegReg(0x89, InputOffsetReg, RegRCX);
+            EmitRegImm(0 /* add */, RegRCX, repeats.upper);
+            BindLabel(endKnown);
+        }
+        EmitRegMem(0x89, RegRCX, RegRSP, RegNone, 0, ChompEndLocal);
+
+        const int loop = NewLabel();
+        const int done = NewLabel();
+        BindLabel(loop);
+        // cmp r8d, [rsp + ChompEndLocal]
+        EmitRegMem(0x3b, InputOffsetReg, RegRSP, RegNone, 0, ChompEndLocal);
+        EmitJumpIf(CondAE, done);
+        EmitLoadChar(RegRCX, 0);
+        EmitJumpIfMatches(predicate, false, done);
+        EmitIncOffset();
+        EmitJump(loop);
+        BindLabel(done);
+
+        if (repeats.lower > 0)
+        {
+            // mov eax, r8d; sub eax, [rsp + ChompStartLocal]; cmp eax, lower; jb fail
+            EmitRegReg(0x89, InputOffsetReg, RegRAX);
+            EmitRegMem(0x2b, RegRAX, RegRSP, RegNone, 0, ChompStartLocal);
+            EmitCmpRegImm(RegRAX, repeats.lower);
+            EmitJumpIf(CondB, failLabel);
+        }
+    }
+
+    void NativeCodeCompiler::EmitSync(const CharPredicate& predicate, bool consume)
+    {
+        const int loop = NewLabel();
+        const int found = NewLabel();
+        BindLabel(loop);
+        EmitCmpOffsetToLength();
+        // Syncing past the end of the input continues from there, unless the character must be consumed, in which case
+        // no later start offset can match either
+        EmitJumpIf(CondAE, consume ? noMatchLabel : found);
+        EmitLoadChar(RegRCX, 0);
+        EmitJumpIfMatches(predicate, true, found);
+        EmitIncOffset();
+        EmitJump(loop);
+        BindLabel(found);
+
+        // mov r11d, r8d
+        EmitRegReg(0x89, InputOffsetReg, MatchStartReg);
+        if (consume)
+            EmitIncOffset();
+    }
+
+    template <int n>
+    void NativeCodeCompiler::EmitSwitch(const SwitchMixin<n>& switchMixin, bool consume)
+    {
+        EmitCmpOffsetToLength();
+        EmitJumpIf(CondAE, failLabel);
+        EmitLoadChar(RegRCX, 0);
+        for (int i = 0; i < switchMixin.numCases; i++)
+        {
+            EmitCmpRegImm(RegRCX, CTU(switchMixin.cases[i].c));
+            if (consume)
+            {
+                const int nextCase = NewLabel();
+                EmitJumpIf(CondNE, nextCase);
+                EmitIncOffset();
+                EmitJump(LabelFor(switchMixin.cases[i].targetLabel));
+                BindLabel(nextCase);
+            }
+            else
+            {
+                EmitJumpIf(CondE, LabelFor(switchMixin.cases[i].targetLabel));
+            }
+        }
+        // No case matched, continue with the next instruction
+    }
+
+    void NativeCodeCompiler::EmitMatchLiteral(const Char* literal, CharCount length)
+    {
+        if (length == 0)
+            return;
+        EmitCheckRemaining(length);
+
+        // Compare four characters at a time, then two, then one
+        CharCount i = 0;
+        for (; length - i >= 4; i += 4)
+        {
+            uint64 chars = 0;
+            for (int j = 3; j >= 0; j--)
+                chars = chars << 16 | CTU(literal[i + j]);
+
+            // mov rax, chars; cmp qword ptr [r10 + r8 * 2 + i * 2], rax; jne fail
+            EmitMovRegImm64(RegRAX, chars);
+            EmitRegMem(0x39, RegRAX, InputReg, InputOffsetReg, 1, (int32)(i * sizeof(Char)), true);
+            EmitJumpIf(CondNE, failLabel);
+        }
+        if (length - i >= 2)
+        {
+            // cmp dword ptr [r10 + r8 * 2 + i * 2], chars; jne fail
+            EmitRegMem(0x81, 7, InputReg, InputOffsetReg, 1, (int32)(i * sizeof(Char)));
+            Emit32((uint32)CTU(literal[i + 1]) << 16 | CTU(literal[i]));
+            EmitJumpIf(CondNE, failLabel);
+            i += 2;
+        }
+        if (length - i == 1)
+        {
+            // cmp word ptr [r10 + r8 * 2 + i * 2], char; jne fail
+            Emit(0x66);
+            EmitRegMem(0x81, 7, InputReg, InputOffsetReg, 1, (int32)(i * sizeof(Char)));
+            Emit16(CTU(literal[i]));
+            EmitJumpIf(CondNE, failLabel);
+        }
+
+        EmitAddOffset(length);
+    }
+
+    void NativeCodeCompiler::EmitInst(const Inst* inst)
+    {
+        const Char* const litbuf = program->rep.insts.litbuf;
+
+        switch (inst->tag)
+        {
+        case Inst::Fail:
+            EmitJump(failLabel);
+            break;
+
+        case Inst::Succ:
+            EmitJump(succLabel);
+            break;
+
+        case Inst::Jump:
+            EmitJump(LabelFor(static_cast<const JumpInst*>(inst)->targetLabel));
+            break;
+
+        case Inst::JumpIfNotChar:
+        {
+            const auto actualInst = static_cast<const JumpIfNotCharInst*>(inst);
+            EmitMatchOrJump(CharPredicate(&actualInst->c, 1), actualInst->targetLabel, false);
+            break;
+        }
+        case Inst::MatchCharOrJump:
+        {
+            const auto actualInst = static_cast<const MatchCharOrJumpInst*>(inst);
+            EmitMatchOrJump(CharPredicate(&actualInst->c, 1), actualInst->targetLabel, true);
+            break;
+        }
+        case Inst::JumpIfNotSet:
+        {
+            const auto actualInst = static_cast<const JumpIfNotSetInst*>(inst);
+            EmitMatchOrJump(CharPredicate(actualInst->set, false), actualInst->targetLabel, false);
+            break;
+        }
+        case Inst::MatchSetOrJump:
+        {
+            const auto actualInst = static_cast<const MatchSetOrJumpInst*>(inst);
+            EmitMatchOrJump(CharPredicate(actualInst->set, false), actualInst->targetLabel, true);
+            break;
+        }
+
+        case Inst::Switch10:
+            EmitSwitch(*static_cast<const Switch10Inst*>(inst), false);
+            break;
+        case Inst::Switch20:
+            EmitSwitch(*static_cast<const Switch20Inst*>(inst), false);
+            break;
+        case Inst::SwitchAndConsume10:
+            EmitSwitch(*static_cast<const SwitchAndConsume10Inst*>(inst), true);
+            break;
+        case Inst::SwitchAndConsume20:
+            EmitSwitch(*static_cast<const SwitchAndConsume20Inst*>(inst), true);
+            break;
+
+        case Inst::BOITest:
+            // test r8d, r8d; jnz fail. A hard fail means no later start offset can match either.
+            EmitRegReg(0x85, InputOffsetReg, InputOffsetReg);
+            EmitJumpIf(CondNE, static_cast<const BOITestInst*>(inst)->canHardFail ? noMatchLabel : failLabel);
+            break;
+
+        case Inst::EOITest:
+            // A hard fail here still lets later start offsets match, which is just a fail
+            EmitCmpOffsetToLength();
+            EmitJumpIf(CondB, failLabel);
+            break;
+
+        case Inst::BOLTest:
+        {
+            const int ok = NewLabel();
+            EmitRegReg(0x85, InputOffsetReg, InputOffsetReg);
+            EmitJumpIf(CondE, ok);
+            EmitLoadChar(RegRCX, -1);
+            EmitJumpIfNewline(ok);
+            EmitJump(failLabel);
+            BindLabel(ok);
+            break;
+        }
+
+        case Inst::EOLTest:
+        {
+            const int ok = NewLabel();
+            EmitCmpOffsetToLength();
+            EmitJumpIf(CondAE, ok);
+            EmitLoadChar(RegRCX, 0);
+            EmitJumpIfNewline(ok);
+            EmitJump(failLabel);
+            BindLabel(ok);
+            break;
+        }
+
+        case Inst::WordBoundaryTest:
+        {
+            // Branch on whether the previous character is a word character, then on whether the current one is, to
+            // whether they are the same or differ
+            const int prevIsWord = NewLabel();
+            const int prevIsNotWord = NewLabel();
+            const int same = NewLabel();
+            const int differ = NewLabel();
+
+            EmitRegReg(0x85, InputOffsetReg, InputOffsetReg);
+            EmitJumpIf(CondE, prevIsNotWord);
+            EmitLoadChar(RegRCX, -1);
+            EmitJumpIfWord(prevIsWord);
+            EmitJump(prevIsNotWord);
+
+            BindLabel(prevIsWord);
+            EmitCmpOffsetToLength();
+            EmitJumpIf(CondAE, differ);
+            EmitLoadChar(RegRCX, 0);
+            EmitJumpIfWord(same);
+            EmitJump(differ);
+
+            BindLabel(prevIsNotWord);
+            EmitCmpOffsetToLength();
+            EmitJumpIf(CondAE, same);
+            EmitLoadChar(RegRCX, 0);
+            EmitJumpIfWord(differ);
+            EmitJump(same);
+
+            // Fail if isNegation == (prev != curr)
+            if (static_cast<const WordBoundaryTestInst*>(inst)->isNegation)
+            {
+                BindLabel(differ);
+                EmitJump(failLabel);
+                BindLabel(same);
+            }
+            else
+            {
+                BindLabel(same);
+                EmitJump(failLabel);
+                BindLabel(differ);
+            }
+            break;
+        }
+
+        case Inst::MatchChar:
+            EmitConsume(CharPredicate(&static_cast<const MatchCharInst*>(inst)->c, 1));
+            break;
+        case Inst::MatchChar2:
+            EmitConsume(CharPredicate(static_cast<const MatchChar2Inst*>(inst)->cs, 2));
+            break;
+        case Inst::MatchChar3:
+            EmitConsume(CharPredicate(static_cast<const MatchChar3Inst*>(inst)->cs, 3));
+            break;
+        case Inst::MatchChar4:
+            EmitConsume(CharPredicate(static_cast<const MatchChar4Inst*>(inst)->cs, 4));
+            break;
+        case Inst::MatchSet:
+            EmitConsume(CharPredicate(static_cast<const MatchSetInst<false>*>(inst)->set, false));
+            break;
+        case Inst::MatchNegatedSet:
+            EmitConsume(CharPredicate(static_cast<const MatchSetInst<true>*>(inst)->set, true));
+            break;
+
+        case Inst::MatchLiteral:
+        {
+            const auto actualInst = static_cast<const MatchLiteralInst*>(inst);
+            EmitMatchLiteral(litbuf + actualInst->offset, actualInst->length);
+            break;
+        }
+
+        case Inst::MatchLiteralEquiv:
+        {
+            const auto actualInst = static_cast<const MatchLiteralEquivInst*>(inst);
+            if (actualInst->length == 0)
+                break;
+            EmitCheckRemaining(actualInst->length);
+            for (CharCount i = 0; i < actualInst->length; i++)
+            {
+                EmitLoadChar(RegRCX, (int)i);
+                EmitJumpIfChar(litbuf + actualInst->offset + i * CaseInsensitive::EquivClassSize, CaseInsensitive::EquivClassSize, false, failLabel);
+            }
+            EmitAddOffset(actualInst->length);
+            break;
+        }
+
+        case Inst::OptMatchChar:
+            EmitOptConsume(CharPredicate(&static_cast<const OptMatchCharInst*>(inst)->c, 1));
+            break;
+        case Inst::OptMatchSet:
+            EmitOptConsume(CharPredicate(static_cast<const OptMatchSetInst*>(inst)->set, false));
+            break;
+
+        case Inst::SyncToCharAndContinue:
+            EmitSync(CharPredicate(&static_cast<const SyncToCharAndContinueInst*>(inst)->c, 1), false);
+            break;
+        case Inst::SyncToChar2SetAndContinue:
+            EmitSync(CharPredicate(static_cast<const SyncToChar2SetAndContinueInst*>(inst)->cs, 2), false);
+            break;
+        case Inst::SyncToSetAndContinue:
+            EmitSync(CharPredicate(static_cast<const SyncToSetAndContinueInst<false>*>(inst)->set, false), false);
+            break;
+        case Inst::SyncToNegatedSetAndContinue:
+            EmitSync(CharPredicate(static_cast<const SyncToSetAndContinueInst<true>*>(inst)->set, true), false);
+            break;
+        case Inst::SyncToCharAndConsume:
+            EmitSync(CharPredicate(&static_cast<const SyncToCharAndConsumeInst*>(inst)->c, 1), true);
+            break;
+        case Inst::SyncToChar2SetAndConsume:
+            EmitSync(CharPredicate(static_cast<const SyncToChar2SetAndConsumeInst*>(inst)->cs, 2), true);
+            break;
+        case Inst::SyncToSetAndConsume:
+            EmitSync(CharPredicate(static_cast<const SyncToSetAndConsumeInst<false>*>(inst)->set, false), true);
+            break;
+        case Inst::SyncToNegatedSetAndConsume:
+            EmitSync(CharPredicate(static_cast<const SyncToSetAndConsumeInst<true>*>(inst)->set, true), true);
+            break;
+
+        case Inst::BeginDefineGroup:
+            // mov [group.offset], r8d
+            EmitRegMem(0x89, InputOffsetReg, GroupInfosReg, RegNone, 0, GroupOffsetDisp(static_cast<const BeginDefineGroupInst*>(inst)->groupId));
+            break;
+
+        case Inst::EndDefineGroup:
+        {
+            // mov eax, r8d; sub eax, [group.offset]; mov [group.length], eax
+            const int groupId = static_cast<const EndDefineGroupInst*>(inst)->groupId;
+            EmitRegReg(0x89, InputOffsetReg, RegRAX);
+            EmitRegMem(0x2b, RegRAX, GroupInfosReg, RegNone, 0, GroupOffsetDisp(groupId));
+            EmitRegMem(0x89, RegRAX, GroupInfosReg, RegNone, 0, GroupLengthDisp(groupId));
+            break;
+        }
+
+        case Inst::DefineGroupFixed:
+        {
+            // mov eax, r8d; sub eax, length; mov [group.offset], eax; mov [group.length], length
+            const auto actualInst = static_cast<const DefineGroupFixedInst*>(inst);
+            EmitRegReg(0x89, InputOffsetReg, RegRAX);
+            EmitRegImm(5 /* sub */, RegRAX, actualInst->length);
+            EmitRegMem(0x89, RegRAX, GroupInfosReg, RegNone, 0, GroupOffsetDisp(actualInst->groupId));
+            EmitMovMemImm(GroupInfosReg, GroupLengthDisp(actualInst->groupId), actualInst->length);
+            break;
+        }
+
+        case Inst::ChompCharStar:
+            EmitChomp(CharPredicate(&static_cast<const ChompCharInst<ChompMode::Star>*>(inst)->c, 1), ChompMode::Star, -1);
+            break;
+        case Inst::ChompCharPlus:
+            EmitChomp(CharPredicate(&static_cast<const ChompCharInst<ChompMode::Plus>*>(inst)->c, 1), ChompMode::Plus, -1);
+            break;
+        case Inst::ChompSetStar:
+            EmitChomp(CharPredicate(static_cast<const ChompSetInst<ChompMode::Star>*>(inst)->set, false), ChompMode::Star, -1);
+            break;
+        case Inst::ChompSetPlus:
+            EmitChomp(CharPredicate(static_cast<const ChompSetInst<ChompMode::Plus>*>(inst)->set, false), ChompMode::Plus, -1);
+            break;
+
+        case Inst::ChompCharGroupStar:
+        {
+            const auto actualInst = static_cast<const ChompCharGroupInst<ChompMode::Star>*>(inst);
+            EmitChomp(CharPredicate(&actualInst->c, 1), ChompMode::Star, actualInst->groupId);
+            break;
+        }
+        case Inst::ChompCharGroupPlus:
+        {
+            const auto actualInst = static_cast<const ChompCharGroupInst<ChompMode::Plus>*>(inst);
+            EmitChomp(CharPredicate(&actualInst->c, 1), ChompMode::Plus, actualInst->groupId);
+            break;
+        }
+        case Inst::ChompSetGroupStar:
+        {
+            const auto actualInst = static_cast<const ChompSetGroupInst<ChompMode::Star>*>(inst);
+            EmitChomp(CharPredicate(actualInst->set, false), ChompMode::Star, actualInst->groupId);
+            break;
+        }
+        case Inst::ChompSetGroupPlus:
+        {
+            const auto actualInst = static_cast<const ChompSetGroupInst<ChompMode::Plus>*>(inst);
+            EmitChomp(CharPredicate(actualInst->set, false), ChompMode::Plus, actualInst->groupId);
+            break;
+        }
+
+        case Inst::ChompCharBounded:
+        {
+            const auto actualInst = static_cast<const ChompCharBoundedInst*>(inst);
+            EmitChompBounded(CharPredicate(&actualInst->c, 1), actualInst->repeats);
+            break;
+        }
+        case Inst::ChompSetBounded:
+        {
+            const auto actualInst = static_cast<const ChompSetBoundedInst*>(inst);
+            EmitChompBounded(CharPredicate(actualInst->set, false), actualInst->repeats);
+            break;
+        }
+
+        default:
+            Assert(false);
+            __assume(false);
+        }
+    }
+
+    void NativeCodeCompiler::EmitBody()
+    {
+        const bool tryLaterOffsets = program->tag == Program::InstructionsTag;
+        const uint8* const insts = program->rep.insts.insts;
+        const CharCount instsLen = program->rep.insts.instsLen;
+
+        failLabel = NewLabel();
+        noMatchLabel = NewLabel();
+        succLabel = NewLabel();
+        const int attemptLabel = NewLabel();
+        const int returnLabel = NewLabel();
+
+        instLabels = AnewArray(allocator, int, instsLen);
+        for (CharCount i = 0; i < instsLen; i++)
+            instLabels[i] = -1;
+        for (CharCount offset = 0; offset < instsLen; offset += (CharCount)InstSize(reinterpret_cast<const Inst*>(insts + offset)))
+            instLabels[offset] = NewLabel();
+
+        // Move the arguments into place. There is no prologue: the code doesn't touch the stack pointer or any
+        // callee-saved register.
+#ifdef _WIN32
+        // input in rcx, inputLength in edx, offset in r8d and groupInfos in r9
+        EmitRegReg(0x89, RegRCX, InputReg, true);
+        EmitRegReg(0x89, RegR8, MatchStartReg);
+        CompileAssert(InputLengthReg == RegRDX && GroupInfosReg == RegR9);
+#else
+        // input in rdi, inputLength in esi, offset in edx and groupInfos in rcx
+        EmitRegReg(0x89, RegRDI, InputReg, true);
+        EmitRegReg(0x89, RegRDX, MatchStartReg);
+        EmitRegReg(0x89, RegRSI, InputLengthReg);
+        EmitRegReg(0x89, RegRCX, GroupInfosReg, true);
+#endif
+
+        // Each attempt starts with all groups undefined and the input offset at the start offset
+        BindLabel(attemptLabel);
+        for (int groupId = 0; groupId < program->numGroups; groupId++)
+            EmitMovMemImm(GroupInfosReg, GroupLengthDisp(groupId), (uint32)CharCountFlag);
+        EmitRegReg(0x89, MatchStartReg, InputOffsetReg);
+
+        for (CharCount offset = 0; offset < instsLen;)
+        {
+            const Inst* const inst = reinterpret_cast<const Inst*>(insts + offset);
+            BindLabel(instLabels[offset]);
+            EmitInst(inst);
+            offset += (CharCount)InstSize(inst);
+        }
+        EmitJump(failLabel);
+
+        // The attempt failed: try the next start offset, if any (sync instructions may have moved the start offset on)
+        BindLabel(failLabel);
+        if (tryLaterOffsets)
+        {
+            EmitRegReg(0xff, 0 /* inc */, MatchStartReg);
+            EmitRegReg(0x39, InputLengthReg, MatchStartReg);
+            EmitJumpIf(CondBE, attemptLabel);
+        }
+
+        BindLabel(noMatchLabel);
+        EmitMovMemImm(GroupInfosReg, GroupLengthDisp(0), (uint32)CharCountFlag);
+        EmitMovRegImm(RegRAX, 0);
+        EmitJump(returnLabel);
+
+        // Success: group 0 is the match
+        BindLabel(succLabel);
+        EmitRegMem(0x89, MatchStartReg, GroupInfosReg, RegNone, 0, GroupOffsetDisp(0));
+        EmitRegReg(0x89, InputOffsetReg, RegRAX);
+        EmitRegReg(0x29, MatchStartReg, RegRAX);
+        EmitRegMem(0x89, RegRAX, GroupInfosReg, RegNone, 0, GroupLengthDisp(0));
+        EmitMovRegImm(RegRAX, 1);
+
+        BindLabel(returnLabel);
+        Emit(0xc3);
+
+        // Resolve the branches
+        for (int i = 0; i < fixups.Count(); i++)
+        {
+            const Fixup& fixup = fixups.Item(i);
+            const int target = labelOffsets.Item(fixup.label);
+            Assert(target >= 0);
+            const uint32 rel = (uint32)(target - (fixup.codeOffset + 4));
+            for (int j = 0; j < 4; j++)
+                code.Item(fixup.codeOffset + j, (uint8)(rel >> (j * 8)));
+        }
+    }
+
+    NativeCode* NativeCodeCompiler::Commit(Js::ScriptContext* scriptContext)
+    {
+        ThreadContext* const threadContext = scriptContext->GetThreadContext();
+        CustomHeap::Heap* const heap = threadContext->GetRegexCodeHeap();
+        const size_t codeSize = code.Count();
+
+        NativeCode* const nativeCode = RecyclerNewLeaf(scriptContext->GetRecycler(), NativeCode, threadContext);
+
+        // No pdata or xdata: the code is a leaf function that never moves the stack pointer or saves a register, so it is
+        // unwound from its return address alone
+        bool isAllJITCodeInPreReservedRegion = true;
+        CustomHeap::Allocation* const allocation = heap->Alloc(codeSize, 0, 0, false, false, &isAllJITCodeInPreReservedRegion);
+        if (allocation == nullptr)
+            return nullptr;
+#if DBG
+        allocation->isAllocationUsed = true;
+#endif
+
+        if (!heap->ProtectAllocationWithExecuteReadWrite(allocation))
+        {
+            heap->Free(allocation);
+            return nullptr;
+        }
+        js_memcpy_s(allocation->address, allocation->size, code.GetBuffer(), codeSize);
+        if (!heap->ProtectAllocationWithExecuteReadOnly(allocation))
+        {
+            heap->Free(allocation);
+            return nullptr;
+        }
+        FlushInstructionCache(GetCurrentProcess(), allocation->address, codeSize);
+
+        nativeCode->allocation = allocation;
+        nativeCode->codeSize = codeSize;
+        threadContext->SetValidCallTargetForCFG(allocation->address);
+        nativeCode->entryPoint = reinterpret_cast<NativeCode::EntryPoint>(allocation->address);
+        return nativeCode;
+    }
+
+    NativeCode* NativeCodeCompiler::Compile(Js::ScriptContext* scriptContext, Program* program)
+    {
+        if (program->tag != Program::InstructionsTag &&
+            program->tag != Program::BOIInstructionsTag &&
+            program->tag != Program::BOIInstructionsForStickyFlagTag)
+        {
+            return nullptr;
+        }
+        if (program->automaton != nullptr || program->numGroups > MaxGroups || program->rep.insts.instsLen > MaxInstsLen)
+            return nullptr;
+
+        const uint8* const insts = program->rep.insts.insts;
+        const CharCount instsLen = program->rep.insts.instsLen;
+        for (CharCount offset = 0; offset < instsLen; offset += (CharCount)InstSize(reinterpret_cast<const Inst*>(insts + offset)))
+        {
+            if (!IsSupported(reinterpret_cast<const Inst*>(insts + offset)))
+                return nullptr;
+        }
+
+        NativeCode* nativeCode = nullptr;
+        BEGIN_TEMP_ALLOCATOR(allocator, scriptContext, _u("UnifiedRegexNativeCode"));
+        {
+            NativeCodeCompiler compiler(allocator, program);
+            compiler.EmitBody();
+            if (!compiler.hasBadLabel && !compiler.hasLargeSet)
+                nativeCode = compiler.Commit(scriptContext);
+        }
+        END_TEMP_ALLOCATOR(allocator, scriptContext);
+        return nativeCode;
+    }
+}
+
+#endif
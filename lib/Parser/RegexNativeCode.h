@@ -0,0 +1,197 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+//
+// Machine code for hot regex programs.
+//
+// Programs whose instructions never push a continuation (literals, characters, sets, switches, chomps, syncs, groups and
+// the built-in assertions) are compiled to x64 code after they have been run a few times. The code keeps the interpreter's
+// state in registers and follows the instructions one for one, so it finds the same match and captures. It does not depend
+// on the JIT: the code lives in a CustomHeap of the thread context, so interpreter-only builds get it too. The code is a
+// leaf function that only uses volatile registers and never moves the stack pointer, so it needs no unwind data.
+#pragma once
+
+#if ENABLE_REGEX_NATIVE_CODEGEN
+
+namespace UnifiedRegex
+{
+    // ----------------------------------------------------------------------
+    // NativeCode
+    // ----------------------------------------------------------------------
+
+    class NativeCode
+    {
+        friend class NativeCodeCompiler;
+
+    public:
+        // Same contract as the instruction loop in Matcher::Match: tries each start offset from offset on (only offset itself
+        // if the program is anchored), on success fills in groupInfos, otherwise resets group 0
+        typedef bool (*EntryPoint)(const char16* input, CharCount inputLength, CharCount offset, GroupInfo* groupInfos);
+
+    private:
+        ThreadContext* threadContext;
+        CustomHeap::Allocation* allocation;
+        EntryPoint entryPoint;
+        size_t codeSize;
+
+        NativeCode(ThreadContext* threadContext);
+
+    public:
+        inline bool Match(const char16* const input, const CharCount inputLength, const CharCount offset, GroupInfo* groupInfos) const
+        {
+            return entryPoint(input, inputLength, offset, groupInfos);
+        }
+
+        void Free();
+
+#if ENABLE_REGEX_CONFIG_OPTIONS
+        void Print(DebugWriter* w) const;
+#endif
+    };
+
+    // ----------------------------------------------------------------------
+    // NativeCodeCompiler
+    // ----------------------------------------------------------------------
+
+    class NativeCodeCompiler : private Chars<char16>
+    {
+    private:
+        enum RegNum : uint8
+        {
+            RegRAX, RegRCX, RegRDX, RegRBX, RegRSP, RegRBP, RegRSI, RegRDI,
+            RegR8, RegR9, RegR10, RegR11, RegR12, RegR13, RegR14, RegR15,
+            RegNone = 0xff
+        };
+
+        enum CondCode : uint8
+        {
+            CondB = 0x2,    // unsigned <, carry set
+            CondAE = 0x3,   // unsigned >=, carry clear
+            CondE = 0x4,
+            CondNE = 0x5,
+            CondBE = 0x6,
+            CondA = 0x7
+        };
+
+        // The matcher state lives in volatile registers, leaving eax and ecx for the character tests
+        static const RegNum InputReg = RegR10;          // const Char* input
+        static const RegNum InputLengthReg = RegRDX;    // CharCount inputLength
+        static const RegNum InputOffsetReg = RegR8;     // CharCount inputOffset
+        static const RegNum MatchStartReg = RegR11;     // CharCount matchStart
+        static const RegNum GroupInfosReg = RegR9;      // GroupInfo* groupInfos
+
+        // The two locals used by chomps live in the caller's home space for the arguments on Windows, and in the red
+        // zone below the stack pointer elsewhere
+#ifdef _WIN32
+        static const int ChompStartLocal = 8;
+        static const int ChompEndLocal = 16;
+#else
+        static const int ChompStartLocal = -8;
+        static const int ChompEndLocal = -16;
+#endif
+
+        // Programs with more instruction bytes or groups than these, or with sets having more ranges of characters past
+        // the first 256 than this, stay in the interpreter
+        static const CharCount MaxInstsLen = 16 * 1024;
+        static const int MaxGroups = 64;
+        static const int MaxNonDirectSetRanges = 16;
+
+        struct Fixup
+        {
+            int codeOffset;     // of the rel32 to patch
+            int label;
+        };
+
+        // Characters matched by a single-character instruction: one of numChars characters, or the (negated) set
+        struct CharPredicate
+        {
+            const Char* cs;
+            int numChars;
+            const RuntimeCharSet<Char>* set;
+            bool isNegation;
+
+            CharPredicate(const Char* cs, int numChars) : cs(cs), numChars(numChars), set(nullptr), isNegation(false) {}
+            CharPredicate(const RuntimeCharSet<Char>& set, bool isNegation) : cs(nullptr), numChars(0), set(&set), isNegation(isNegation) {}
+        };
+
+        ArenaAllocator* allocator;
+        Program* program;
+        JsUtil::List<uint8, ArenaAllocator> code;
+        JsUtil::List<int, ArenaAllocator> labelOffsets;     // -1 until bound
+        JsUtil::List<Fixup, ArenaAllocator> fixups;
+        int* instLabels;        // instruction byte offset -> label, -1 between instructions
+        int failLabel;          // this attempt failed, try the next start offset if any
+        int noMatchLabel;       // no later start offset can match either
+        int succLabel;
+        bool hasBadLabel;       // a jump target is not the start of an instruction
+        bool hasLargeSet;       // a set has too many ranges to test inline
+
+        NativeCodeCompiler(ArenaAllocator* allocator, Program* program);
+
+        static size_t InstSize(const Inst* inst);
+        static bool IsSupported(const Inst* inst);
+
+        // Encoding. Two-byte opcodes are given with their 0x0F escape in the high byte.
+        void Emit(uint8 b);
+        void Emit16(uint16 v);
+        void Emit32(uint32 v);
+        void Emit64(uint64 v);
+        void EmitRex(bool w, int reg, int index, int base);
+        void EmitOpcode(uint16 opcode);
+        void EmitModRMMem(int reg, int base, int index, int scaleLog, int32 disp);
+        void EmitRegReg(uint16 opcode, int reg, int rm, bool w = false);
+        void EmitRegMem(uint16 opcode, int reg, int base, int index, int scaleLog, int32 disp, bool w = false);
+        void EmitRegImm(uint8 ext, int rm, uint32 imm);
+        void EmitRegImm8(uint8 ext, int rm, uint8 imm);
+        void EmitMovRegImm(int reg, uint32 imm);
+        void EmitMovRegImm64(int reg, uint64 imm);
+        void EmitMovMemImm(int base, int32 disp, uint32 imm);
+
+        // Labels and branches
+        int NewLabel();
+        void BindLabel(int label);
+        void EmitRel32(int label);
+        void EmitJump(int label);
+        void EmitJumpIf(CondCode cc, int label);
+        int LabelFor(Label target);
+
+        // Matcher state
+        void EmitCmpOffsetToLength();
+        void EmitIncOffset();
+        void EmitAddOffset(CharCount n);
+        void EmitLoadChar(int reg, int charDisp);
+        void EmitCmpRegImm(int reg, uint32 imm);
+        void EmitCheckRemaining(CharCount n);
+        static int32 GroupOffsetDisp(int groupId);
+        static int32 GroupLengthDisp(int groupId);
+
+        // Character tests on ecx; these clobber eax
+        void EmitJumpIfChar(const Char* cs, int numChars, bool jumpIfMatch, int label);
+        void EmitJumpIfSet(const RuntimeCharSet<Char>& set, bool jumpIfIn, int label);
+        void EmitJumpIfNewline(int label);
+        void EmitJumpIfWord(int label);
+        void EmitJumpIfMatches(const CharPredicate& predicate, bool jumpIfMatch, int label);
+
+        // Instructions
+        void EmitConsume(const CharPredicate& predicate);
+        void EmitOptConsume(const CharPredicate& predicate);
+        void EmitMatchOrJump(const CharPredicate& predicate, Label targetLabel, bool consume);
+        void EmitChomp(const CharPredicate& predicate, ChompMode mode, int groupId);
+        void EmitChompBounded(const CharPredicate& predicate, const CountDomain& repeats);
+        void EmitSync(const CharPredicate& predicate, bool consume);
+        template <int n>
+        void EmitSwitch(const SwitchMixin<n>& switchMixin, bool consume);
+        void EmitMatchLiteral(const Char* literal, CharCount length);
+        void EmitInst(const Inst* inst);
+        void EmitBody();
+
+        NativeCode* Commit(Js::ScriptContext* scriptContext);
+
+    public:
+        // Null if the program has instructions that may backtrack, or the code can't be allocated
+        static NativeCode* Compile(Js::ScriptContext* scriptContext, Program* program);
+    };
+}
+
+#endif
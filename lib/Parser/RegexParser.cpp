@@ -2899,7 +2899,32 @@ namespace UnifiedRegex
             return nullptr;
         }
 
-        RegexPattern* pattern = RegexPattern::New(this->scriptContext, program, true);
+        // Another script context of this thread may already have compiled the same literal, otherwise compile it so that
+        // the others can use it too
+        ThreadContext* threadContext = this->scriptContext->GetThreadContext();
+        ArenaAllocator* rtAllocator = this->scriptContext->RegexAllocator();
+        SharedProgram* sharedProgram = nullptr;
+        RegexPattern* pattern;
+        if (threadContext->IsSharingRegexPrograms())
+        {
+            const RegexKey key(program->source, program->sourceLen, flags);
+            sharedProgram = threadContext->GetSharedRegexProgram(key);
+            if (sharedProgram)
+            {
+#ifdef PROFILE_EXEC
+                this->scriptContext->ProfileEnd(Js::RegexCompilePhase);
+#endif
+                return RegexPattern::New(this->scriptContext, sharedProgram, true);
+            }
+
+            rtAllocator = threadContext->GetRegexAllocator();
+            sharedProgram = SharedProgram::New(this->scriptContext->GetRecycler(), program, rtAllocator);
+            pattern = RegexPattern::New(this->scriptContext, sharedProgram, true);
+        }
+        else
+        {
+            pattern = RegexPattern::New(this->scriptContext, program, true);
+        }
 
 #if ENABLE_REGEX_CONFIG_OPTIONS
         RegexStats* stats = 0;
@@ -2919,7 +2944,6 @@ namespace UnifiedRegex
             this->scriptContext->GetRegexStatsDatabase()->BeginProfile();
 #endif
 
-        ArenaAllocator* rtAllocator = this->scriptContext->RegexAllocator();
         Compiler::Compile
             ( this->scriptContext
               , ctAllocator
@@ -2940,6 +2964,11 @@ namespace UnifiedRegex
             this->scriptContext->GetRegexStatsDatabase()->EndProfile(stats, RegexStats::Compile);
 #endif
 
+        if (sharedProgram && pattern->CanShareProgram())
+        {
+            threadContext->AddSharedRegexProgram(RegexKey(program->source, program->sourceLen, flags), sharedProgram);
+        }
+
 #ifdef PROFILE_EXEC
         this->scriptContext->ProfileEnd(Js::RegexCompilePhase);
 #endif
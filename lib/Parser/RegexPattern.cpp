@@ -6,8 +6,31 @@
 
 namespace UnifiedRegex
 {
+    SharedProgram::SharedProgram(Program *const program, ArenaAllocator *const rtAllocator)
+        : program(program), rtAllocator(rtAllocator)
+    {
+    }
+
+    SharedProgram *SharedProgram::New(Recycler *recycler, Program *program, ArenaAllocator *rtAllocator)
+    {
+        return RecyclerNewFinalized(recycler, SharedProgram, program, rtAllocator);
+    }
+
+    void SharedProgram::Finalize(bool isShutdown)
+    {
+        // On shutdown the allocator goes away with the thread context
+        if(isShutdown)
+            return;
+
+        program->FreeBody(rtAllocator);
+    }
+
+    void SharedProgram::Dispose(bool isShutdown)
+    {
+    }
+
     RegexPattern::RegexPattern(Js::JavascriptLibrary *const library, Program* program, bool isLiteral)
-        : library(library), isLiteral(isLiteral), isShallowClone(false)
+        : library(library), sharedProgram(nullptr), isLiteral(isLiteral), isShallowClone(false)
     {
         rep.unified.program = program;
         rep.unified.matcher = 0;
@@ -24,6 +47,14 @@ namespace UnifiedRegex
                 program,
                 isLiteral);
     }
+
+    RegexPattern *RegexPattern::New(Js::ScriptContext *scriptContext, SharedProgram* sharedProgram, bool isLiteral)
+    {
+        RegexPattern *result = New(scriptContext, sharedProgram->program, isLiteral);
+        result->sharedProgram = sharedProgram;
+        return result;
+    }
+
     void RegexPattern::Finalize(bool isShutdown)
     {
         if(isShutdown)
@@ -47,7 +78,7 @@ namespace UnifiedRegex
         }
 #endif
 
-        if(isShallowClone)
+        if(isShallowClone || sharedProgram)
             return;
 
         rep.unified.program->FreeBody(scriptContext->RegexAllocator());
@@ -124,6 +155,7 @@ namespace UnifiedRegex
         RegexPattern *result = UnifiedRegex::RegexPattern::New(scriptContext, rep.unified.program, isLiteral);
         Matcher *matcherClone = rep.unified.matcher ? rep.unified.matcher->CloneToScriptContext(scriptContext, result) : nullptr;
         result->rep.unified.matcher = matcherClone;
+        result->sharedProgram = sharedProgram;
         result->isShallowClone = true;
         return result;
     }
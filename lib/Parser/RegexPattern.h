@@ -15,6 +15,23 @@ namespace UnifiedRegex
     class Matcher;
     struct TrigramInfo;
 
+    // A program compiled into the thread context's regex allocator instead of a script context's, so that the patterns of
+    // every script context in the thread can use it. Owns the program's body, which is freed once neither a pattern nor the
+    // thread context's cache of shared programs refers to this object any longer.
+    struct SharedProgram : FinalizableObject
+    {
+        Program *const program;
+        ArenaAllocator *const rtAllocator;
+
+        SharedProgram(Program *const program, ArenaAllocator *const rtAllocator);
+
+        static SharedProgram *New(Recycler *recycler, Program *program, ArenaAllocator *rtAllocator);
+
+        virtual void Finalize(bool isShutdown) override;
+        virtual void Dispose(bool isShutdown) override;
+        virtual void Mark(Recycler *recycler) override { AssertMsg(false, "Mark called on object that isn't TrackableObject"); }
+    };
+
     struct RegexPattern : FinalizableObject
     {
 
@@ -27,6 +44,9 @@ namespace UnifiedRegex
 
         Js::JavascriptLibrary *const library;
 
+        // Non-null if the program is shared with other patterns; keeps it alive, and the pattern does not own it
+        SharedProgram *sharedProgram;
+
         bool isLiteral : 1;
         bool isShallowClone : 1;
 
@@ -38,6 +58,7 @@ namespace UnifiedRegex
         RegexPattern(Js::JavascriptLibrary *const library, Program* program, bool isLiteral);
 
         static RegexPattern *New(Js::ScriptContext *scriptContext, Program* program, bool isLiteral);
+        static RegexPattern *New(Js::ScriptContext *scriptContext, SharedProgram* sharedProgram, bool isLiteral);
 
         virtual void Finalize(bool isShutdown) override;
         virtual void Dispose(bool isShutdown) override;
@@ -61,5 +82,9 @@ namespace UnifiedRegex
         void Print(DebugWriter* w);
 #endif
         RegexPattern *CopyToScriptContext(Js::ScriptContext *scriptContext);
+
+        // Trigram info belongs to the pattern and is registered with the script context, so a program that needs it can't be
+        // shared
+        inline bool CanShareProgram() const { return rep.unified.trigramInfo == 0; }
     };
 }
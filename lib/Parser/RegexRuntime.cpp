@@ -4239,6 +4239,7 @@ namespace UnifiedRegex
         , groupInfos(nullptr)
         , loopInfos(nullptr)
         , literalNextSyncInputOffsets(nullptr)
+        , automatonMatcher(nullptr)
         , recycler(scriptContext->GetRecycler())
         , previousQcTime(0)
 #if ENABLE_REGEX_CONFIG_OPTIONS
@@ -4755,6 +4756,37 @@ namespace UnifiedRegex
         return false;
     }
 
+    inline bool Matcher::MatchAutomaton(const Char* const input, const CharCount inputLength, CharCount offset)
+    {
+        if (automatonMatcher == nullptr)
+        {
+            automatonMatcher = AutomatonMatcher::New(recycler, standardChars, program->automaton);
+        }
+        return automatonMatcher->Match(input, inputLength, offset, groupInfos, program->numGroups);
+    }
+
+#if ENABLE_REGEX_NATIVE_CODEGEN
+    inline bool Matcher::HasNativeCode(Js::ScriptContext* scriptContext)
+    {
+#if ENABLE_REGEX_CONFIG_OPTIONS
+        // Tracing and statistics are only collected by the interpreter
+        if (w != 0 || stats != 0)
+            return false;
+#endif
+
+        // The matcher only sees the program as const, but compiling it is a change to the pattern
+        Program *const mutableProgram = pattern->rep.unified.program;
+        Assert(mutableProgram == program);
+        if (mutableProgram->nativeCode == nullptr)
+        {
+            if (mutableProgram->runsBeforeNativeCode == 0 || --mutableProgram->runsBeforeNativeCode != 0)
+                return false;
+            mutableProgram->nativeCode = NativeCodeCompiler::Compile(scriptContext, mutableProgram);
+        }
+        return mutableProgram->nativeCode != nullptr;
+    }
+#endif
+
     bool Matcher::Match
         ( const Char* const input
         , const CharCount inputLength
@@ -4796,6 +4828,22 @@ namespace UnifiedRegex
             // fall through
 
         case Program::InstructionsTag:
+            if (prog->automaton != nullptr)
+            {
+                res = MatchAutomaton(input, inputLength, offset);
+                break;
+            }
+
+#if ENABLE_REGEX_NATIVE_CODEGEN
+            // The machine code tries later start offsets itself unless the program is anchored
+            if (HasNativeCode(scriptContext))
+            {
+                Assert(loopMatchHere == (prog->tag == Program::InstructionsTag));
+                res = prog->nativeCode->Match(input, inputLength, offset, groupInfos);
+                break;
+            }
+#endif
+
             {
                 previousQcTime = 0;
                 uint qcTicks = 0;
@@ -4937,6 +4985,11 @@ namespace UnifiedRegex
         , flags(flags)
         , numGroups(0)
         , numLoops(0)
+        , automaton(nullptr)
+#if ENABLE_REGEX_NATIVE_CODEGEN
+        , nativeCode(nullptr)
+        , runsBeforeNativeCode(REGEX_CONFIG_FLAG(RegexNativeCode) ? REGEX_CONFIG_FLAG(RegexNativeCodeThreshold) : 0)
+#endif
     {
         tag = InstructionsTag;
         rep.insts.insts = 0;
@@ -4983,6 +5036,17 @@ namespace UnifiedRegex
 
     void Program::FreeBody(ArenaAllocator* rtAllocator)
     {
+        if(automaton)
+            automaton->FreeBody(rtAllocator);
+
+#if ENABLE_REGEX_NATIVE_CODEGEN
+        if(nativeCode)
+        {
+            nativeCode->Free();
+            nativeCode = nullptr;
+        }
+#endif
+
         if(tag != InstructionsTag || !rep.insts.insts)
             return;
 
@@ -5054,6 +5118,12 @@ namespace UnifiedRegex
                     curr += ((Inst*)curr)->Print(w, (Label)(isBaselineMode ? i++ : curr - rep.insts.insts), rep.insts.litbuf);
                 w->Unindent();
                 w->PrintEOL(_u("}"));
+                if (automaton)
+                    automaton->Print(w);
+#if ENABLE_REGEX_NATIVE_CODEGEN
+                if (nativeCode)
+                    nativeCode->Print(w);
+#endif
             }
             break;
         case SingleCharTag:
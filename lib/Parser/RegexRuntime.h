@@ -17,6 +17,11 @@ namespace UnifiedRegex
     class ContStack;
     class AssertionStack;
     class OctoquadMatcher;
+    class Automaton;
+    class AutomatonMatcher;
+#if ENABLE_REGEX_NATIVE_CODEGEN
+    class NativeCode;
+#endif
 
     enum class ChompMode : uint8
     {
@@ -31,6 +36,10 @@ namespace UnifiedRegex
     struct Program : private Chars<char16>
     {
         friend class Compiler;
+        friend class AutomatonCompiler;
+#if ENABLE_REGEX_NATIVE_CODEGEN
+        friend class NativeCodeCompiler;
+#endif
         friend struct MatchLiteralNode;
         friend struct AltNode;
         friend class Matcher;
@@ -134,6 +143,17 @@ namespace UnifiedRegex
             Other other;
         } rep;
 
+        // Backtracking-free matcher for the same pattern, used instead of the instructions if present.
+        // Only for the instruction tags. In recycler, owned by program, may be null.
+        Automaton* automaton;
+
+#if ENABLE_REGEX_NATIVE_CODEGEN
+        // Machine code for the instructions, used instead of them once present. In recycler, owned by program, may be null.
+        NativeCode* nativeCode;
+        // Matches left in the interpreter before the instructions are compiled to machine code, 0 if they never will be
+        uint runsBeforeNativeCode;
+#endif
+
     public:
         Program(RegexFlags flags);
         static Program *New(Recycler *recycler, RegexFlags flags);
@@ -1718,6 +1738,9 @@ namespace UnifiedRegex
         // for "foo" after the first time.
         CharCount* literalNextSyncInputOffsets;
 
+        // Created on first match if the program has an automaton
+        AutomatonMatcher* automatonMatcher;
+
         Recycler* recycler;
 
         uint previousQcTime;
@@ -1848,6 +1871,14 @@ namespace UnifiedRegex
         // Specialized matcher for regex ^literal
         inline bool MatchBOILiteral2(const Char * const input, const CharCount inputLength, CharCount offset, DWORD literal2);
 
+        // Backtracking-free matcher for patterns compiled to an automaton
+        inline bool MatchAutomaton(const Char* const input, const CharCount inputLength, CharCount offset);
+
+#if ENABLE_REGEX_NATIVE_CODEGEN
+        // Compiles the program to machine code once it has been run often enough. True if there is machine code to run.
+        inline bool HasNativeCode(Js::ScriptContext* scriptContext);
+#endif
+
         void SaveInnerGroups(const int fromGroupId, const int toGroupId, const bool reset, const Char *const input, ContStack &contStack);
         void DoSaveInnerGroups(const int fromGroupId, const int toGroupId, const bool reset, const Char *const input, ContStack &contStack);
         void SaveInnerGroups_AllUndefined(const int fromGroupId, const int toGroupId, const Char *const input, ContStack &contStack);
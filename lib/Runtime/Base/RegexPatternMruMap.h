@@ -7,6 +7,7 @@
 namespace Js
 {
     typedef JsUtil::MruDictionary<UnifiedRegex::RegexKey, UnifiedRegex::RegexPattern*> RegexPatternMruMap;
+    typedef JsUtil::MruDictionary<UnifiedRegex::RegexKey, UnifiedRegex::SharedProgram*> SharedRegexProgramMruMap;
 };
 
 namespace JsUtil
@@ -21,4 +22,14 @@ namespace JsUtil
         }
     };
 
+    template <>
+    class ValueEntry<Js::SharedRegexProgramMruMap::MruDictionaryData>: public BaseValueEntry<Js::SharedRegexProgramMruMap::MruDictionaryData>
+    {
+    public:
+        void Clear()
+        {
+            this->value = 0;
+        }
+    };
+
 };
@@ -4179,6 +4179,13 @@ if (!sourceList)
 
     void ScriptContext::ClearScriptContextCaches()
     {
+        // Drop the JSON.parse type transition cache so that it doesn't keep types alive. A context that only
+        // parses JSON through JsParseJsonUtf8 never uses an inline cache, so don't wait for the check below.
+        if (!this->isScriptContextActuallyClosed && this->cache != nullptr)
+        {
+            this->cache->jsonTypeCacheList = nullptr;
+        }
+
         // Prevent reentrancy for the following work, which is not required to be done on every call to this function including
         // reentrant calls
         if (this->isPerformingNonreentrantWork || !this->hasUsedInlineCache)
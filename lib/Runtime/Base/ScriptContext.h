@@ -374,6 +374,7 @@ namespace Js
         SRCINFO* noContextGlobalSourceInfo;
         SRCINFO const ** moduleSrcInfo;
         BuiltInLibraryFunctionMap* builtInLibraryFunctions;
+        JSON::JsonTypeCacheList* jsonTypeCacheList;
     };
 
     class ScriptContext : public ScriptContextBase, public ScriptContextInfo
@@ -747,12 +748,14 @@ private:
         ScriptConfiguration config;
         CharClassifier *charClassifier;
 
+#if ENABLE_BACKGROUND_PARSING
+        BackgroundParser *backgroundParser;
+#endif
         // DisableJIT-TODO: Switch this to Dynamic thunk ifdef instead
 #if ENABLE_NATIVE_CODEGEN
 #if DYNAMIC_INTERPRETER_THUNK
         InterpreterThunkEmitter* interpreterThunkEmitter;
 #endif
-        BackgroundParser *backgroundParser;
 #ifdef ASMJS_PLAT
         InterpreterThunkEmitter* asmJsInterpreterThunkEmitter;
         AsmJsCodeGenerator* asmJsCodeGenerator;
@@ -1345,6 +1348,8 @@ private:
         void SetDisposeDisposeByFaultInjectionEventHandler(EventHandler eventHandler);
 #endif
         EnumeratedObjectCache* GetEnumeratedObjectCache() { return &(cache->enumObjCache); }
+        JSON::JsonTypeCacheList* GetJsonTypeCacheList() const { return cache->jsonTypeCacheList; }
+        void SetJsonTypeCacheList(JSON::JsonTypeCacheList* typeCacheList) { cache->jsonTypeCacheList = typeCacheList; }
         PropertyString* TryGetPropertyString(PropertyId propertyId);
         PropertyString* GetPropertyString(PropertyId propertyId);
         void InvalidatePropertyStringCache(PropertyId propertyId, Type* type);
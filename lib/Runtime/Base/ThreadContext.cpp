@@ -116,9 +116,7 @@ ThreadContext::ThreadContext(AllocationPolicyManager * allocationPolicyManager,
     recycler(nullptr),
     hasCollectionCallBack(false),
     callDispose(true),
-#if ENABLE_NATIVE_CODEGEN
     jobProcessor(nullptr),
-#endif
     interruptPoller(nullptr),
     expirableCollectModeGcCount(-1),
     expirableObjectList(nullptr),
@@ -147,6 +145,7 @@ ThreadContext::ThreadContext(AllocationPolicyManager * allocationPolicyManager,
     sourceCodeSize(0),
     nativeCodeSize(0),
     threadAlloc(_u("TC"), GetPageAllocator(), Js::Throw::OutOfMemory),
+    regexAllocator(_u("TC-Regex"), GetPageAllocator(), Js::Throw::OutOfMemory),
     inlineCacheThreadInfoAllocator(_u("TC-InlineCacheInfo"), GetPageAllocator(), Js::Throw::OutOfMemory),
     isInstInlineCacheThreadInfoAllocator(_u("TC-IsInstInlineCacheInfo"), GetPageAllocator(), Js::Throw::OutOfMemory),
     equivalentTypeCacheInfoAllocator(_u("TC-EquivalentTypeCacheInfo"), GetPageAllocator(), Js::Throw::OutOfMemory),
@@ -173,6 +172,10 @@ ThreadContext::ThreadContext(AllocationPolicyManager * allocationPolicyManager,
     thunkPageAllocators(allocationPolicyManager, /* allocXData */ false, /* virtualAllocator */ nullptr, GetCurrentProcess()),
 #endif
     codePageAllocators(allocationPolicyManager, ALLOC_XDATA, GetPreReservedVirtualAllocator(), GetCurrentProcess()),
+#endif
+#if ENABLE_REGEX_NATIVE_CODEGEN
+    regexCodePageAllocators(allocationPolicyManager, /* allocXData */ false, /* virtualAllocator */ nullptr, GetCurrentProcess()),
+    regexCodeHeap(&threadAlloc, &regexCodePageAllocators, GetCurrentProcess()),
 #endif
     dynamicObjectEnumeratorCacheMap(&HeapAllocator::Instance, 16),
     //threadContextFlags(ThreadContextFlagNoFlag),
@@ -473,6 +476,8 @@ ThreadContext::~ThreadContext()
             this->recyclableData->symbolRegistrationMap = nullptr;
         }
 
+        this->recyclableData->sharedRegexPrograms = nullptr;
+
         if (this->recyclableData->returnedValueList != nullptr)
         {
             this->recyclableData->returnedValueList->Clear();
@@ -528,20 +533,20 @@ ThreadContext::~ThreadContext()
         HeapDelete(recycler);
     }
 
-#if ENABLE_NATIVE_CODEGEN
     if(jobProcessor)
     {
+#if ENABLE_BACKGROUND_JOB_PROCESSOR
         if(this->bgJit)
         {
             HeapDelete(static_cast<JsUtil::BackgroundJobProcessor *>(jobProcessor));
         }
         else
+#endif
         {
             HeapDelete(static_cast<JsUtil::ForegroundJobProcessor *>(jobProcessor));
         }
         jobProcessor = nullptr;
     }
-#endif
 
     // Do not require all GC callbacks to be revoked, because Trident may not revoke if there
     // is a leak, and we don't want the leak to be masked by an assert
@@ -1375,29 +1380,33 @@ ThreadContext::ForceCleanPropertyMap()
     // No-op now that we no longer use weak refs
 }
 
-#if ENABLE_NATIVE_CODEGEN
+// The job processor is shared by the JIT and the background parser. With the JIT disabled, the BgJit
+// flag still decides whether the jobs run on background threads.
 JsUtil::JobProcessor *
 ThreadContext::GetJobProcessor()
 {
+#if ENABLE_BACKGROUND_JOB_PROCESSOR
     if(bgJit && isOptimizedForManyInstances)
     {
         return ThreadBoundThreadContextManager::GetSharedJobProcessor();
     }
+#endif
 
     if (!jobProcessor)
     {
+#if ENABLE_BACKGROUND_JOB_PROCESSOR
         if(bgJit && !isOptimizedForManyInstances)
         {
             jobProcessor = HeapNew(JsUtil::BackgroundJobProcessor, GetAllocationPolicyManager(), &threadService, false /*disableParallelThreads*/);
         }
         else
+#endif
         {
             jobProcessor = HeapNew(JsUtil::ForegroundJobProcessor);
         }
     }
     return jobProcessor;
 }
-#endif
 
 void
 ThreadContext::RegisterCodeGenRecyclableData(Js::CodeGenRecyclableData *const codeGenRecyclableData)
@@ -2510,6 +2519,12 @@ ThreadContext::PreCollectionCallBack(CollectionFlags flags)
     // script contexts with inline caches
     this->ClearScriptContextCaches();
 
+    // Let the shared regex programs that fell out of the MRU list be collected once no pattern uses them
+    if (this->recyclableData->sharedRegexPrograms != nullptr)
+    {
+        this->recyclableData->sharedRegexPrograms->RemoveRecentlyUnusedItems();
+    }
+
     // Clear up references to types to avoid keep them alive
     this->ClearPrototypeChainEnsuredToHaveOnlyWritableDataPropertiesCaches();
 
@@ -2553,6 +2568,8 @@ ThreadContext::PreSweepCallback()
 
     ClearEquivalentTypeCaches();
 
+    this->megamorphicPropertyCache.ClearUnusedEntries(this->recycler);
+
     this->dynamicObjectEnumeratorCacheMap.Clear();
 }
 
@@ -3668,6 +3685,10 @@ void ThreadContext::InvalidateProtoTypePropertyCaches(const Js::PropertyId prope
 
 void ThreadContext::InternalInvalidateProtoTypePropertyCaches(const Js::PropertyId propertyId)
 {
+    // The megamorphic cache doesn't register its types, so it needs to be invalidated even if no type has a prototype
+    // entry for the property
+    megamorphicPropertyCache.ClearProtoEntries(propertyId);
+
     // Get the hash set of registered types associated with the property ID, invalidate each type in the hash set, and
     // remove the property ID and its hash set from the map
     PropertyIdToTypeHashSetDictionary &typesWithProtoPropertyCache = recyclableData->typesWithProtoPropertyCache;
@@ -3680,6 +3701,8 @@ void ThreadContext::InternalInvalidateProtoTypePropertyCaches(const Js::Property
 
 void ThreadContext::InvalidateAllProtoTypePropertyCaches()
 {
+    megamorphicPropertyCache.ClearAllProtoEntries();
+
     PropertyIdToTypeHashSetDictionary &typesWithProtoPropertyCache = recyclableData->typesWithProtoPropertyCache;
     if (typesWithProtoPropertyCache.Count() > 0)
     {
@@ -3994,6 +4017,44 @@ const Js::PropertyRecord* ThreadContext::AddSymbolToRegistrationMap(const char16
     return propertyRecord;
 }
 
+bool ThreadContext::IsSharingRegexPrograms() const
+{
+#if ENABLE_REGEX_CONFIG_OPTIONS
+    // Debug output and statistics are collected when a regex is compiled, so compile every one
+    if (REGEX_CONFIG_FLAG(RegexDebug) || REGEX_CONFIG_FLAG(RegexProfile) || REGEX_CONFIG_FLAG(RegexTracing))
+    {
+        return false;
+    }
+#endif
+    return REGEX_CONFIG_FLAG(RegexProgramCacheSize) > 0;
+}
+
+UnifiedRegex::SharedProgram* ThreadContext::GetSharedRegexProgram(const UnifiedRegex::RegexKey& key)
+{
+    Assert(IsSharingRegexPrograms());
+
+    UnifiedRegex::SharedProgram* sharedProgram = nullptr;
+    if (this->recyclableData->sharedRegexPrograms != nullptr)
+    {
+        this->recyclableData->sharedRegexPrograms->TryGetValue(key, &sharedProgram);
+    }
+    return sharedProgram;
+}
+
+void ThreadContext::AddSharedRegexProgram(const UnifiedRegex::RegexKey& key, UnifiedRegex::SharedProgram* sharedProgram)
+{
+    Assert(IsSharingRegexPrograms());
+
+    if (this->recyclableData->sharedRegexPrograms == nullptr)
+    {
+        this->EnsureRecycler();
+        this->recyclableData->sharedRegexPrograms = Js::SharedRegexProgramMruMap::New(GetRecycler(), REGEX_CONFIG_FLAG(RegexProgramCacheSize));
+    }
+
+    // The key must refer to the program's copy of the source, which lives as long as the map entry
+    this->recyclableData->sharedRegexPrograms->Add(key, sharedProgram);
+}
+
 void ThreadContext::ClearImplicitCallFlags()
 {
     SetImplicitCallFlags(Js::ImplicitCall_None);
@@ -637,6 +637,9 @@ private:
         // See ES6 (draft 22) 19.4.2.2
         SymbolRegistrationMap* symbolRegistrationMap;
 
+        // Compiled regexes shared by the script contexts of this thread, so that each context doesn't compile its own copy
+        Js::SharedRegexProgramMruMap* sharedRegexPrograms;
+
         // Just holding the reference to the returnedValueList of the stepController. This way that list will not get recycled prematurely.
         Js::ReturnedValueList *returnedValueList;
 
@@ -693,6 +696,8 @@ private:
     Js::InterpreterStackFrame* leafInterpreterFrame;
     const Js::PropertyRecord * propertyNamesDirect[128];
     ArenaAllocator threadAlloc;
+    // Run-time data of the shared regex programs
+    ArenaAllocator regexAllocator;
     ThreadServiceWrapper* threadServiceWrapper;
     uint functionCount;
     uint sourceInfoCount;
@@ -707,8 +712,8 @@ private:
 #endif
 #endif
 
-#if ENABLE_NATIVE_CODEGEN
     JsUtil::JobProcessor *jobProcessor;
+#if ENABLE_NATIVE_CODEGEN
     Js::Var * bailOutRegisterSaveSpace;
     CodeGenNumberThreadAllocator * codeGenNumberThreadAllocator;
     XProcNumberPageSegmentManager * xProcNumberPageSegmentManager;
@@ -717,6 +722,11 @@ private:
 #endif
     CustomHeap::CodePageAllocators codePageAllocators;
 #endif
+#if ENABLE_REGEX_NATIVE_CODEGEN
+    // Machine code for hot regex programs, independent of the JIT
+    CustomHeap::CodePageAllocators regexCodePageAllocators;
+    CustomHeap::Heap regexCodeHeap;
+#endif
 
     RecyclerRootPtr<RecyclableData> recyclableData;
     uint temporaryArenaAllocatorCount;
@@ -833,6 +843,8 @@ private:
     typedef JsUtil::BaseDictionary<Js::DynamicType const *, void *, HeapAllocator, PowerOf2SizePolicy> DynamicObjectEnumeratorCacheMap;
     DynamicObjectEnumeratorCacheMap dynamicObjectEnumeratorCacheMap;
 
+    Js::MegamorphicPropertyCache megamorphicPropertyCache;
+
     ThreadContextWatsonTelemetryBlock localTelemetryBlock;
     ThreadContextWatsonTelemetryBlock * telemetryBlock;
 
@@ -870,6 +882,9 @@ public:
 #endif
     CustomHeap::CodePageAllocators * GetCodePageAllocators() { return &codePageAllocators; }
 #endif // ENABLE_NATIVE_CODEGEN
+#if ENABLE_REGEX_NATIVE_CODEGEN
+    CustomHeap::Heap * GetRegexCodeHeap() { return &regexCodeHeap; }
+#endif
 
     CriticalSection* GetEtwRundownCriticalSection() { return &csEtwRundown; }
 
@@ -1080,12 +1095,11 @@ public:
             JITManager::GetJITManager()->CleanupThreadContext(m_remoteThreadContextInfo);
             m_remoteThreadContextInfo = 0;
         }
-
+#endif
         if (jobProcessor)
         {
             jobProcessor->Close();
         }
-#endif
 #if ENABLE_CONCURRENT_GC
         if (this->recycler != nullptr)
         {
@@ -1098,6 +1112,7 @@ public:
 
     DateTime::HiResTimer * GetHiResTimer() { return &hTimer; }
     ArenaAllocator* GetThreadAlloc() { return &threadAlloc; }
+    ArenaAllocator* GetRegexAllocator() { return &regexAllocator; }
     static CriticalSection * GetCriticalSection() { return &s_csThreadContext; }
 
     ThreadContext(AllocationPolicyManager * allocationPolicyManager = nullptr, JsUtil::ThreadService::ThreadServiceCallback threadServiceCallback = nullptr, bool enableExperimentalFeatures = false);
@@ -1224,9 +1239,9 @@ public:
     Js::ScriptEntryExitRecord * GetScriptEntryExit() const { return entryExitRecord; }
     void RegisterCodeGenRecyclableData(Js::CodeGenRecyclableData *const codeGenRecyclableData);
     void UnregisterCodeGenRecyclableData(Js::CodeGenRecyclableData *const codeGenRecyclableData);
+    JsUtil::JobProcessor *GetJobProcessor();
 #if ENABLE_NATIVE_CODEGEN
     BOOL IsNativeAddress(void * pCodeAddr);
-    JsUtil::JobProcessor *GetJobProcessor();
     Js::Var * GetBailOutRegisterSaveSpace() const { return bailOutRegisterSaveSpace; }
     virtual intptr_t GetBailOutRegisterSaveSpaceAddr() const override { return (intptr_t)bailOutRegisterSaveSpace; }
     CodeGenNumberThreadAllocator * GetCodeGenNumberThreadAllocator() const
@@ -1395,6 +1410,8 @@ public:
     void InternalInvalidateProtoTypePropertyCaches(const Js::PropertyId propertyId);
     void InvalidateAllProtoTypePropertyCaches();
 
+    Js::MegamorphicPropertyCache * GetMegamorphicPropertyCache() { return &megamorphicPropertyCache; }
+
     Js::ScriptContext ** RegisterPrototypeChainEnsuredToHaveOnlyWritableDataPropertiesScriptContext(Js::ScriptContext * scriptContext);
     void UnregisterPrototypeChainEnsuredToHaveOnlyWritableDataPropertiesScriptContext(Js::ScriptContext ** scriptContext);
     void ClearPrototypeChainEnsuredToHaveOnlyWritableDataPropertiesCaches();
@@ -1449,6 +1466,10 @@ public:
     const Js::PropertyRecord* GetSymbolFromRegistrationMap(const char16* stringKey);
     const Js::PropertyRecord* AddSymbolToRegistrationMap(const char16* stringKey, charcount_t stringLength);
 
+    bool IsSharingRegexPrograms() const;
+    UnifiedRegex::SharedProgram* GetSharedRegexProgram(const UnifiedRegex::RegexKey& key);
+    void AddSharedRegexProgram(const UnifiedRegex::RegexKey& key, UnifiedRegex::SharedProgram* sharedProgram);
+
     inline void ClearPendingSOError()
     {
         this->GetPendingSOErrorObject()->ClearError();
@@ -4,6 +4,6 @@
 //-------------------------------------------------------------------------------------------------------
 // NOTE: If there is a merge conflict the correct fix is to make a new GUID.
 
-// {771a842c-80af-49ed-881c-1890d339426c}
+// {dbb696e1-4736-45ff-b86e-0c5283d0034f}
 const GUID byteCodeCacheReleaseFileVersion =
-{ 0x771a842c, 0x80af, 0x49ed, { 0x88, 0x1c, 0x18, 0x90, 0xd3, 0x39, 0x42, 0x6c } };
+{ 0xdbb696e1, 0x4736, 0x45ff, { 0xb8, 0x6e, 0x0c, 0x52, 0x83, 0xd0, 0x03, 0x4f } };
@@ -26,6 +26,14 @@ namespace Js
     const int majorVersionConstant = 1;
     const int minorVersionConstant = 1;
 
+    // Byte code written by builds that fuse opcodes for the interpreter can't be run by builds with the JIT, so the two
+    // kinds of builds use different file versions (library byte code is never fused, and has a fixed version)
+#if ENABLE_BYTECODE_SUPERINSTRUCTIONS
+    const DWORD superInstructionsVersionMask = 1;
+#else
+    const DWORD superInstructionsVersionMask = 0;
+#endif
+
 #ifdef BYTE_CODE_MAGIC_CONSTANTS
     // These magic constants can be enabled to bracket and check different sections of the serialization
     // file.  Turn on BYTE_CODE_MAGIC_CONSTANTS in ByteCodeSerializer.h to enable this.
@@ -438,7 +446,7 @@ public:
                 V1.value = jscriptMajor;
                 V2.value = jscriptMinor;
                 V3.value = buildDateHash;
-                V4.value = buildTimeHash;
+                V4.value = buildTimeHash ^ superInstructionsVersionMask;
                 break;
             }
 
@@ -449,7 +457,7 @@ public:
                 V1.value = guidDWORDs[0];
                 V2.value = guidDWORDs[1];
                 V3.value = guidDWORDs[2];
-                V4.value = guidDWORDs[3];
+                V4.value = guidDWORDs[3] ^ superInstructionsVersionMask;
                 break;
             }
 
@@ -2820,6 +2828,7 @@ public:
             {
                 Js::VerifyCatastrophic(!isLibraryCode);
                 Js::VerifyOkCatastrophic(AutoSystemInfo::GetJscriptFileVersion(&expectedV1, &expectedV2, &expectedV3, &expectedV4));
+                expectedV4 ^= superInstructionsVersionMask;
                 break;
             }
 
@@ -2830,7 +2839,7 @@ public:
                 expectedV1 = guidDWORDs[0];
                 expectedV2 = guidDWORDs[1];
                 expectedV3 = guidDWORDs[2];
-                expectedV4 = guidDWORDs[3];
+                expectedV4 = guidDWORDs[3] ^ superInstructionsVersionMask;
                 break;
             }
 
@@ -4278,7 +4287,7 @@ public:
 
 // Construct the byte code cache. Copy things needed by inline 'Lookup' functions from reader.
 ByteCodeCache::ByteCodeCache(ScriptContext * scriptContext, ByteCodeBufferReader * reader, int builtInPropertyCount)
-    : reader(reader), propertyCount(reader->string16Count), builtInPropertyCount(builtInPropertyCount)
+    : scriptContext(scriptContext), reader(reader), propertyCount(reader->string16Count), builtInPropertyCount(builtInPropertyCount)
 {
     auto alloc = scriptContext->SourceCodeAllocator();
     propertyIds = AnewArray(alloc, PropertyId, propertyCount);
@@ -4289,28 +4298,26 @@ ByteCodeCache::ByteCodeCache(ScriptContext * scriptContext, ByteCodeBufferReader
 
     raw = reader->raw;
 
-    // Read and populate PropertyIds
-    for(int i=0; i < propertyCount; ++i)
-    {
-        PopulateLookupPropertyId(scriptContext, i);
-    }
+    // PropertyIds are populated on first lookup
 }
 
 // Deserialize and save a PropertyId
-void ByteCodeCache::PopulateLookupPropertyId(ScriptContext * scriptContext, int realOffset)
+PropertyId ByteCodeCache::PopulateLookupPropertyId(int realOffset) const
 {
+    Assert(propertyIds[realOffset] == -1);
+
     PropertyId idInCache = realOffset + this->builtInPropertyCount;
     bool isPropertyRecord;
     auto propertyName = reader->GetString16ById(idInCache, &isPropertyRecord);
-    if(isPropertyRecord)
-    {
-        auto propertyNameLength = reader->GetString16LengthById(idInCache);
+    AssertMsg(isPropertyRecord, "Looked up a string that was not serialized as a property record");
 
-        const Js::PropertyRecord * propertyRecord = scriptContext->GetThreadContext()->GetOrAddPropertyRecordBind(
-            JsUtil::CharacterBuffer<char16>(propertyName, propertyNameLength));
+    auto propertyNameLength = reader->GetString16LengthById(idInCache);
 
-        propertyIds[realOffset] = propertyRecord->GetPropertyId();
-    }
+    const Js::PropertyRecord * propertyRecord = scriptContext->GetThreadContext()->GetOrAddPropertyRecordBind(
+        JsUtil::CharacterBuffer<char16>(propertyName, propertyNameLength));
+
+    propertyIds[realOffset] = propertyRecord->GetPropertyId();
+    return propertyIds[realOffset];
 }
 
 // Serialize function body
@@ -104,8 +104,12 @@ namespace Js
 
     // Holds information about the deserialized bytecode cache. Contains fast inline functions
     // for the lookup hit case. The slower deserialization of VarArray, etc are in the .cpp.
+    //
+    // Property records are bound the first time a deserialized function refers to them rather than for the whole
+    // string table up front, so that loading a large cache costs in proportion to the code that actually runs.
     class ByteCodeCache
     {
+        ScriptContext * scriptContext;
         ByteCodeBufferReader * reader;
         const byte * raw;
         PropertyId * propertyIds;
@@ -113,7 +117,7 @@ namespace Js
         int builtInPropertyCount;
     public:
         ByteCodeCache(ScriptContext * scriptContext, ByteCodeBufferReader * reader, int builtInPropertyCount);
-        void PopulateLookupPropertyId(ScriptContext * scriptContext, int realArrayOffset);
+        PropertyId PopulateLookupPropertyId(int realArrayOffset) const;
 
         ByteCodeBufferReader* GetReader()
         {
@@ -130,8 +134,7 @@ namespace Js
             }
             auto realOffset = unobscured - builtInPropertyCount;
             Assert(realOffset<propertyCount);
-            Assert(propertyIds[realOffset]!=-1);
-            return propertyIds[realOffset];
+            return propertyIds[realOffset] != -1 ? propertyIds[realOffset] : PopulateLookupPropertyId(realOffset);
         }
 
         // Convert a serialized propertyID into a real one.
@@ -139,8 +142,7 @@ namespace Js
         {
             auto realOffset = obscuredIdInCache ^ SERIALIZER_OBSCURE_NONBUILTIN_PROPERTY_ID;
             Assert(realOffset<propertyCount);
-            Assert(propertyIds[realOffset]!=-1);
-            return propertyIds[realOffset];
+            return propertyIds[realOffset] != -1 ? propertyIds[realOffset] : PopulateLookupPropertyId(realOffset);
         }
 
         // Get the raw byte code buffer.
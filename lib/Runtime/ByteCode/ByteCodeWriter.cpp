@@ -75,6 +75,13 @@ namespace Js
         m_doInterruptProbe = functionWrite->GetScriptContext()->GetThreadContext()->DoInterruptProbe(functionWrite);
         m_hasLoop = hasLoop;
         m_isInDebugMode = byteCodeGenerator->IsInDebugMode();
+#if ENABLE_BYTECODE_SUPERINSTRUCTIONS
+        // Fused opcodes would merge statement boundaries the debugger steps over. Library code isn't fused either, as its
+        // serialized byte code is shared with builds that have the JIT.
+        m_doSuperInstructions = !m_isInDebugMode && !functionWrite->GetUtf8SourceInfo()->GetIsLibraryCode() &&
+            !PHASE_OFF(Js::SuperInstructionsPhase, functionWrite);
+        ResetFusableIncr();
+#endif
     }
 
     template <typename T>
@@ -283,6 +290,9 @@ namespace Js
         m_byteCodeInLoopCount = 0;
         m_loopNest = 0;
         m_currentDebuggerScope = nullptr;
+#if ENABLE_BYTECODE_SUPERINSTRUCTIONS
+        ResetFusableIncr();
+#endif
     }
 
     inline Js::RegSlot ByteCodeWriter::ConsumeReg(Js::RegSlot reg)
@@ -440,6 +450,15 @@ namespace Js
             isProfiled = true;
         }
 
+#if ENABLE_BYTECODE_SUPERINSTRUCTIONS
+        DataChunk * startChunk = m_byteCodeData.GetCurrentChunk();
+        uint startChunkOffset = startChunk->GetCurrentOffset();
+        uint startOffset = m_byteCodeData.GetCurrentOffset();
+#ifdef BYTECODE_BRANCH_ISLAND
+        int longJumpCount = m_longJumpOffsets->Count();
+#endif
+#endif
+
         if (isReg2WithICIndex)
         {
             MULTISIZE_LAYOUT_WRITE(Reg2WithICIndex, op, R0, R1, unit.cacheId, unit.isRootObjectCache);
@@ -449,6 +468,24 @@ namespace Js
             MULTISIZE_LAYOUT_WRITE(Reg2, op, R0, R1);
         }
 
+#if ENABLE_BYTECODE_SUPERINSTRUCTIONS
+        // Only remember the increment if a branch island wasn't emitted in front of it,
+        // so that startOffset is where the instruction itself begins.
+        if (m_doSuperInstructions && (op == OpCode::Incr_A || op == OpCode::Decr_A) && R0 == R1
+#ifdef BYTECODE_BRANCH_ISLAND
+            && longJumpCount == m_longJumpOffsets->Count()
+#endif
+            )
+        {
+            m_fusableIncr.op = op;
+            m_fusableIncr.reg = R0;
+            m_fusableIncr.startOffset = startOffset;
+            m_fusableIncr.endOffset = m_byteCodeData.GetCurrentOffset();
+            m_fusableIncr.startChunk = startChunk;
+            m_fusableIncr.startChunkOffset = startChunkOffset;
+        }
+#endif
+
         if (isProfiled)
         {
             m_byteCodeData.Encode(&profileId, sizeof(Js::ProfileId));
@@ -744,6 +781,13 @@ namespace Js
         CheckLabel(labelID);
         Assert(!OpCodeAttr::HasMultiSizeLayout(op));
 
+#if ENABLE_BYTECODE_SUPERINSTRUCTIONS
+        if (op == OpCode::Br && TryFuseIncrBr(labelID))
+        {
+            return;
+        }
+#endif
+
         size_t const offsetOfRelativeJumpOffsetFromEnd = sizeof(OpLayoutBr) - offsetof(OpLayoutBr, RelativeJumpOffset);
         OpLayoutBr data;
         data.RelativeJumpOffset = offsetOfRelativeJumpOffsetFromEnd;
@@ -794,6 +838,36 @@ namespace Js
         MULTISIZE_LAYOUT_WRITE(BrReg1, op, labelID, R1);
     }
 
+#if ENABLE_BYTECODE_SUPERINSTRUCTIONS
+    // Loop increments ("for (...; ...; i++)") are written as an in-place Incr_A followed by
+    // the branch back to the loop condition. Replace the pair with a single IncrBr_A so the
+    // interpreter dispatches once per iteration for both.
+    bool ByteCodeWriter::TryFuseIncrBr(ByteCodeLabel labelID)
+    {
+        if (m_fusableIncr.endOffset != m_byteCodeData.GetCurrentOffset())
+        {
+            return false;
+        }
+#ifdef BYTECODE_BRANCH_ISLAND
+        if (inEnsureLongBranch)
+        {
+            // The jump around a branch island must stay a plain Br of a known size
+            return false;
+        }
+#endif
+
+        // Nothing was written after the increment, so rewind over it and write the fused op instead.
+        OpCode op = m_fusableIncr.op == OpCode::Incr_A ? OpCode::IncrBr_A : OpCode::DecrBr_A;
+        RegSlot R1 = m_fusableIncr.reg;
+        m_fusableIncr.startChunk->SetCurrentOffset(m_fusableIncr.startChunkOffset);
+        m_byteCodeData.SetCurrent(m_fusableIncr.startOffset, m_fusableIncr.startChunk);
+        ResetFusableIncr();
+
+        MULTISIZE_LAYOUT_WRITE(BrReg1, op, labelID, R1);
+        return true;
+    }
+#endif
+
     template <typename SizePolicy>
     bool ByteCodeWriter::TryWriteBrReg2(OpCode op, ByteCodeLabel labelID, RegSlot R1, RegSlot R2)
     {
@@ -2554,6 +2628,11 @@ StoreCommon:
 
         AssertMsg(m_labelOffsets->Item(labelID) == UINT_MAX, "A label may only be defined at one location");
         m_labelOffsets->SetExistingItem(labelID, m_byteCodeData.GetCurrentOffset());
+
+#if ENABLE_BYTECODE_SUPERINSTRUCTIONS
+        // Code can now jump in between the increment and whatever follows it
+        ResetFusableIncr();
+#endif
     }
 
     void ByteCodeWriter::AddJumpOffset(Js::OpCode op, ByteCodeLabel labelId, uint fieldByteOffsetFromEnd) // Offset of "Offset" field in OpLayout, in bytes
@@ -2817,6 +2896,11 @@ StoreCommon:
         m_pMatchingNode = node;
         m_beginCodeSpan = m_byteCodeData.GetCurrentOffset();
 
+#if ENABLE_BYTECODE_SUPERINSTRUCTIONS
+        // The statement must begin at an instruction, not inside a fused one
+        ResetFusableIncr();
+#endif
+
         if (m_isInDebugMode && m_tmpRegCount != tmpRegCount)
         {
             Unsigned1(OpCode::EmitTmpRegCount, tmpRegCount);
@@ -175,6 +175,22 @@ namespace Js
         bool m_hasLoop;
         bool m_isInDebugMode;
         bool m_doInterruptProbe;
+#if ENABLE_BYTECODE_SUPERINSTRUCTIONS
+        bool m_doSuperInstructions;
+
+        // The last in-place Incr_A/Decr_A written, so that a Br emitted right after it
+        // can be rewritten as a single IncrBr_A/DecrBr_A.
+        struct FusableIncr
+        {
+            OpCode op;
+            RegSlot reg;
+            uint startOffset;
+            uint endOffset;
+            DataChunk * startChunk;
+            uint startChunkOffset;
+        };
+        FusableIncr m_fusableIncr;
+#endif
     public:
         struct CacheIdUnit {
             uint cacheId;
@@ -197,6 +213,10 @@ namespace Js
 #endif
 
         void IncreaseByteCodeCount();
+#if ENABLE_BYTECODE_SUPERINSTRUCTIONS
+        void ResetFusableIncr() { m_fusableIncr.endOffset = UINT_MAX; }
+        bool TryFuseIncrBr(ByteCodeLabel labelID);
+#endif
         void AddJumpOffset(Js::OpCode op, ByteCodeLabel labelId, uint fieldByteOffset);
 
         RegSlot ConsumeReg(RegSlot reg);
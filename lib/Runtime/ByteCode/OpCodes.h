@@ -747,6 +747,11 @@ MACRO_BACKEND_ONLY(     SlotArrayCheck,     Empty,          OpCanCSE)
 MACRO_BACKEND_ONLY(     FrameDisplayCheck,  Empty,          OpCanCSE)
 MACRO_EXTEND(           BeginBodyScope,     Empty,          OpSideEffect)
 
+// Interpreter super-instructions. These stay at the end of the extended range so that adding them
+// doesn't renumber the opcodes in byte code serialized by older builds (e.g. the library byte code).
+MACRO_EXTEND_WMS(       IncrBr_A,           BrReg1,         OpByteCodeOnly|OpSideEffect|OpNoFallThrough|OpOpndHasImplicitCall|OpTempNumberSources|OpTempObjectSources)      // Increment in place and branch
+MACRO_EXTEND_WMS(       DecrBr_A,           BrReg1,         OpByteCodeOnly|OpSideEffect|OpNoFallThrough|OpOpndHasImplicitCall|OpTempNumberSources|OpTempObjectSources)      // Decrement in place and branch
+
 // All SIMD ops are backend only for non-asmjs.
 #define MACRO_SIMD(opcode, asmjsLayout, opCodeAttrAsmJs, OpCodeAttr, ...) MACRO_BACKEND_ONLY(opcode, Empty, OpCodeAttr)
 #define MACRO_SIMD_WMS(opcode, asmjsLayout, opCodeAttrAsmJs, OpCodeAttr, ...) MACRO_BACKEND_ONLY(opcode, Empty, OpCodeAttr)
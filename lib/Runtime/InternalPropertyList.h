@@ -15,7 +15,7 @@ INTERNALPROPERTY(SealedType)                      // Used to store shared sealed
 INTERNALPROPERTY(FrozenType)                      // Used to store shared frozen type in PathTypeHandler::propertySuccessors map.
 INTERNALPROPERTY(StackTrace)                      // Stack trace object for Error.stack generation
 INTERNALPROPERTY(StackTraceCache)                 // Cache of Error.stack string
-INTERNALPROPERTY(WeakMapKeyMap)                   // WeakMap data stored on WeakMap key objects
+INTERNALPROPERTY(WeakMapKeyMap)                   // Unused, WeakMap data is no longer stored on key objects. Kept so that the ids of built-in properties don't change
 INTERNALPROPERTY(HiddenObject)                    // Used to store hidden data for JS library code (Intl as an example will use this)
 INTERNALPROPERTY(RevocableProxy)                  // Internal slot for [[RevokableProxy]] for revocable proxy in ES6
 INTERNALPROPERTY(MutationBp)                      // Used to store strong reference to the mutation breakpoint object
@@ -94,6 +94,25 @@ namespace Js
             return false;
         }
 
+        if(requestContext->GetThreadContext()->GetMegamorphicPropertyCache()->TryGetProperty(
+                CheckMissing,
+                object,
+                propertyId,
+                propertyValue,
+                requestContext,
+                propertyValueInfo))
+        {
+            // The property access was cached in an inline cache. Get the proper property operation info.
+            if(ReturnOperationInfo)
+            {
+                PretendTryGetProperty<IsInlineCacheAvailable, IsPolymorphicInlineCacheAvailable>(
+                    object->GetType(),
+                    operationInfo,
+                    propertyValueInfo);
+            }
+            return true;
+        }
+
         TypePropertyCache *const typePropertyCache = object->GetType()->GetPropertyCache();
         if(!typePropertyCache ||
             !typePropertyCache->TryGetProperty(
@@ -496,6 +515,21 @@ namespace Js
         }
         Assert(!IsAccessor);
 
+        // Loads at a site whose polymorphic inline cache is full and still misses are megamorphic. Share what they find
+        // with all such sites on the thread.
+        if(IsRead &&
+            createTypePropertyCache &&
+            (!polymorphicInlineCache || !polymorphicInlineCache->CanAllocateBigger()))
+        {
+            requestContext->GetThreadContext()->GetMegamorphicPropertyCache()->Cache(
+                type,
+                propertyId,
+                propertyIndex,
+                isInlineSlot,
+                isMissing,
+                isProto ? objectWithProperty : nullptr);
+        }
+
         TypePropertyCache *typePropertyCache = type->GetPropertyCache();
         if(!typePropertyCache)
         {
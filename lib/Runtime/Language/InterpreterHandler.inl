@@ -99,6 +99,8 @@ EXDEF2_WMS(A1toA1Mem,               NewWithObject,              JavascriptOperat
   DEF2_WMS(A1toA1Mem,               Conv_Num,                   JavascriptOperators::ToNumber)
   DEF2_WMS(A1toA1Mem,               Incr_A,                     JavascriptMath::Increment)
   DEF2_WMS(A1toA1Mem,               Decr_A,                     JavascriptMath::Decrement)
+EXDEF2_WMS(A1toA1MemBr,             IncrBr_A,                   JavascriptMath::Increment)
+EXDEF2_WMS(A1toA1MemBr,             DecrBr_A,                   JavascriptMath::Decrement)
   DEF2_WMS(A1toA1Mem,               Neg_A,                      JavascriptMath::Negate)
   DEF2_WMS(A1toA1Mem,               Not_A,                      JavascriptMath::Not)
   DEF2_WMS(A1toA1Mem,               Typeof,                     JavascriptOperators::Typeof)
@@ -26,6 +26,24 @@
 #define PROFILEDOP(prof, unprof) unprof
 #endif
 
+// Threaded dispatch: each handler in the main loop is labeled and jumps straight to the
+// handler of the next opcode through a table instead of going back to the top of the switch.
+// The debugging loop has to check for breakpoints before each opcode, so it keeps the switch.
+#if ENABLE_INTERPRETER_COMPUTED_GOTO && !DEBUGGING_LOOP && !defined(INTERPRETER_ASMJS) && !defined(ENABLE_BASIC_TELEMETRY)
+#define THREADED_DISPATCH 1
+#define INTERPRETER_OPCODE_LABEL(name) OpHandler_##name:
+#define INTERPRETER_NEXT_OPCODE \
+    do \
+    { \
+        op = ReadByteOp<INTERPRETER_OPCODE>(ip); \
+        goto *dispatchTable[(int)op]; \
+    } while (false)
+#else
+#define THREADED_DISPATCH 0
+#define INTERPRETER_OPCODE_LABEL(name)
+#define INTERPRETER_NEXT_OPCODE break
+#endif
+
 //two layers of macros are necessary to get arguments to the invocation of the top level macro expanded.
 #define CONCAT_TOKENS_AGAIN(loopName, fnSuffix) loopName ## fnSuffix
 #define CONCAT_TOKENS(loopName, fnSuffix) CONCAT_TOKENS_AGAIN(loopName, fnSuffix)
@@ -179,6 +197,43 @@ Var Js::InterpreterStackFrame::INTERPRETERLOOPNAME()
     // For checked builds this does mean we are incrementing 2 different counters to
     // track the ip.
     const byte* ip = m_reader.GetIP();
+
+#if THREADED_DISPATCH
+    // Only byte sized opcodes are dispatched from the main loop; the layout prefixes handle the rest.
+    static void * dispatchTable[(int)INTERPRETER_OPCODE::MaxByteSizedOpcodes + 1];
+    static bool volatile dispatchTableInitialized = false;
+    if (!dispatchTableInitialized)
+    {
+        for (int i = 0; i <= (int)INTERPRETER_OPCODE::MaxByteSizedOpcodes; i++)
+        {
+            dispatchTable[i] = &&OpHandler_BadOpcode;
+        }
+
+#define DEF2(x, op, func) dispatchTable[(int)INTERPRETER_OPCODE::op] = &&OpHandler_##op;
+#define DEF3(x, op, func, y) dispatchTable[(int)INTERPRETER_OPCODE::op] = &&OpHandler_##op;
+#define DEF2_WMS(x, op, func) dispatchTable[(int)INTERPRETER_OPCODE::op] = &&OpHandler_##op;
+#define DEF3_WMS(x, op, func, y) dispatchTable[(int)INTERPRETER_OPCODE::op] = &&OpHandler_##op;
+#define DEF4_WMS(x, op, func, y, t) dispatchTable[(int)INTERPRETER_OPCODE::op] = &&OpHandler_##op;
+#include "InterpreterHandler.inl"
+
+        dispatchTable[(int)INTERPRETER_OPCODE::Ret] = &&OpHandler_Ret;
+        dispatchTable[(int)INTERPRETER_OPCODE::Yield] = &&OpHandler_Yield;
+        dispatchTable[(int)INTERPRETER_OPCODE::Leave] = &&OpHandler_Leave;
+        dispatchTable[(int)INTERPRETER_OPCODE::LeaveNull] = &&OpHandler_LeaveNull;
+        dispatchTable[(int)INTERPRETER_OPCODE::ExtendedOpcodePrefix] = &&OpHandler_ExtendedOpcodePrefix;
+        dispatchTable[(int)INTERPRETER_OPCODE::MediumLayoutPrefix] = &&OpHandler_MediumLayoutPrefix;
+        dispatchTable[(int)INTERPRETER_OPCODE::ExtendedMediumLayoutPrefix] = &&OpHandler_ExtendedMediumLayoutPrefix;
+        dispatchTable[(int)INTERPRETER_OPCODE::LargeLayoutPrefix] = &&OpHandler_LargeLayoutPrefix;
+        dispatchTable[(int)INTERPRETER_OPCODE::ExtendedLargeLayoutPrefix] = &&OpHandler_ExtendedLargeLayoutPrefix;
+        dispatchTable[(int)INTERPRETER_OPCODE::EndOfBlock] = &&OpHandler_EndOfBlock;
+        dispatchTable[(int)INTERPRETER_OPCODE::Break] = &&OpHandler_Break;
+
+        // The table is identical on every thread; publish it only once it is complete.
+        MemoryBarrier();
+        dispatchTableInitialized = true;
+    }
+#endif
+
     while (true)
     {
         INTERPRETER_OPCODE op = ReadByteOp<INTERPRETER_OPCODE>(ip);
@@ -271,6 +326,7 @@ SWAP_BP_FOR_OPCODE:
         switch (op)
         {
         case INTERPRETER_OPCODE::Ret:
+        INTERPRETER_OPCODE_LABEL(Ret)
             {
                 //
                 // Return "Reg: 0" as the return-value.
@@ -287,6 +343,7 @@ SWAP_BP_FOR_OPCODE:
             }
 
         case INTERPRETER_OPCODE::Yield:
+        INTERPRETER_OPCODE_LABEL(Yield)
             {
                 m_reader.Reg2_Small(ip);
                 return GetReg(GetFunctionBody()->GetYieldRegister());
@@ -298,15 +355,31 @@ SWAP_BP_FOR_OPCODE:
 #define DEF3_WMS(x, op, func, y) PROCESS_##x##_COMMON(op, func, y, _Small)
 #define DEF4_WMS(x, op, func, y, t) PROCESS_##x##_COMMON(op, func, y, _Small, t)
 
+#if THREADED_DISPATCH
+#undef PROCESS_OPCODE_LABEL
+#undef PROCESS_OPCODE_NEXT
+#define PROCESS_OPCODE_LABEL(name) INTERPRETER_OPCODE_LABEL(name)
+#define PROCESS_OPCODE_NEXT INTERPRETER_NEXT_OPCODE
+#endif
+
 #include "InterpreterHandler.inl"
 
+#if THREADED_DISPATCH
+#undef PROCESS_OPCODE_LABEL
+#undef PROCESS_OPCODE_NEXT
+#define PROCESS_OPCODE_LABEL(name)
+#define PROCESS_OPCODE_NEXT break
+#endif
+
             case INTERPRETER_OPCODE::Leave:
+            INTERPRETER_OPCODE_LABEL(Leave)
                 // Return the continuation address to the helper.
                 // This tells the helper that control left the scope without completing the try/handler,
                 // which is particularly significant when executing a finally.
                 m_reader.Empty(ip);
                 return (Var)this->m_reader.GetCurrentOffset();
             case INTERPRETER_OPCODE::LeaveNull:
+            INTERPRETER_OPCODE_LABEL(LeaveNull)
                 // Return to the helper without specifying a continuation address,
                 // indicating that the handler completed without jumping, so exception processing
                 // should continue.
@@ -314,6 +387,7 @@ SWAP_BP_FOR_OPCODE:
                 return nullptr;
 
             case INTERPRETER_OPCODE::ExtendedOpcodePrefix:
+            INTERPRETER_OPCODE_LABEL(ExtendedOpcodePrefix)
             {
                 ip = CONCAT_TOKENS(INTERPRETERLOOPNAME, ExtendedOpCodePrefix)(ip);
 
@@ -324,9 +398,10 @@ SWAP_BP_FOR_OPCODE:
                     return nullptr;
                 }
 #endif
-                break;
+                INTERPRETER_NEXT_OPCODE;
             }
             case INTERPRETER_OPCODE::MediumLayoutPrefix:
+            INTERPRETER_OPCODE_LABEL(MediumLayoutPrefix)
             {
                 Var yieldValue = nullptr;
                 ip = CONCAT_TOKENS(INTERPRETERLOOPNAME, MediumLayoutPrefix)(ip, yieldValue);
@@ -343,9 +418,10 @@ SWAP_BP_FOR_OPCODE:
                     return nullptr;
                 }
 #endif
-                break;
+                INTERPRETER_NEXT_OPCODE;
             }
             case INTERPRETER_OPCODE::ExtendedMediumLayoutPrefix:
+            INTERPRETER_OPCODE_LABEL(ExtendedMediumLayoutPrefix)
             {
                 ip = CONCAT_TOKENS(INTERPRETERLOOPNAME, ExtendedMediumLayoutPrefix)(ip);
 
@@ -356,9 +432,10 @@ SWAP_BP_FOR_OPCODE:
                     return nullptr;
                 }
 #endif
-                break;
+                INTERPRETER_NEXT_OPCODE;
             }
             case INTERPRETER_OPCODE::LargeLayoutPrefix:
+            INTERPRETER_OPCODE_LABEL(LargeLayoutPrefix)
             {
                 Var yieldValue = nullptr;
                 ip = CONCAT_TOKENS(INTERPRETERLOOPNAME, LargeLayoutPrefix)(ip, yieldValue);
@@ -375,9 +452,10 @@ SWAP_BP_FOR_OPCODE:
                     return nullptr;
                 }
 #endif
-                break;
+                INTERPRETER_NEXT_OPCODE;
             }
             case INTERPRETER_OPCODE::ExtendedLargeLayoutPrefix:
+            INTERPRETER_OPCODE_LABEL(ExtendedLargeLayoutPrefix)
             {
                 ip = CONCAT_TOKENS(INTERPRETERLOOPNAME, ExtendedLargeLayoutPrefix)(ip);
 
@@ -388,10 +466,11 @@ SWAP_BP_FOR_OPCODE:
                     return nullptr;
                 }
 #endif
-                break;
+                INTERPRETER_NEXT_OPCODE;
             }
 
             case INTERPRETER_OPCODE::EndOfBlock:
+            INTERPRETER_OPCODE_LABEL(EndOfBlock)
             {
                 // Note that at this time though ip was advanced by 'OpCode op = ReadByteOp<INTERPRETER_OPCODE>(ip)',
                 // we haven't advanced m_reader.m_currentLocation yet, thus m_reader.m_currentLocation still points to EndOfBLock,
@@ -417,6 +496,7 @@ SWAP_BP_FOR_OPCODE:
             }
 
             case INTERPRETER_OPCODE::Break:
+            INTERPRETER_OPCODE_LABEL(Break)
             {
 #if DEBUGGING_LOOP
                 // The reader has already advanced the IP:
@@ -493,9 +573,10 @@ SWAP_BP_FOR_OPCODE:
 #else
                 m_reader.Empty(ip);
 #endif
-                break;
+                INTERPRETER_NEXT_OPCODE;
             }
             default:
+            INTERPRETER_OPCODE_LABEL(BadOpcode)
                 // Help the C++ optimizer by declaring that the cases we
                 // have above are sufficient
                 AssertMsg(false, "dispatch to bad opcode");
@@ -507,6 +588,9 @@ SWAP_BP_FOR_OPCODE:
 // Restore optimizations to what's specified by the /O switch.
 #pragma optimize("", on)
 #endif
+#undef THREADED_DISPATCH
+#undef INTERPRETER_OPCODE_LABEL
+#undef INTERPRETER_NEXT_OPCODE
 #undef DEBUGGING_LOOP
 #undef INTERPRETERPROFILE
 #undef PROFILEDOP
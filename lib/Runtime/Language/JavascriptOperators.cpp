@@ -1649,6 +1649,14 @@ CommonNumber:
             RootObjectBase* rootObject = static_cast<RootObjectBase*>(object);
             foundProperty = rootObject->GetRootProperty(instance, propertyId, value, info, requestContext);
         }
+        else if (!unscopables && value != nullptr && DynamicType::Is(object->GetTypeId()) &&
+            requestContext->GetThreadContext()->GetMegamorphicPropertyCache()->TryGetProperty(false, object, propertyId, value, requestContext, nullptr) &&
+            !requestContext->IsUndeclBlockVar(*value))
+        {
+            // Found without walking the prototype chain. The load is megamorphic, so there is nothing worth caching.
+            PropertyValueInfo::SetNoCache(info, object);
+            return TRUE;
+        }
         while (!foundProperty && JavascriptOperators::GetTypeId(object) != TypeIds_Null)
         {
 
@@ -18,6 +18,8 @@ namespace JSON
     Js::FunctionInfo EntryInfo::Parse(JSON::Parse, Js::FunctionInfo::ErrorOnNew);
 
     Js::Var Parse(Js::JavascriptString* input, Js::RecyclableObject* reviver, Js::ScriptContext* scriptContext);
+    template <typename CharType>
+    Js::Var Parse(const CharType* input, uint length, Js::RecyclableObject* reviver, Js::ScriptContext* scriptContext);
 
     Js::Var Parse(Js::RecyclableObject* function, Js::CallInfo callInfo, ...)
     {
@@ -58,14 +60,25 @@ namespace JSON
     }
 
     Js::Var Parse(Js::JavascriptString* input, Js::RecyclableObject* reviver, Js::ScriptContext* scriptContext)
+    {
+        return Parse(input->GetSz(), input->GetLength(), reviver, scriptContext);
+    }
+
+    Js::Var ParseUtf8(const utf8char_t* input, uint length, Js::ScriptContext* scriptContext)
+    {
+        return Parse(input, length, nullptr, scriptContext);
+    }
+
+    template <typename CharType>
+    Js::Var Parse(const CharType* input, uint length, Js::RecyclableObject* reviver, Js::ScriptContext* scriptContext)
     {
         // alignment required because of the union in JSONParser::m_token
-        __declspec (align(8)) JSONParser parser(scriptContext, reviver);
+        __declspec (align(8)) JSONParserT<CharType> parser(scriptContext, reviver);
         Js::Var result = NULL;
 
         TryFinally([&]()
         {
-            result = parser.Parse(input);
+            result = parser.Parse(input, length);
 
 #ifdef ENABLE_DEBUG_CONFIG_OPTIONS
             if (CONFIG_FLAG(ForceGCAfterJSONParse))
@@ -320,13 +333,18 @@ namespace JSON
         {
             stringifySession.CompleteInit(space, tempAlloc);
 
-            Js::DynamicObject* wrapper = scriptContext->GetLibrary()->CreateObject();
-            JS_ETW(EventWriteJSCRIPT_RECYCLER_ALLOCATE_OBJECT(wrapper));
-            Js::PropertyRecord const * propertyRecord;
-            scriptContext->GetOrAddPropertyRecord(_u(""), 0, &propertyRecord);
-            Js::PropertyId propertyId = propertyRecord->GetPropertyId();
-            Js::JavascriptOperators::InitProperty(wrapper, propertyId, value);
-            result = stringifySession.Str(scriptContext->GetLibrary()->GetEmptyString(), propertyId, wrapper);
+            if (CONFIG_FLAG(StreamingJSONStringify))
+            {
+                // Write the result out in order into a CompoundString rather than building a concat string tree
+                CompoundStringStringifyWriter writer(scriptContext);
+                result = stringifySession.StringifyToWriter(value, &writer) ? writer.GetResult() : library->GetUndefined();
+            }
+            else
+            {
+                Js::PropertyId propertyId;
+                Js::DynamicObject* wrapper = stringifySession.CreateWrapper(value, &propertyId);
+                result = stringifySession.Str(scriptContext->GetLibrary()->GetEmptyString(), propertyId, wrapper);
+            }
         }
         END_TEMP_ALLOCATOR(tempAlloc, scriptContext);
 
@@ -334,6 +352,104 @@ namespace JSON
         return result;
     }
 
+    bool StringifyToWriter(Js::Var value, StringifyWriter* writer, Js::ScriptContext* scriptContext)
+    {
+        StringifySession stringifySession(scriptContext);
+        bool written = false;
+
+        BEGIN_TEMP_ALLOCATOR(tempAlloc, scriptContext, _u("JSON"))
+        {
+            stringifySession.CompleteInit(scriptContext->GetLibrary()->GetNull(), tempAlloc);
+            written = stringifySession.StringifyToWriter(value, writer);
+        }
+        END_TEMP_ALLOCATOR(tempAlloc, scriptContext);
+
+        return written;
+    }
+
+    // -------- StringifyWriter implementation ------------//
+
+    void StringifyWriter::Append(const char16* str, charcount_t length)
+    {
+        if (length >= BufferLength)
+        {
+            // Hand large strings over directly rather than copying them through the buffer
+            FlushBuffer();
+            Flush(str, length);
+            return;
+        }
+
+        while (length > 0)
+        {
+            if (current == bufferEnd)
+            {
+                FlushBuffer();
+            }
+            charcount_t count = min(length, static_cast<charcount_t>(bufferEnd - current));
+            js_wmemcpy_s(current, count, str, count);
+            current += count;
+            str += count;
+            length -= count;
+        }
+    }
+
+    void StringifyWriter::AppendQuoted(Js::JavascriptString* str)
+    {
+        const char16* chars = str->GetString();
+        const char16* charsEnd = chars + str->GetLength();
+        const char16* runStart = chars;
+
+        Append(_u('"'));
+        for (const char16* ch = chars; ch < charsEnd; ch++)
+        {
+            char16 escapeChar = Js::JSONString::GetEscapeChar(*ch);
+            if (escapeChar == _u('\0'))
+            {
+                continue;
+            }
+
+            Append(runStart, static_cast<charcount_t>(ch - runStart));
+            runStart = ch + 1;
+            Append(_u('\\'));
+            Append(escapeChar);
+            if (escapeChar == _u('u'))
+            {
+                // Only control characters are escaped as \u00XX
+                static const char16 hexDigits[] = _u("0123456789abcdef");
+                Append(_u("00"));
+                Append(hexDigits[(*ch >> 4) & 0xF]);
+                Append(hexDigits[*ch & 0xF]);
+            }
+        }
+        Append(runStart, static_cast<charcount_t>(charsEnd - runStart));
+        Append(_u('"'));
+    }
+
+    void StringifyWriter::FlushBuffer()
+    {
+        if (current != buffer)
+        {
+            Flush(buffer, static_cast<charcount_t>(current - buffer));
+            current = buffer;
+        }
+    }
+
+    CompoundStringStringifyWriter::CompoundStringStringifyWriter(Js::ScriptContext* scriptContext) :
+        result(Js::CompoundString::NewWithCharCapacity(BufferLength, scriptContext->GetLibrary()))
+    {
+    }
+
+    void CompoundStringStringifyWriter::Flush(const char16* chars, charcount_t length)
+    {
+        result->AppendChars(chars, length);
+    }
+
+    Js::JavascriptString* CompoundStringStringifyWriter::GetResult()
+    {
+        FlushBuffer();
+        return result;
+    }
+
     // -------- StringifySession implementation ------------//
 
     void StringifySession::CompleteInit(Js::Var space, ArenaAllocator* tempAlloc)
@@ -388,7 +504,47 @@ namespace JSON
         objectStack = Anew(tempAlloc, JSONStack, tempAlloc, scriptContext);
     }
 
+    Js::DynamicObject* StringifySession::CreateWrapper(Js::Var value, Js::PropertyId* propertyId)
+    {
+        Js::DynamicObject* wrapper = scriptContext->GetLibrary()->CreateObject();
+        JS_ETW(EventWriteJSCRIPT_RECYCLER_ALLOCATE_OBJECT(wrapper));
+        Js::PropertyRecord const * propertyRecord;
+        scriptContext->GetOrAddPropertyRecord(_u(""), 0, &propertyRecord);
+        *propertyId = propertyRecord->GetPropertyId();
+        Js::JavascriptOperators::InitProperty(wrapper, *propertyId, value);
+        return wrapper;
+    }
+
+    bool StringifySession::StringifyToWriter(Js::Var value, StringifyWriter* writer)
+    {
+        Assert(this->objectStack != nullptr);
+        this->writer = writer;
+
+        Js::PropertyId propertyId;
+        Js::DynamicObject* wrapper = CreateWrapper(value, &propertyId);
+        Js::Var filteredValue = GetValue(scriptContext->GetLibrary()->GetEmptyString(), propertyId, wrapper);
+        if (!IsSerializable(filteredValue))
+        {
+            return false;
+        }
+
+        WriteValue(filteredValue);
+        writer->FlushBuffer();
+        return true;
+    }
+
     Js::Var StringifySession::Str(uint32 index, Js::Var holder)
+    {
+        return StrValue(GetValue(index, holder));
+    }
+
+    Js::Var StringifySession::Str(Js::JavascriptString* key, Js::PropertyId keyId, Js::Var holder)
+    {
+        return StrValue(GetValue(key, keyId, holder));
+    }
+
+    // Returns holder[index] after applying toJSON and the replacer function
+    Js::Var StringifySession::GetValue(uint32 index, Js::Var holder)
     {
         Js::Var value;
         Js::RecyclableObject *undefined = scriptContext->GetLibrary()->GetUndefined();
@@ -415,10 +571,11 @@ namespace JSON
         }
 
         Js::JavascriptString *key = scriptContext->GetIntegerString(index);
-        return StrHelper(key, value, holder);
+        return ApplyFilters(key, value, holder);
     }
 
-    Js::Var StringifySession::Str(Js::JavascriptString* key, Js::PropertyId keyId, Js::Var holder)
+    // Returns holder[key] after applying toJSON and the replacer function
+    Js::Var StringifySession::GetValue(Js::JavascriptString* key, Js::PropertyId keyId, Js::Var holder)
     {
         Js::Var value;
         // We should look only into object's own properties here. When an object is serialized, only the own properties are considered,
@@ -431,17 +588,16 @@ namespace JSON
         {
             return scriptContext->GetLibrary()->GetUndefined();
         }
-        return StrHelper(key, value, holder);
+        return ApplyFilters(key, value, holder);
     }
 
-    Js::Var StringifySession::StrHelper(Js::JavascriptString* key, Js::Var value, Js::Var holder)
+    Js::Var StringifySession::ApplyFilters(Js::JavascriptString* key, Js::Var value, Js::Var holder)
     {
         PROBE_STACK(scriptContext, Js::Constants::MinStackDefault);
         AssertMsg(Js::RecyclableObject::Is(holder), "The holder argument in a JSON::Str function must be an object");
 
         Js::Var values[3];
         Js::Arguments args(0, values);
-        Js::Var undefined = scriptContext->GetLibrary()->GetUndefined();
 
         //check and apply 'toJSON' filter
         if (Js::JavascriptOperators::IsJsNativeObject(value) || (Js::JavascriptOperators::IsObject(value)))
@@ -485,7 +641,16 @@ namespace JSON
             value = Js::JavascriptBooleanObject::FromVar(value)->GetValue() ? scriptContext->GetLibrary()->GetTrue() : scriptContext->GetLibrary()->GetFalse();
         }
 
-        id = Js::JavascriptOperators::GetTypeId(value);
+        return value;
+    }
+
+    // Returns the JSON text of a filtered value as a string, or undefined if it is not serialized.
+    // In streaming mode objects and arrays are written out instead and nullptr is returned for them.
+    Js::Var StringifySession::StrValue(Js::Var value)
+    {
+        Js::Var undefined = scriptContext->GetLibrary()->GetUndefined();
+
+        Js::TypeId id = Js::JavascriptOperators::GetTypeId(value);
         switch (id)
         {
         case Js::TypeIds_Undefined:
@@ -586,9 +751,14 @@ namespace JSON
         Js::RecyclableObject* object = Js::RecyclableObject::FromVar(value);
         Js::JavascriptString* result = NULL;
 
+        if (this->writer)
+        {
+            this->writer->Append(_u('{'));
+        }
+
         if(ReplacerArray == this->replacerType)
         {
-            result = Js::ConcatStringBuilder::New(this->scriptContext, this->replacer.propertyList.length); // Reserve initial slots for properties.
+            result = NewMemberList(this->replacer.propertyList.length); // Reserve initial slots for properties.
 
             for (uint k = 0; k < this->replacer.propertyList.length;  k++)
             {
@@ -607,7 +777,7 @@ namespace JSON
 
                 // filter enumerable keys
                 uint32 resultLength = proxyResult->GetLength();
-                result = Js::ConcatStringBuilder::New(this->scriptContext, resultLength);    // Reserve initial slots for properties.
+                result = NewMemberList(resultLength);    // Reserve initial slots for properties.
                 Var element;
                 for (uint32 i = 0; i < resultLength; i++)
                 {
@@ -643,7 +813,7 @@ namespace JSON
                         precisePropertyCount = propertyCount;
                     }
 
-                    result = Js::ConcatStringBuilder::New(this->scriptContext, propertyCount);    // Reserve initial slots for properties.
+                    result = NewMemberList(propertyCount);    // Reserve initial slots for properties.
 
                     if (ReplacerFunction != replacerType)
                     {
@@ -713,6 +883,13 @@ namespace JSON
                 }
             }
         }
+        if (this->writer)
+        {
+            WriteEnd(_u('}'), isEmpty, stepBackIndent);
+            this->indent = stepBackIndent;
+            return nullptr;
+        }
+
         Assert(isEmpty || result);
 
         if(isEmpty)
@@ -780,6 +957,27 @@ namespace JSON
             Assert(Js::JavascriptConversion::ToLength(Js::JavascriptOperators::OP_GetLength(value, scriptContext), scriptContext) == length);
         }
 
+        if (this->writer)
+        {
+            this->writer->Append(_u('['));
+            for (uint32 k = 0; k < length; k++)
+            {
+                WriteMemberSeparator(k == 0);
+                Js::Var element = GetValue(k, value);
+                if (IsSerializable(element))
+                {
+                    WriteValue(element);
+                }
+                else
+                {
+                    this->writer->Append(_u("null"));
+                }
+            }
+            WriteEnd(_u(']'), length == 0, stepBackIndent);
+            this->indent = stepBackIndent;
+            return nullptr;
+        }
+
         Js::JavascriptString* result;
         if (length == 0)
         {
@@ -885,6 +1083,22 @@ namespace JSON
 
     void StringifySession::StringifyMemberObject( Js::JavascriptString* propertyName, Js::PropertyId id, Js::Var value, Js::ConcatStringBuilder* result, Js::JavascriptString* &indentString, Js::JavascriptString* &memberSeparator, bool &isFirstMember, bool &isEmpty )
     {
+        if (this->writer)
+        {
+            // The member is skipped if its value is not serialized, so that has to be known before writing the name
+            Js::Var propertyValue = GetValue(propertyName, id, value);
+            if (IsSerializable(propertyValue))
+            {
+                WriteMemberSeparator(isFirstMember);
+                this->writer->AppendQuoted(propertyName);
+                this->writer->Append(this->GetPropertySeparator());
+                WriteValue(propertyValue);
+                isFirstMember = false;
+                isEmpty = false;
+            }
+            return;
+        }
+
         Js::Var propertyObjectString = Str(propertyName, id, value);
         if(!Js::JavascriptOperators::IsUndefinedObject(propertyObjectString, scriptContext))
         {
@@ -956,6 +1170,88 @@ namespace JSON
         return count;
     }
 
+    Js::ConcatStringBuilder* StringifySession::NewMemberList(uint count)
+    {
+        // Members are written out directly in streaming mode
+        return this->writer ? nullptr : Js::ConcatStringBuilder::New(this->scriptContext, count);
+    }
+
+    // Whether StrValue would produce a JSON text for a filtered value (rather than undefined)
+    bool StringifySession::IsSerializable(Js::Var value)
+    {
+        switch (Js::JavascriptOperators::GetTypeId(value))
+        {
+        case Js::TypeIds_Undefined:
+        case Js::TypeIds_Symbol:
+            return false;
+
+        case Js::TypeIds_Null:
+        case Js::TypeIds_Integer:
+        case Js::TypeIds_Boolean:
+        case Js::TypeIds_Int64Number:
+        case Js::TypeIds_UInt64Number:
+        case Js::TypeIds_Number:
+        case Js::TypeIds_String:
+            return true;
+
+        default:
+            if (Js::JavascriptOperators::IsJsNativeObject(value))
+            {
+                return !Js::JavascriptConversion::IsCallable(value);
+            }
+            return !!Js::JavascriptOperators::IsObject(value);
+        }
+    }
+
+    void StringifySession::WriteValue(Js::Var value)
+    {
+        Assert(this->writer && IsSerializable(value));
+
+        if (Js::JavascriptString::Is(value))
+        {
+            this->writer->AppendQuoted(Js::JavascriptString::FromVar(value));
+            return;
+        }
+
+        // Primitives come back as their (mostly cached) display strings, objects and arrays write themselves
+        Js::Var text = StrValue(value);
+        if (text != nullptr)
+        {
+            this->writer->Append(Js::JavascriptString::FromVar(text));
+        }
+    }
+
+    void StringifySession::WriteIndent(uint count)
+    {
+        for (uint i = 0; i < count; i++)
+        {
+            this->writer->Append(this->gap);
+        }
+    }
+
+    void StringifySession::WriteMemberSeparator(bool isFirstMember)
+    {
+        if (!isFirstMember)
+        {
+            this->writer->Append(_u(','));
+        }
+        if (this->gap)
+        {
+            this->writer->Append(_u('\n'));
+            WriteIndent(this->indent);
+        }
+    }
+
+    void StringifySession::WriteEnd(char16 ch, bool isEmpty, uint stepBackIndent)
+    {
+        if (!isEmpty && this->gap)
+        {
+            this->writer->Append(_u('\n'));
+            WriteIndent(stepBackIndent);
+        }
+        this->writer->Append(ch);
+    }
+
     inline Js::JavascriptString* StringifySession::Quote(Js::JavascriptString* value)
     {
         // By default, optimize for scenario when we don't need to change the inside of the string. That's majority of cases.
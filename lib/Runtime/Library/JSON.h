@@ -7,7 +7,7 @@
 namespace JSON
 {
     class JSONStack;
-    class JSONParser;
+    template <typename CharType> class JSONParserT;
 
     class EntryInfo
     {
@@ -19,6 +19,64 @@ namespace JSON
     Js::Var Stringify(Js::RecyclableObject* function, Js::CallInfo callInfo, ...);
     Js::Var Parse(Js::RecyclableObject* function, Js::CallInfo callInfo, ...);
 
+    // Parses JSON text encoded as UTF-8 (without a reviver), used by JsParseJsonUtf8
+    Js::Var ParseUtf8(const utf8char_t* input, uint length, Js::ScriptContext* scriptContext);
+
+    // Output of a streaming stringify (StringifySession::StringifyToWriter). Characters are collected in a
+    // small fixed size buffer that is handed to Flush whenever it fills up, so the result is written out in
+    // order instead of being built as a tree of concat strings.
+    class StringifyWriter
+    {
+    public:
+        void Append(char16 ch)
+        {
+            if (current == bufferEnd)
+            {
+                FlushBuffer();
+            }
+            *current++ = ch;
+        }
+        void Append(const char16* str, charcount_t length);
+        void Append(Js::JavascriptString* str) { Append(str->GetString(), str->GetLength()); }
+        template <charcount_t LengthPlusOne>
+        void Append(const char16 (&str)[LengthPlusOne]) { Append(str, LengthPlusOne - 1); }
+
+        // Appends str as a quoted and escaped JSON string
+        void AppendQuoted(Js::JavascriptString* str);
+
+        void FlushBuffer();
+
+    protected:
+        static const charcount_t BufferLength = 512;
+
+        StringifyWriter() : current(buffer), bufferEnd(buffer + BufferLength) {}
+
+        virtual void Flush(const char16* chars, charcount_t length) = 0;
+
+    private:
+        char16* current;
+        char16* bufferEnd;
+        char16 buffer[BufferLength];
+    };
+
+    // Collects the output of a streaming stringify in a CompoundString (JSON.stringify)
+    class CompoundStringStringifyWriter : public StringifyWriter
+    {
+    public:
+        CompoundStringStringifyWriter(Js::ScriptContext* scriptContext);
+        Js::JavascriptString* GetResult();
+
+    protected:
+        virtual void Flush(const char16* chars, charcount_t length) override;
+
+    private:
+        Js::CompoundString* result;
+    };
+
+    // Stringifies value (without replacer or space) to writer, as used by JsStringifyToUtf8Callback.
+    // Returns false, without writing anything, if the value has no JSON representation (e.g. undefined).
+    bool StringifyToWriter(Js::Var value, StringifyWriter* writer, Js::ScriptContext* scriptContext);
+
     class StringifySession
     {
     public:
@@ -39,7 +97,8 @@ namespace JSON
                 replacerType(ReplacerNone),
                 gap(NULL),
                 indent(0),
-                propertySeparator(NULL)
+                propertySeparator(NULL),
+                writer(nullptr)
         {
             replacer.propertyList.propertyNames = NULL;
             replacer.propertyList.length = 0;
@@ -47,6 +106,13 @@ namespace JSON
 
         Js::Var Stringify(){};
 
+        // Streaming mode: writes the JSON text of value to writer instead of building a string.
+        // Returns false if the value has no JSON representation, in which case nothing is written.
+        bool StringifyToWriter(Js::Var value, StringifyWriter* writer);
+
+        // Creates the {"": value} holder object passed to the first Str call
+        Js::DynamicObject* CreateWrapper(Js::Var value, Js::PropertyId* propertyId);
+
         // Init operation is split in three functions
         void InitReplacer(Js::RecyclableObject* f)
         {
@@ -67,6 +133,18 @@ namespace JSON
     private:
         Js::JavascriptString* Quote(Js::JavascriptString* value);
 
+        Js::Var GetValue(Js::JavascriptString* key, Js::PropertyId keyId, Js::Var holder);
+        Js::Var GetValue(uint32 index, Js::Var holder);
+        Js::Var ApplyFilters(Js::JavascriptString* key, Js::Var value, Js::Var holder);
+        Js::ConcatStringBuilder* NewMemberList(uint count);
+        Js::Var StrValue(Js::Var value);
+        bool IsSerializable(Js::Var value);
+
+        void WriteValue(Js::Var value);
+        void WriteIndent(uint count);
+        void WriteMemberSeparator(bool isFirstMember);
+        void WriteEnd(char16 ch, bool isEmpty, uint stepBackIndent);
+
         Js::Var StringifyObject(Js::Var value);
 
         Js::Var StringifyArray(Js::Var value);
@@ -99,6 +177,6 @@ namespace JSON
         Js::JavascriptString* gap;
         uint indent;
         Js::JavascriptString* propertySeparator;     // colon or colon+space
-        Js::Var StringifySession::StrHelper(Js::JavascriptString* key, Js::Var value, Js::Var holder);
+        StringifyWriter* writer;                      // non-null in streaming mode
     };
 } // namespace JSON
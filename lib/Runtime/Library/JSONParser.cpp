@@ -11,26 +11,28 @@ using namespace Js;
 namespace JSON
 {
     // -------- Parser implementation ------------//
-    void JSONParser::Finalizer()
+    template <typename CharType>
+    void JSONParserT<CharType>::Finalizer()
     {
         m_scanner.Finalizer();
-        if(arenaAllocatorObject)
-        {
-            this->scriptContext->ReleaseTemporaryGuestAllocator(arenaAllocatorObject);
-        }
     }
 
-    Js::Var JSONParser::Parse(LPCWSTR str, int length)
+    template <typename CharType>
+    JsonTypeCacheList* JSONParserT<CharType>::EnsureTypeCacheList()
     {
-        if (length > MIN_CACHE_LENGTH)
+        JsonTypeCacheList* list = scriptContext->GetJsonTypeCacheList();
+        if (list == nullptr)
         {
-            if (!this->arenaAllocatorObject)
-            {
-                this->arenaAllocatorObject = scriptContext->GetTemporaryGuestAllocator(_u("JSONParse"));
-                this->arenaAllocator = arenaAllocatorObject->GetAllocator();
-            }
+            list = JsonTypeCacheList::New(scriptContext->GetRecycler());
+            scriptContext->SetJsonTypeCacheList(list);
         }
-        m_scanner.Init(str, length, &m_token, scriptContext, str, this->arenaAllocator);
+        return list;
+    }
+
+    template <typename CharType>
+    Js::Var JSONParserT<CharType>::Parse(const CharType* str, uint length)
+    {
+        m_scanner.Init(str, length, &m_token, scriptContext, str, nullptr);
         Scan();
         Js::Var ret = ParseObject();
         if (m_token.tk != tkEOF)
@@ -40,12 +42,8 @@ namespace JSON
         return ret;
     }
 
-    Js::Var JSONParser::Parse(Js::JavascriptString* input)
-    {
-        return Parse(input->GetSz(), input->GetLength());
-    }
-
-    Js::Var JSONParser::Walk(Js::JavascriptString* name, Js::PropertyId id, Js::Var holder, uint32 index)
+    template <typename CharType>
+    Js::Var JSONParserT<CharType>::Walk(Js::JavascriptString* name, Js::PropertyId id, Js::Var holder, uint32 index)
     {
         AssertMsg(reviver, "JSON post parse walk with null reviver");
         Js::Var value;
@@ -188,7 +186,8 @@ namespace JSON
         return value;
     }
 
-    Js::Var JSONParser::ParseObject()
+    template <typename CharType>
+    Js::Var JSONParserT<CharType>::ParseObject()
     {
         PROBE_STACK(scriptContext, Js::Constants::MinStackDefault);
 
@@ -206,7 +205,7 @@ namespace JSON
             {
                 // will auto-null-terminate the string (as length=len+1)
                 uint len = m_scanner.GetCurrentStringLen();
-                retVal = Js::JavascriptString::NewCopyBuffer(m_scanner.GetCurrentString(), len, scriptContext);
+                retVal = Js::OneByteString::NewCopyBuffer(m_scanner.GetCurrentString(), len, scriptContext);
                 Scan();
                 return retVal;
             }
@@ -277,12 +276,9 @@ namespace JSON
             {
 
                 // Parse an object, "{"name1" : ObjMember1, "name2" : ObjMember2, ...} "
-                if(IsCaching())
+                if(!IsCaching())
                 {
-                    if(!typeCacheList)
-                    {
-                        typeCacheList = Anew(this->arenaAllocator, JsonTypeCacheList, this->arenaAllocator, 8);
-                    }
+                    typeCacheList = EnsureTypeCacheList();
                 }
 
                 // first, create the object
@@ -381,24 +377,30 @@ namespace JSON
                     {
                         PropertyIndex propertyIndex = info.GetPropertyIndex();
 
-                        if(!previousCache)
+                        if(currentCache)
+                        {
+                            // cache miss!!
+                            currentCache->Update(propertyRecord, typeWithoutProperty, typeWithProperty, propertyIndex);
+                        }
+                        else if(!previousCache)
                         {
                             // This is the first property in the set add it to the dictionary.
-                            currentCache = JsonTypeCache::New(this->arenaAllocator, propertyRecord, typeWithoutProperty, typeWithProperty, propertyIndex);
-                            typeCacheList->AddNew(propertyRecord, currentCache);
+                            if(typeCacheList->Count() < JsonTypeCacheList::MaxCount)
+                            {
+                                currentCache = JsonTypeCache::New(scriptContext->GetRecycler(), propertyRecord, typeWithoutProperty, typeWithProperty, propertyIndex);
+                                typeCacheList->AddNew(propertyRecord, currentCache);
+                            }
                         }
-                        else if(!currentCache)
+                        else
                         {
-                            currentCache = JsonTypeCache::New(this->arenaAllocator, propertyRecord, typeWithoutProperty, typeWithProperty, propertyIndex);
+                            currentCache = JsonTypeCache::New(scriptContext->GetRecycler(), propertyRecord, typeWithoutProperty, typeWithProperty, propertyIndex);
                             previousCache->next = currentCache;
                         }
-                        else
+                        if(currentCache)
                         {
-                            // cache miss!!
-                            currentCache->Update(propertyRecord, typeWithoutProperty, typeWithProperty, propertyIndex);
+                            previousCache = currentCache;
+                            currentCache = currentCache->next;
                         }
-                        previousCache = currentCache;
-                        currentCache = currentCache->next;
                     }
 
                     // if the next token is not a comma consider the list of members done.
@@ -416,4 +418,7 @@ namespace JSON
             m_scanner.ThrowSyntaxError(JSERR_JsonSyntax);
         }
     }
+
+    template class JSONParserT<char16>;
+    template class JSONParserT<utf8char_t>;
 } // namespace JSON
@@ -24,13 +24,13 @@ namespace JSON
             propertyIndex(propertyIndex),
             next(nullptr) {}
 
-        static JsonTypeCache* JsonTypeCache::New(ArenaAllocator* allocator,
+        static JsonTypeCache* New(Recycler* recycler,
             const Js::PropertyRecord* propertyRecord,
             Js::DynamicType* typeWithoutProperty,
             Js::DynamicType* typeWithProperty,
             Js::PropertyIndex propertyIndex)
         {
-            return Anew(allocator, JsonTypeCache, propertyRecord, typeWithoutProperty, typeWithProperty, propertyIndex);
+            return RecyclerNew(recycler, JsonTypeCache, propertyRecord, typeWithoutProperty, typeWithProperty, propertyIndex);
         }
 
         void Update(const Js::PropertyRecord* propertyRecord,
@@ -45,17 +45,34 @@ namespace JSON
         }
     };
 
+    // Type transition chains keyed by the first property name of an object. The list is kept on the
+    // ScriptContext so that it is shared by all JSON.parse calls, and dropped before each GC
+    // (ScriptContext::ClearScriptContextCaches) so that it does not keep types alive.
+    class JsonTypeCacheList : public JsUtil::BaseDictionary<const Js::PropertyRecord *, JsonTypeCache*, Recycler, PowerOf2SizePolicy, Js::PropertyRecordStringHashComparer>
+    {
+    public:
+        static const int MaxCount = 64; // Maximum number of distinct first properties cached
+
+        JsonTypeCacheList(Recycler* recycler) :
+            JsUtil::BaseDictionary<const Js::PropertyRecord *, JsonTypeCache*, Recycler, PowerOf2SizePolicy, Js::PropertyRecordStringHashComparer>(recycler, 8) {}
 
-    class JSONParser
+        static JsonTypeCacheList* New(Recycler* recycler)
+        {
+            return RecyclerNew(recycler, JsonTypeCacheList, recycler);
+        }
+    };
+
+    // CharType is the encoding of the JSON text, see JSONScannerT
+    template <typename CharType>
+    class JSONParserT
     {
     public:
-        JSONParser(Js::ScriptContext* sc, Js::RecyclableObject* rv) : scriptContext(sc),
-            reviver(rv),  arenaAllocatorObject(nullptr), arenaAllocator(nullptr), typeCacheList(nullptr)
+        JSONParserT(Js::ScriptContext* sc, Js::RecyclableObject* rv) : scriptContext(sc),
+            reviver(rv), typeCacheList(nullptr)
         {
         };
 
-        Js::Var Parse(LPCWSTR str, int length);
-        Js::Var Parse(Js::JavascriptString* input);
+        Js::Var Parse(const CharType* str, uint length);
         Js::Var Walk(Js::JavascriptString* name, Js::PropertyId id, Js::Var holder, uint32 index = Js::JavascriptArray::InvalidIndex);
         void Finalizer();
 
@@ -76,17 +93,17 @@ namespace JSON
 
         bool IsCaching()
         {
-            return arenaAllocator != nullptr;
+            return typeCacheList != nullptr;
         }
 
+        JsonTypeCacheList* EnsureTypeCacheList();
+
         Token m_token;
-        JSONScanner m_scanner;
+        JSONScannerT<CharType> m_scanner;
         Js::ScriptContext* scriptContext;
         Js::RecyclableObject* reviver;
-        Js::TempGuestArenaAllocatorObject* arenaAllocatorObject;
-        ArenaAllocator* arenaAllocator;
-        typedef JsUtil::BaseDictionary<const Js::PropertyRecord *, JsonTypeCache*, ArenaAllocator, PowerOf2SizePolicy, Js::PropertyRecordStringHashComparer>  JsonTypeCacheList;
         JsonTypeCacheList* typeCacheList;
-        static const int MIN_CACHE_LENGTH = 50; // Use Json type cache only if the JSON string is larger than this constant.
     };
+
+    typedef JSONParserT<char16> JSONParser;
 } // namespace JSON
@@ -10,13 +10,18 @@ using namespace Js;
 namespace JSON
 {
     // -------- Scanner implementation ------------//
-    JSONScanner::JSONScanner()
+    template <typename CharType>
+    JSONScannerT<CharType>::JSONScannerT()
         : inputText(0), inputLen(0), pToken(0), stringBuffer(0), allocator(0), allocatorObject(0),
         currentRangeCharacterPairList(0), stringBufferLength(0), currentIndex(0)
     {
+#if defined(_M_IX86) || defined(_M_X64)
+        useSSE2 = AutoSystemInfo::Data.SSE2Available() != FALSE;
+#endif
     }
 
-    void JSONScanner::Finalizer()
+    template <typename CharType>
+    void JSONScannerT<CharType>::Finalizer()
     {
         // All dynamic memory allocated by this object is on the arena - either the one this object owns or by the
         // one shared with JSON parser - here we will deallocate ours. The others will be deallocated when JSONParser
@@ -28,7 +33,8 @@ namespace JSON
         }
     }
 
-    void JSONScanner::Init(const char16* input, uint len, Token* pOutToken, Js::ScriptContext* sc, const char16* current, ArenaAllocator* allocator)
+    template <typename CharType>
+    void JSONScannerT<CharType>::Init(const CharType* input, uint len, Token* pOutToken, Js::ScriptContext* sc, const CharType* current, ArenaAllocator* allocator)
     {
         // Note that allocator could be nullptr from JSONParser, if we could not reuse an allocator, keep our own
         inputText = input;
@@ -39,7 +45,247 @@ namespace JSON
         this->allocator = allocator;
     }
 
-    tokens JSONScanner::Scan()
+    template <>
+    const char16* JSONScannerT<char16>::SkipPlainStringChars(const char16* current, const char16* end) const
+    {
+#if defined(_M_IX86) || defined(_M_X64)
+        if (useSSE2)
+        {
+            // Check 8 characters at a time for '"', '\\' and the \u0000 - \u001f range
+            const __m128i quote = _mm_set1_epi16(_u('"'));
+            const __m128i backslash = _mm_set1_epi16(_u('\\'));
+            const __m128i lastControlChar = _mm_set1_epi16(0x1F);
+            const __m128i zero = _mm_setzero_si128();
+            while (end - current >= 8)
+            {
+                const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(current));
+                const __m128i special = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi16(chars, quote), _mm_cmpeq_epi16(chars, backslash)),
+                    _mm_cmpeq_epi16(_mm_subs_epu16(chars, lastControlChar), zero));
+                const int mask = _mm_movemask_epi8(special);
+                if (mask != 0)
+                {
+                    DWORD index;
+                    _BitScanForward(&index, (DWORD)mask);
+                    return current + index / sizeof(char16);
+                }
+                current += 8;
+            }
+        }
+#endif
+        while (current < end)
+        {
+            const char16 ch = *current;
+            if (ch == '"' || ch == '\\' || ch <= 0x1F)
+            {
+                break;
+            }
+            current++;
+        }
+        return current;
+    }
+
+    template <>
+    const char16* JSONScannerT<char16>::SkipDigits(const char16* current, const char16* end) const
+    {
+#if defined(_M_IX86) || defined(_M_X64)
+        if (useSSE2)
+        {
+            // (ch - '0') wraps around for characters below '0', so a digit is (ch - '0') <= 9 unsigned
+            const __m128i zeroChar = _mm_set1_epi16(_u('0'));
+            const __m128i nine = _mm_set1_epi16(9);
+            const __m128i zero = _mm_setzero_si128();
+            while (end - current >= 8)
+            {
+                const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(current));
+                const __m128i digits = _mm_cmpeq_epi16(_mm_subs_epu16(_mm_sub_epi16(chars, zeroChar), nine), zero);
+                const int mask = _mm_movemask_epi8(digits) ^ 0xFFFF;
+                if (mask != 0)
+                {
+                    DWORD index;
+                    _BitScanForward(&index, (DWORD)mask);
+                    return current + index / sizeof(char16);
+                }
+                current += 8;
+            }
+        }
+#endif
+        while (current < end && IsDigit(*current))
+        {
+            current++;
+        }
+        return current;
+    }
+
+    template <>
+    const utf8char_t* JSONScannerT<utf8char_t>::SkipPlainStringChars(const utf8char_t* current, const utf8char_t* end) const
+    {
+        // Bytes of multi-byte UTF-8 sequences are all >= 0x80, so they are plain string characters
+#if defined(_M_IX86) || defined(_M_X64)
+        if (useSSE2)
+        {
+            // Check 16 bytes at a time for '"', '\\' and the 0x00 - 0x1f range
+            const __m128i quote = _mm_set1_epi8('"');
+            const __m128i backslash = _mm_set1_epi8('\\');
+            const __m128i lastControlChar = _mm_set1_epi8(0x1F);
+            const __m128i zero = _mm_setzero_si128();
+            while (end - current >= 16)
+            {
+                const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(current));
+                const __m128i special = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(chars, quote), _mm_cmpeq_epi8(chars, backslash)),
+                    _mm_cmpeq_epi8(_mm_subs_epu8(chars, lastControlChar), zero));
+                const int mask = _mm_movemask_epi8(special);
+                if (mask != 0)
+                {
+                    DWORD index;
+                    _BitScanForward(&index, (DWORD)mask);
+                    return current + index;
+                }
+                current += 16;
+            }
+        }
+#endif
+        while (current < end)
+        {
+            const utf8char_t ch = *current;
+            if (ch == '"' || ch == '\\' || ch <= 0x1F)
+            {
+                break;
+            }
+            current++;
+        }
+        return current;
+    }
+
+    template <>
+    const utf8char_t* JSONScannerT<utf8char_t>::SkipDigits(const utf8char_t* current, const utf8char_t* end) const
+    {
+#if defined(_M_IX86) || defined(_M_X64)
+        if (useSSE2)
+        {
+            const __m128i zeroChar = _mm_set1_epi8('0');
+            const __m128i nine = _mm_set1_epi8(9);
+            const __m128i zero = _mm_setzero_si128();
+            while (end - current >= 16)
+            {
+                const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(current));
+                const __m128i digits = _mm_cmpeq_epi8(_mm_subs_epu8(_mm_sub_epi8(chars, zeroChar), nine), zero);
+                const int mask = _mm_movemask_epi8(digits) ^ 0xFFFF;
+                if (mask != 0)
+                {
+                    DWORD index;
+                    _BitScanForward(&index, (DWORD)mask);
+                    return current + index;
+                }
+                current += 16;
+            }
+        }
+#endif
+        while (current < end && IsDigit(*current))
+        {
+            current++;
+        }
+        return current;
+    }
+
+    template <>
+    uint JSONScannerT<char16>::CopyChars(char16* dest, const char16* src, uint count)
+    {
+        js_wmemcpy_s(dest, count, src, count);
+        return count;
+    }
+
+    template <>
+    uint JSONScannerT<utf8char_t>::CopyChars(char16* dest, const utf8char_t* src, uint count)
+    {
+        // Ranges are always split on ASCII characters so a multi-byte sequence is never cut in two
+        LPCUTF8 current = src;
+        return (uint)utf8::DecodeUnitsInto(dest, current, src + count);
+    }
+
+    template <>
+    void JSONScannerT<char16>::SetCurrentStringFromInput(const char16* bulkStart, uint bulkLength)
+    {
+        // No escapes: the string is directly mapped in the input text
+        this->currentString = const_cast<char16*>(bulkStart);
+        this->currentIndex = bulkLength;
+
+        OUTPUT_TRACE_DEBUGONLY(Js::JSONPhase, _u("ScanString(): direct-mapped string as '%.*s'\n"),
+            GetCurrentStringLen(), GetCurrentString());
+    }
+
+    template <>
+    void JSONScannerT<utf8char_t>::SetCurrentStringFromInput(const utf8char_t* bulkStart, uint bulkLength)
+    {
+        // No escapes, but the input still needs to be decoded to char16. The decoded string is never
+        // longer (in code units) than its UTF-8 encoding, so the byte length is enough for the buffer.
+        this->EnsureStringBuffer(max(bulkLength, 1u));
+        this->currentIndex = CopyChars(this->stringBuffer, bulkStart, bulkLength);
+        this->currentString = this->stringBuffer;
+
+        OUTPUT_TRACE_DEBUGONLY(Js::JSONPhase, _u("ScanString(): decoded string as '%.*s'\n"),
+            GetCurrentStringLen(), GetCurrentString());
+    }
+
+    template <>
+    double JSONScannerT<char16>::ScanNumber()
+    {
+        // The input of JSON.parse is a null terminated JavaScript string
+        const char16* end;
+        double val = Js::NumberUtilities::StrToDbl(currentChar, &end, scriptContext);
+        if (currentChar == end)
+        {
+           ThrowSyntaxError(JSERR_JsonBadNumber);
+        }
+        currentChar = end;
+        return val;
+    }
+
+    template <>
+    double JSONScannerT<utf8char_t>::ScanNumber()
+    {
+        // A host buffer need not be null terminated, so StrToDbl is given a null terminated copy of the
+        // characters that can be part of the number. The JSON grammar was already verified by IsJSONNumber.
+        const utf8char_t* inputEnd = inputText + inputLen;
+        const utf8char_t* numberEnd = currentChar;
+        while (numberEnd < inputEnd)
+        {
+            const utf8char_t ch = *numberEnd;
+            if (!IsDigit(ch) && ch != '.' && ch != 'e' && ch != 'E' && ch != '+' && ch != '-')
+            {
+                break;
+            }
+            numberEnd++;
+        }
+
+        const uint numberLength = (uint)(numberEnd - currentChar);
+        utf8char_t localBuffer[64];
+        utf8char_t* buffer = localBuffer;
+        if (numberLength >= _countof(localBuffer))
+        {
+            buffer = AnewArray(this->GetAllocator(), utf8char_t, numberLength + 1);
+        }
+        memcpy(buffer, currentChar, numberLength);
+        buffer[numberLength] = '\0';
+
+        const utf8char_t* end;
+        double val = Js::NumberUtilities::StrToDbl<utf8char_t>(buffer, &end, scriptContext);
+        if (buffer == end)
+        {
+           ThrowSyntaxError(JSERR_JsonBadNumber);
+        }
+        currentChar += end - buffer;
+
+        if (buffer != localBuffer)
+        {
+            AdeleteArray(this->GetAllocator(), numberLength + 1, buffer);
+        }
+        return val;
+    }
+
+    template <typename CharType>
+    tokens JSONScannerT<CharType>::Scan()
     {
         pTokenString = currentChar;
 
@@ -79,23 +325,16 @@ namespace JSON
 
                     // we use StrToDbl() here for compat with the rest of the engine. StrToDbl() accept a larger syntax.
                     // Verify first the JSON grammar.
-                    const char16* saveCurrentChar = currentChar;
+                    const CharType* saveCurrentChar = currentChar;
                     if(!IsJSONNumber())
                     {
                        ThrowSyntaxError(JSERR_JsonBadNumber);
                     }
                     currentChar = saveCurrentChar;
-                    double val;
-                    const char16* end;
-                    val = Js::NumberUtilities::StrToDbl(currentChar, &end, scriptContext);
-                    if(currentChar == end)
-                    {
-                       ThrowSyntaxError(JSERR_JsonBadNumber);
-                    }
+                    double val = ScanNumber();
                     AssertMsg(!Js::JavascriptNumber::IsNan(val), "Bad result from string to double conversion");
                     pToken->tk = tkFltCon;
                     pToken->SetDouble(val, false);
-                    currentChar = end;
                     return tkFltCon;
                 }
 
@@ -156,83 +395,71 @@ namespace JSON
         return (pToken->tk = tkEOF);
     }
 
-    bool JSONScanner::IsJSONNumber()
+    template <typename CharType>
+    bool JSONScannerT<CharType>::IsJSONNumber()
     {
-        bool firstDigitIsAZero = false;
-        if (PeekNextChar() == '0')
-        {
-            firstDigitIsAZero = true;
-            currentChar++;
-        }
+        const CharType* inputEnd = inputText + inputLen;
 
         //partial verification of number JSON grammar.
-        while (currentChar < inputText + inputLen)
+        if (PeekNextChar() == '0')
         {
-            switch(ReadNextChar())
+            // no other digit can follow a leading zero
+            currentChar++;
+            if (currentChar < inputEnd && IsDigit(PeekNextChar()))
             {
-            case 0:
                 return false;
-            case '0':
-            case '1':
-            case '2':
-            case '3':
-            case '4':
-            case '5':
-            case '6':
-            case '7':
-            case '8':
-            case '9':
-                if (firstDigitIsAZero)
-                {
-                    return false;
-                }
-                break;
-
-            case '.':
-                {
-                    // at least one digit after '.'
-                    if(currentChar < inputText + inputLen)
-                    {
-                        char16 nch = ReadNextChar();
-                        if('0' <= nch && nch <= '9')
-                        {
-                            return true;
-                        }
-                        else
-                        {
-                            return false;
-                        }
-                    }
-                    else
-                    {
-                        return false;
-                    }
-                }
-                //case 'E':
-                //case 'e':
-                //    return true;
-            default:
-                return true;
             }
+        }
+        else
+        {
+            currentChar = SkipDigits(currentChar, inputEnd);
+        }
+
+        if (currentChar >= inputEnd)
+        {
+            return true;
+        }
 
-            firstDigitIsAZero = false;
+        switch(ReadNextChar())
+        {
+        case 0:
+            return false;
+
+        case '.':
+            // at least one digit after '.'
+            return currentChar < inputEnd && IsDigit(ReadNextChar());
+
+        //case 'E':
+        //case 'e':
+        //    return true;
+        default:
+            return true;
         }
-        return true;
     }
 
-    tokens JSONScanner::ScanString()
+    template <typename CharType>
+    tokens JSONScannerT<CharType>::ScanString()
     {
         char16 ch;
 
         this->currentIndex = 0;
-        this->currentString = const_cast<char16*>(currentChar);
         bool endFound = false;
         bool isStringDirectInputTextMapped = true;
-        LPCWSTR bulkStart = currentChar;
+        const CharType* bulkStart = currentChar;
         uint bulkLength = 0;
 
-        while (currentChar < inputText + inputLen)
+        const CharType* inputEnd = inputText + inputLen;
+        while (currentChar < inputEnd)
         {
+            // Skip over the run of characters that need no processing in bulk
+            const CharType* plainEnd = SkipPlainStringChars(currentChar, inputEnd);
+            bulkLength += (uint)(plainEnd - currentChar);
+            currentChar = plainEnd;
+            if (currentChar >= inputEnd)
+            {
+                break;
+            }
+
             ch = ReadNextChar();
             int tempHex;
 
@@ -394,35 +621,23 @@ namespace JSON
         }
         else
         {
-            // make currentIndex the length (w/o the \0)
-            currentIndex = bulkLength;
-
-            OUTPUT_TRACE_DEBUGONLY(Js::JSONPhase, _u("ScanString(): direct-mapped string as '%.*s'\n"),
-                GetCurrentStringLen(), GetCurrentString());
+            this->SetCurrentStringFromInput(bulkStart, bulkLength);
         }
 
         return (pToken->tk = tkStrCon);
     }
 
-    void JSONScanner::BuildUnescapedString(bool shouldSkipLastCharacter)
+    template <typename CharType>
+    void JSONScannerT<CharType>::BuildUnescapedString(bool shouldSkipLastCharacter)
     {
         AssertMsg(this->allocator != nullptr, "We must have built the allocator");
         AssertMsg(this->currentRangeCharacterPairList != nullptr, "We must have built the currentRangeCharacterPairList");
         AssertMsg(this->currentRangeCharacterPairList->Count() > 0, "We need to build the current string only because we have escaped characters");
 
         // Step 1: Ensure the buffer has sufficient space
+        // (for UTF-8 input the current length is in bytes, an upper bound of the decoded length)
         int requiredSize = this->GetCurrentStringLen();
-        if (requiredSize > this->stringBufferLength)
-        {
-            if (this->stringBuffer)
-            {
-                AdeleteArray(this->allocator, this->stringBufferLength, this->stringBuffer);
-                this->stringBuffer = nullptr;
-            }
-
-            this->stringBuffer = AnewArray(this->allocator, char16, requiredSize);
-            this->stringBufferLength = requiredSize;
-        }
+        this->EnsureStringBuffer(requiredSize);
 
         // Step 2: Copy the data to the buffer
         int totalCopied = 0;
@@ -431,10 +646,9 @@ namespace JSON
         for (int i = 0; i <= lastCharacterIndex; i++)
         {
             RangeCharacterPair data = this->currentRangeCharacterPairList->Item(i);
-            int charactersToCopy = data.m_rangeLength;
-            js_wmemcpy_s(begin_copy, charactersToCopy, this->inputText + data.m_rangeStart, charactersToCopy);
-            begin_copy += charactersToCopy;
-            totalCopied += charactersToCopy;
+            int charactersCopied = CopyChars(begin_copy, this->inputText + data.m_rangeStart, data.m_rangeLength);
+            begin_copy += charactersCopied;
+            totalCopied += charactersCopied;
 
             if (i == lastCharacterIndex && shouldSkipLastCharacter)
             {
@@ -446,28 +660,57 @@ namespace JSON
             totalCopied++;
         }
 
-        if (totalCopied != requiredSize)
+        if (totalCopied != requiredSize && sizeof(CharType) == sizeof(char16))
         {
             OUTPUT_TRACE_DEBUGONLY(Js::JSONPhase, _u("BuildUnescapedString(): allocated size = %d != copying size %d\n"), requiredSize, totalCopied);
             AssertMsg(totalCopied == requiredSize, "BuildUnescapedString(): The allocated size and copying size should match.");
         }
+        AssertMsg(totalCopied <= requiredSize, "BuildUnescapedString(): Copied more than the allocated size.");
+        this->currentIndex = totalCopied;
 
         OUTPUT_TRACE_DEBUGONLY(Js::JSONPhase, _u("BuildUnescapedString(): unescaped string as '%.*s'\n"), GetCurrentStringLen(), this->stringBuffer);
     }
 
-    JSONScanner::RangeCharacterPairList* JSONScanner::GetCurrentRangeCharacterPairList(void)
+    template <typename CharType>
+    void JSONScannerT<CharType>::EnsureStringBuffer(int requiredSize)
     {
-        if (this->currentRangeCharacterPairList == nullptr)
+        if (requiredSize > this->stringBufferLength)
         {
-            if (this->allocator == nullptr)
+            ArenaAllocator* allocator = this->GetAllocator();
+            if (this->stringBuffer)
             {
-                this->allocatorObject = this->scriptContext->GetTemporaryGuestAllocator(_u("JSONScanner"));
-                this->allocator = this->allocatorObject->GetAllocator();
+                AdeleteArray(allocator, this->stringBufferLength, this->stringBuffer);
+                this->stringBuffer = nullptr;
             }
 
-            this->currentRangeCharacterPairList = Anew(this->allocator, RangeCharacterPairList, this->allocator, 4);
+            this->stringBuffer = AnewArray(allocator, char16, requiredSize);
+            this->stringBufferLength = requiredSize;
+        }
+    }
+
+    template <typename CharType>
+    ArenaAllocator* JSONScannerT<CharType>::GetAllocator()
+    {
+        if (this->allocator == nullptr)
+        {
+            this->allocatorObject = this->scriptContext->GetTemporaryGuestAllocator(_u("JSONScanner"));
+            this->allocator = this->allocatorObject->GetAllocator();
+        }
+        return this->allocator;
+    }
+
+    template <typename CharType>
+    typename JSONScannerT<CharType>::RangeCharacterPairList* JSONScannerT<CharType>::GetCurrentRangeCharacterPairList(void)
+    {
+        if (this->currentRangeCharacterPairList == nullptr)
+        {
+            ArenaAllocator* allocator = this->GetAllocator();
+            this->currentRangeCharacterPairList = Anew(allocator, RangeCharacterPairList, allocator, 4);
         }
 
         return this->currentRangeCharacterPairList;
     }
+
+    template class JSONScannerT<char16>;
+    template class JSONScannerT<utf8char_t>;
 } // namespace JSON
@@ -6,18 +6,21 @@
 
 namespace JSON
 {
-    class JSONParser;
-
     // Small scanner for exclusive JSON purpose. The general
     // JScript scanner is not appropriate here because of the JSON restricted lexical grammar
     // token enums and structures are shared although the token semantics is slightly different.
-    class JSONScanner
+    //
+    // CharType is the encoding of the input: char16 for JavaScript strings, or utf8char_t for UTF-8
+    // buffers handed over by the host (JsParseJsonUtf8). Strings are always produced as char16; UTF-8
+    // input is decoded one string token at a time into the scanner's string buffer.
+    template <typename CharType>
+    class JSONScannerT
     {
     public:
-        JSONScanner();
+        JSONScannerT();
         tokens Scan();
-        void Init(const char16* input, uint len, Token* pOutToken,
-            ::Js::ScriptContext* sc, const char16* current, ArenaAllocator* allocator);
+        void Init(const CharType* input, uint len, Token* pOutToken,
+            ::Js::ScriptContext* sc, const CharType* current, ArenaAllocator* allocator);
 
         void Finalizer();
         char16* GetCurrentString() { return currentString; } 
@@ -50,15 +53,22 @@ namespace JSON
         Js::TempGuestArenaAllocatorObject* allocatorObject;
         ArenaAllocator* allocator;
         void BuildUnescapedString(bool shouldSkipLastCharacter);
+        void SetCurrentStringFromInput(const CharType* bulkStart, uint bulkLength);
+        void EnsureStringBuffer(int requiredSize);
+        ArenaAllocator* GetAllocator();
+        double ScanNumber();
+
+        // Copies count input characters to dest as char16, returning the number of char16 written (at most count)
+        static uint CopyChars(char16* dest, const CharType* src, uint count);
 
         RangeCharacterPairList* GetCurrentRangeCharacterPairList(void);
 
-        inline char16 ReadNextChar(void)
+        inline CharType ReadNextChar(void)
         {
             return *currentChar++;
         }
 
-        inline char16 PeekNextChar(void)
+        inline CharType PeekNextChar(void)
         {
             return *currentChar;
         }
@@ -66,10 +76,20 @@ namespace JSON
         tokens ScanString();
         bool IsJSONNumber();
 
-        const char16* inputText;
+        // Bulk scanning helpers: return the first character in [current, end) that is not a plain
+        // string character (i.e. '"', '\\' or a control character), or not a decimal digit
+        const CharType* SkipPlainStringChars(const CharType* current, const CharType* end) const;
+        const CharType* SkipDigits(const CharType* current, const CharType* end) const;
+
+        static bool IsDigit(CharType ch)
+        {
+            return (CharType)(ch - '0') <= 9;
+        }
+
+        const CharType* inputText;
         uint    inputLen;
-        const char16* currentChar;
-        const char16* pTokenString;
+        const CharType* currentChar;
+        const CharType* pTokenString;
 
         Token*   pToken;
         ::Js::ScriptContext* scriptContext;
@@ -78,7 +98,12 @@ namespace JSON
         char16* currentString;
         __field_ecount(stringBufferLength) char16* stringBuffer;
         int      stringBufferLength;
+#if defined(_M_IX86) || defined(_M_X64)
+        bool     useSSE2;
+#endif
 
-        friend class JSONParser;
+        template <typename T> friend class JSONParserT;
     };
+
+    typedef JSONScannerT<char16> JSONScanner;
 } // namespace JSON
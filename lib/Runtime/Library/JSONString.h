@@ -52,6 +52,12 @@ namespace Js
         static const WCHAR escapeMap[128];
         static const BYTE escapeMapCount[128];
     public:
+        // Returns the character following the '\\' of the escape sequence for wch, or '\0' if wch is not escaped
+        static WCHAR GetEscapeChar(char16 wch)
+        {
+            return wch < _countof(escapeMap) ? escapeMap[wch] : _u('\0');
+        }
+
         template <EscapingOperation op>
         static Js::JavascriptString* Escape(Js::JavascriptString* value, uint start = 0, WritableStringBuffer* outputString = nullptr)
         {
@@ -3628,9 +3628,9 @@ namespace Js
             {
                 return includesAlgorithm ? falseValue : TaggedInt::ToVarUnchecked(-1);
             }
-            int32 index = pArr->HeadSegmentIndexOfHelper(search, fromIndex, len, includesAlgorithm, scriptContext);
+            int32 index = pArr->SegmentsIndexOfHelper(search, fromIndex, len, includesAlgorithm, scriptContext);
 
-            // If we found the search value in the head segment, or if we determined there is no need to search other segments,
+            // If we found the search value in the segments, or if we determined there is no need to search any further,
             // we stop right here.
             if (index != -1 || fromIndex == -1)
             {
@@ -3646,7 +3646,7 @@ namespace Js
                 }
             }
 
-            //  If we really must search other segments, let's do it now. We'll have to search the slow way (dealing with holes, etc.).
+            //  If we really must search the rest of the array, let's do it now. We'll have to search the slow way (dealing with holes, etc.).
 
             switch (pArr->GetTypeId())
             {
@@ -3918,7 +3918,7 @@ namespace Js
         return includesAlgorithm ? falseValue :  TaggedInt::ToVarUnchecked(-1);
     }
 
-    int32 JavascriptArray::HeadSegmentIndexOfHelper(Var search, uint32 &fromIndex, uint32 toIndex, bool includesAlgorithm, ScriptContext * scriptContext)
+    int32 JavascriptArray::SegmentsIndexOfHelper(Var search, uint32 &fromIndex, uint32 toIndex, bool includesAlgorithm, ScriptContext * scriptContext)
     {
         Assert(Is(GetTypeId()) && !JavascriptNativeArray::Is(GetTypeId()));
 
@@ -3985,7 +3985,18 @@ namespace Js
         }
         else
         {
-            for (uint32 i = 0; i < length; i++)
+            uint32 i = 0;
+#if defined(_M_IX86) || defined(_M_X64)
+            if (AutoSystemInfo::Data.SSE2Available())
+            {
+                const __m128d values = _mm_set1_pd(value);
+                for (; length - i >= 2; i += 2)
+                {
+                    _mm_storeu_pd(buffer + i, values);
+                }
+            }
+#endif
+            for (; i < length; i++)
             {
                 buffer[i] = value;
             }
@@ -4001,7 +4012,18 @@ namespace Js
         }
         else
         {
-            for (uint32 i = 0; i < length; i++)
+            uint32 i = 0;
+#if defined(_M_IX86) || defined(_M_X64)
+            if (AutoSystemInfo::Data.SSE2Available())
+            {
+                const __m128i values = _mm_set1_epi32(value);
+                for (; length - i >= 4; i += 4)
+                {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(buffer + i), values);
+                }
+            }
+#endif
+            for (; i < length; i++)
             {
                 buffer[i] = value;
             }
@@ -4017,116 +4039,188 @@ namespace Js
         }
     }
 
-    int32 JavascriptNativeIntArray::HeadSegmentIndexOfHelper(Var search, uint32 &fromIndex, uint32 toIndex, bool includesAlgorithm,  ScriptContext * scriptContext)
+    template<typename T, typename Fn>
+    int32 JavascriptArray::NativeSegmentsIndexOfHelper(uint32 &fromIndex, const uint32 toIndex, Fn findValueOrMissingItem) const
     {
-        // We proceed largely in the same manner as in JavascriptArray's version of this method (see comments there for more information),
-        // except when we can further optimize thanks to the knowledge that all elements in the array are int32's. This allows for two additional optimizations:
-        // 1. Only tagged ints or JavascriptNumbers that can be represented as int32 can be strict equal to some element in the array (all int32). Thus, if
-        // the search value is some other kind of Var, we can return -1 without ever iterating over the elements.
-        // 2. If the search value is a number that can be represented as int32, then we inspect the elements, but we don't need to perform the full strict equality algorithm.
-        // Instead we can use simple C++ equality (which in case of such values is equivalent to strict equality in JavaScript).
-
-        if (!HasNoMissingValues() || fromIndex >= GetHead()->length)
+        // Search the segments from fromIndex for as long as the elements are contiguous. Missing items and gaps between
+        // segments are holes that may be filled in by a prototype, so the generic search has to take over at the first one.
+        if (fromIndex >= toIndex)
         {
             return -1;
         }
 
-        bool isSearchTaggedInt = TaggedInt::Is(search);
-        if (!isSearchTaggedInt && !JavascriptNumber::Is_NoTaggedIntCheck(search))
-        {
-            // The value can't be in the array, but it could be in a prototype, and we can only guarantee that
-            // the head segment has no gaps.
-            fromIndex = toIndex > GetHead()->length ? GetHead()->length : -1;
-            return -1;
-        }
-        int32 searchAsInt32;
-        if (isSearchTaggedInt)
+        uint32 index = fromIndex;
+        SparseArraySegmentBase *seg = GetBeginLookupSegment(index);
+        for (; seg != nullptr && index < toIndex; seg = seg->next)
         {
-            searchAsInt32 = TaggedInt::ToInt32(search);
-        }
-        else if (!JavascriptNumber::TryGetInt32Value<true>(JavascriptNumber::GetValue(search), &searchAsInt32))
-        {
-            // The value can't be in the array, but it could be in a prototype, and we can only guarantee that
-            // the head segment has no gaps.
-            fromIndex = toIndex > GetHead()->length ? GetHead()->length : -1;
-            return -1;
+            if (index < seg->left)
+            {
+                fromIndex = index;
+                return -1;
+            }
+
+            const uint32 segEnd = seg->left + seg->length;
+            if (index >= segEnd)
+            {
+                continue;
+            }
+
+            const uint32 searchEnd = segEnd < toIndex ? segEnd : toIndex;
+            const T *const elements = static_cast<SparseArraySegment<T>*>(seg)->elements + (index - seg->left);
+            const uint32 count = searchEnd - index;
+            const uint32 found = findValueOrMissingItem(elements, count);
+            if (found != count)
+            {
+                if (SparseArraySegment<T>::IsMissingItem(&elements[found]) || index + found > INT32_MAX)
+                {
+                    fromIndex = index + found;
+                    return -1;
+                }
+                return index + found;
+            }
+            index = searchEnd;
         }
 
-        // We need to cast head segment to SparseArraySegment<int32> to have access to GetElement (onSparseArraySegment<T>). Because there are separate overloads of this
-        // virtual method on JavascriptNativeIntArray and JavascriptNativeFloatArray, we know this version of this method will only be called for true JavascriptNativeIntArray, and not for
-        // the other two, so the elements of each segment used here must be int32's. Hence, the cast is safe.
+        // Anything left past the last segment is a hole as well
+        fromIndex = index < toIndex ? index : -1;
+        return -1;
+    }
 
-        SparseArraySegment<int32> * head = static_cast<SparseArraySegment<int32>*>(GetHead());
-        uint32 toIndexTrimmed = toIndex <= head->length ? toIndex : head->length;
-        for (uint32 i = fromIndex; i < toIndexTrimmed; i++)
+    uint32 JavascriptArray::FindValueOrMissingItem(const int32 * elements, const uint32 count, const int32 value)
+    {
+        uint32 i = 0;
+#if defined(_M_IX86) || defined(_M_X64)
+        if (AutoSystemInfo::Data.SSE2Available())
         {
-            int32 element = head->GetElement(i);
-            if (searchAsInt32 == element)
+            // Compare 4 elements at a time against both the value and the missing item
+            const __m128i values = _mm_set1_epi32(value);
+            const __m128i missingItems = _mm_set1_epi32(JavascriptNativeIntArray::MissingItem);
+            for (; count - i >= 4; i += 4)
+            {
+                const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(elements + i));
+                const __m128i matches = _mm_or_si128(_mm_cmpeq_epi32(chunk, values), _mm_cmpeq_epi32(chunk, missingItems));
+                const int mask = _mm_movemask_ps(_mm_castsi128_ps(matches));
+                if (mask != 0)
+                {
+                    DWORD bit;
+                    _BitScanForward(&bit, (DWORD)mask);
+                    return i + bit;
+                }
+            }
+        }
+#endif
+        for (; i < count; i++)
+        {
+            if (elements[i] == value || elements[i] == JavascriptNativeIntArray::MissingItem)
             {
                 return i;
             }
         }
-
-        // Element not found in the head segment. Keep looking only if the range of indices extends past
-        // the head segment.
-        fromIndex = toIndex > GetHead()->length ? GetHead()->length : -1;
-        return -1;
+        return count;
     }
 
-    int32 JavascriptNativeFloatArray::HeadSegmentIndexOfHelper(Var search, uint32 &fromIndex, uint32 toIndex, bool includesAlgorithm, ScriptContext * scriptContext)
+    int32 JavascriptNativeIntArray::SegmentsIndexOfHelper(Var search, uint32 &fromIndex, uint32 toIndex, bool includesAlgorithm,  ScriptContext * scriptContext)
     {
-        // We proceed largely in the same manner as in JavascriptArray's version of this method (see comments there for more information),
-        // except when we can further optimize thanks to the knowledge that all elements in the array are doubles. This allows for two additional optimizations:
-        // 1. Only tagged ints or JavascriptNumbers can be strict equal to some element in the array (all doubles). Thus, if
-        // the search value is some other kind of Var, we can return -1 without ever iterating over the elements.
-        // 2. If the search value is a number, then we inspect the elements, but we don't need to perform the full strict equality algorithm.
+        // Unlike JavascriptArray's version of this method, the elements of all segments are searched, as they can be compared
+        // without looking them up. All elements in the array are int32's, which allows for two additional optimizations:
+        // 1. Only tagged ints or JavascriptNumbers that can be represented as int32 can be strict equal to some element in the array (all int32). Thus, if
+        // the search value is some other kind of Var, we only need to look for holes, where a prototype may provide the value.
+        // 2. If the search value is a number that can be represented as int32, then we inspect the elements, but we don't need to perform the full strict equality algorithm.
         // Instead we can use simple C++ equality (which in case of such values is equivalent to strict equality in JavaScript).
+        // The missing item is never stored as a value, so looking for it finds only the holes.
 
-        if (!HasNoMissingValues() || fromIndex >= GetHead()->length)
+        int32 searchAsInt32 = MissingItem;
+        if (TaggedInt::Is(search))
         {
-            return -1;
+            searchAsInt32 = TaggedInt::ToInt32(search);
         }
-
-        bool isSearchTaggedInt = TaggedInt::Is(search);
-        if (!isSearchTaggedInt && !JavascriptNumber::Is_NoTaggedIntCheck(search))
+        else if (JavascriptNumber::Is_NoTaggedIntCheck(search))
         {
-            // The value can't be in the array, but it could be in a prototype, and we can only guarantee that
-            // the head segment has no gaps.
-            fromIndex = toIndex > GetHead()->length ? GetHead()->length : -1;
-            return -1;
+            int32 value;
+            if (JavascriptNumber::TryGetInt32Value<true>(JavascriptNumber::GetValue(search), &value))
+            {
+                searchAsInt32 = value;
+            }
         }
 
-        double searchAsDouble = isSearchTaggedInt ? TaggedInt::ToDouble(search) : JavascriptNumber::GetValue(search);
-
-        // We need to cast head segment to SparseArraySegment<double> to have access to GetElement (SparseArraySegment). We know the
-        // segment's elements are all Vars so the cast is safe. It would have been more convenient here if JavascriptArray
-        // used SparseArraySegment<Var>, instead of SparseArraySegmentBase.
-
-
-        SparseArraySegment<double> * head = static_cast<SparseArraySegment<double>*>(GetHead());
-        uint32 toIndexTrimmed = toIndex <= head->length ? toIndex : head->length;
-
-        bool matchNaN = includesAlgorithm && JavascriptNumber::IsNan(searchAsDouble);
-
-        for (uint32 i = fromIndex; i < toIndexTrimmed; i++)
+        return NativeSegmentsIndexOfHelper<int32>(fromIndex, toIndex, [=](const int32 * elements, uint32 count)
         {
-            double element = head->GetElement(i);
+            return FindValueOrMissingItem(elements, count, searchAsInt32);
+        });
+    }
 
-            if (element == searchAsDouble)
+    uint32 JavascriptArray::FindValueOrMissingItem(const double * elements, const uint32 count, const double value, const bool matchNaN)
+    {
+        uint32 i = 0;
+#if defined(_M_IX86) || defined(_M_X64)
+        if (AutoSystemInfo::Data.SSE2Available())
+        {
+            // Compare 2 elements at a time against the value, and against the missing item bitwise like IsMissingItem does.
+            // The missing item is a negative denormal, which a floating point compare could confuse with -0 when denormals
+            // are flushed. SSE2 has no 64-bit integer compare, so both halves of an element have to match.
+            const __m128d values = _mm_set1_pd(value);
+            const __m128i missingItems = _mm_castpd_si128(_mm_set1_pd(JavascriptNativeFloatArray::MissingItem));
+            for (; count - i >= 2; i += 2)
             {
-                return i;
+                const __m128d chunk = _mm_loadu_pd(elements + i);
+                __m128d matches = _mm_cmpeq_pd(chunk, values);
+                if (matchNaN)
+                {
+                    matches = _mm_or_pd(matches, _mm_cmpunord_pd(chunk, chunk));
+                }
+                const __m128i halfMatches = _mm_cmpeq_epi32(_mm_castpd_si128(chunk), missingItems);
+                const __m128i missingMatches = _mm_and_si128(halfMatches, _mm_shuffle_epi32(halfMatches, _MM_SHUFFLE(2, 3, 0, 1)));
+                const int mask = _mm_movemask_pd(_mm_or_pd(matches, _mm_castsi128_pd(missingMatches)));
+                if (mask != 0)
+                {
+                    DWORD bit;
+                    _BitScanForward(&bit, (DWORD)mask);
+                    return i + bit;
+                }
             }
-
+        }
+#endif
+        for (; i < count; i++)
+        {
+            const double element = elements[i];
             //NaN != NaN we expect to match for NaN in Array.prototype.includes algorithm
-            if (matchNaN && JavascriptNumber::IsNan(element))
+            if (element == value || (matchNaN && JavascriptNumber::IsNan(element)) || SparseArraySegment<double>::IsMissingItem(&elements[i]))
             {
                 return i;
             }
+        }
+        return count;
+    }
+
+    int32 JavascriptNativeFloatArray::SegmentsIndexOfHelper(Var search, uint32 &fromIndex, uint32 toIndex, bool includesAlgorithm, ScriptContext * scriptContext)
+    {
+        // We proceed largely in the same manner as in JavascriptNativeIntArray's version of this method (see comments there for more information),
+        // except that all elements in the array are doubles:
+        // 1. Only tagged ints or JavascriptNumbers can be strict equal to some element in the array (all doubles). Thus, if
+        // the search value is some other kind of Var, we only need to look for holes. No element compares equal to NaN, so
+        // searching for NaN without matchNaN finds only the holes.
+        // 2. If the search value is a number, then we inspect the elements, but we don't need to perform the full strict equality algorithm.
+        // Instead we can use simple C++ equality (which in case of such values is equivalent to strict equality in JavaScript).
 
+        double searchAsDouble = JavascriptNumber::NaN;
+        if (TaggedInt::Is(search))
+        {
+            searchAsDouble = TaggedInt::ToDouble(search);
+        }
+        else if (JavascriptNumber::Is_NoTaggedIntCheck(search))
+        {
+            searchAsDouble = JavascriptNumber::GetValue(search);
+        }
+        else
+        {
+            includesAlgorithm = false;
         }
 
-        fromIndex = toIndex > GetHead()->length ? GetHead()->length : -1;
-        return -1;
+        const bool matchNaN = includesAlgorithm && JavascriptNumber::IsNan(searchAsDouble);
+        return NativeSegmentsIndexOfHelper<double>(fromIndex, toIndex, [=](const double * elements, uint32 count)
+        {
+            return FindValueOrMissingItem(elements, count, searchAsDouble, matchNaN);
+        });
     }
 
     Var JavascriptArray::EntryJoin(RecyclableObject* function, CallInfo callInfo, ...)
@@ -6127,41 +6221,62 @@ Case0:
         }
     }
 
-    static void hybridSort(__inout_ecount(length) Var *elements, uint32 length, CompareVarsInfo* compareInfo)
+    static void timSort(__inout_ecount(length) Var *elements, uint32 length, CompareVarsInfo* compareInfo)
     {
-        // The cost of memory moves starts to be more expensive than additional comparer calls (given a simple comparer)
-        // for arrays of more than 512 elements.
-        if (length > 512)
+        Recycler* recycler = compareInfo->scriptContext->GetRecycler();
+
+        // The merge buffer may hold the only reference to some of the elements while the comparer runs (and can
+        // trigger a GC), so it has to be a scanned recycler allocation.
+        JsUtil::TimSort(elements, length,
+            [compareInfo](const Var& a, const Var& b) { return compareVars(compareInfo, &a, &b); },
+            [recycler](uint32 count) { return RecyclerNewArray(recycler, Var, count); });
+    }
+
+    // Compares two int32 values the way the default sort compare would compare their ToString results, without
+    // creating the strings. '-' sorts before any digit, and two digit strings compare like the shorter one padded
+    // with zeros on the right, with ties going to the shorter one.
+    static int compareInt32AsString(int32 a, int32 b)
+    {
+        static const uint32 powersOf10[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000 };
+
+        if (a == b)
         {
-            qsort_s(elements, length, sizeof(Var), compareVars, compareInfo);
-            return;
+            return 0;
+        }
+        if ((a < 0) != (b < 0))
+        {
+            return a < 0 ? -1 : 1;
         }
 
-        for (int i = 1; i < (int)length; i++)
+        const uint32 x = a < 0 ? 0u - (uint32)a : (uint32)a;
+        const uint32 y = b < 0 ? 0u - (uint32)b : (uint32)b;
+        uint32 digitsX = 1;
+        uint32 digitsY = 1;
+        while (digitsX < _countof(powersOf10) && x >= powersOf10[digitsX])
         {
-            if (compareVars(compareInfo, elements + i, elements + i - 1) < 0) {
-                // binary search for the left-most element greater than value:
-                int first = 0;
-                int last = i - 1;
-                while (first <= last)
-                {
-                    int middle = (first + last) / 2;
-                    if (compareVars(compareInfo, elements + i, elements + middle) < 0)
-                    {
-                        last = middle - 1;
-                    }
-                    else
-                    {
-                        first = middle + 1;
-                    }
-                }
+            digitsX++;
+        }
+        while (digitsY < _countof(powersOf10) && y >= powersOf10[digitsY])
+        {
+            digitsY++;
+        }
 
-                // insert value right before first:
-                Var value = elements[i];
-                memmove(elements + first + 1, elements + first, (i - first) * sizeof(Var));
-                elements[first] = value;
-            }
+        uint64 scaledX = x;
+        uint64 scaledY = y;
+        if (digitsX < digitsY)
+        {
+            scaledX *= powersOf10[digitsY - digitsX];
         }
+        else if (digitsY < digitsX)
+        {
+            scaledY *= powersOf10[digitsX - digitsY];
+        }
+
+        if (scaledX != scaledY)
+        {
+            return scaledX < scaledY ? -1 : 1;
+        }
+        return digitsX < digitsY ? -1 : 1;
     }
 
     void JavascriptArray::Sort(RecyclableObject* compFn)
@@ -6207,7 +6322,7 @@ Case0:
 #ifdef VALIDATE_ARRAY
                     ValidateSegment(startSeg);
 #endif
-                    hybridSort(startSeg->elements, startSeg->length, &cvInfo);
+                    timSort(startSeg->elements, startSeg->length, &cvInfo);
                 }
                 else
                 {
@@ -6239,7 +6354,7 @@ Case0:
 
                 if (compFn != nullptr)
                 {
-                    hybridSort(allElements->elements, allElements->length, &cvInfo);
+                    timSort(allElements->elements, allElements->length, &cvInfo);
                 }
                 else
                 {
@@ -6350,20 +6465,54 @@ Case0:
         return countUndefined;
     }
 
-    int __cdecl JavascriptArray::CompareElements(void* context, const void* elem1, const void* elem2)
+    void JavascriptArray::SortElements(Element* elements, uint32 left, uint32 right)
+    {
+        Recycler* recycler = this->GetScriptContext()->GetRecycler();
+
+        JsUtil::TimSort(elements + left, right - left + 1,
+            [](const Element& element1, const Element& element2) { return JavascriptString::strcmp(element1.StringValue, element2.StringValue); },
+            [recycler](uint32 count) { return RecyclerNewArray(recycler, Element, count); });
+    }
+
+    template <typename T>
+    bool JavascriptArray::TrySortNativeArrayByDefaultCompare()
     {
-        const Element* element1 = static_cast<const Element*>(elem1);
-        const Element* element2 = static_cast<const Element*>(elem2);
+        // Only a single segment that covers the whole array without holes is sorted in place; everything else goes
+        // through the var array path.
+        if (head->next != nullptr || head->left != 0 || head->length != this->length || !HasNoMissingValues())
+        {
+            return false;
+        }
 
-        Assert(element1 != NULL);
-        Assert(element2 != NULL);
+        SparseArraySegment<T>* seg = (SparseArraySegment<T>*)head;
+        return SortNativeElementsByDefaultCompare(seg->elements, seg->length, this->GetScriptContext()->GetRecycler());
+    }
 
-        return JavascriptString::strcmp(element1->StringValue, element2->StringValue);
+    bool JavascriptArray::SortNativeElementsByDefaultCompare(__inout_ecount(length) int32* elements, uint32 length, Recycler* recycler)
+    {
+        JsUtil::TimSort(elements, length,
+            [](const int32& a, const int32& b) { return compareInt32AsString(a, b); },
+            [recycler](uint32 count) { return RecyclerNewArrayLeaf(recycler, int32, count); });
+        return true;
     }
 
-    void JavascriptArray::SortElements(Element* elements, uint32 left, uint32 right)
+    bool JavascriptArray::SortNativeElementsByDefaultCompare(__inout_ecount(length) double* elements, uint32 length, Recycler* recycler)
     {
-        qsort_s(elements, right - left + 1, sizeof(Element), CompareElements, this);
+        // Doubles that are integers in int32 range (-0 included, since it formats as "0") compare as their int32
+        // value would. Anything else (fractions, exponents, NaN, Infinity) needs the general number formatting.
+        for (uint32 i = 0; i < length; i++)
+        {
+            int32 intValue;
+            if (!JavascriptNumber::TryGetInt32Value<true>(elements[i], &intValue))
+            {
+                return false;
+            }
+        }
+
+        JsUtil::TimSort(elements, length,
+            [](const double& a, const double& b) { return compareInt32AsString((int32)a, (int32)b); },
+            [recycler](uint32 count) { return RecyclerNewArrayLeaf(recycler, double, count); });
+        return true;
     }
 
     Var JavascriptArray::EntrySort(RecyclableObject* function, CallInfo callInfo, ...)
@@ -6417,6 +6566,26 @@ Case0:
                 arr->FillFromPrototypes(0, arr->length); // We need find all missing value from [[proto]] object
             }
 
+            // With the default compare, int and float arrays whose elements all format as integers are sorted in place
+            // on the native values, which keeps the array native and avoids creating a string per element.
+            if (compFn == nullptr)
+            {
+                if (JavascriptNativeIntArray::Is(arr))
+                {
+                    if (arr->TrySortNativeArrayByDefaultCompare<int32>())
+                    {
+                        return args[0];
+                    }
+                }
+                else if (JavascriptNativeFloatArray::Is(arr))
+                {
+                    if (arr->TrySortNativeArrayByDefaultCompare<double>())
+                    {
+                        return args[0];
+                    }
+                }
+            }
+
             // Maintain nativity of the array only for the following cases (To favor inplace conversions - keeps the conversion cost less):
             // -    int cases for X86 and
             // -    FloatArray for AMD64
@@ -8543,6 +8712,50 @@ Case0:
         return JavascriptArray::CopyWithinHelper(pArr, nullptr, obj, length, args, scriptContext);
     }
 
+    template<typename T>
+    SparseArraySegment<T> * JavascriptArray::GetSegmentHoldingRange(const uint32 startIndex, const uint32 endIndex) const
+    {
+        Assert(startIndex < endIndex);
+
+        SparseArraySegmentBase *seg = GetBeginLookupSegment(startIndex);
+        while (seg != nullptr && seg->left + seg->length <= startIndex)
+        {
+            seg = seg->next;
+        }
+
+        if (seg == nullptr || startIndex < seg->left || endIndex > seg->left + seg->length)
+        {
+            return nullptr;
+        }
+        return static_cast<SparseArraySegment<T>*>(seg);
+    }
+
+    template<typename T>
+    bool JavascriptArray::TryCopyWithinSegment(const uint32 toIndex, const uint32 fromIndex, const uint32 count)
+    {
+        // Moving the elements with memmove gives the same result as copying them one at a time in the right direction, as
+        // long as the source has no holes to look up and the destination already holds elements, so that nothing is
+        // deleted and the segments and length of the array stay the same.
+        const uint32 startIndex = toIndex < fromIndex ? toIndex : fromIndex;
+        const uint32 endIndex = (toIndex < fromIndex ? fromIndex : toIndex) + count;
+        SparseArraySegment<T> *const seg = GetSegmentHoldingRange<T>(startIndex, endIndex);
+        if (seg == nullptr)
+        {
+            return false;
+        }
+
+        T *const source = seg->elements + (fromIndex - seg->left);
+        if (FindValueOrMissingItem(source, count, SparseArraySegment<T>::GetMissingItem()) != count)
+        {
+            return false;
+        }
+
+        // Filling holes in the destination can only leave HasNoMissingValues too conservative
+        memmove(seg->elements + (toIndex - seg->left), source, count * sizeof(T));
+        SetLastUsedSegment(seg);
+        return true;
+    }
+
     // Array.prototype.copyWithin as defined in ES6.0 (draft 22) Section 22.1.3.3
     Var JavascriptArray::CopyWithinHelper(JavascriptArray* pArr, Js::TypedArrayBase* typedArrayBase, RecyclableObject* obj, int64 length, Arguments& args, ScriptContext* scriptContext)
     {
@@ -8588,6 +8801,27 @@ Case0:
         // We shouldn't have made it here if the count was going to be zero
         Assert(count > 0);
 
+        // Native arrays can move the elements of a segment at once if there are no holes involved
+        if (pArr && (fromVal + count) <= MaxArrayLength && (toVal + count) <= MaxArrayLength &&
+            scriptContext->optimizationOverrides.IsEnabledArraySetElementFastPath())
+        {
+            bool isCopied = false;
+            switch (pArr->GetTypeId())
+            {
+            case TypeIds_NativeIntArray:
+                isCopied = pArr->TryCopyWithinSegment<int32>(static_cast<uint32>(toVal), static_cast<uint32>(fromVal), static_cast<uint32>(count));
+                break;
+            case TypeIds_NativeFloatArray:
+                isCopied = pArr->TryCopyWithinSegment<double>(static_cast<uint32>(toVal), static_cast<uint32>(fromVal), static_cast<uint32>(count));
+                break;
+            }
+
+            if (isCopied)
+            {
+                return obj;
+            }
+        }
+
         int direction;
 
         if (fromVal < toVal && toVal < (fromVal + count))
@@ -8751,6 +8985,38 @@ Case0:
             int64 end = min<int64>(finalVal, MaxArrayLength);
             uint32 u32k = static_cast<uint32>(k);
 
+            // Native arrays can store a number that fits their elements into a whole range of elements at once. The array
+            // may have been converted while getting the indices, so check its type now.
+            if (pArr && u32k < end && scriptContext->optimizationOverrides.IsEnabledArraySetElementFastPath())
+            {
+                const uint32 fillLength = static_cast<uint32>(end) - u32k;
+                bool isFilled = false;
+                switch (pArr->GetTypeId())
+                {
+                case TypeIds_NativeIntArray:
+                    if (TaggedInt::Is(fillValue) && TaggedInt::ToInt32(fillValue) != JavascriptNativeIntArray::MissingItem)
+                    {
+                        isFilled = pArr->DirectSetItemAtRange<int32>(u32k, fillLength, TaggedInt::ToInt32(fillValue));
+                    }
+                    break;
+                case TypeIds_NativeFloatArray:
+                    if (TaggedInt::Is(fillValue) || JavascriptNumber::Is_NoTaggedIntCheck(fillValue))
+                    {
+                        const double fillValueAsDouble = TaggedInt::Is(fillValue) ? TaggedInt::ToDouble(fillValue) : JavascriptNumber::GetValue(fillValue);
+                        if (!SparseArraySegment<double>::IsMissingItem(&fillValueAsDouble))
+                        {
+                            isFilled = pArr->DirectSetItemAtRange<double>(u32k, fillLength, fillValueAsDouble);
+                        }
+                    }
+                    break;
+                }
+
+                if (isFilled)
+                {
+                    u32k = static_cast<uint32>(end);
+                }
+            }
+
             while (u32k < end)
             {
                 if (typedArrayBase)
@@ -481,6 +481,11 @@ namespace Js
         void SetHeadAndLastUsedSegment(SparseArraySegmentBase * segment);
         void SetLastUsedSegment(SparseArraySegmentBase * segment);
         bool HasSegmentMap() const;
+        static uint32 FindValueOrMissingItem(const int32 * elements, const uint32 count, const int32 value);
+        static uint32 FindValueOrMissingItem(const double * elements, const uint32 count, const double value, const bool matchNaN = false);
+        template<typename T> SparseArraySegment<T> * GetSegmentHoldingRange(const uint32 startIndex, const uint32 endIndex) const;
+        template<typename T, typename Fn> int32 NativeSegmentsIndexOfHelper(uint32 &fromIndex, const uint32 toIndex, Fn findValueOrMissingItem) const;
+        template<typename T> bool TryCopyWithinSegment(const uint32 toIndex, const uint32 fromIndex, const uint32 count);
 
     private:
         void SetSegmentMap(SegmentBTreeRoot * segmentMap);
@@ -516,7 +521,9 @@ namespace Js
         template <bool includesAlgorithm>
         static Var IndexOfHelper(Arguments const & args, ScriptContext *scriptContext);
 
-        virtual int32 HeadSegmentIndexOfHelper(Var search, uint32 &fromIndex, uint32 toIndex, bool includesAlgorithm, ScriptContext * scriptContext);
+        // Searches the elements that can be compared without looking at the prototype chain, starting at fromIndex. Returns
+        // the index found, or -1 with fromIndex set to where the generic search must continue, or to -1 if it doesn't need to.
+        virtual int32 SegmentsIndexOfHelper(Var search, uint32 &fromIndex, uint32 toIndex, bool includesAlgorithm, ScriptContext * scriptContext);
 
 
         template<typename T>
@@ -555,9 +562,12 @@ namespace Js
             JavascriptString* StringValue;
         };
 
-        static int __cdecl CompareElements(void* context, const void* elem1, const void* elem2);
         void SortElements(Element* elements, uint32 left, uint32 right);
 
+        template <typename T> bool TrySortNativeArrayByDefaultCompare();
+        static bool SortNativeElementsByDefaultCompare(__inout_ecount(length) int32* elements, uint32 length, Recycler* recycler);
+        static bool SortNativeElementsByDefaultCompare(__inout_ecount(length) double* elements, uint32 length, Recycler* recycler);
+
         template <typename Fn>
         static void ForEachOwnArrayIndexOfObject(RecyclableObject* obj, uint32 startIndex, uint32 limitIndex, Fn fn);
 
@@ -971,7 +981,7 @@ namespace Js
         static DynamicType * GetInitialType(ScriptContext * scriptContext);
         static JavascriptNativeIntArray * BoxStackInstance(JavascriptNativeIntArray * instance);
     private:
-        virtual int32 HeadSegmentIndexOfHelper(Var search, uint32 &fromIndex, uint32 toIndex, bool includesAlgorithm, ScriptContext * scriptContext) override;
+        virtual int32 SegmentsIndexOfHelper(Var search, uint32 &fromIndex, uint32 toIndex, bool includesAlgorithm, ScriptContext * scriptContext) override;
 
 #if ENABLE_TTD
     public:
@@ -1108,7 +1118,7 @@ namespace Js
         static JavascriptNativeFloatArray * BoxStackInstance(JavascriptNativeFloatArray * instance);
         static double Pop(ScriptContext * scriptContext, Var nativeFloatArray);
     private:
-        virtual int32 HeadSegmentIndexOfHelper(Var search, uint32 &fromIndex, uint32 toIndex, bool includesAlgorithm, ScriptContext * scriptContext) override;
+        virtual int32 SegmentsIndexOfHelper(Var search, uint32 &fromIndex, uint32 toIndex, bool includesAlgorithm, ScriptContext * scriptContext) override;
 
 #if ENABLE_TTD
     public:
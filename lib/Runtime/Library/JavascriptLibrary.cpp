@@ -5849,13 +5849,13 @@ namespace Js
     JavascriptWeakMap* JavascriptLibrary::CreateWeakMap()
     {
         AssertMsg(weakMapType, "Where's weakMapType?");
-        return RecyclerNewFinalized(this->GetRecycler(), JavascriptWeakMap, weakMapType);
+        return RecyclerNew(this->GetRecycler(), JavascriptWeakMap, weakMapType);
     }
 
     JavascriptWeakSet* JavascriptLibrary::CreateWeakSet()
     {
         AssertMsg(weakSetType, "Where's weakSetType?");
-        return RecyclerNewFinalized(this->GetRecycler(), JavascriptWeakSet, weakSetType);
+        return RecyclerNew(this->GetRecycler(), JavascriptWeakSet, weakSetType);
     }
 
     JavascriptPromise* JavascriptLibrary::CreatePromise()
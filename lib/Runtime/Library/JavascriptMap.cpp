@@ -14,7 +14,7 @@ namespace Js
     JavascriptMap* JavascriptMap::New(ScriptContext* scriptContext)
     {
         JavascriptMap* map = scriptContext->GetLibrary()->CreateMap();
-        map->map = RecyclerNew(scriptContext->GetRecycler(), MapDataMap, scriptContext->GetRecycler());
+        map->map.Initialize(scriptContext->GetRecycler());
 
         return map;
     }
@@ -31,9 +31,9 @@ namespace Js
         return static_cast<JavascriptMap *>(RecyclableObject::FromVar(aValue));
     }
 
-    JavascriptMap::MapDataList::Iterator JavascriptMap::GetIterator()
+    JavascriptMap::MapDataTable::Iterator JavascriptMap::GetIterator()
     {
-        return list.GetIterator();
+        return map.GetIterator();
     }
 
     Var JavascriptMap::NewInstance(RecyclableObject* function, CallInfo callInfo, ...)
@@ -78,12 +78,12 @@ namespace Js
             adder = RecyclableObject::FromVar(adderVar);
         }
 
-        if (mapObject->map != nullptr)
+        if (mapObject->map.IsInitialized())
         {
             JavascriptError::ThrowTypeErrorVar(scriptContext, JSERR_ObjectIsAlreadyInitialized, _u("Map"), _u("Map"));
         }
 
-        mapObject->map = RecyclerNew(scriptContext->GetRecycler(), MapDataMap, scriptContext->GetRecycler());
+        mapObject->map.Initialize(scriptContext->GetRecycler());
 
         if (iter != nullptr)
         {
@@ -340,27 +340,20 @@ namespace Js
 
     void JavascriptMap::Clear()
     {
-        list.Clear();
-        map->Clear();
+        map.Clear(GetScriptContext()->GetRecycler());
     }
 
     bool JavascriptMap::Delete(Var key)
     {
-        if (map->ContainsKey(key))
-        {
-            MapDataNode* node = map->Item(key);
-            list.Remove(node);
-            return map->Remove(key);
-        }
-        return false;
+        return map.Remove(key, GetScriptContext()->GetRecycler());
     }
 
     bool JavascriptMap::Get(Var key, Var* value)
     {
-        if (map->ContainsKey(key))
+        MapDataKeyValuePair* pair = map.Find(key);
+        if (pair != nullptr)
         {
-            MapDataNode* node = map->Item(key);
-            *value = node->data.Value();
+            *value = pair->Value();
             return true;
         }
         return false;
@@ -368,27 +361,26 @@ namespace Js
 
     bool JavascriptMap::Has(Var key)
     {
-        return map->ContainsKey(key);
+        return map.Find(key) != nullptr;
     }
 
     void JavascriptMap::Set(Var key, Var value)
     {
-        if (map->ContainsKey(key))
+        MapDataKeyValuePair* pair = map.Find(key);
+        if (pair != nullptr)
         {
-            MapDataNode* node = map->Item(key);
-            node->data = MapDataKeyValuePair(key, value);
+            // The key already in the map stays
+            *pair = MapDataKeyValuePair(pair->Key(), value);
         }
         else
         {
-            MapDataKeyValuePair pair(key, value);
-            MapDataNode* node = list.Append(pair, GetScriptContext()->GetRecycler());
-            map->Add(key, node);
+            map.Add(MapDataKeyValuePair(key, value), GetScriptContext()->GetRecycler());
         }
     }
 
     int JavascriptMap::Size()
     {
-        return map->Count();
+        return map.Count();
     }
 
     BOOL JavascriptMap::GetDiagTypeString(StringBuilder<ArenaAllocator>* stringBuilder, ScriptContext* requestContext)
@@ -450,7 +442,7 @@ namespace Js
     JavascriptMap* JavascriptMap::CreateForSnapshotRestore(ScriptContext* ctx)
     {
         JavascriptMap* res = ctx->GetLibrary()->CreateMap();
-        res->map = RecyclerNew(ctx->GetRecycler(), MapDataMap, ctx->GetRecycler());
+        res->map.Initialize(ctx->GetRecycler());
 
         return res;
     }
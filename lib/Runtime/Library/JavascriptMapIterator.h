@@ -17,7 +17,7 @@ namespace Js
     {
     private:
         JavascriptMap*                          m_map;
-        JavascriptMap::MapDataList::Iterator    m_mapIterator;
+        JavascriptMap::MapDataTable::Iterator   m_mapIterator;
         JavascriptMapIteratorKind               m_kind;
 
     protected:
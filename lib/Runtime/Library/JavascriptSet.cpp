@@ -14,7 +14,7 @@ namespace Js
     JavascriptSet* JavascriptSet::New(ScriptContext* scriptContext)
     {
         JavascriptSet* set = scriptContext->GetLibrary()->CreateSet();
-        set->set = RecyclerNew(scriptContext->GetRecycler(), SetDataSet, scriptContext->GetRecycler());
+        set->set.Initialize(scriptContext->GetRecycler());
 
         return set;
     }
@@ -31,9 +31,9 @@ namespace Js
         return static_cast<JavascriptSet *>(RecyclableObject::FromVar(aValue));
     }
 
-    JavascriptSet::SetDataList::Iterator JavascriptSet::GetIterator()
+    JavascriptSet::SetDataTable::Iterator JavascriptSet::GetIterator()
     {
-        return list.GetIterator();
+        return set.GetIterator();
     }
 
     Var JavascriptSet::NewInstance(RecyclableObject* function, CallInfo callInfo, ...)
@@ -78,13 +78,13 @@ namespace Js
             adder = RecyclableObject::FromVar(adderVar);
         }
 
-        if (setObject->set != nullptr)
+        if (setObject->set.IsInitialized())
         {
             JavascriptError::ThrowTypeErrorVar(scriptContext, JSERR_ObjectIsAlreadyInitialized, _u("Set"), _u("Set"));
         }
 
 
-        setObject->set = RecyclerNew(scriptContext->GetRecycler(), SetDataSet, scriptContext->GetRecycler());
+        setObject->set.Initialize(scriptContext->GetRecycler());
 
         if (iter != nullptr)
         {
@@ -287,40 +287,31 @@ namespace Js
 
     void JavascriptSet::Add(Var value)
     {
-        if (!set->ContainsKey(value))
+        if (set.Find(value) == nullptr)
         {
-            SetDataNode* node = list.Append(value, GetScriptContext()->GetRecycler());
-            set->Add(value, node);
+            set.Add(value, GetScriptContext()->GetRecycler());
         }
     }
 
     void JavascriptSet::Clear()
     {
-        // TODO: (Consider) Should we clear the set here and leave it as large as it has grown, or
-        // toss it away and create a new empty set, letting it grow as needed?
-        list.Clear();
-        set->Clear();
+        // Iterators still pointing into the old entries continue from the start of the new, empty table
+        set.Clear(GetScriptContext()->GetRecycler());
     }
 
     bool JavascriptSet::Delete(Var value)
     {
-        if (set->ContainsKey(value))
-        {
-            SetDataNode* node = set->Item(value);
-            list.Remove(node);
-            return set->Remove(value);
-        }
-        return false;
+        return set.Remove(value, GetScriptContext()->GetRecycler());
     }
 
     bool JavascriptSet::Has(Var value)
     {
-        return set->ContainsKey(value);
+        return set.Find(value) != nullptr;
     }
 
     int JavascriptSet::Size()
     {
-        return set->Count();
+        return set.Count();
     }
 
     BOOL JavascriptSet::GetDiagTypeString(StringBuilder<ArenaAllocator>* stringBuilder, ScriptContext* requestContext)
@@ -371,7 +362,7 @@ namespace Js
     JavascriptSet* JavascriptSet::CreateForSnapshotRestore(ScriptContext* ctx)
     {
         JavascriptSet* res = ctx->GetLibrary()->CreateSet();
-        res->set = RecyclerNew(ctx->GetRecycler(), SetDataSet, ctx->GetRecycler());
+        res->set.Initialize(ctx->GetRecycler());
 
         return res;
     }
@@ -337,6 +337,11 @@ namespace Js
     {
         AssertMsg( IsValidIndexValue(index), "Must specify valid character");
 
+        if (OneByteString::Is(this))
+        {
+            return OneByteString::FromString(this)->GetItem(index);
+        }
+
         const char16 *str = this->GetString();
         return str[index];
     }
@@ -1073,16 +1078,16 @@ case_2:
 
         if (position < pThis->GetLengthAsSignedInt())
         {
+            if (OneByteString::Is(pThis) && (searchLen == 1 || OneByteString::Is(searchString)))
+            {
+                return OneByteString::IndexOf(OneByteString::FromString(pThis), searchString, position);
+            }
+
             const char16* searchStr = searchString->GetString();
             const char16* inputStr = pThis->GetString();
-            if (searchLen == 1)
+            if (searchLen == 1 || UseVectorizedSearch(searchLen))
             {
-                int i = position;
-                for(; i < len && inputStr[i] != *searchStr ; i++);
-                if (i < len)
-                {
-                    result = i;
-                }
+                result = IndexOfString(inputStr, len, searchStr, searchLen, position);
             }
             else
             {
@@ -1173,18 +1178,9 @@ case_2:
         {
             return JavascriptNumber::ToVar(position, scriptContext);
         }
-        else if (searchLen == 1)
+        else if (searchLen == 1 || UseVectorizedSearch(searchLen))
         {
-            char16 const * current = inputStr + min(position,len - 1);
-            while (*current != *searchStr)
-            {
-                current--;
-                if (current < inputStr)
-                {
-                    return JavascriptNumber::ToVar(result, scriptContext); //return -1
-                }
-            }
-            result =  (int)(current - inputStr);
+            result = LastIndexOfString(inputStr, len, searchStr, searchLen, position);
             return JavascriptNumber::ToVar(result, scriptContext);
         }
 
@@ -1192,7 +1188,11 @@ case_2:
         JmpTable jmpTable;
         bool fAsciiJumpTable = BuildFirstCharBackwardBoyerMooreTable(jmpTable, searchStr, searchLen);
 
-        if (!fAsciiJumpTable)
+        if (!fAsciiJumpTable && IsVectorizedSearchAvailable())
+        {
+            result = LastIndexOfString(inputStr, len, searchStr, searchLen, position);
+        }
+        else if (!fAsciiJumpTable)
         {
             char16 const * start = inputStr;
             char16 const * current = inputStr + min(position, len - 1);
@@ -2691,6 +2691,15 @@ case_2:
         return m_pszValue;
     }
 
+    uint JavascriptString::GetHashCode()
+    {
+        if (OneByteString::Is(this))
+        {
+            return OneByteString::FromString(this)->GetHashCode();
+        }
+        return JsUtil::CharacterBuffer<WCHAR>::StaticGetHashCode(this->GetString(), this->GetLength());
+    }
+
     void const * JavascriptString::GetOriginalStringReference()
     {
         // Just return the string buffer
@@ -3012,6 +3021,15 @@ case_2:
             return false;
         }
 
+        if (OneByteString::Is(leftString))
+        {
+            return OneByteString::Equals(OneByteString::FromString(leftString), rightString);
+        }
+        if (OneByteString::Is(rightString))
+        {
+            return OneByteString::Equals(OneByteString::FromString(rightString), leftString);
+        }
+
         if (wmemcmp(leftString->GetString(), rightString->GetString(), leftString->GetLength()) == 0)
         {
             return true;
@@ -3344,6 +3362,112 @@ case_2:
         return builder.ToString();
     }
 
+    // Index of the first occurrence of searchStr in inputStr at or after position, or -1.
+    // Candidate positions are filtered by comparing both the first and the last character of searchStr,
+    // eight positions at a time with SSE2, and only the survivors are compared in full. Unlike the
+    // Boyer-Moore jump tables this works the same for non-ASCII search strings.
+    int JavascriptString::IndexOfString(const char16* inputStr, charcount_t len, const char16* searchStr, charcount_t searchLen, charcount_t position)
+    {
+        Assert(searchLen != 0);
+        if (position > len || searchLen > len - position)
+        {
+            return -1;
+        }
+
+        const char16 searchFirst = searchStr[0];
+        const char16 searchLast = searchStr[searchLen - 1];
+        const charcount_t lastStart = len - searchLen;
+        charcount_t i = position;
+
+#if defined(_M_IX86) || defined(_M_X64)
+        if (AutoSystemInfo::Data.SSE2Available())
+        {
+            const __m128i first = _mm_set1_epi16(searchFirst);
+            const __m128i last = _mm_set1_epi16(searchLast);
+            for (; i + 7 <= lastStart; i += 8)
+            {
+                const __m128i firstChars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inputStr + i));
+                const __m128i lastChars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inputStr + i + searchLen - 1));
+                DWORD mask = (DWORD)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi16(firstChars, first), _mm_cmpeq_epi16(lastChars, last)));
+                while (mask != 0)
+                {
+                    // Each candidate sets two adjacent mask bits, one per byte of the char16
+                    DWORD bit;
+                    _BitScanForward(&bit, mask);
+                    const charcount_t candidate = i + bit / 2;
+                    if (searchLen <= 2 || wmemcmp(inputStr + candidate + 1, searchStr + 1, searchLen - 2) == 0)
+                    {
+                        return (int)candidate;
+                    }
+                    mask &= ~(3u << bit);
+                }
+            }
+        }
+#endif
+
+        for (; i <= lastStart; i++)
+        {
+            if (inputStr[i] == searchFirst && inputStr[i + searchLen - 1] == searchLast &&
+                (searchLen <= 2 || wmemcmp(inputStr + i + 1, searchStr + 1, searchLen - 2) == 0))
+            {
+                return (int)i;
+            }
+        }
+        return -1;
+    }
+
+    // Index of the last occurrence of searchStr in inputStr starting at or before position, or -1.
+    // Same first and last character filter as IndexOfString, going backwards.
+    int JavascriptString::LastIndexOfString(const char16* inputStr, charcount_t len, const char16* searchStr, charcount_t searchLen, charcount_t position)
+    {
+        Assert(searchLen != 0);
+        if (searchLen > len)
+        {
+            return -1;
+        }
+
+        const char16 searchFirst = searchStr[0];
+        const char16 searchLast = searchStr[searchLen - 1];
+        charcount_t end = min(position, len - searchLen) + 1; // one past the last candidate
+
+#if defined(_M_IX86) || defined(_M_X64)
+        if (AutoSystemInfo::Data.SSE2Available())
+        {
+            const __m128i first = _mm_set1_epi16(searchFirst);
+            const __m128i last = _mm_set1_epi16(searchLast);
+            for (; end >= 8; end -= 8)
+            {
+                const charcount_t blockStart = end - 8;
+                const __m128i firstChars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inputStr + blockStart));
+                const __m128i lastChars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inputStr + blockStart + searchLen - 1));
+                DWORD mask = (DWORD)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi16(firstChars, first), _mm_cmpeq_epi16(lastChars, last)));
+                while (mask != 0)
+                {
+                    DWORD bit;
+                    _BitScanReverse(&bit, mask);
+                    const charcount_t candidate = blockStart + bit / 2;
+                    if (searchLen <= 2 || wmemcmp(inputStr + candidate + 1, searchStr + 1, searchLen - 2) == 0)
+                    {
+                        return (int)candidate;
+                    }
+                    mask &= ~(3u << (bit & ~1u));
+                }
+            }
+        }
+#endif
+
+        while (end > 0)
+        {
+            end--;
+            if (inputStr[end] == searchFirst && inputStr[end + searchLen - 1] == searchLast &&
+                (searchLen <= 2 || wmemcmp(inputStr + end + 1, searchStr + 1, searchLen - 2) == 0))
+            {
+                return (int)end;
+            }
+        }
+        return -1;
+    }
+
     int JavascriptString::IndexOfUsingJmpTable(JmpTable jmpTable, const char16* inputStr, int len, const char16* searchStr, int searchLen, int position)
     {
         int result = -1;
@@ -3497,6 +3621,12 @@ case_2:
         uint stringLen = stringLenOrig - start;
         uint substringLen = substring->GetLength();
 
+        if (useBoyerMoore ? UseVectorizedSearch(substringLen) : IsVectorizedSearchAvailable())
+        {
+            // If substring is empty, it matches anything...
+            return substringLen == 0 ? 0 : (uint)IndexOfString(stringOrig, stringLenOrig, substringSz, substringLen, start);
+        }
+
         if (useBoyerMoore && substringLen > 2)
         {
             JmpTable jmpTable;
@@ -3513,6 +3643,10 @@ case_2:
                     return (uint)-1;
                 }
             }
+            else if (IsVectorizedSearchAvailable())
+            {
+                return (uint)IndexOfString(stringOrig, stringLenOrig, substringSz, substringLen, start);
+            }
         }
 
         if (stringLen >= substringLen)
@@ -3538,8 +3672,34 @@ case_2:
         return (uint)-1;
     }
 
+    bool JavascriptString::IsVectorizedSearchAvailable()
+    {
+#if defined(_M_IX86) || defined(_M_X64)
+        return AutoSystemInfo::Data.SSE2Available() != FALSE;
+#else
+        return false;
+#endif
+    }
+
+    bool JavascriptString::UseVectorizedSearch(charcount_t searchLen)
+    {
+        // The SSE2 search moves 8 characters per step, while the Boyer-Moore tables can skip up to the length of the search
+        // string, so the tables are still used for long search strings. Search strings without a table (non-ASCII) can use
+        // the SSE2 search at any length.
+        return searchLen <= 16 && IsVectorizedSearchAvailable();
+    }
+
     int JavascriptString::strcmp(JavascriptString *string1, JavascriptString *string2)
     {
+        if (OneByteString::Is(string1))
+        {
+            return OneByteString::Compare(OneByteString::FromString(string1), string2);
+        }
+        if (OneByteString::Is(string2))
+        {
+            return -OneByteString::Compare(OneByteString::FromString(string2), string1);
+        }
+
         uint string1Len = string1->GetLength();
         uint string2Len = string2->GetLength();
 
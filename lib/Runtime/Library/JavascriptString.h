@@ -148,6 +148,8 @@ namespace Js
         static uint strstr(JavascriptString *string, JavascriptString *substring, bool useBoyerMoore, uint start=0);
         static int strcmp(JavascriptString *string1, JavascriptString *string2);
 
+        uint GetHashCode();     // Same as CharacterBuffer<char16>'s hash of the contents, without flattening one-byte strings
+
     private:
         enum ToCase{
             ToLower,
@@ -156,6 +158,10 @@ namespace Js
         char16* GetSzCopy();   // get a copy of the inner string without compacting the chunks
 
         static Var ToCaseCore(JavascriptString* pThis, ToCase toCase);
+        static bool IsVectorizedSearchAvailable();
+        static bool UseVectorizedSearch(charcount_t searchLen);
+        static int IndexOfString(const char16* inputStr, charcount_t len, const char16* searchStr, charcount_t searchLen, charcount_t position);
+        static int LastIndexOfString(const char16* inputStr, charcount_t len, const char16* searchStr, charcount_t searchLen, charcount_t position);
         static int IndexOfUsingJmpTable(JmpTable jmpTable, const char16* inputStr, int len, const char16* searchStr, int searchLen, int position);
         static int LastIndexOfUsingJmpTable(JmpTable jmpTable, const char16* inputStr, int len, const char16* searchStr, int searchLen, int position);
         static bool BuildLastCharForwardBoyerMooreTable(JmpTable jmpTable, const char16* searchStr, int searchLen);
@@ -391,7 +397,7 @@ namespace Js
 
         inline static uint GetHashCode(JavascriptString * str)
         {
-            return JsUtil::CharacterBuffer<WCHAR>::StaticGetHashCode(str->GetString(), str->GetLength());
+            return str->GetHashCode();
         }
     };
 
@@ -412,6 +418,6 @@ struct DefaultComparer<Js::JavascriptString*>
 
     inline static uint GetHashCode(Js::JavascriptString * pStr)
     {
-        return JsUtil::CharacterBuffer<char16>::StaticGetHashCode(pStr->GetString(), pStr->GetLength());
+        return pStr->GetHashCode();
     }
 };
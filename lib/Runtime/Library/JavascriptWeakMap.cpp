@@ -8,7 +8,7 @@ namespace Js
 {
     JavascriptWeakMap::JavascriptWeakMap(DynamicType* type)
         : DynamicObject(type),
-        keySet(type->GetScriptContext()->GetRecycler())
+        table(type->GetScriptContext()->GetRecycler(), this)
     {
     }
 
@@ -24,42 +24,6 @@ namespace Js
         return static_cast<JavascriptWeakMap *>(RecyclableObject::FromVar(aValue));
     }
 
-    JavascriptWeakMap::WeakMapKeyMap* JavascriptWeakMap::GetWeakMapKeyMapFromKey(DynamicObject* key) const
-    {
-        Var weakMapKeyData = nullptr;
-        if (!key->GetInternalProperty(key, InternalPropertyIds::WeakMapKeyMap, &weakMapKeyData, nullptr, key->GetScriptContext()))
-        {
-            return nullptr;
-        }
-
-        return static_cast<WeakMapKeyMap*>(weakMapKeyData);
-    }
-
-    JavascriptWeakMap::WeakMapKeyMap* JavascriptWeakMap::AddWeakMapKeyMapToKey(DynamicObject* key)
-    {
-        // The internal property may exist on an object that has had DynamicObject::ResetObject called on itself.
-        // In that case the value stored in the property slot should be null.
-        DebugOnly(Var unused = nullptr);
-        Assert(!key->GetInternalProperty(key, InternalPropertyIds::WeakMapKeyMap, &unused, nullptr, key->GetScriptContext()) || unused == nullptr);
-
-        WeakMapKeyMap* weakMapKeyData = RecyclerNew(GetScriptContext()->GetRecycler(), WeakMapKeyMap, GetScriptContext()->GetRecycler());
-        BOOL success = key->SetInternalProperty(InternalPropertyIds::WeakMapKeyMap, weakMapKeyData, PropertyOperation_Force, nullptr);
-        Assert(success);
-
-        return weakMapKeyData;
-    }
-
-    bool JavascriptWeakMap::KeyMapGet(WeakMapKeyMap* map, Var* value) const
-    {
-        if (map->ContainsKey(GetWeakMapId()))
-        {
-            *value = map->Item(GetWeakMapId());
-            return true;
-        }
-
-        return false;
-    }
-
     Var JavascriptWeakMap::NewInstance(RecyclableObject* function, CallInfo callInfo, ...)
     {
         PROBE_STACK(function->GetScriptContext(), Js::Constants::MinStackDefault);
@@ -260,76 +224,24 @@ namespace Js
         return weakMap;
     }
 
-    void JavascriptWeakMap::Clear()
-    {
-        keySet.Map([&](DynamicObject* key, bool value, const RecyclerWeakReference<DynamicObject>* weakRef) {
-            WeakMapKeyMap* keyMap = GetWeakMapKeyMapFromKey(key);
-
-            // It may be the case that a CEO has been reset and the keyMap is now null.
-            // Just ignore it in this case, the keyMap has already been collected.
-            if (keyMap != nullptr)
-            {
-                // It may also be the case that a CEO has been reset and then added to a separate WeakMap,
-                // creating a new WeakMapKeyMap on the CEO.  In this case GetWeakMapId() may not be in the
-                // keyMap, so don't assert successful removal here.
-                keyMap->Remove(GetWeakMapId());
-            }
-        });
-        keySet.Clear();
-    }
-
     bool JavascriptWeakMap::Delete(DynamicObject* key)
     {
-        WeakMapKeyMap* keyMap = GetWeakMapKeyMapFromKey(key);
-
-        if (keyMap != nullptr)
-        {
-            bool unused = false;
-            bool inSet = keySet.TryGetValueAndRemove(key, &unused);
-            bool inData = keyMap->Remove(GetWeakMapId());
-            Assert(inSet == inData);
-
-            return inData;
-        }
-
-        return false;
+        return table.Remove(key);
     }
 
     bool JavascriptWeakMap::Get(DynamicObject* key, Var* value) const
     {
-        WeakMapKeyMap* keyMap = GetWeakMapKeyMapFromKey(key);
-
-        if (keyMap != nullptr)
-        {
-            return KeyMapGet(keyMap, value);
-        }
-
-        return false;
+        return table.TryGetValue(key, value);
     }
 
     bool JavascriptWeakMap::Has(DynamicObject* key) const
     {
-        WeakMapKeyMap* keyMap = GetWeakMapKeyMapFromKey(key);
-
-        if (keyMap != nullptr)
-        {
-            return keyMap->ContainsKey(GetWeakMapId());
-        }
-
-        return false;
+        return table.Contains(key);
     }
 
     void JavascriptWeakMap::Set(DynamicObject* key, Var value)
     {
-        WeakMapKeyMap* keyMap = GetWeakMapKeyMapFromKey(key);
-
-        if (keyMap == nullptr)
-        {
-            keyMap = AddWeakMapKeyMapToKey(key);
-        }
-
-        keyMap->Item(GetWeakMapId(), value);
-        keySet.Item(key, true);
+        table.Set(key, value);
     }
 
     BOOL JavascriptWeakMap::GetDiagTypeString(StringBuilder<ArenaAllocator>* stringBuilder, ScriptContext* requestContext)
@@ -8,7 +8,7 @@ namespace Js
 {
     JavascriptWeakSet::JavascriptWeakSet(DynamicType* type)
         : DynamicObject(type),
-        keySet(type->GetScriptContext()->GetRecycler())
+        keySet(type->GetScriptContext()->GetRecycler(), this)
     {
     }
 
@@ -174,19 +174,17 @@ namespace Js
 
     void JavascriptWeakSet::Add(DynamicObject* key)
     {
-        keySet.Item(key, true);
+        keySet.Set(key, nullptr);
     }
 
     bool JavascriptWeakSet::Delete(DynamicObject* key)
     {
-        bool unused = false;
-        return keySet.TryGetValueAndRemove(key, &unused);
+        return keySet.Remove(key);
     }
 
     bool JavascriptWeakSet::Has(DynamicObject* key)
     {
-        bool unused = false;
-        return keySet.TryGetValue(key, &unused);
+        return keySet.Contains(key);
     }
 
     BOOL JavascriptWeakSet::GetDiagTypeString(StringBuilder<ArenaAllocator>* stringBuilder, ScriptContext* requestContext)
@@ -9,11 +9,10 @@ namespace Js
     class JavascriptWeakSet : public DynamicObject
     {
     private:
-        typedef JsUtil::WeaklyReferencedKeyDictionary<DynamicObject, bool, RecyclerPointerComparer<const DynamicObject*>> KeySet;
+        // The keys are kept in an ephemeron table processed by the recycler, with no values
+        RecyclerEphemeronTable keySet;
 
-        KeySet keySet;
-
-        DEFINE_VTABLE_CTOR_MEMBER_INIT(JavascriptWeakSet, DynamicObject, keySet);
+        DEFINE_VTABLE_CTOR(JavascriptWeakSet, DynamicObject);
         DEFINE_MARSHAL_OBJECT_TO_SCRIPT_CONTEXT(JavascriptWeakSet);
 
     public:
@@ -44,13 +43,13 @@ namespace Js
 
     public:
         // For diagnostics and heap enum provide size and allow enumeration of key value pairs
-        int Size() { keySet.Clean(); return keySet.Count(); }
+        int Size() { return keySet.Count(); }
         template <typename Fn>
         void Map(Fn fn)
         {
-            return keySet.Map([&](DynamicObject* key, bool, const RecyclerWeakReference<DynamicObject>*)
+            keySet.Map([&](void* key, void*)
             {
-                fn(key);
+                fn(static_cast<DynamicObject*>(key));
             });
         }
 
@@ -0,0 +1,334 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+// This is a special use hash table that keeps its entries in insertion order
+// in one contiguous array, and whose iterators are always valid no matter
+// what modifications are made to the table during iteration.
+//
+// Entries are appended to the array and chained from the hash buckets by
+// index. A deleted entry is unlinked from its chain and its key cleared, but
+// it keeps its place in the array until the table fills up, so iteration
+// order is well defined and iterators just skip over it. When the array
+// fills up, or the table is cleared, the live entries are moved in order to
+// a new array. The old one then records which positions were dropped, so
+// that an iterator still pointing into it can find its place in the new
+// one. Old arrays are recycler allocated and only referenced by the
+// iterators that have yet to move on, so the table doesn't need to track
+// its iterators.
+//
+// The intended use of this table is to hold the items of ES6 Map and Set
+// objects. If a more general use if found for this data structure please
+// generalize it and consider moving it to Common\DataStructures.
+
+namespace Js
+{
+    template <typename TData>
+    class MapOrSetDataTable
+    {
+    private:
+        struct Entry
+        {
+            TData data;
+            hash_t hash;
+            int next;       // next entry in the same bucket, -1 if none
+        };
+
+        class Table
+        {
+        public:
+            // Current tables only
+            Entry* entries;
+            int* buckets;           // first entry in each bucket, -1 if none
+            int capacity;
+            int bucketCount;        // capacity / 2, a power of 2
+            int used;               // entries appended so far, including deleted ones
+            int count;              // live entries
+
+            // Obsolete tables only
+            Table* nextTable;
+            int* removedIndices;    // ascending positions of the deleted entries that were dropped
+            int removedCount;
+            bool isCleared;
+
+            Table(int capacity, Recycler* recycler)
+                : capacity(capacity), bucketCount(capacity / 2), used(0), count(0),
+                nextTable(nullptr), removedIndices(nullptr), removedCount(0), isCleared(false)
+            {
+                Assert(::Math::IsPow2(capacity) && capacity >= MinCapacity);
+
+                entries = RecyclerNewArrayZ(recycler, Entry, capacity);
+                buckets = RecyclerNewArrayLeaf(recycler, int, bucketCount);
+                for (int i = 0; i < bucketCount; i++)
+                {
+                    buckets[i] = -1;
+                }
+            }
+
+            // Position in the next table of the entry at the given position in this one, or of the first entry after
+            // it if it was dropped
+            int TransitionIndex(int index) const
+            {
+                Assert(nextTable != nullptr);
+
+                if (isCleared)
+                {
+                    return 0;
+                }
+
+                int lo = 0;
+                int hi = removedCount;
+                while (lo < hi)
+                {
+                    int mid = lo + (hi - lo) / 2;
+                    if (removedIndices[mid] < index)
+                    {
+                        lo = mid + 1;
+                    }
+                    else
+                    {
+                        hi = mid;
+                    }
+                }
+                return index - lo;
+            }
+        };
+
+        static const int MinCapacity = 4;
+
+        Table* table;
+
+        static Var GetKey(const Var& data) { return data; }
+        static Var GetKey(const JsUtil::KeyValuePair<Var, Var>& data) { return data.Key(); }
+        static void ClearData(Var& data) { data = nullptr; }
+        static void ClearData(JsUtil::KeyValuePair<Var, Var>& data) { data = JsUtil::KeyValuePair<Var, Var>(nullptr, nullptr); }
+
+        static bool IsDeleted(const Entry& entry)
+        {
+            return GetKey(entry.data) == nullptr;
+        }
+
+        // Keys are mostly tagged ints and strings, so those are hashed and compared without the full SameValueZero dispatch
+        static hash_t GetHashCode(Var key)
+        {
+            if (TaggedInt::Is(key))
+            {
+                return SameValueZeroComparer<Var>::HashDouble((double)TaggedInt::ToInt32(key));
+            }
+            return SameValueZeroComparer<Var>::GetHashCode(key);
+        }
+
+        static bool KeysEqual(Var x, Var y)
+        {
+            if (x == y)
+            {
+                return true;
+            }
+            if (TaggedInt::Is(x) && TaggedInt::Is(y))
+            {
+                return false;
+            }
+            return SameValueZeroComparer<Var>::Equals(x, y);
+        }
+
+        int Find(Var key, hash_t hash, int* prevIndex = nullptr) const
+        {
+            int prev = -1;
+            for (int i = table->buckets[hash & (table->bucketCount - 1)]; i != -1; i = table->entries[i].next)
+            {
+                // The hash is compared first so that strings are only compared when they are likely equal
+                if (table->entries[i].hash == hash && KeysEqual(GetKey(table->entries[i].data), key))
+                {
+                    if (prevIndex)
+                    {
+                        *prevIndex = prev;
+                    }
+                    return i;
+                }
+                prev = i;
+            }
+            return -1;
+        }
+
+        void Rehash(int newCapacity, Recycler* recycler)
+        {
+            Table* oldTable = table;
+            Table* newTable = RecyclerNew(recycler, Table, newCapacity, recycler);
+
+            int removedCount = oldTable->used - oldTable->count;
+            int* removedIndices = removedCount != 0 ? RecyclerNewArrayLeaf(recycler, int, removedCount) : nullptr;
+            int removed = 0;
+
+            for (int i = 0; i < oldTable->used; i++)
+            {
+                Entry& entry = oldTable->entries[i];
+                if (IsDeleted(entry))
+                {
+                    removedIndices[removed++] = i;
+                    continue;
+                }
+
+                int index = newTable->used++;
+                int bucket = entry.hash & (newTable->bucketCount - 1);
+                newTable->entries[index].data = entry.data;
+                newTable->entries[index].hash = entry.hash;
+                newTable->entries[index].next = newTable->buckets[bucket];
+                newTable->buckets[bucket] = index;
+            }
+            Assert(removed == removedCount);
+            newTable->count = newTable->used;
+
+            Obsolete(oldTable, newTable);
+            oldTable->removedIndices = removedIndices;
+            oldTable->removedCount = removedCount;
+        }
+
+        void Obsolete(Table* oldTable, Table* newTable)
+        {
+            // Iterators only need to find their way to the new table, so let go of the old entries
+            oldTable->entries = nullptr;
+            oldTable->buckets = nullptr;
+            oldTable->nextTable = newTable;
+            table = newTable;
+        }
+
+    public:
+        MapOrSetDataTable(VirtualTableInfoCtorEnum) {};
+        MapOrSetDataTable() : table(nullptr) { }
+
+        class Iterator
+        {
+            Table* table;
+            int index;      // next position to look at
+        public:
+            Iterator() : table(nullptr), index(0) { }
+            Iterator(MapOrSetDataTable<TData>* dataTable) : table(dataTable->table), index(0) { }
+
+            bool Next()
+            {
+                if (table == nullptr)
+                {
+                    return false;
+                }
+
+                // Entries can be moved to a new table while iterating, so follow them
+                while (table->nextTable != nullptr)
+                {
+                    index = table->TransitionIndex(index);
+                    table = table->nextTable;
+                }
+
+                for (; index < table->used; index++)
+                {
+                    if (!IsDeleted(table->entries[index]))
+                    {
+                        index++;
+                        return true;
+                    }
+                }
+
+                table = nullptr;
+                return false;
+            }
+
+            TData& Current()
+            {
+                Assert(table != nullptr && table->nextTable == nullptr && index > 0);
+                return table->entries[index - 1].data;
+            }
+        };
+
+        bool IsInitialized() const
+        {
+            return table != nullptr;
+        }
+
+        void Initialize(Recycler* recycler)
+        {
+            Assert(!IsInitialized());
+            table = RecyclerNew(recycler, Table, MinCapacity, recycler);
+        }
+
+        int Count() const
+        {
+            return table->count;
+        }
+
+        TData* Find(Var key)
+        {
+            int index = Find(key, GetHashCode(key));
+            return index != -1 ? &table->entries[index].data : nullptr;
+        }
+
+        // Adds data whose key is not in the table
+        void Add(const TData& data, Recycler* recycler)
+        {
+            Var key = GetKey(data);
+            hash_t hash = GetHashCode(key);
+            Assert(Find(key, hash) == -1);
+
+            if (table->used == table->capacity)
+            {
+                // Only grow if dropping the deleted entries wouldn't leave enough room
+                Rehash(table->count >= table->capacity / 2 ? table->capacity * 2 : table->capacity, recycler);
+            }
+
+            int index = table->used++;
+            int bucket = hash & (table->bucketCount - 1);
+            Entry& entry = table->entries[index];
+            entry.data = data;
+            entry.hash = hash;
+            entry.next = table->buckets[bucket];
+            table->buckets[bucket] = index;
+            table->count++;
+        }
+
+        bool Remove(Var key, Recycler* recycler)
+        {
+            hash_t hash = GetHashCode(key);
+            int prev;
+            int index = Find(key, hash, &prev);
+            if (index == -1)
+            {
+                return false;
+            }
+
+            Entry& entry = table->entries[index];
+            if (prev == -1)
+            {
+                table->buckets[hash & (table->bucketCount - 1)] = entry.next;
+            }
+            else
+            {
+                table->entries[prev].next = entry.next;
+            }
+            ClearData(entry.data);
+            table->count--;
+
+            if (table->count < table->capacity / 4 && table->capacity > MinCapacity)
+            {
+                Rehash(table->capacity / 2, recycler);
+            }
+            return true;
+        }
+
+        void Clear(Recycler* recycler)
+        {
+            if (table->used == 0)
+            {
+                return;
+            }
+
+            Table* oldTable = table;
+            Obsolete(oldTable, RecyclerNew(recycler, Table, MinCapacity, recycler));
+            oldTable->isCleared = true;
+        }
+
+        Iterator GetIterator()
+        {
+            return Iterator(this);
+        }
+    };
+}
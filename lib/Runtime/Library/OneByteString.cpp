@@ -0,0 +1,253 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#include "RuntimeLibraryPch.h"
+
+namespace Js
+{
+    DEFINE_RECYCLER_TRACKER_PERF_COUNTER(OneByteString);
+
+    OneByteString::OneByteString(StaticType* type, const byte* content, charcount_t charLength) :
+        LiteralString(type),
+        m_oneByteBuffer(content)
+    {
+        Assert(content != nullptr);
+        this->SetLength(charLength);
+    }
+
+    JavascriptString* OneByteString::NewCopyBuffer(__in_ecount(charLength) const char16* content, charcount_t charLength, ScriptContext* scriptContext)
+    {
+        // Empty and single character strings come from the library's caches
+        if (charLength <= 1 || !CONFIG_FLAG(OneByteStrings) || !IsOneByte(content, charLength))
+        {
+            return JavascriptString::NewCopyBuffer(content, charLength, scriptContext);
+        }
+
+#ifdef PROFILE_STRINGS
+        StringProfiler::RecordNewString(scriptContext, content, charLength);
+#endif
+
+        Recycler* recycler = scriptContext->GetRecycler();
+        byte* buffer = RecyclerNewArrayLeaf(recycler, byte, charLength);
+        for (charcount_t i = 0; i < charLength; i++)
+        {
+            buffer[i] = static_cast<byte>(content[i]);
+        }
+
+        return RecyclerNew(recycler, OneByteString, scriptContext->GetLibrary()->GetStringTypeStatic(), buffer, charLength);
+    }
+
+    JavascriptString* OneByteString::NewSubString(OneByteString* string, charcount_t start, charcount_t length)
+    {
+        Assert(string->GetLength() >= start + length);
+
+        ScriptContext* scriptContext = string->GetScriptContext();
+        switch (length)
+        {
+        case 0:
+            return scriptContext->GetLibrary()->GetEmptyString();
+
+        case 1:
+            return scriptContext->GetLibrary()->GetCharStringCache().GetStringForChar(string->GetItem(start));
+
+        default:
+            break;
+        }
+
+        // Copy the bytes rather than pointing into the original: that keeps the substring one byte per
+        // character without having to keep the whole original buffer alive
+        Recycler* recycler = scriptContext->GetRecycler();
+        byte* buffer = RecyclerNewArrayLeaf(recycler, byte, length);
+        js_memcpy_s(buffer, length, string->GetOneByteBuffer() + start, length);
+
+        return RecyclerNew(recycler, OneByteString, scriptContext->GetLibrary()->GetStringTypeStatic(), buffer, length);
+    }
+
+    bool OneByteString::Is(JavascriptString* string)
+    {
+        return VirtualTableInfo<OneByteString>::HasVirtualTable(string);
+    }
+
+    OneByteString* OneByteString::FromString(JavascriptString* string)
+    {
+        Assert(Is(string));
+        return static_cast<OneByteString*>(string);
+    }
+
+    bool OneByteString::IsOneByte(__in_ecount(charLength) const char16* content, charcount_t charLength)
+    {
+        // OR the characters together a block at a time so the loop can be vectorized, only
+        // checking in between blocks whether a wide character has been seen
+        const charcount_t BlockLength = 32;
+        charcount_t i = 0;
+        while (i < charLength)
+        {
+            const charcount_t blockEnd = min(charLength, i + BlockLength);
+            char16 bits = 0;
+            for (; i < blockEnd; i++)
+            {
+                bits |= content[i];
+            }
+            if (bits > 0xFF)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    char16 OneByteString::GetItem(charcount_t index) const
+    {
+        Assert(index < this->GetLength());
+        return m_oneByteBuffer[index];
+    }
+
+    const char16* OneByteString::GetSz()
+    {
+        AssertCanHandleOutOfMemory();
+        Assert(!this->IsFinalized());
+
+        charcount_t allocSize = SafeSzSize();
+        Recycler* recycler = this->GetScriptContext()->GetRecycler();
+        char16* target = RecyclerNewArrayLeaf(recycler, char16, allocSize);
+
+        const charcount_t length = this->GetLength();
+        for (charcount_t i = 0; i < length; i++)
+        {
+            target[i] = m_oneByteBuffer[i];
+        }
+        target[length] = _u('\0');
+
+        SetBuffer(target);
+        m_oneByteBuffer = nullptr;
+        VirtualTableInfo<LiteralString>::SetVirtualTable(this);
+        return JavascriptString::GetSz();
+    }
+
+    void OneByteString::CopyVirtual(
+        _Out_writes_(m_charLength) char16 *const buffer,
+        StringCopyInfoStack &nestedStringTreeCopyInfos,
+        const byte recursionDepth)
+    {
+        Assert(buffer);
+        Assert(!this->IsFinalized());
+
+        const charcount_t length = this->GetLength();
+        for (charcount_t i = 0; i < length; i++)
+        {
+            buffer[i] = m_oneByteBuffer[i];
+        }
+    }
+
+    size_t OneByteString::GetAllocatedByteCount() const
+    {
+        return this->GetLength() * sizeof(byte);
+    }
+
+    bool OneByteString::Equals(OneByteString* left, JavascriptString* right)
+    {
+        const charcount_t length = left->GetLength();
+        if (length != right->GetLength())
+        {
+            return false;
+        }
+
+        const byte* leftBuffer = left->GetOneByteBuffer();
+        if (Is(right))
+        {
+            return memcmp(leftBuffer, FromString(right)->GetOneByteBuffer(), length) == 0;
+        }
+
+        const char16* rightBuffer = right->GetString();
+        for (charcount_t i = 0; i < length; i++)
+        {
+            if (leftBuffer[i] != rightBuffer[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    int OneByteString::Compare(OneByteString* left, JavascriptString* right)
+    {
+        const charcount_t leftLength = left->GetLength();
+        const charcount_t rightLength = right->GetLength();
+        const charcount_t length = min(leftLength, rightLength);
+        const byte* leftBuffer = left->GetOneByteBuffer();
+
+        // Latin-1 is the first 256 code units of UTF-16, so byte order is code unit order
+        int result = 0;
+        if (Is(right))
+        {
+            result = memcmp(leftBuffer, FromString(right)->GetOneByteBuffer(), length);
+        }
+        else
+        {
+            const char16* rightBuffer = right->GetString();
+            for (charcount_t i = 0; i < length && result == 0; i++)
+            {
+                result = (int)leftBuffer[i] - (int)rightBuffer[i];
+            }
+        }
+
+        return (result == 0) ? (int)(leftLength - rightLength) : result;
+    }
+
+    int OneByteString::IndexOf(OneByteString* string, JavascriptString* searchString, charcount_t position)
+    {
+        const charcount_t length = string->GetLength();
+        const charcount_t searchLength = searchString->GetLength();
+        Assert(searchLength != 0);
+        if (position > length || searchLength > length - position)
+        {
+            return -1;
+        }
+
+        const byte* buffer = string->GetOneByteBuffer();
+        const byte* search;
+        byte searchChar;
+        if (Is(searchString))
+        {
+            search = FromString(searchString)->GetOneByteBuffer();
+        }
+        else
+        {
+            Assert(searchLength == 1);
+
+            // A wide character can't occur in a one-byte string
+            const char16 wideSearchChar = searchString->GetString()[0];
+            if (wideSearchChar > 0xFF)
+            {
+                return -1;
+            }
+            searchChar = static_cast<byte>(wideSearchChar);
+            search = &searchChar;
+        }
+
+        // Find the first byte with memchr, then compare the rest
+        const byte* current = buffer + position;
+        const byte* const last = buffer + length - searchLength;
+        while (current <= last)
+        {
+            current = static_cast<const byte*>(memchr(current, search[0], last - current + 1));
+            if (current == nullptr)
+            {
+                return -1;
+            }
+            if (searchLength == 1 || memcmp(current + 1, search + 1, searchLength - 1) == 0)
+            {
+                return static_cast<int>(current - buffer);
+            }
+            current++;
+        }
+        return -1;
+    }
+
+    uint OneByteString::GetHashCode() const
+    {
+        // Same hash as over the widened characters, so one-byte and char16 strings can share hash tables
+        return JsUtil::CharacterBuffer<byte>::StaticGetHashCode(m_oneByteBuffer, this->GetLength());
+    }
+} // namespace Js
@@ -0,0 +1,57 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+namespace Js
+{
+    // A string whose characters all fit in one byte (Latin-1), stored with one byte per character.
+    // Only the string values produced by JSON.parse, and substrings of them, are stored this way. Parsed
+    // payloads are often kept alive in bulk and are mostly ASCII, so this halves the memory they hold.
+    // Literals and property strings share their buffer with the source or the PropertyRecord, and concat
+    // strings flatten into char16 for their consumers, so they would only pay for a copy.
+    //
+    // It is a separate string type, rather than a flag on LiteralString, so that the one-byte paths only
+    // cost a vtable compare on other strings and a widened string can drop back to LiteralString's vtable.
+    // The char16 buffer is created on demand (call GetString() or GetSz()). At that point the one-byte
+    // buffer is released and the vtable is switched to LiteralString's, so a string is only ever
+    // stored one way.
+    // Until then equality, comparison, hashing, indexOf and character access work on the bytes directly,
+    // and copying into a concat string tree widens into the destination without flattening this string.
+    class OneByteString sealed : public LiteralString // vtable will be switched to LiteralString's vtable after widening
+    {
+    protected:
+        OneByteString(StaticType* type, const byte* content, charcount_t charLength);
+        DEFINE_VTABLE_CTOR(OneByteString, LiteralString);
+        DECLARE_CONCRETE_STRING_CLASS;
+
+        virtual void CopyVirtual(_Out_writes_(m_charLength) char16 *const buffer, StringCopyInfoStack &nestedStringTreeCopyInfos, const byte recursionDepth) override;
+
+    public:
+        // Copies a JSON string value into a one-byte string if every character fits in one byte, or into a regular string
+        // otherwise
+        static JavascriptString* NewCopyBuffer(__in_ecount(charLength) const char16* content, charcount_t charLength, ScriptContext* scriptContext);
+        static JavascriptString* NewSubString(OneByteString* string, charcount_t start, charcount_t length);
+
+        static bool Is(JavascriptString* string);
+        static OneByteString* FromString(JavascriptString* string);
+        static bool IsOneByte(__in_ecount(charLength) const char16* content, charcount_t charLength);
+
+        const byte* GetOneByteBuffer() const { return m_oneByteBuffer; }
+        char16 GetItem(charcount_t index) const;
+
+        virtual const char16* GetSz() override;
+        virtual size_t GetAllocatedByteCount() const override;
+
+        // Fast paths for JavascriptString. The other string may be of any kind; it is only flattened if it isn't one-byte.
+        // IndexOf takes a one-byte or single character search string.
+        static bool Equals(OneByteString* left, JavascriptString* right);
+        static int Compare(OneByteString* left, JavascriptString* right);
+        static int IndexOf(OneByteString* string, JavascriptString* searchString, charcount_t position);
+        uint GetHashCode() const;
+
+    private:
+        const byte* m_oneByteBuffer;
+    };
+}
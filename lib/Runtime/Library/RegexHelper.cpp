@@ -89,7 +89,8 @@ namespace Js
         {
             // The source is from a literal regex, so we're cloning a literal regex. Don't use the dynamic regex MRU map since
             // these literal regex patterns' lifetimes are tied with the function body.
-            return PrimCompileDynamic(scriptContext, psz, csz, pszOpts, cszOpts, isLiteralSource);
+            UnifiedRegex::RegexPattern* pattern = NewPatternFromSharedProgram(scriptContext, psz, csz, flags, isLiteralSource);
+            return pattern ? pattern : PrimCompileDynamic(scriptContext, psz, csz, pszOpts, cszOpts, isLiteralSource);
         }
 
         UnifiedRegex::RegexKey lookupKey(psz, csz, flags);
@@ -97,7 +98,11 @@ namespace Js
         RegexPatternMruMap* dynamicRegexMap = scriptContext->GetDynamicRegexMap();
         if (!dynamicRegexMap->TryGetValue(lookupKey, &pattern))
         {
-            pattern = PrimCompileDynamic(scriptContext, psz, csz, pszOpts, cszOpts, isLiteralSource);
+            pattern = NewPatternFromSharedProgram(scriptContext, psz, csz, flags, isLiteralSource);
+            if (!pattern)
+            {
+                pattern = PrimCompileDynamic(scriptContext, psz, csz, pszOpts, cszOpts, isLiteralSource);
+            }
 
             // WARNING: Must calculate key again so that dictionary has copy of source associated with the pattern
             const auto source = pattern->GetSource();
@@ -147,6 +152,19 @@ namespace Js
         return CompileDynamic(scriptContext, psz, csz, opts, i, isLiteralSource);
     }
 
+    UnifiedRegex::RegexPattern* RegexHelper::NewPatternFromSharedProgram(ScriptContext *scriptContext, const char16* psz, CharCount csz, UnifiedRegex::RegexFlags flags, bool isLiteralSource)
+    {
+        // Another script context of this thread may already have compiled the same source and flags
+        ThreadContext* threadContext = scriptContext->GetThreadContext();
+        if (!threadContext->IsSharingRegexPrograms())
+        {
+            return nullptr;
+        }
+
+        UnifiedRegex::SharedProgram* sharedProgram = threadContext->GetSharedRegexProgram(UnifiedRegex::RegexKey(psz, csz, flags));
+        return sharedProgram ? UnifiedRegex::RegexPattern::New(scriptContext, sharedProgram, isLiteralSource) : nullptr;
+    }
+
     UnifiedRegex::RegexPattern* RegexHelper::PrimCompileDynamic(ScriptContext *scriptContext, const char16* psz, CharCount csz, const char16* pszOpts, CharCount cszOpts, bool isLiteralSource)
     {
         PROBE_STACK(scriptContext, Js::Constants::MinStackRegex);
@@ -221,7 +239,20 @@ namespace Js
         UnifiedRegex::Program* program = UnifiedRegex::Program::New(recycler, flags);
         parser.CaptureSourceAndGroups(recycler, program, psz, csz);
 
-        UnifiedRegex::RegexPattern* pattern = UnifiedRegex::RegexPattern::New(scriptContext, program, isLiteralSource);
+        // When the program may be shared with the other script contexts of the thread, its run-time data must outlive this one
+        ThreadContext* threadContext = scriptContext->GetThreadContext();
+        UnifiedRegex::SharedProgram* sharedProgram = nullptr;
+        UnifiedRegex::RegexPattern* pattern;
+        if (threadContext->IsSharingRegexPrograms())
+        {
+            rtAllocator = threadContext->GetRegexAllocator();
+            sharedProgram = UnifiedRegex::SharedProgram::New(recycler, program, rtAllocator);
+            pattern = UnifiedRegex::RegexPattern::New(scriptContext, sharedProgram, isLiteralSource);
+        }
+        else
+        {
+            pattern = UnifiedRegex::RegexPattern::New(scriptContext, program, isLiteralSource);
+        }
 
 #if ENABLE_REGEX_CONFIG_OPTIONS
         if (REGEX_CONFIG_FLAG(RegexProfile))
@@ -261,6 +292,16 @@ namespace Js
 #endif
 
         END_TEMP_ALLOCATOR(ctAllocator, scriptContext);
+
+        if (sharedProgram && pattern->CanShareProgram())
+        {
+            UnifiedRegex::RegexKey sharedKey(program->source, program->sourceLen, program->flags);
+            if (!threadContext->GetSharedRegexProgram(sharedKey))
+            {
+                threadContext->AddSharedRegexProgram(sharedKey, sharedProgram);
+            }
+        }
+
 #ifdef PROFILE_EXEC
         scriptContext->ProfileEnd(Js::RegexCompilePhase);
 #endif
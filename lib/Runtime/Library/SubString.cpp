@@ -25,6 +25,12 @@ namespace Js
         AssertMsg( IsValidCharCount(start), "start is out of range" );
         AssertMsg( IsValidCharCount(length), "length is out of range" );
 
+        if (OneByteString::Is(string))
+        {
+            // Keep one byte per character instead of widening the whole string to point into it
+            return OneByteString::NewSubString(OneByteString::FromString(string), start, length);
+        }
+
         ScriptContext *scriptContext = string->GetScriptContext();
         if (!length)
         {
@@ -2459,6 +2459,158 @@ namespace Js
         }
     }
 
+    // Maps the bits of each element type to an unsigned key of the same size whose unsigned order is the order of
+    // the default comparison (ascending, -0 before +0, NaN last), so that sorting without a comparer is a radix sort.
+    template<typename T> struct TypedArraySortKey;
+
+#define TYPEDARRAY_INTEGER_SORT_KEY(type, keyType, bias) \
+    template<> struct TypedArraySortKey<type> \
+    { \
+        typedef keyType Key; \
+        static Key ToKey(Key bits) { return bits ^ (bias); } \
+        static Key FromKey(Key key) { return key ^ (bias); } \
+    };
+
+    TYPEDARRAY_INTEGER_SORT_KEY(int8, uint8, 0x80)
+    TYPEDARRAY_INTEGER_SORT_KEY(uint8, uint8, 0)
+    TYPEDARRAY_INTEGER_SORT_KEY(int16, uint16, 0x8000)
+    TYPEDARRAY_INTEGER_SORT_KEY(uint16, uint16, 0)
+    TYPEDARRAY_INTEGER_SORT_KEY(int32, uint32, 0x80000000)
+    TYPEDARRAY_INTEGER_SORT_KEY(uint32, uint32, 0)
+    TYPEDARRAY_INTEGER_SORT_KEY(int64, uint64, 0x8000000000000000ull)
+    TYPEDARRAY_INTEGER_SORT_KEY(uint64, uint64, 0)
+    TYPEDARRAY_INTEGER_SORT_KEY(bool, uint8, 0)
+#undef TYPEDARRAY_INTEGER_SORT_KEY
+
+    // Positive values get the sign bit set and negative values are inverted, which orders IEEE bit patterns like the
+    // numbers they represent. NaNs are first replaced with the positive canonical NaN so that they all sort last.
+    template<typename TKey, TKey SignBit, TKey InfinityBits, TKey NaNBits> struct TypedArrayFloatSortKey
+    {
+        typedef TKey Key;
+        static Key ToKey(Key bits)
+        {
+            if ((bits & ~SignBit) > InfinityBits)
+            {
+                bits = NaNBits;
+            }
+            return (bits & SignBit) ? ~bits : (bits | SignBit);
+        }
+        static Key FromKey(Key key) { return (key & SignBit) ? (key ^ SignBit) : ~key; }
+    };
+
+    template<> struct TypedArraySortKey<float> : TypedArrayFloatSortKey<uint32, 0x80000000, 0x7F800000, 0x7FC00000> {};
+    template<> struct TypedArraySortKey<double> : TypedArrayFloatSortKey<uint64, 0x8000000000000000ull, 0x7FF0000000000000ull, 0x7FF8000000000000ull> {};
+
+    template<typename TKey> void TypedArrayRadixSortKeys(__inout_ecount(length) TKey* keys, uint32 length, ArenaAllocator* tempAlloc)
+    {
+        const uint32 DigitBits = 8;
+        const uint32 DigitCount = sizeof(TKey);
+        const uint32 BucketCount = 1 << DigitBits;
+        const uint32 BucketMask = BucketCount - 1;
+
+        // Below this, the histogram setup costs more than a plain insertion sort.
+        const uint32 InsertionSortThreshold = 64;
+        if (DigitCount > 1 && length < InsertionSortThreshold)
+        {
+            for (uint32 i = 1; i < length; i++)
+            {
+                const TKey key = keys[i];
+                uint32 j = i;
+                for (; j > 0 && keys[j - 1] > key; j--)
+                {
+                    keys[j] = keys[j - 1];
+                }
+                keys[j] = key;
+            }
+            return;
+        }
+
+        // Count every digit position in a single pass over the keys.
+        uint32* counts = AnewArrayZ(tempAlloc, uint32, DigitCount * BucketCount);
+        for (uint32 i = 0; i < length; i++)
+        {
+            TKey key = keys[i];
+            for (uint32 digit = 0; digit < DigitCount; digit++)
+            {
+                counts[digit * BucketCount + (uint32)(key & BucketMask)]++;
+                key = (TKey)(key >> (DigitBits - 1) >> 1);
+            }
+        }
+
+        if (DigitCount == 1)
+        {
+            // Single byte elements: the histogram is the sorted array.
+            uint32 index = 0;
+            for (uint32 bucket = 0; bucket < BucketCount; bucket++)
+            {
+                for (uint32 count = counts[bucket]; count != 0; count--)
+                {
+                    keys[index++] = (TKey)bucket;
+                }
+            }
+            Assert(index == length);
+            return;
+        }
+
+        // LSD radix sort, ping-ponging between the keys and a scratch buffer. Digit positions where every key has
+        // the same digit (e.g. the high bytes of small integers) don't need a pass.
+        TKey* from = keys;
+        TKey* to = AnewArray(tempAlloc, TKey, length);
+        for (uint32 digit = 0; digit < DigitCount; digit++)
+        {
+            const uint32 shift = digit * DigitBits;
+            uint32* bucketOffsets = counts + digit * BucketCount;
+            if (bucketOffsets[(uint32)(from[0] >> shift) & BucketMask] == length)
+            {
+                continue;
+            }
+
+            uint32 offset = 0;
+            for (uint32 bucket = 0; bucket < BucketCount; bucket++)
+            {
+                const uint32 count = bucketOffsets[bucket];
+                bucketOffsets[bucket] = offset;
+                offset += count;
+            }
+
+            for (uint32 i = 0; i < length; i++)
+            {
+                const TKey key = from[i];
+                to[bucketOffsets[(uint32)(key >> shift) & BucketMask]++] = key;
+            }
+
+            TKey* const swap = from;
+            from = to;
+            to = swap;
+        }
+
+        if (from != keys)
+        {
+            js_memcpy_s(keys, length * sizeof(TKey), from, length * sizeof(TKey));
+        }
+    }
+
+    template<typename T> void __cdecl TypedArraySortElementsHelper(void* elements, uint32 length, ArenaAllocator* tempAlloc)
+    {
+        typedef TypedArraySortKey<T> SortKey;
+        typedef typename SortKey::Key Key;
+        CompileAssert(sizeof(Key) == sizeof(T));
+
+        // Sort the keys in place in the element buffer; no user code runs, so nothing can observe the keys.
+        Key* keys = static_cast<Key*>(elements);
+        for (uint32 i = 0; i < length; i++)
+        {
+            keys[i] = SortKey::ToKey(keys[i]);
+        }
+
+        TypedArrayRadixSortKeys(keys, length, tempAlloc);
+
+        for (uint32 i = 0; i < length; i++)
+        {
+            keys[i] = SortKey::FromKey(keys[i]);
+        }
+    }
+
     Var TypedArrayBase::EntrySort(RecyclableObject* function, CallInfo callInfo, ...)
     {
         PROBE_STACK(function->GetScriptContext(), Js::Constants::MinStackDefault);
@@ -2502,6 +2654,18 @@ namespace Js
             compareFn = RecyclableObject::FromVar(args[1]);
         }
 
+        if (compareFn == nullptr)
+        {
+            // Without a comparer the result only depends on the element values, so sort them directly.
+            BEGIN_TEMP_ALLOCATOR(tempAlloc, scriptContext, _u("Runtime"))
+            {
+                typedArrayBase->GetSortElementsFunction()(typedArrayBase->GetByteBuffer(), length, tempAlloc);
+            }
+            END_TEMP_ALLOCATOR(tempAlloc, scriptContext);
+
+            return typedArrayBase;
+        }
+
         // Get the elements comparison function for the type of this TypedArray
         void* elementCompare = reinterpret_cast<void*>(typedArrayBase->GetCompareElementsFunction());
 
@@ -11,6 +11,7 @@ namespace Js
     typedef Var (*PFNCreateTypedArray)(Js::ArrayBufferBase* arrayBuffer, uint32 offSet, uint32 mappedLength, Js::JavascriptLibrary* javascriptLibrary);
 
     template<typename T> int __cdecl TypedArrayCompareElementsHelper(void* context, const void* elem1, const void* elem2);
+    template<typename T> void __cdecl TypedArraySortElementsHelper(void* elements, uint32 length, ArenaAllocator* tempAlloc);
 
     class TypedArrayBase : public ArrayBufferParent
     {
@@ -182,6 +183,10 @@ namespace Js
         typedef int(__cdecl* CompareElementsFunction)(void*, const void*, const void*);
         virtual CompareElementsFunction GetCompareElementsFunction() = 0;
 
+        // Sorts the elements in the default order (no comparer)
+        typedef void(__cdecl* SortElementsFunction)(void*, uint32, ArenaAllocator*);
+        virtual SortElementsFunction GetSortElementsFunction() = 0;
+
         virtual Var Subarray(uint32 begin, uint32 end) = 0;
         int32 BYTES_PER_ELEMENT;
         uint32 byteOffset;
@@ -438,6 +443,11 @@ namespace Js
         {
             return &TypedArrayCompareElementsHelper<TypeName>;
         }
+
+        SortElementsFunction GetSortElementsFunction()
+        {
+            return &TypedArraySortElementsHelper<TypeName>;
+        }
     };
 
     // in windows build environment, char16 is not an intrinsic type, and we cannot do the type
@@ -494,6 +504,12 @@ namespace Js
         {
             return &TypedArrayCompareElementsHelper<char16>;
         }
+
+        SortElementsFunction GetSortElementsFunction()
+        {
+            // char16 may not be a distinct type (see above); its elements sort like uint16.
+            return &TypedArraySortElementsHelper<uint16>;
+        }
     };
 
 #if defined(__clang__)
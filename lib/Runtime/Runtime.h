@@ -26,6 +26,7 @@ enum SymbolType : byte;
 namespace UnifiedRegex
 {
     struct RegexPattern;
+    struct SharedProgram;
     template <typename T> class StandardChars;      // Used by ThreadContext.h
     struct TrigramAlphabet;
     struct RegexStacks;
@@ -121,6 +122,7 @@ namespace Js
     class JavascriptGenerator;
     class LiteralString;
     class ArenaLiteralString;
+    class OneByteString;
     class JavascriptStringObject;
     struct PropertyDescriptor;
     class Type;
@@ -474,13 +476,14 @@ enum tagDEBUG_EVENT_INFO_TYPE
 #define CHAKRATEL_LANGSTATS_INC_BUILTINCOUNT(builtin)
 #define CHAKRATEL_LANGSTATS_INC_LANGFEATURECOUNT(feature, m_scriptContext)
 #endif
+#include "Base/RegexPatternMruMap.h" // Used by ThreadContext.h
+#include "Types/MegamorphicPropertyCache.h" // Used by ThreadContext.h
 #include "Base/ThreadContext.h"
 
 #include "Base/StackProber.h"
 #include "Base/ScriptContextProfiler.h"
 
 #include "Language/EvalMapRecord.h"
-#include "Base/RegexPatternMruMap.h"
 #include "Language/JavascriptConversion.h"
 
 #include "Base/ScriptContextOptimizationOverrideInfo.h"
@@ -497,6 +500,7 @@ enum tagDEBUG_EVENT_INFO_TYPE
 #include "Library/GlobalObject.h"
 
 #include "Library/LiteralString.h"
+#include "Library/OneByteString.h"
 #include "Library/ConcatString.h"
 #include "Library/CompoundString.h"
 #include "Library/PropertyString.h"
@@ -196,7 +196,8 @@ namespace Js
 
 namespace JSON
 {
-    class JSONParser;
+    template <typename CharType> class JSONParserT;
+    class JsonTypeCacheList;
 }
 
 //
@@ -656,13 +656,11 @@ namespace Js
         }
 
         // Marshalling cannot handle non-Var values, so extract
-        // the two internal property values that could appear on a CEO, clear them to null which
-        // marshalling does handle, and then restore them after marshalling.  Neither property's
-        // data needs marshalling because:
-        //  1. StackTrace's data does not contain references to JavaScript objects that would need marshalling.
-        //  2. Values in the WeakMapKeyMap can only be accessed by the WeakMap object that put them there.  If
-        //     that WeakMap is marshalled it will take care of any necessary marshalling of the value by virtue
-        //     of being wrapped in CrossSite<>.
+        // the internal property values that could appear on a CEO, clear them to null which
+        // marshalling does handle, and then restore them after marshalling.  StackTrace's data
+        // does not need marshalling because it does not contain references to JavaScript objects.
+        // (WeakMap entries are not stored on their keys, so a reset object stays a key of the
+        // WeakMaps it was added to.)
 
         Var stackTraceValue = nullptr;
         if (this->GetInternalProperty(this, InternalPropertyIds::StackTrace, &stackTraceValue, nullptr, this->GetScriptContext()))
@@ -670,12 +668,6 @@ namespace Js
             this->SetInternalProperty(InternalPropertyIds::StackTrace, nullptr, PropertyOperation_None, nullptr);
         }
 
-        Var weakMapKeyMapValue = nullptr;
-        if (this->GetInternalProperty(this, InternalPropertyIds::WeakMapKeyMap, &weakMapKeyMapValue, nullptr, this->GetScriptContext()))
-        {
-            this->SetInternalProperty(InternalPropertyIds::WeakMapKeyMap, nullptr, PropertyOperation_Force, nullptr);
-        }
-
         Var mutationBpValue = nullptr;
         if (this->GetInternalProperty(this, InternalPropertyIds::MutationBp, &mutationBpValue, nullptr, this->GetScriptContext()))
         {
@@ -690,10 +682,6 @@ namespace Js
             {
                 this->SetInternalProperty(InternalPropertyIds::StackTrace, stackTraceValue, PropertyOperation_None, nullptr);
             }
-            if (weakMapKeyMapValue)
-            {
-                this->SetInternalProperty(InternalPropertyIds::WeakMapKeyMap, weakMapKeyMapValue, PropertyOperation_Force, nullptr);
-            }
             if (mutationBpValue)
             {
                 this->SetInternalProperty(InternalPropertyIds::MutationBp, mutationBpValue, PropertyOperation_Force, nullptr);
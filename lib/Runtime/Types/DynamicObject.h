@@ -59,7 +59,7 @@ namespace Js
         friend class PathTypeHandlerBase; // for ReplaceType
         friend class JavascriptLibrary;  // for ReplaceType
         friend class ScriptFunction; // for ReplaceType;
-        friend class JSON::JSONParser; //for ReplaceType
+        template <typename CharType> friend class JSON::JSONParserT; //for ReplaceType
         friend class ModuleNamespace; // for slot setting.
 
 #if ENABLE_OBJECT_SOURCE_TRACKING
@@ -0,0 +1,265 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#include "RuntimeTypePch.h"
+
+namespace Js
+{
+    MegamorphicPropertyCache::MegamorphicPropertyCache() : entries(nullptr)
+    {
+        protoPropertyIdBuckets.ClearAll();
+    }
+
+    MegamorphicPropertyCache::~MegamorphicPropertyCache()
+    {
+        if(entries)
+        {
+            HeapDeleteArray(MegamorphicPropertyCache_NumEntries, entries);
+        }
+    }
+
+    uint MegamorphicPropertyCache::EntryIndex(const Type *const type, const PropertyId id)
+    {
+        Assert(type);
+        Assert(id != Constants::NoProperty);
+        CompileAssert((MegamorphicPropertyCache_NumEntries & MegamorphicPropertyCache_NumEntries - 1) == 0);
+
+        // The low bits of a type's address are the same for all types, and property IDs are small and dense, so spread
+        // the property ID over the bits that differ between types
+        const uint typeBits = static_cast<uint>(reinterpret_cast<size_t>(type) >> HeapConstants::ObjectAllocationShift);
+        return (typeBits ^ ((static_cast<uint>(id) * 0x9e3779b1) >> 16)) & (MegamorphicPropertyCache_NumEntries - 1);
+    }
+
+    uint MegamorphicPropertyCache::ProtoPropertyIdBucket(const PropertyId id)
+    {
+        Assert(id != Constants::NoProperty);
+        CompileAssert((MegamorphicPropertyCache_NumProtoPropertyIdBuckets & MegamorphicPropertyCache_NumProtoPropertyIdBuckets - 1) == 0);
+
+        return id & (MegamorphicPropertyCache_NumProtoPropertyIdBuckets - 1);
+    }
+
+    bool MegamorphicPropertyCache::TryGetProperty(
+        const bool checkMissing,
+        RecyclableObject *const object,
+        const PropertyId propertyId,
+        Var *const propertyValue,
+        ScriptContext *const requestContext,
+        PropertyValueInfo *const propertyValueInfo)
+    {
+        Assert(object);
+        Assert(propertyValue);
+
+        if(!entries || object->GetScriptContext() != requestContext)
+        {
+            return false;
+        }
+
+        Type *const type = object->GetType();
+        const Entry &entry = entries[EntryIndex(type, propertyId)];
+        if(entry.type != type ||
+            entry.id != propertyId ||
+            (entry.isMissing && !checkMissing) ||
+            (
+                entry.prototypeObjectWithProperty &&
+                (
+                    entry.prototypeObjectWithProperty->GetScriptContext() != requestContext ||
+                    PropertyValueInfo::PrototypeCacheDisabled(propertyValueInfo)
+                )
+            ))
+        {
+        #if DBG_DUMP
+            if(PHASE_TRACE1(MegamorphicPropertyCachePhase))
+            {
+                CacheOperators::TraceCache(
+                    static_cast<InlineCache *>(nullptr),
+                    _u("MegamorphicPropertyCache get miss"),
+                    propertyId,
+                    requestContext,
+                    object);
+            }
+        #endif
+            return false;
+        }
+
+        const bool isProto = !!entry.prototypeObjectWithProperty;
+        DynamicObject *const objectWithProperty = isProto ? entry.prototypeObjectWithProperty : DynamicObject::FromVar(object);
+
+    #if DBG_DUMP
+        if(PHASE_TRACE1(MegamorphicPropertyCachePhase))
+        {
+            CacheOperators::TraceCache(
+                static_cast<InlineCache *>(nullptr),
+                isProto ? _u("MegamorphicPropertyCache get hit prototype") : _u("MegamorphicPropertyCache get hit"),
+                propertyId,
+                requestContext,
+                object);
+        }
+    #endif
+
+    #if DBG
+        const PropertyIndex typeHandlerPropertyIndex =
+            objectWithProperty
+                ->GetDynamicType()
+                ->GetTypeHandler()
+                ->InlineOrAuxSlotIndexToPropertyIndex(entry.index, entry.isInlineSlot);
+        Assert(typeHandlerPropertyIndex == objectWithProperty->GetPropertyIndex(propertyId));
+    #endif
+
+        *propertyValue =
+            entry.isInlineSlot
+                ? objectWithProperty->GetInlineSlot(entry.index)
+                : objectWithProperty->GetAuxSlot(entry.index);
+
+        if(propertyValueInfo)
+        {
+            // Put the type back in the site's caches, in case the next access at the site is with the same type
+            CacheOperators::Cache<false, true, false>(
+                isProto,
+                objectWithProperty,
+                false,
+                type,
+                nullptr,
+                propertyId,
+                entry.index,
+                entry.isInlineSlot,
+                entry.isMissing,
+                0,
+                propertyValueInfo,
+                requestContext);
+        }
+        return true;
+    }
+
+    void MegamorphicPropertyCache::Cache(
+        Type *const type,
+        const PropertyId id,
+        const PropertyIndex index,
+        const bool isInlineSlot,
+        const bool isMissing,
+        DynamicObject *const prototypeObjectWithProperty)
+    {
+        Assert(type);
+        Assert(id != Constants::NoProperty);
+        Assert(index != Constants::NoSlot);
+        Assert(!isMissing || prototypeObjectWithProperty);
+
+        if(PHASE_OFF1(MegamorphicPropertyCachePhase))
+        {
+            return;
+        }
+
+        if(!entries)
+        {
+            // The cache is only an optimization, so don't throw if it can't be allocated
+            entries = HeapNewNoThrowArrayZ(Entry, MegamorphicPropertyCache_NumEntries);
+            if(!entries)
+            {
+                return;
+            }
+        }
+
+        Entry &entry = entries[EntryIndex(type, id)];
+        entry.type = type;
+        entry.prototypeObjectWithProperty = prototypeObjectWithProperty;
+        entry.id = id;
+        entry.index = index;
+        entry.isInlineSlot = isInlineSlot;
+        entry.isMissing = isMissing;
+        Assert(!prototypeObjectWithProperty ||
+            isMissing == (prototypeObjectWithProperty == prototypeObjectWithProperty->GetLibrary()->GetMissingPropertyHolder()));
+
+        if(prototypeObjectWithProperty)
+        {
+            protoPropertyIdBuckets.Set(ProtoPropertyIdBucket(id));
+        }
+    }
+
+    void MegamorphicPropertyCache::ClearProtoEntries(const PropertyId id)
+    {
+        // Properties are invalidated on prototypes much more often than entries are cached for them, so only look at the
+        // entries if there may be a prototype entry for the property
+        const uint bucket = ProtoPropertyIdBucket(id);
+        if(!entries || !protoPropertyIdBuckets.Test(bucket))
+        {
+            return;
+        }
+
+        bool isBucketInUse = false;
+        for(uint i = 0; i < MegamorphicPropertyCache_NumEntries; i++)
+        {
+            Entry &entry = entries[i];
+            if(!entry.prototypeObjectWithProperty)
+            {
+                continue;
+            }
+
+            if(entry.id == id)
+            {
+                entry.type = nullptr;
+                entry.prototypeObjectWithProperty = nullptr;
+            }
+            else if(ProtoPropertyIdBucket(entry.id) == bucket)
+            {
+                isBucketInUse = true;
+            }
+        }
+
+        if(!isBucketInUse)
+        {
+            protoPropertyIdBuckets.Clear(bucket);
+        }
+    }
+
+    void MegamorphicPropertyCache::ClearAllProtoEntries()
+    {
+        if(!entries)
+        {
+            return;
+        }
+
+        for(uint i = 0; i < MegamorphicPropertyCache_NumEntries; i++)
+        {
+            Entry &entry = entries[i];
+            if(entry.prototypeObjectWithProperty)
+            {
+                entry.type = nullptr;
+                entry.prototypeObjectWithProperty = nullptr;
+            }
+        }
+        protoPropertyIdBuckets.ClearAll();
+    }
+
+    void MegamorphicPropertyCache::ClearUnusedEntries(Recycler *const recycler)
+    {
+        // Called before sweeping. The entries don't keep their types and prototype objects alive, so they must not refer
+        // to them anymore once they are swept.
+        Assert(recycler);
+
+        if(!entries)
+        {
+            return;
+        }
+
+        protoPropertyIdBuckets.ClearAll();
+        for(uint i = 0; i < MegamorphicPropertyCache_NumEntries; i++)
+        {
+            Entry &entry = entries[i];
+            if(!entry.type)
+            {
+                continue;
+            }
+
+            if(!recycler->IsObjectMarked(entry.type) ||
+                (entry.prototypeObjectWithProperty && !recycler->IsObjectMarked(entry.prototypeObjectWithProperty)))
+            {
+                entry.type = nullptr;
+                entry.prototypeObjectWithProperty = nullptr;
+            }
+            else if(entry.prototypeObjectWithProperty)
+            {
+                protoPropertyIdBuckets.Set(ProtoPropertyIdBucket(entry.id));
+            }
+        }
+    }
+}
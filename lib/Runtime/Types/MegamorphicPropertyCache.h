@@ -0,0 +1,55 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+// Must be powers of 2
+#define MegamorphicPropertyCache_NumEntries 2048
+#define MegamorphicPropertyCache_NumProtoPropertyIdBuckets 256
+
+namespace Js
+{
+    // A direct mapped cache of property loads, shared by all script contexts of a thread and keyed by the type of the
+    // object and the property ID. It backs the inline caches of load sites that have seen more types than their
+    // polymorphic inline cache can hold, so that a type that was displaced from a site's caches, or that was seen at
+    // another megamorphic site, is still found without going through the type handler and prototype chain.
+    //
+    // Like inline caches, an entry is guarded by the type of the object: a local entry refers to a slot of the object
+    // itself, and a prototype entry refers to a slot of an object on its prototype chain, or to the library's missing
+    // property holder if the property isn't found on the chain. Prototype entries are cleared when their property is
+    // invalidated on a prototype, along with the prototype caches of TypePropertyCache. The entries don't keep their
+    // types and prototype objects alive and are cleared before sweeping if either wasn't marked.
+    class MegamorphicPropertyCache
+    {
+    private:
+        struct Entry
+        {
+            Type *type;
+            DynamicObject *prototypeObjectWithProperty;   // nullptr for local entries
+            PropertyId id;
+            PropertyIndex index;
+            bool isInlineSlot : 1;
+            bool isMissing : 1;
+        };
+
+        Entry *entries;     // nullptr until the first entry is cached
+        BVStatic<MegamorphicPropertyCache_NumProtoPropertyIdBuckets> protoPropertyIdBuckets;
+
+    public:
+        MegamorphicPropertyCache();
+        ~MegamorphicPropertyCache();
+
+    private:
+        static uint EntryIndex(const Type *const type, const PropertyId id);
+        static uint ProtoPropertyIdBucket(const PropertyId id);
+
+    public:
+        bool TryGetProperty(const bool checkMissing, RecyclableObject *const object, const PropertyId propertyId, Var *const propertyValue, ScriptContext *const requestContext, PropertyValueInfo *const propertyValueInfo);
+        void Cache(Type *const type, const PropertyId id, const PropertyIndex index, const bool isInlineSlot, const bool isMissing, DynamicObject *const prototypeObjectWithProperty);
+
+        void ClearProtoEntries(const PropertyId id);
+        void ClearAllProtoEntries();
+        void ClearUnusedEntries(Recycler *const recycler);
+    };
+}
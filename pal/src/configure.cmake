@@ -29,6 +29,7 @@ check_include_files(sys/time.h HAVE_SYS_TIME_H)
 check_include_files(pthread_np.h HAVE_PTHREAD_NP_H)
 check_include_files(sys/lwp.h HAVE_SYS_LWP_H)
 check_include_files(libunwind.h HAVE_LIBUNWIND_H)
+check_include_files(linux/userfaultfd.h HAVE_LINUX_USERFAULTFD_H)
 check_include_files(runetype.h HAVE_RUNETYPE_H)
 check_include_files(unicode/uchar.h HAVE_LIBICU_UCHAR_H)
 
@@ -42,6 +42,14 @@ Abstract:
 #include <mach/mach_init.h>
 #endif // HAVE_VM_ALLOCATE
 
+#if HAVE_LINUX_USERFAULTFD_H
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/fs.h>
+#include <linux/userfaultfd.h>
+#endif // HAVE_LINUX_USERFAULTFD_H
+
 using namespace CorUnix;
 
 SET_DEFAULT_DEBUG_CHANNEL(VIRTUAL);
@@ -110,6 +118,93 @@ static LPVOID ReserveVirtualMemory(
 // of virtual memory that is located near the coreclr library.
 static ExecutableMemoryAllocator g_executableMemoryAllocator PAL_GLOBAL;
 
+/*
+ * Write watch (MEM_WRITE_WATCH, GetWriteWatch, ResetWriteWatch)
+ *
+ * Implemented on Linux with asynchronous userfaultfd write-protection
+ * (UFFD_FEATURE_WP_ASYNC) and the /proc/self/pagemap PAGEMAP_SCAN ioctl.
+ * A write to a write-protected page is resolved by the kernel without
+ * notifying us and leaves the page unprotected, so "written since the
+ * last reset" is simply "not write-protected". Both resetting and
+ * querying-with-reset work on an exact address range, which is what the
+ * recycler expects from the Windows API.
+ *
+ * Write watched regions are committed and decommitted with mprotect
+ * instead of being remapped, as remapping would drop the userfaultfd
+ * registration of the range.
+ */
+#if HAVE_LINUX_USERFAULTFD_H && defined(__NR_userfaultfd)
+#define HAVE_WRITE_WATCH 1
+
+// Older kernel headers don't define the async write-protect interface
+#ifndef UFFD_USER_MODE_ONLY
+#define UFFD_USER_MODE_ONLY 1
+#endif
+#ifndef UFFD_FEATURE_WP_UNPOPULATED
+#define UFFD_FEATURE_WP_UNPOPULATED (1 << 13)
+#endif
+#ifndef UFFD_FEATURE_WP_ASYNC
+#define UFFD_FEATURE_WP_ASYNC (1 << 15)
+#endif
+
+#ifndef PAGEMAP_SCAN
+#define PAGE_IS_WPALLOWED       (1 << 0)
+#define PAGE_IS_WRITTEN         (1 << 1)
+
+#define PM_SCAN_WP_MATCHING     (1 << 0)
+#define PM_SCAN_CHECK_WPASYNC   (1 << 1)
+
+struct page_region {
+    __u64 start;
+    __u64 end;
+    __u64 categories;
+};
+
+struct pm_scan_arg {
+    __u64 size;
+    __u64 flags;
+    __u64 start;
+    __u64 end;
+    __u64 walk_end;
+    __u64 vec;
+    __u64 vec_len;
+    __u64 max_pages;
+    __u64 category_inverted;
+    __u64 category_mask;
+    __u64 category_anyof_mask;
+    __u64 return_mask;
+};
+
+#define PAGEMAP_SCAN _IOWR('f', 16, struct pm_scan_arg)
+#endif // PAGEMAP_SCAN
+
+enum WRITE_WATCH_STATE
+{
+    WRITE_WATCH_UNINITIALIZED,
+    WRITE_WATCH_SUPPORTED,
+    WRITE_WATCH_UNSUPPORTED
+};
+
+static WRITE_WATCH_STATE gWriteWatchState PAL_GLOBAL = WRITE_WATCH_UNINITIALIZED;
+static int gWriteWatchUffd PAL_GLOBAL = -1;
+static int gWriteWatchPagemap PAL_GLOBAL = -1;
+
+static BOOL VIRTUALIsWriteWatchSupported(CPalThread *pthrCurrent);
+static BOOL VIRTUALRegisterWriteWatch(UINT_PTR startBoundary, SIZE_T memSize);
+static BOOL VIRTUALResetWriteWatch(UINT_PTR startBoundary, SIZE_T memSize);
+#else
+#define HAVE_WRITE_WATCH 0
+#endif // HAVE_LINUX_USERFAULTFD_H && __NR_userfaultfd
+
+static BOOL VIRTUALIsWriteWatchRegion( CONST PCMI pInformation )
+{
+#if HAVE_WRITE_WATCH
+    return (pInformation->allocationType & MEM_WRITE_WATCH) != 0;
+#else
+    return FALSE;
+#endif
+}
+
 /*++
 Function:
     VIRTUALInitialize()
@@ -199,6 +294,20 @@ void VIRTUALCleanup()
     }
 #endif  // RESERVE_FROM_BACKING_FILE
 
+#if HAVE_WRITE_WATCH
+    if (gWriteWatchUffd != -1)
+    {
+        close(gWriteWatchUffd);
+        gWriteWatchUffd = -1;
+    }
+    if (gWriteWatchPagemap != -1)
+    {
+        close(gWriteWatchPagemap);
+        gWriteWatchPagemap = -1;
+    }
+    gWriteWatchState = WRITE_WATCH_UNINITIALIZED;
+#endif // HAVE_WRITE_WATCH
+
     InternalLeaveCriticalSection(pthrCurrent, &virtual_critsec);
 
     TRACE( "Deleting the Virtual Critical Sections. \n" );
@@ -965,6 +1074,17 @@ static LPVOID VIRTUALReserveMemory(
             munmap( pRetVal, MemSize );
             pRetVal = NULL;
         }
+#if HAVE_WRITE_WATCH
+        else if ( ( flAllocationType & MEM_WRITE_WATCH ) != 0 &&
+                  !VIRTUALRegisterWriteWatch( StartBoundary, MemSize ) )
+        {
+            ERROR( "Unable to enable write watch on the region.\n");
+            pthrCurrent->SetLastError( ERROR_NOT_ENOUGH_MEMORY );
+            VIRTUALReleaseMemory( VIRTUALFindRegionInformation( StartBoundary ) );
+            munmap( pRetVal, MemSize );
+            pRetVal = NULL;
+        }
+#endif // HAVE_WRITE_WATCH
     }
 
     InternalLeaveCriticalSection(pthrCurrent, &virtual_critsec);
@@ -1206,8 +1326,17 @@ static LPVOID VIRTUALCommitMemory(
             if (mprotect((void *) StartBoundary, MemSize, PROT_WRITE | PROT_READ) == 0)
                 pRet = (void *)StartBoundary;
 #else // MMAP_DOESNOT_ALLOW_REMAP
-            pRet = mmap((void *) StartBoundary, MemSize, PROT_WRITE | PROT_READ,
-                     MAP_ANON | MAP_FIXED | MAP_PRIVATE, -1, 0);
+            if (VIRTUALIsWriteWatchRegion(pInformation))
+            {
+                // Keep the userfaultfd registration; decommit already discarded the pages
+                if (mprotect((void *) StartBoundary, MemSize, PROT_WRITE | PROT_READ) == 0)
+                    pRet = (void *)StartBoundary;
+            }
+            else
+            {
+                pRet = mmap((void *) StartBoundary, MemSize, PROT_WRITE | PROT_READ,
+                         MAP_ANON | MAP_FIXED | MAP_PRIVATE, -1, 0);
+            }
 #endif // MMAP_DOESNOT_ALLOW_REMAP
             if (pRet != MAP_FAILED)
             {
@@ -1627,7 +1756,11 @@ Function:
   VirtualAlloc
 
 Note:
-  MEM_TOP_DOWN, MEM_PHYSICAL, MEM_WRITE_WATCH are not supported.
+  MEM_TOP_DOWN, MEM_PHYSICAL are not supported.
+  MEM_WRITE_WATCH is only supported on Linux kernels with asynchronous
+  userfaultfd write-protection (see HAVE_WRITE_WATCH).
+  MEM_RESET discards the pages with madvise(MADV_DONTNEED); unlike on
+  Windows, private pages are guaranteed to read back as zero afterwards.
   Unsupported flags are ignored.
 
   Page size on i386 is set to 4k.
@@ -1651,17 +1784,45 @@ VirtualAlloc(
 
     pthrCurrent = InternalGetCurrentThread();
 
-    if ( ( flAllocationType & MEM_WRITE_WATCH )  != 0 )
+    if ( flAllocationType == MEM_RESET )
     {
-        pthrCurrent->SetLastError( ERROR_INVALID_PARAMETER );
+        UINT_PTR StartBoundary = (UINT_PTR)lpAddress & ~VIRTUAL_PAGE_MASK;
+        SIZE_T MemSize = ( ( (UINT_PTR)lpAddress + dwSize + VIRTUAL_PAGE_MASK ) & ~VIRTUAL_PAGE_MASK ) - StartBoundary;
+
+        if ( lpAddress == NULL || dwSize == 0 )
+        {
+            pthrCurrent->SetLastError( ERROR_INVALID_PARAMETER );
+            goto done;
+        }
+
+        if ( madvise( (LPVOID)StartBoundary, MemSize, MADV_DONTNEED ) != 0 )
+        {
+            ERROR( "madvise(MADV_DONTNEED) failed, errno = %d\n", errno );
+            pthrCurrent->SetLastError( ERROR_INVALID_ADDRESS );
+            goto done;
+        }
+
+        pRetVal = lpAddress;
         goto done;
     }
 
+    if ( ( flAllocationType & MEM_WRITE_WATCH )  != 0 )
+    {
+#if HAVE_WRITE_WATCH
+        if ( ( flAllocationType & MEM_RESERVE ) == 0 ||
+             !VIRTUALIsWriteWatchSupported( pthrCurrent ) )
+#endif // HAVE_WRITE_WATCH
+        {
+            pthrCurrent->SetLastError( ERROR_INVALID_PARAMETER );
+            goto done;
+        }
+    }
+
     /* Test for un-supported flags. */
-    if ( ( flAllocationType & ~( MEM_COMMIT | MEM_RESERVE | MEM_TOP_DOWN | MEM_RESERVE_EXECUTABLE ) ) != 0 )
+    if ( ( flAllocationType & ~( MEM_COMMIT | MEM_RESERVE | MEM_TOP_DOWN | MEM_RESERVE_EXECUTABLE | MEM_WRITE_WATCH ) ) != 0 )
     {
         ASSERT( "flAllocationType can be one, or any combination of MEM_COMMIT, \
-               MEM_RESERVE, MEM_TOP_DOWN, or MEM_RESERVE_EXECUTABLE.\n" );
+               MEM_RESERVE, MEM_TOP_DOWN, MEM_RESERVE_EXECUTABLE, or MEM_WRITE_WATCH.\n" );
         pthrCurrent->SetLastError( ERROR_INVALID_PARAMETER );
         goto done;
     }
@@ -1818,24 +1979,36 @@ VirtualFree(
         TRACE( "Un-committing the following page(s) %d to %d.\n",
                StartBoundary, MemSize );
 
+        BOOL bDecommitted;
 #if MMAP_DOESNOT_ALLOW_REMAP
         // if no double mapping is supported,
         // just mprotect the memory with no access
-        if (mprotect((LPVOID)StartBoundary, MemSize, PROT_NONE) == 0)
+        bDecommitted = ( mprotect((LPVOID)StartBoundary, MemSize, PROT_NONE) == 0 );
 #else // MMAP_DOESNOT_ALLOW_REMAP
-        // Explicitly calling mmap instead of mprotect here makes it
-        // that much more clear to the operating system that we no
-        // longer need these pages.
+        if ( VIRTUALIsWriteWatchRegion( pUnCommittedMem ) )
+        {
+            // Remapping would drop the write watch registration of the range,
+            // so discard the pages and revoke access instead.
+            bDecommitted = ( madvise( (LPVOID)StartBoundary, MemSize, MADV_DONTNEED ) == 0 &&
+                             mprotect( (LPVOID)StartBoundary, MemSize, PROT_NONE ) == 0 );
+        }
+        else
+        {
+            // Explicitly calling mmap instead of mprotect here makes it
+            // that much more clear to the operating system that we no
+            // longer need these pages.
 #if RESERVE_FROM_BACKING_FILE
-        if ( mmap( (LPVOID)StartBoundary, MemSize, PROT_NONE,
-                   MAP_FIXED | MAP_PRIVATE, gBackingFile,
-                   (char *) StartBoundary - (char *) gBackingBaseAddress ) !=
-             MAP_FAILED )
+            bDecommitted = ( mmap( (LPVOID)StartBoundary, MemSize, PROT_NONE,
+                                   MAP_FIXED | MAP_PRIVATE, gBackingFile,
+                                   (char *) StartBoundary - (char *) gBackingBaseAddress ) !=
+                             MAP_FAILED );
 #else   // RESERVE_FROM_BACKING_FILE
-        if ( mmap( (LPVOID)StartBoundary, MemSize, PROT_NONE,
-                   MAP_FIXED | MAP_ANON | MAP_PRIVATE, -1, 0 ) != MAP_FAILED )
+            bDecommitted = ( mmap( (LPVOID)StartBoundary, MemSize, PROT_NONE,
+                                   MAP_FIXED | MAP_ANON | MAP_PRIVATE, -1, 0 ) != MAP_FAILED );
 #endif  // RESERVE_FROM_BACKING_FILE
+        }
 #endif // MMAP_DOESNOT_ALLOW_REMAP
+        if ( bDecommitted )
         {
 #if (MMAP_ANON_IGNORES_PROTECTION && !MMAP_DOESNOT_ALLOW_REMAP)
             if (mprotect((LPVOID) StartBoundary, MemSize, PROT_NONE) != 0)
@@ -2357,6 +2530,164 @@ ExitVirtualQuery:
     return sizeof( *lpBuffer );
 }
 
+#if HAVE_WRITE_WATCH
+/*++
+Function:
+    VIRTUALIsWriteWatchSupported
+
+    Opens the process wide userfaultfd and pagemap descriptors used to
+    implement write watch, the first time it is called.
+
+    Returns TRUE if the kernel supports asynchronous write-protection and
+    PAGEMAP_SCAN, FALSE otherwise.
+--*/
+static BOOL VIRTUALIsWriteWatchSupported(CPalThread *pthrCurrent)
+{
+    InternalEnterCriticalSection(pthrCurrent, &virtual_critsec);
+
+    if (gWriteWatchState == WRITE_WATCH_UNINITIALIZED)
+    {
+        gWriteWatchState = WRITE_WATCH_UNSUPPORTED;
+
+        // Only user mode faults are handled, which is all that is allowed
+        // for unprivileged processes
+        int uffd = syscall(__NR_userfaultfd, O_CLOEXEC | O_NONBLOCK | UFFD_USER_MODE_ONLY);
+        if (uffd == -1)
+        {
+            WARN("userfaultfd is not available (errno=%d), write watch is disabled.\n", errno);
+            goto done;
+        }
+
+        struct uffdio_api api;
+        memset(&api, 0, sizeof(api));
+        api.api = UFFD_API;
+        api.features = UFFD_FEATURE_WP_ASYNC | UFFD_FEATURE_WP_UNPOPULATED;
+        if (ioctl(uffd, UFFDIO_API, &api) == -1)
+        {
+            WARN("Asynchronous userfaultfd write-protect is not supported, write watch is disabled.\n");
+            close(uffd);
+            goto done;
+        }
+
+        int pagemap = open("/proc/self/pagemap", O_RDONLY | O_CLOEXEC);
+        if (pagemap == -1)
+        {
+            WARN("Unable to open /proc/self/pagemap, write watch is disabled.\n");
+            close(uffd);
+            goto done;
+        }
+
+        // Probe PAGEMAP_SCAN with an empty range
+        struct pm_scan_arg arg;
+        memset(&arg, 0, sizeof(arg));
+        arg.size = sizeof(arg);
+        if (ioctl(pagemap, PAGEMAP_SCAN, &arg) == -1)
+        {
+            WARN("PAGEMAP_SCAN is not supported, write watch is disabled.\n");
+            close(pagemap);
+            close(uffd);
+            goto done;
+        }
+
+        gWriteWatchUffd = uffd;
+        gWriteWatchPagemap = pagemap;
+        gWriteWatchState = WRITE_WATCH_SUPPORTED;
+    }
+
+done:
+    BOOL bRetVal = (gWriteWatchState == WRITE_WATCH_SUPPORTED);
+    InternalLeaveCriticalSection(pthrCurrent, &virtual_critsec);
+    return bRetVal;
+}
+
+/*++
+Function:
+    VIRTUALRegisterWriteWatch
+
+    Registers a newly reserved region for write-protect tracking and
+    starts watching it.
+--*/
+static BOOL VIRTUALRegisterWriteWatch(UINT_PTR startBoundary, SIZE_T memSize)
+{
+    _ASSERTE(gWriteWatchState == WRITE_WATCH_SUPPORTED);
+
+    struct uffdio_register reg;
+    memset(&reg, 0, sizeof(reg));
+    reg.range.start = startBoundary;
+    reg.range.len = memSize;
+    reg.mode = UFFDIO_REGISTER_MODE_WP;
+    if (ioctl(gWriteWatchUffd, UFFDIO_REGISTER, &reg) == -1)
+    {
+        ERROR("UFFDIO_REGISTER failed! Error(%d)=%s\n", errno, strerror(errno));
+        return FALSE;
+    }
+
+    return VIRTUALResetWriteWatch(startBoundary, memSize);
+}
+
+/*++
+Function:
+    VIRTUALResetWriteWatch
+
+    Write-protects the range so that the next write to each page is recorded.
+--*/
+static BOOL VIRTUALResetWriteWatch(UINT_PTR startBoundary, SIZE_T memSize)
+{
+    struct uffdio_writeprotect wp;
+    memset(&wp, 0, sizeof(wp));
+    wp.range.start = startBoundary;
+    wp.range.len = memSize;
+    wp.mode = UFFDIO_WRITEPROTECT_MODE_WP;
+
+    int result;
+    do
+    {
+        result = ioctl(gWriteWatchUffd, UFFDIO_WRITEPROTECT, &wp);
+    } while (result == -1 && errno == EAGAIN);
+
+    if (result == -1)
+    {
+        ERROR("UFFDIO_WRITEPROTECT failed! Error(%d)=%s\n", errno, strerror(errno));
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/*++
+Function:
+    VIRTUALFindWriteWatchRegion
+
+    Rounds the range to page boundaries and checks that it lies within a
+    single write watched region.
+    NOTE: The caller must own the critical section.
+--*/
+static BOOL VIRTUALFindWriteWatchRegion(
+    IN PVOID lpBaseAddress,
+    IN SIZE_T dwRegionSize,
+    OUT UINT_PTR *pStartBoundary,
+    OUT UINT_PTR *pEndBoundary)
+{
+    if (gWriteWatchState != WRITE_WATCH_SUPPORTED || dwRegionSize == 0)
+    {
+        return FALSE;
+    }
+
+    UINT_PTR startBoundary = (UINT_PTR)lpBaseAddress & ~VIRTUAL_PAGE_MASK;
+    UINT_PTR endBoundary = ((UINT_PTR)lpBaseAddress + dwRegionSize + VIRTUAL_PAGE_MASK) & ~VIRTUAL_PAGE_MASK;
+
+    PCMI pInformation = VIRTUALFindRegionInformation(startBoundary);
+    if (pInformation == NULL || !VIRTUALIsWriteWatchRegion(pInformation) ||
+        endBoundary > pInformation->startBoundary + pInformation->memSize)
+    {
+        return FALSE;
+    }
+
+    *pStartBoundary = startBoundary;
+    *pEndBoundary = endBoundary;
+    return TRUE;
+}
+#endif // HAVE_WRITE_WATCH
+
 /*++
 Function:
   GetWriteWatch
@@ -2374,10 +2705,86 @@ GetWriteWatch(
   OUT PULONG lpdwGranularity
 )
 {
-    // TODO: implement this method
+#if HAVE_WRITE_WATCH
+    CPalThread *pthrCurrent = InternalGetCurrentThread();
+    UINT_PTR startBoundary;
+    UINT_PTR endBoundary;
+    UINT uRetVal = 1;
+
+    InternalEnterCriticalSection(pthrCurrent, &virtual_critsec);
+
+    if ((dwFlags & ~WRITE_WATCH_FLAG_RESET) == 0 && lpAddresses != NULL && lpdwCount != NULL &&
+        VIRTUALFindWriteWatchRegion(lpBaseAddress, dwRegionSize, &startBoundary, &endBoundary))
+    {
+        const ULONG_PTR maxCount = *lpdwCount;
+        ULONG_PTR count = 0;
+        struct page_region regions[32];
+
+        uRetVal = 0;
+        while (startBoundary < endBoundary && count < maxCount)
+        {
+            // With WRITE_WATCH_FLAG_RESET, the pages reported are write-protected
+            // again atomically. max_pages makes sure we don't reset pages we can't report.
+            struct pm_scan_arg arg;
+            memset(&arg, 0, sizeof(arg));
+            arg.size = sizeof(arg);
+            arg.flags = (dwFlags & WRITE_WATCH_FLAG_RESET) ? (PM_SCAN_WP_MATCHING | PM_SCAN_CHECK_WPASYNC) : 0;
+            arg.start = startBoundary;
+            arg.end = endBoundary;
+            arg.vec = (UINT_PTR)regions;
+            arg.vec_len = sizeof(regions) / sizeof(regions[0]);
+            arg.max_pages = maxCount - count;
+            arg.category_mask = PAGE_IS_WRITTEN;
+            arg.return_mask = PAGE_IS_WRITTEN;
+
+            long regionCount = ioctl(gWriteWatchPagemap, PAGEMAP_SCAN, &arg);
+            if (regionCount == -1)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                ERROR("PAGEMAP_SCAN failed! Error(%d)=%s\n", errno, strerror(errno));
+                uRetVal = 1;
+                break;
+            }
+
+            for (long i = 0; i < regionCount; i++)
+            {
+                for (UINT_PTR page = regions[i].start; page < regions[i].end && count < maxCount; page += VIRTUAL_PAGE_SIZE)
+                {
+                    lpAddresses[count++] = (PVOID)page;
+                }
+            }
+
+            if (arg.walk_end <= startBoundary)
+            {
+                break;
+            }
+            startBoundary = arg.walk_end;
+        }
+
+        if (uRetVal == 0)
+        {
+            *lpdwCount = count;
+            if (lpdwGranularity != NULL)
+            {
+                *lpdwGranularity = VIRTUAL_PAGE_SIZE;
+            }
+        }
+    }
+
+    InternalLeaveCriticalSection(pthrCurrent, &virtual_critsec);
+
+    if (uRetVal == 0)
+    {
+        return 0;
+    }
+#endif // HAVE_WRITE_WATCH
+
     *lpAddresses = NULL;
     *lpdwCount = 0;
-    // Until it is implemented, return non-zero value as an indicator of failure
+    // Write watch is not supported on this region, return non-zero value as an indicator of failure
     return 1;
 }
 
@@ -2394,9 +2801,25 @@ ResetWriteWatch(
   IN SIZE_T dwRegionSize
 )
 {
-    // TODO: implement this method
-    // Until it is implemented, return non-zero value as an indicator of failure
+#if HAVE_WRITE_WATCH
+    CPalThread *pthrCurrent = InternalGetCurrentThread();
+    UINT_PTR startBoundary;
+    UINT_PTR endBoundary;
+    UINT uRetVal = 1;
+
+    InternalEnterCriticalSection(pthrCurrent, &virtual_critsec);
+    if (VIRTUALFindWriteWatchRegion(lpBaseAddress, dwRegionSize, &startBoundary, &endBoundary) &&
+        VIRTUALResetWriteWatch(startBoundary, endBoundary - startBoundary))
+    {
+        uRetVal = 0;
+    }
+    InternalLeaveCriticalSection(pthrCurrent, &virtual_critsec);
+
+    return uRetVal;
+#else
+    // Write watch is not supported, return non-zero value as an indicator of failure
     return 1;
+#endif // HAVE_WRITE_WATCH
 }
 
 /*++
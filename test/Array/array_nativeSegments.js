@@ -0,0 +1,111 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// indexOf, includes, fill and copyWithin on native arrays, including elements past the head segment and holes
+
+function write(args)
+{
+    WScript.Echo(args);
+}
+
+function ints(n)
+{
+    var arr = [];
+    for (var i = 0; i < n; i++)
+    {
+        arr[i] = i * 3;
+    }
+    return arr;
+}
+
+function floats(n)
+{
+    var arr = [];
+    for (var i = 0; i < n; i++)
+    {
+        arr[i] = i + 0.5;
+    }
+    return arr;
+}
+
+write("Scenario 1: search in int arrays");
+var a = ints(37);
+write(a.indexOf(0) + " " + a.indexOf(9) + " " + a.indexOf(108) + " " + a.indexOf(109) + " " + a.indexOf(-0));
+write(a.indexOf(9, 4) + " " + a.indexOf(108, 36) + " " + a.indexOf(108, -1) + " " + a.indexOf("9"));
+write(a.includes(57) + " " + a.includes(58) + " " + a.includes(NaN) + " " + a.includes(6.5) + " " + a.includes(-2147483646));
+a[1000] = 5;
+a[1003] = 7;
+write(a.indexOf(5) + " " + a.indexOf(7) + " " + a.indexOf(7, 1002) + " " + a.indexOf(undefined) + " " + a.includes(undefined));
+
+write("Scenario 2: search in float arrays");
+var f = floats(23);
+write(f.indexOf(0.5) + " " + f.indexOf(11.5) + " " + f.indexOf(22.5) + " " + f.indexOf(11) + " " + f.indexOf("11.5"));
+f[7] = NaN;
+f[12] = -0;
+write(f.indexOf(NaN) + " " + f.includes(NaN) + " " + f.indexOf(0) + " " + f.includes(0) + " " + f.indexOf(-0));
+f[5000] = 3.25;
+write(f.indexOf(3.25) + " " + f.includes(3.25) + " " + f.indexOf(undefined) + " " + f.includes(undefined));
+f[14] = -2147483646;
+write(f.indexOf(-2147483646) + " " + f.includes(-2147483646));
+
+write("Scenario 3: fill");
+a = ints(19);
+a.fill(4, 2, 17);
+write(a.join());
+a.fill(-2147483646, 15);
+write(a.join());
+f = floats(9);
+f.fill(1.25, 1, 8);
+write(f.join());
+f.fill(-0, 6);
+write(f.join() + " " + (1 / f[8]));
+f.fill(NaN, 0, 2);
+write(f.join());
+a = ints(10);
+a.fill(2, 5, 15);
+write(a.join() + " " + a.length);
+a.fill("x", 7);
+write(a.join());
+a = [1, 2, 3, , , 6, 7];
+a.fill(9, 2, 5);
+write(a.join());
+
+write("Scenario 4: copyWithin");
+a = ints(14);
+a.copyWithin(3, 0, 9);
+write(a.join());
+a = ints(14);
+a.copyWithin(0, 3);
+write(a.join());
+f = floats(11);
+f.copyWithin(2, 0);
+write(f.join());
+a = [0, 1, 2, , 4, 5, 6, 7, 8];
+a.copyWithin(5, 1, 5);
+write(a.join() + " " + (7 in a));
+a = [0, 1, 2, , 4, 5, 6, 7, 8];
+a.copyWithin(0, 4, 9);
+write(a.join() + " " + (3 in a));
+a = ints(5);
+a[100] = 1;
+a.copyWithin(98, 2, 5);
+write(a.slice(96).join());
+
+write("Scenario 5: holes filled in by a prototype");
+var proto = [];
+proto[3] = 42;
+proto[1001] = 43;
+a = ints(6);
+a[1000] = 5;
+delete a[3];
+Object.setPrototypeOf(a, proto);
+write(a.indexOf(42) + " " + a.includes(42) + " " + a.indexOf(43) + " " + a.indexOf(5) + " " + a.indexOf(12));
+f = floats(6);
+f[1000] = 2.5;
+delete f[3];
+Object.setPrototypeOf(f, proto);
+write(f.indexOf(42) + " " + f.indexOf(43) + " " + f.indexOf(2.5) + " " + f.indexOf(4.5));
+a.copyWithin(0, 2, 5);
+write(a.slice(0, 6).join() + " " + a.hasOwnProperty(1));
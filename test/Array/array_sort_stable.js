@@ -0,0 +1,146 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+function write(args)
+{
+    WScript.Echo(args);
+}
+
+function checkSorted(name, arr, compare)
+{
+    for (var i = 1; i < arr.length; i++)
+    {
+        if (compare(arr[i - 1], arr[i]) > 0)
+        {
+            write(name + ": FAILED at " + i);
+            return;
+        }
+    }
+    write(name + ": sorted");
+}
+
+function checkStable(name, arr)
+{
+    for (var i = 1; i < arr.length; i++)
+    {
+        if (arr[i - 1].key === arr[i].key && arr[i - 1].index > arr[i].index)
+        {
+            write(name + ": NOT STABLE at " + i);
+            return;
+        }
+    }
+    write(name + ": stable");
+}
+
+function records(n, keyOf)
+{
+    var arr = [];
+    for (var i = 0; i < n; i++)
+    {
+        arr.push({ key: keyOf(i), index: i });
+    }
+    return arr;
+}
+
+var byKey = function (a, b) { return a.key - b.key; };
+
+write("Scenario 1: stability with few distinct keys");
+[10, 100, 1000, 5000].forEach(function (n)
+{
+    var arr = records(n, function (i) { return (i * 7919) % 13; });
+    arr.sort(byKey);
+    checkSorted("n=" + n, arr, byKey);
+    checkStable("n=" + n, arr);
+});
+
+write("Scenario 2: presorted, reversed and mostly sorted runs");
+var shapes = {
+    "ascending": function (i, n) { return i; },
+    "descending": function (i, n) { return n - i; },
+    "sawtooth": function (i, n) { return i % 97; },
+    "ascending with noise": function (i, n) { return (i % 50 === 0) ? (i * 31) % n : i; },
+    "organ pipe": function (i, n) { return i < n / 2 ? i : n - i; },
+    "descending pairs": function (i, n) { return n - (i >> 1); }
+};
+Object.keys(shapes).forEach(function (shape)
+{
+    var arr = records(4000, function (i) { return shapes[shape](i, 4000); });
+    arr.sort(byKey);
+    checkSorted(shape, arr, byKey);
+    checkStable(shape, arr);
+});
+
+write("Scenario 3: comparison count on sorted input");
+var calls = 0;
+var sortedInput = [];
+for (var i = 0; i < 10000; i++)
+{
+    sortedInput.push(i);
+}
+sortedInput.sort(function (a, b) { calls++; return a - b; });
+write(calls < 10000 ? "linear comparisons" : "too many comparisons: " + calls);
+
+write("Scenario 4: galloping merges of interleaved blocks");
+var blocks = [];
+for (var i = 0; i < 3000; i++)
+{
+    blocks.push((i % 2 === 0 ? 0 : 100000) + i);
+}
+blocks.sort(function (a, b) { return a - b; });
+checkSorted("blocks", blocks, function (a, b) { return a - b; });
+
+write("Scenario 5: default compare on native int and float arrays");
+var ints = [];
+var floats = [];
+for (var i = 0; i < 200; i++)
+{
+    ints.push(((i * 7919) % 401) - 200);
+    floats.push((((i * 7919) % 401) - 200) * 1.0);
+}
+floats[3] = -0;
+ints.push(2147483647, -2147483648, 1000000000, 10, 9, 100);
+var intsExpected = ints.map(String).sort().join();
+write(ints.sort().join() === intsExpected ? "ints match string order" : "ints MISMATCH");
+write([10, 9, 1, 100, -1, -10, -9, 0].sort().join());
+write([10.5, 9, 1e21, 100, -1.5, NaN, Infinity, 0].sort().join());
+var floatsExpected = floats.map(String).sort().join();
+write(floats.sort().join() === floatsExpected ? "floats match string order" : "floats MISMATCH");
+write(floats.length);
+
+write("Scenario 6: comparer that throws keeps all elements");
+var arr = [];
+for (var i = 0; i < 1000; i++)
+{
+    arr.push(1000 - i + (i % 3 === 0 ? 500 : 0));
+}
+var count = 0;
+try
+{
+    arr.sort(function (a, b) { if (++count > 3000) { throw new Error("stop"); } return a - b; });
+}
+catch (e)
+{
+    write(e.message);
+}
+var seen = arr.slice().sort(function (a, b) { return a - b; });
+var original = [];
+for (var i = 0; i < 1000; i++)
+{
+    original.push(1000 - i + (i % 3 === 0 ? 500 : 0));
+}
+original.sort(function (a, b) { return a - b; });
+write(seen.join() === original.join() ? "permutation preserved" : "elements lost");
+
+write("Scenario 7: inconsistent comparer");
+var random = 12345;
+var mixed = [];
+for (var i = 0; i < 2000; i++)
+{
+    mixed.push(i);
+}
+mixed.sort(function (a, b) { random = (random * 1103515245 + 12345) & 0x7fffffff; return (random % 3) - 1; });
+mixed.sort(function (a, b) { return a - b; });
+checkSorted("inconsistent", mixed, function (a, b) { return a - b; });
+write(mixed.length + " " + mixed[0] + " " + mixed[1999]);
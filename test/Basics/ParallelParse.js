@@ -0,0 +1,58 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Function bodies below are handed to the background parser when parallel parsing is on.
+
+function sum(values) {
+    var total = 0;
+    for (var i = 0; i < values.length; i++) {
+        total += values[i];
+    }
+    return total;
+}
+
+function makeCounter(start) {
+    var count = start;
+    return {
+        next: function () { return ++count; },
+        reset: function () { count = start; }
+    };
+}
+
+function classify(value) {
+    switch (typeof value) {
+        case "number":
+            return value % 2 === 0 ? "even" : "odd";
+        case "string":
+            return /^[a-z]+$/.test(value) ? "word" : "text";
+        default:
+            return "other";
+    }
+}
+
+function outer(n) {
+    function inner(m) {
+        var result = [];
+        for (var i = 0; i < m; i++) {
+            result.push(i * i);
+        }
+        return result;
+    }
+    return sum(inner(n));
+}
+
+var counter = makeCounter(10);
+counter.next();
+counter.next();
+
+var passed =
+    sum([1, 2, 3, 4]) === 10 &&
+    counter.next() === 13 &&
+    classify(4) === "even" &&
+    classify("abc") === "word" &&
+    classify(null) === "other" &&
+    outer(4) === 14;
+
+WScript.Echo(passed ? "pass" : "FAILED");
@@ -0,0 +1,103 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Under -ForceSerialized, nested functions are only deserialized when first called, and the property
+// ids they refer to are bound then. Each function below uses names that nothing before it has used.
+
+var failures = 0;
+
+function check(actual, expected, message) {
+    if (actual !== expected) {
+        WScript.Echo("FAILED: " + message + ": expected " + expected + ", got " + actual);
+        failures++;
+    }
+}
+
+function literalAndDot() {
+    var o = {
+        alpha: 1, bravo: 2, charlie: 3, delta: 4, echo: 5, foxtrot: 6, golf: 7, hotel: 8,
+        india: 9, juliett: 10, kilo: 11, lima: 12, mike: 13, november: 14, oscar: 15, papa: 16,
+        quebec: 17, romeo: 18, sierra: 19, tango: 20, uniform: 21, victor: 22, whiskey: 23,
+        xray: 24, yankee: 25, zulu: 26
+    };
+    return o.alpha + o.bravo + o.charlie + o.delta + o.echo + o.foxtrot + o.golf + o.hotel +
+        o.india + o.juliett + o.kilo + o.lima + o.mike + o.november + o.oscar + o.papa +
+        o.quebec + o.romeo + o.sierra + o.tango + o.uniform + o.victor + o.whiskey +
+        o.xray + o.yankee + o.zulu;
+}
+
+function destructuring() {
+    var { mercury, venus, earth: planet, mars = 4 } = { mercury: 1, venus: 2, earth: 3 };
+    return mercury + venus + planet + mars;
+}
+
+function stringsAndNames() {
+    // The same text used both as a string constant and as a property name
+    var o = { saturn: "saturn" };
+    o["jupiter"] = "jupiter";
+    return o.saturn + "," + o.jupiter + "," + Object.keys(o).join(",");
+}
+
+function accessorsAndMethods() {
+    var o = {
+        _uranus: 1,
+        get neptune() { return this._uranus + 1; },
+        set neptune(v) { this._uranus = v; },
+        pluto() { return this.neptune * 10; }
+    };
+    o.neptune = 5;
+    return o.pluto();
+}
+
+class Ceres {
+    constructor() { this.eris = 2; }
+    haumea() { return this.eris + Ceres.makemake(); }
+    static makemake() { return 3; }
+}
+
+function classes() {
+    return new Ceres().haumea();
+}
+
+var sedna = 7;
+let quaoar = 8;
+
+function globals() {
+    titania = 6;
+    return sedna + quaoar + titania;
+}
+
+function scoped() {
+    var o = { orcus: 9 };
+    with (o) {
+        return orcus + (typeof gonggong === "undefined" ? 1 : 0);
+    }
+}
+
+function outer() {
+    function inner() {
+        return { varuna: 10, ixion: 11 }.ixion;
+    }
+    return inner() + { salacia: 12 }.salacia;
+}
+
+function deletion() {
+    var o = { chaos: 1, huya: 2 };
+    delete o.chaos;
+    return ("chaos" in o) + "," + o.hasOwnProperty("huya");
+}
+
+check(literalAndDot(), 351, "object literal and property access");
+check(literalAndDot(), 351, "second call");
+check(destructuring(), 10, "destructuring");
+check(stringsAndNames(), "saturn,jupiter,saturn,jupiter", "strings and property names");
+check(accessorsAndMethods(), 60, "accessors and methods");
+check(classes(), 5, "class members");
+check(globals(), 21, "global names");
+check(scoped(), 10, "with scope lookup");
+check(outer(), 23, "nested functions");
+check(deletion(), "false,true", "delete and in");
+
+WScript.Echo(failures === 0 ? "pass" : "FAILED");
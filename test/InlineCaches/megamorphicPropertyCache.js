@@ -0,0 +1,103 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Loads at sites that see more types than their polymorphic inline cache can hold go through the thread's
+// megamorphic property cache. Check that the values it finds stay right as the objects and their prototypes change.
+
+var shapeCount = 64;
+
+function makeObjects(proto) {
+    var objects = [];
+    for (var i = 0; i < shapeCount; i++) {
+        var o = Object.create(proto);
+        o["f" + i] = i;
+        o.x = i;
+        objects.push(o);
+    }
+    return objects;
+}
+
+function sumX(objects) {
+    var sum = 0;
+    for (var i = 0; i < objects.length; i++) {
+        sum += objects[i].x;
+    }
+    return sum;
+}
+
+function sumP(objects) {
+    var sum = 0;
+    for (var i = 0; i < objects.length; i++) {
+        sum += objects[i].p;
+    }
+    return sum;
+}
+
+function countMissing(objects) {
+    var count = 0;
+    for (var i = 0; i < objects.length; i++) {
+        if (objects[i].q === undefined) {
+            count++;
+        }
+    }
+    return count;
+}
+
+function sumKeyed(objects, name) {
+    var sum = 0;
+    for (var i = 0; i < objects.length; i++) {
+        sum += objects[i][name];
+    }
+    return sum;
+}
+
+var proto = { p: 1 };
+var objects = makeObjects(proto);
+
+for (var i = 0; i < 3; i++) {
+    WScript.Echo("local: " + sumX(objects));
+    WScript.Echo("prototype: " + sumP(objects));
+    WScript.Echo("missing: " + countMissing(objects));
+    WScript.Echo("keyed: " + sumKeyed(objects, "x"));
+}
+
+// Change the value of a local property
+objects[5].x = 1000;
+WScript.Echo("local after store: " + sumX(objects));
+
+// Change the value of the prototype property
+proto.p = 2;
+WScript.Echo("prototype after store: " + sumP(objects));
+
+// Shadow the prototype property on some of the objects
+objects[0].p = 100;
+objects[1].p = 100;
+WScript.Echo("prototype after shadowing: " + sumP(objects));
+
+// Move the prototype property further up the chain
+delete proto.p;
+Object.prototype.p = 3;
+WScript.Echo("prototype after moving: " + sumP(objects));
+delete Object.prototype.p;
+WScript.Echo("prototype after deleting: " + sumP(objects));
+
+// Add the missing property on the prototype chain
+Object.prototype.q = 1;
+WScript.Echo("missing after adding: " + countMissing(objects));
+delete Object.prototype.q;
+WScript.Echo("missing after deleting: " + countMissing(objects));
+
+// Turn the prototype property into an accessor
+proto.p = 1;
+WScript.Echo("prototype after adding back: " + sumP(objects));
+Object.defineProperty(proto, "p", { get: function () { return 5; }, configurable: true });
+WScript.Echo("prototype after accessor: " + sumP(objects));
+
+// Change the prototype of the objects
+var otherProto = { p: 7 };
+for (var i = 0; i < objects.length; i++) {
+    Object.setPrototypeOf(objects[i], otherProto);
+}
+WScript.Echo("prototype after setPrototypeOf: " + sumP(objects));
@@ -0,0 +1,82 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// The JSON.parse type cache is kept across calls; small documents parsed repeatedly
+// with the same or diverging shapes must still produce the right objects.
+
+function Dump(msg, o)
+{
+    var keys = Object.keys(o);
+    var s = "";
+    for (var i = 0; i < keys.length; i++)
+    {
+        s += (i ? ", " : "") + keys[i] + ": " + JSON.stringify(o[keys[i]]);
+    }
+    WScript.Echo(msg + " { " + s + " }");
+}
+
+// Same shape parsed many times
+var last;
+for (var i = 0; i < 100; i++)
+{
+    last = JSON.parse('{"id":' + i + ',"name":"n' + i + '","ok":true}');
+}
+Dump("repeated", last);
+
+// Shapes diverging at the second property across calls: a->b, a->c, a->b
+Dump("diverge1", JSON.parse('{"a":1,"b":2}'));
+Dump("diverge2", JSON.parse('{"a":1,"c":2}'));
+Dump("diverge3", JSON.parse('{"a":1,"b":2}'));
+Dump("diverge4", JSON.parse('{"a":1,"b":2,"c":3}'));
+Dump("diverge5", JSON.parse('{"a":1}'));
+
+// Nested objects sharing the cache with their parents
+var nested = JSON.parse('{"a":{"a":{"b":1},"b":2},"b":{"a":3}}');
+Dump("nested", nested);
+Dump("nested.a", nested.a);
+Dump("nested.a.a", nested.a.a);
+Dump("nested.b", nested.b);
+
+// Numeric and duplicate property names
+Dump("numeric1", JSON.parse('{"a":1,"1":2,"c":3}'));
+Dump("numeric2", JSON.parse('{"a":1,"1":2,"c":3}'));
+Dump("duplicate1", JSON.parse('{"a":1,"b":2,"a":3}'));
+Dump("duplicate2", JSON.parse('{"a":1,"b":2,"a":3}'));
+
+// Objects created from cached types stay independent
+var o1 = JSON.parse('{"x":1,"y":2}');
+var o2 = JSON.parse('{"x":1,"y":2}');
+o1.z = 3;
+delete o2.x;
+Dump("independent1", o1);
+Dump("independent2", o2);
+Dump("independent3", JSON.parse('{"x":1,"y":2}'));
+
+// More distinct first properties than the cache keeps
+var ok = true;
+for (var round = 0; round < 2; round++)
+{
+    for (var i = 0; i < 200; i++)
+    {
+        var o = JSON.parse('{"k' + i + '":' + i + ',"v":' + round + '}');
+        if (o["k" + i] !== i || o.v !== round || Object.keys(o).length !== 2)
+        {
+            ok = false;
+        }
+    }
+}
+WScript.Echo("many shapes: " + (ok ? "PASSED" : "FAILED"));
+
+// The cache is dropped across garbage collections
+if (typeof CollectGarbage !== "undefined")
+{
+    CollectGarbage();
+}
+Dump("after gc", JSON.parse('{"id":1,"name":"n","ok":false}'));
+
+// Reviver still sees every property
+var seen = [];
+JSON.parse('{"id":1,"name":"n","ok":true}', function (k, v) { seen.push(k); return v; });
+WScript.Echo("reviver: " + seen.join(","));
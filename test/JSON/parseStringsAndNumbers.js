@@ -0,0 +1,70 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// JSON.parse scans strings and numbers several characters at a time; check that escapes, terminators
+// and invalid characters are found at every position within and across those blocks.
+
+function Expect(msg, result, expected)
+{
+    if (result !== expected)
+    {
+        WScript.Echo("FAILED " + msg + ": " + JSON.stringify(result) + " !== " + JSON.stringify(expected));
+        return false;
+    }
+    return true;
+}
+
+function Check(msg, json, expected)
+{
+    var result;
+    try
+    {
+        result = JSON.parse(json);
+    }
+    catch (e)
+    {
+        result = e.name;
+    }
+    return Expect(msg, result, expected);
+}
+
+var passed = true;
+var plain = "abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJ\u00e9\u4e2d\uffff";
+
+for (var length = 0; length < 40; length++)
+{
+    var prefix = plain.substring(0, length);
+    passed = Check("plain " + length, '"' + prefix + '"', prefix) && passed;
+    passed = Check("escaped quote " + length, '"' + prefix + '\\"' + prefix + '"', prefix + '"' + prefix) && passed;
+    passed = Check("escaped backslash " + length, '"' + prefix + '\\\\x"', prefix + '\\x') && passed;
+    passed = Check("unicode escape " + length, '"' + prefix + '\\u0041\\n"', prefix + 'A\n') && passed;
+    passed = Check("control char " + length, '"' + prefix + '\u0001' + prefix + '"', "SyntaxError") && passed;
+    passed = Check("nul char " + length, '"' + prefix + '\u0000"', "SyntaxError") && passed;
+    passed = Check("unterminated " + length, '"' + prefix, "SyntaxError") && passed;
+
+    var obj = JSON.parse('{"' + prefix + '":1,"' + prefix + 'k":"' + prefix + '"}');
+    passed = Expect("key " + length, obj[prefix], 1) && Expect("key value " + length, obj[prefix + "k"], prefix) && passed;
+
+    var digits = "12345678901234567890123456789012345678901234567890".substring(0, length + 1);
+    passed = Check("integer " + length, digits, Number(digits)) && passed;
+    passed = Check("negative " + length, "-" + digits, -Number(digits)) && passed;
+    passed = Check("fraction " + length, digits + ".5", Number(digits + ".5")) && passed;
+    passed = Check("exponent " + length, digits + "e2", Number(digits + "e2")) && passed;
+    passed = Expect("array " + length, JSON.parse("[" + digits + "," + digits + "]")[1], Number(digits)) && passed;
+    passed = Check("missing fraction " + length, digits + ".", "SyntaxError") && passed;
+    passed = Check("bad fraction " + length, digits + ".x", "SyntaxError") && passed;
+}
+
+passed = Check("zero", "0", 0) && passed;
+passed = Check("zero fraction", "0.25", 0.25) && passed;
+passed = Check("leading zero", "01", "SyntaxError") && passed;
+passed = Check("negative leading zero", "-01", "SyntaxError") && passed;
+passed = Check("zero then space", "0 ", 0) && passed;
+
+var longString = new Array(100001).join("x");
+passed = Check("long", '"' + longString + '"', longString) && passed;
+passed = Check("long escaped", '"' + longString + '\\t' + longString + '"', longString + '\t' + longString) && passed;
+
+WScript.Echo(passed ? "PASSED" : "FAILED");
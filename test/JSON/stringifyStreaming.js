@@ -0,0 +1,78 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// JSON.stringify writes its result out in order (-StreamingJSONStringify, on by default). Members whose
+// value is not serialized, indentation and escapes have to come out exactly as with the concat string tree.
+
+function Expect(msg, result, expected)
+{
+    if (result !== expected)
+    {
+        WScript.Echo("FAILED " + msg + ": " + JSON.stringify(result) + " !== " + JSON.stringify(expected));
+        return false;
+    }
+    return true;
+}
+
+var passed = true;
+
+passed = Expect("undefined", JSON.stringify(undefined), undefined) && passed;
+passed = Expect("function", JSON.stringify(function () {}), undefined) && passed;
+passed = Expect("symbol", JSON.stringify(Symbol()), undefined) && passed;
+passed = Expect("toJSON undefined", JSON.stringify({ toJSON: function () { } }), undefined) && passed;
+passed = Expect("number", JSON.stringify(-1.5e300), "-1.5e+300") && passed;
+passed = Expect("int", JSON.stringify(42), "42") && passed;
+passed = Expect("NaN", JSON.stringify([NaN, Infinity, -0]), "[null,null,0]") && passed;
+passed = Expect("wrappers", JSON.stringify([new Number(1), new String("s"), new Boolean(false)]), '[1,"s",false]') && passed;
+passed = Expect("empty", JSON.stringify([{}, [], ""]), '[{},[],""]') && passed;
+passed = Expect("escapes", JSON.stringify("\"\\\b\f\n\r\t\u0000\u001f\u007f \u00e9"), '"\\"\\\\\\b\\f\\n\\r\\t\\u0000\\u001f\u007f \u00e9"') && passed;
+passed = Expect("escaped key", JSON.stringify({ "a\"b": 1 }), '{"a\\"b":1}') && passed;
+
+passed = Expect("skipped members", JSON.stringify({ a: undefined, b: function () {}, c: 1, d: Symbol(), e: 2 }), '{"c":1,"e":2}') && passed;
+passed = Expect("all members skipped", JSON.stringify({ a: undefined }), "{}") && passed;
+passed = Expect("all members skipped with gap", JSON.stringify({ a: undefined }, null, 2), "{}") && passed;
+passed = Expect("skipped elements", JSON.stringify([undefined, function () {}, Symbol(), 1]), "[null,null,null,1]") && passed;
+passed = Expect("sparse", JSON.stringify([, 1, , ]), "[null,1,null]") && passed;
+
+var nested = { a: [1, { b: [], c: {} }, "x"], d: { e: null } };
+passed = Expect("gap", JSON.stringify(nested, null, 2),
+    '{\n  "a": [\n    1,\n    {\n      "b": [],\n      "c": {}\n    },\n    "x"\n  ],\n  "d": {\n    "e": null\n  }\n}') && passed;
+passed = Expect("string gap", JSON.stringify([[1]], null, "--"), "[\n--[\n----1\n--]\n]") && passed;
+passed = Expect("replacer array", JSON.stringify({ a: 1, b: 2, c: 3 }, ["c", "a"]), '{"c":3,"a":1}') && passed;
+passed = Expect("replacer function", JSON.stringify({ a: 1, b: 2 }, function (k, v) { return k === "a" ? undefined : v; }), '{"b":2}') && passed;
+
+var order = [];
+var getters = { get a() { order.push("a"); return { toJSON: function () { order.push("a.toJSON"); return 1; } }; }, get b() { order.push("b"); return 2; } };
+passed = Expect("getters", JSON.stringify(getters), '{"a":1,"b":2}') && passed;
+passed = Expect("getter order", order.join(), "a,a.toJSON,b") && passed;
+
+var circular = { a: [] };
+circular.a.push(circular);
+var error;
+try
+{
+    JSON.stringify(circular);
+}
+catch (e)
+{
+    error = e.name;
+}
+passed = Expect("circular", error, "TypeError") && passed;
+
+// Results much larger than the writer's buffer, with long strings and many small members
+var big = [];
+var longString = new Array(5001).join("\u00e9x\"");
+for (var i = 0; i < 1000; i++)
+{
+    big.push({ index: i, text: i % 100 === 0 ? longString : "s" + i });
+}
+var bigJson = JSON.stringify(big);
+var parsed = JSON.parse(bigJson);
+passed = Expect("big length", parsed.length, 1000) && passed;
+passed = Expect("big long string", parsed[500].text, longString) && passed;
+passed = Expect("big small string", parsed[999].text, "s999") && passed;
+passed = Expect("big round trip", JSON.stringify(parsed), bigJson) && passed;
+
+WScript.Echo(passed ? "PASSED" : "FAILED");
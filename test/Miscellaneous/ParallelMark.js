@@ -0,0 +1,67 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Build a heap that is wide in some places and deep in others so that the parallel mark contexts
+// run out of work at different times and have to take work from each other.
+
+function makeTree(depth, width) {
+    var node = { depth: depth, children: [] };
+    if (depth > 0) {
+        for (var i = 0; i < width; i++) {
+            node.children.push(makeTree(depth - 1, width));
+        }
+    }
+    return node;
+}
+
+function makeList(length) {
+    var head = null;
+    for (var i = 0; i < length; i++) {
+        head = { value: i, next: head };
+    }
+    return head;
+}
+
+function countTree(node) {
+    var count = 1;
+    for (var i = 0; i < node.children.length; i++) {
+        count += countTree(node.children[i]);
+    }
+    return count;
+}
+
+function countList(head) {
+    var count = 0;
+    for (; head !== null; head = head.next) {
+        count++;
+    }
+    return count;
+}
+
+var roots = [];
+for (var i = 0; i < 16; i++) {
+    roots.push(i % 2 == 0 ? makeTree(3, 30) : makeList(50000));
+}
+
+for (var iteration = 0; iteration < 5; iteration++) {
+    CollectGarbage();
+
+    // Drop and rebuild part of the heap between collections
+    roots[iteration] = iteration % 2 == 0 ? makeTree(3, 30) : makeList(50000);
+}
+
+var passed = true;
+for (var i = 0; i < roots.length; i++) {
+    var expected = i % 2 == 0 ? 1 + 30 + 30 * 30 + 30 * 30 * 30 : 50000;
+    var actual = i % 2 == 0 ? countTree(roots[i]) : countList(roots[i]);
+    if (actual !== expected) {
+        WScript.Echo("FAILED: root " + i + " has " + actual + " objects, expected " + expected);
+        passed = false;
+    }
+}
+
+if (passed) {
+    WScript.Echo("pass");
+}
@@ -0,0 +1,66 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Regexes with the same source and flags share their compiled program between the script contexts of a thread. Make
+// sure each context still gets its own matcher state, lastIndex and captures.
+
+var other = WScript.LoadScript(
+    "var literal = function () { return /(\\w+)@(\\w+)\\.com/g; };" +
+    "var sticky = /ab/y;" +
+    "function dynamic(source, flags) { return new RegExp(source, flags); }", "samethread");
+
+function check(actual, expected, message) {
+    if (JSON.stringify(actual) !== JSON.stringify(expected)) {
+        throw new Error(message + ": expected " + JSON.stringify(expected) + ", got " + JSON.stringify(actual));
+    }
+}
+
+var input = "mail alice@example.com and bob@test.com";
+
+// Same literal in both contexts
+var local = /(\w+)@(\w+)\.com/g;
+var remote = other.literal();
+check(local.exec(input), ["alice@example.com", "alice", "example"], "local literal, first match");
+check(local.lastIndex, 22, "local literal lastIndex");
+check(remote.lastIndex, 0, "remote literal lastIndex is independent");
+check(remote.exec(input), ["alice@example.com", "alice", "example"], "remote literal, first match");
+check(local.exec(input), ["bob@test.com", "bob", "test"], "local literal, second match");
+check(remote.exec(input), ["bob@test.com", "bob", "test"], "remote literal, second match");
+check(local.exec(input), null, "local literal, no more matches");
+
+// Literal evaluated repeatedly in the other context
+for (var i = 0; i < 3; i++) {
+    check(input.replace(other.literal(), "$2:$1"), "mail example:alice and test:bob", "remote literal replace " + i);
+}
+
+// Dynamic regexes, both orders of creation
+var sources = ["a(b*)c", "^\\d{3}-\\d{4}$", "[A-Z]+", "(x|y)+z"];
+var inputs = ["xabbbcx", "555-1234", "abcDEFghi", "xyxyz"];
+for (var i = 0; i < sources.length; i++) {
+    var first = i % 2 ? other.dynamic(sources[i], "i") : new RegExp(sources[i], "i");
+    var second = i % 2 ? new RegExp(sources[i], "i") : other.dynamic(sources[i], "i");
+    check(first.exec(inputs[i]), second.exec(inputs[i]), "dynamic " + sources[i]);
+    check(first.source, sources[i], "dynamic source " + sources[i]);
+}
+
+// Same source, different flags
+check(new RegExp("abc", "i").test("ABC"), true, "ignore case");
+check(other.dynamic("abc", "").test("ABC"), false, "case sensitive");
+
+// Sticky regexes advance independently
+var localSticky = /ab/y;
+check(localSticky.test("abab"), true, "local sticky, first");
+check(localSticky.lastIndex, 2, "local sticky lastIndex");
+check(other.sticky.lastIndex, 0, "remote sticky lastIndex");
+check(other.sticky.test("xab"), false, "remote sticky, not at lastIndex");
+check(localSticky.test("abab"), true, "local sticky, second");
+check(localSticky.lastIndex, 4, "local sticky lastIndex after second");
+
+// RegExp statics are per context
+"id=42".match(/(\d+)/);
+other.dynamic("(\\d+)", "").exec("id=7");
+check(RegExp.$1, "42", "local RegExp.$1");
+
+WScript.Echo("PASSED");
@@ -0,0 +1,119 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// String values produced by JSON.parse are stored one byte per character when they fit in Latin-1.
+// Check that they behave exactly like regular strings before and after they are widened.
+
+var failed = 0;
+function check(actual, expected, message) {
+    if (actual !== expected) {
+        WScript.Echo("FAILED: " + message + ": expected " + expected + ", got " + actual);
+        failed++;
+    }
+}
+
+function parsed(s) {
+    return JSON.parse(JSON.stringify(s));
+}
+
+// Built from char codes so the comparison strings are regular (two byte) strings
+function wide(s) {
+    var result = "";
+    for (var i = 0; i < s.length; i++) {
+        result += String.fromCharCode(s.charCodeAt(i));
+    }
+    return result;
+}
+
+var samples = ["ab", "hello world", "caf\u00e9", "\u00ff\u00fe\u0080\u007f", "Content-Type: application/json", "x".repeat(1000) + "y", "a\u0100b", "\u2603 snowman", "\ud83d\ude00!"];
+
+samples.forEach(function (s) {
+    var p = parsed(s);
+    var w = wide(s);
+    check(p.length, s.length, "length of " + s);
+    check(p === w, true, "=== of " + s);
+    check(w === p, true, "=== (reversed) of " + s);
+    check(p == w, true, "== of " + s);
+    check(p < w || p > w, false, "relational of " + s);
+    check(p.charCodeAt(p.length - 1), s.charCodeAt(s.length - 1), "charCodeAt of " + s);
+    check(p.charAt(1), s.charAt(1), "charAt of " + s);
+    check(p[0], s[0], "index of " + s);
+    check(p.substring(1), s.substring(1), "substring of " + s);
+    check(p.slice(1, 3), s.slice(1, 3), "slice of " + s);
+    check(p.substr(-2), s.substr(-2), "substr of " + s);
+    check(p.indexOf(s.substring(1)), s.indexOf(s.substring(1)), "indexOf of " + s);
+    check(p + "!", s + "!", "concat of " + s);
+    check(("<" + p + ">").length, s.length + 2, "concat length of " + s);
+    check(p.toUpperCase(), s.toUpperCase(), "toUpperCase of " + s);
+});
+
+// Comparisons between one-byte strings, and with regular strings, including a prefix of the other
+var sorted = ["", "a", "ab", "abc", "abd", "b", "caf\u00e9", "cafe", "caf\u0100", "z", "\u00e9"].map(parsed).concat(["ab\u0100"]);
+sorted.sort();
+var expected = ["", "a", "ab", "abc", "abd", "ab\u0100", "b", "cafe", "caf\u00e9", "caf\u0100", "z", "\u00e9"];
+check(sorted.join(","), expected.join(","), "sort order");
+for (var i = 0; i < expected.length; i++) {
+    for (var j = 0; j < expected.length; j++) {
+        check(parsed(expected[i]) < wide(expected[j]), i < j, "'" + expected[i] + "' < '" + expected[j] + "'");
+        check(parsed(expected[i]) < parsed(expected[j]), i < j, "parsed '" + expected[i] + "' < '" + expected[j] + "'");
+    }
+}
+
+// indexOf / includes with one-byte and regular search strings
+var text = parsed("the quick brown fox jumps over the lazy dog \u00e9t\u00e9");
+check(text.indexOf("the"), 0, "indexOf the");
+check(text.indexOf("the", 1), 31, "indexOf the from 1");
+check(text.indexOf(parsed("lazy")), 35, "indexOf parsed lazy");
+check(text.indexOf("\u00e9"), 44, "indexOf e acute");
+check(text.indexOf("\u0100"), -1, "indexOf wide char");
+check(text.indexOf("dog \u00e9t\u00e9"), 40, "indexOf with Latin-1 tail");
+check(text.indexOf("dog\u0100"), -1, "indexOf with wide tail");
+check(text.indexOf("g", 43), -1, "indexOf past last");
+check(text.indexOf(parsed("dog \u00e9t\u00e9!")), -1, "indexOf longer than the rest");
+check(text.includes("fox"), true, "includes fox");
+check(text.includes(parsed("cat")), false, "includes parsed cat");
+check(text.indexOf(""), 0, "indexOf empty");
+
+// Map and Set keys hash one-byte and regular strings the same way
+var map = new Map();
+map.set(parsed("key-one"), 1);
+map.set(wide("key-two"), 2);
+check(map.get(wide("key-one")), 1, "Map get with regular string");
+check(map.get(parsed("key-two")), 2, "Map get with one-byte string");
+var set = new Set([parsed("caf\u00e9"), wide("caf\u00e9")]);
+check(set.size, 1, "Set dedupes one-byte and regular strings");
+
+// Property keys and switch statements
+var obj = {};
+obj[parsed("dynamicKey")] = 42;
+check(obj.dynamicKey, 42, "property set with one-byte key");
+check(parsed("dynamicKey") in obj, true, "in with one-byte key");
+function classify(s) {
+    switch (s) {
+        case "alpha": return 1;
+        case "beta": return 2;
+        default: return 0;
+    }
+}
+check(classify(parsed("beta")), 2, "switch on one-byte string");
+
+// Strings nested in a parsed document
+var doc = JSON.parse('{"name":"caf\\u00e9","tags":["a1","b2","\\u0100"],"nested":{"k":"value"}}');
+check(doc.name, "caf\u00e9", "nested name");
+check(doc.tags.join("|"), "a1|b2|\u0100", "nested tags");
+check(JSON.stringify(doc), '{"name":"caf\u00e9","tags":["a1","b2","\u0100"],"nested":{"k":"value"}}', "round trip");
+
+// A parsed string used in a regex and many concatenations
+check(/qu(i)ck/.exec(text)[1], "i", "regex exec");
+var built = "";
+for (var i = 0; i < 100; i++) {
+    built += parsed("ab");
+}
+check(built.length, 200, "concat loop length");
+check(built.lastIndexOf("ab"), 198, "concat loop lastIndexOf");
+
+if (failed === 0) {
+    WScript.Echo("PASSED");
+}
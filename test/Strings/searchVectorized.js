@@ -0,0 +1,130 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// indexOf, lastIndexOf, includes, split and replace with string patterns search eight characters at a
+// time. Compare them against a naive search for matches around block boundaries, non-ASCII search
+// strings and search strings whose first and last characters are common in the input.
+
+var failed = 0;
+function check(actual, expected, message) {
+    if (actual !== expected) {
+        WScript.Echo("FAILED: " + message + ": expected " + expected + ", got " + actual);
+        failed++;
+    }
+}
+
+function matchesAt(input, search, k) {
+    for (var j = 0; j < search.length; j++) {
+        if (input.charCodeAt(k + j) !== search.charCodeAt(j)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+function naiveIndexOf(input, search, position) {
+    for (var k = position; k + search.length <= input.length; k++) {
+        if (matchesAt(input, search, k)) {
+            return k;
+        }
+    }
+    return -1;
+}
+
+function naiveLastIndexOf(input, search, position) {
+    for (var k = Math.min(position, input.length - search.length); k >= 0; k--) {
+        if (matchesAt(input, search, k)) {
+            return k;
+        }
+    }
+    return -1;
+}
+
+function naiveSplit(input, search) {
+    var result = [];
+    var start = 0;
+    var k;
+    while ((k = naiveIndexOf(input, search, start)) !== -1) {
+        result.push(input.substring(start, k));
+        start = k + search.length;
+    }
+    result.push(input.substring(start));
+    return result;
+}
+
+// Deterministic pseudo random generator so failures are reproducible
+var seed = 12345;
+function random(n) {
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    return seed % n;
+}
+
+var alphabets = [
+    "ab",
+    "abc\u00e9",
+    "a\u0100\u4e00",
+    "\ud83d\ude00x",
+    "a\u0161\u6100"   // characters that differ from 'a' only in the high byte
+];
+
+function randomString(alphabet, length) {
+    var s = "";
+    for (var i = 0; i < length; i++) {
+        s += alphabet.charAt(random(alphabet.length));
+    }
+    return s;
+}
+
+for (var iteration = 0; iteration < 3000; iteration++) {
+    var alphabet = alphabets[iteration % alphabets.length];
+    var input = randomString(alphabet, random(40));
+    var search = randomString(alphabet, 1 + random(5));
+    var position = random(input.length + 2);
+    var description = JSON.stringify(input) + " / " + JSON.stringify(search) + " @" + position;
+
+    check(input.indexOf(search, position), naiveIndexOf(input, search, Math.min(position, input.length)), "indexOf " + description);
+    check(input.lastIndexOf(search, position), naiveLastIndexOf(input, search, position), "lastIndexOf " + description);
+    check(input.includes(search), naiveIndexOf(input, search, 0) !== -1, "includes " + description);
+    check(JSON.stringify(input.split(search)), JSON.stringify(naiveSplit(input, search)), "split " + description);
+
+    var index = naiveIndexOf(input, search, 0);
+    var replaced = index === -1 ? input : input.substring(0, index) + "<>" + input.substring(index + search.length);
+    check(input.replace(search, "<>"), replaced, "replace " + description);
+}
+
+// Matches in every position of the first blocks of a long string, and right at the end
+var filler = "x".repeat(100);
+for (var k = 0; k <= 97; k++) {
+    var s = filler.substring(0, k) + "\u00e9y\u0100" + filler.substring(k + 3);
+    check(s.indexOf("\u00e9y\u0100"), k, "indexOf at " + k);
+    check(s.lastIndexOf("\u00e9y\u0100"), k, "lastIndexOf at " + k);
+    check(s.indexOf("\u00e9y\u0100", k + 1), -1, "indexOf after " + k);
+    if (k > 0) {
+        check(s.lastIndexOf("\u00e9y\u0100", k - 1), -1, "lastIndexOf before " + k);
+    }
+    check(s.split("\u00e9y\u0100").join("|"), "x".repeat(k) + "|" + "x".repeat(97 - k), "split at " + k);
+}
+
+// First and last characters match often, the middle does not
+var tricky = "ab".repeat(50) + "abcab";
+check(tricky.indexOf("abcab"), 100, "tricky indexOf");
+check(tricky.lastIndexOf("abab"), 98, "tricky lastIndexOf");
+check(tricky.indexOf("aba", 101), -1, "tricky indexOf past the end");
+
+// Search strings longer than 16 characters use the Boyer-Moore tables when they are ASCII
+for (var iteration = 0; iteration < 500; iteration++) {
+    var alphabet = alphabets[iteration % 2 === 0 ? 0 : 2];
+    var search = randomString(alphabet, 17 + random(8));
+    var input = randomString(alphabet, random(30)) + search + randomString(alphabet, random(30));
+    var position = random(input.length + 2);
+    var description = JSON.stringify(input) + " / " + JSON.stringify(search) + " @" + position;
+
+    check(input.indexOf(search, position), naiveIndexOf(input, search, Math.min(position, input.length)), "long indexOf " + description);
+    check(input.lastIndexOf(search, position), naiveLastIndexOf(input, search, position), "long lastIndexOf " + description);
+}
+
+if (failed === 0) {
+    WScript.Echo("PASSED");
+}
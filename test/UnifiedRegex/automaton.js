@@ -0,0 +1,70 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Patterns without backreferences or lookaheads that could backtrack are matched by a lazy DFA and a
+// Pike VM. Check that they find the same match and captures as backtracking would, and that patterns
+// which backtrack exponentially finish quickly.
+
+var failed = 0;
+function check(actual, expected, message) {
+    if (actual !== expected) {
+        WScript.Echo("FAILED: " + message + ": expected " + expected + ", got " + actual);
+        failed++;
+    }
+}
+
+function checkExec(re, input, lastIndex, expected, expectedIndex) {
+    re.lastIndex = lastIndex;
+    var match = re.exec(input);
+    var description = re + " on " + JSON.stringify(input) + " @" + lastIndex;
+    check(JSON.stringify(match && Array.prototype.slice.call(match)), JSON.stringify(expected), "exec " + description);
+    if (match) {
+        check(match.index, expectedIndex, "index " + description);
+    }
+}
+
+// Alternatives and greedy / lazy loops resolve as they do when backtracking
+checkExec(/(a|b)*c/, "xxababcab", 0, ["ababc", "b"], 2);
+checkExec(/(a|ab)(c|bcd)(d*)/, "abcd", 0, ["abcd", "a", "bcd", ""], 0);
+checkExec(/(a+|b+)*?c/, "aabbc", 0, ["aabbc", "bb"], 0);
+checkExec(/a{2,4}?/, "aaaaa", 0, ["aa"], 0);
+checkExec(/(a{2,4})(a*)/, "aaaaaa", 0, ["aaaaaa", "aaaa", "aa"], 0);
+checkExec(/(a|ab)*?b/, "aabab", 0, ["aab", "a"], 0);
+checkExec(/(.*)(\d+)/, "abc123", 0, ["abc123", "abc12", "3"], 0);
+checkExec(/(.*?)(\d+)/, "abc123", 0, ["abc123", "abc", "123"], 0);
+checkExec(/(\w+)\s*=\s*(\w+|"[^"]*")/, "  key = \"a value\" rest", 0, ["key = \"a value\"", "key", "\"a value\""], 2);
+
+// Groups in a loop body are reset at the start of every iteration
+checkExec(/(?:(a)|b)+/, "ab", 0, ["ab", undefined], 0);
+checkExec(/(?:(a)|(b))+/, "aba", 0, ["aba", "a", undefined], 0);
+
+// Assertions, multiline, case insensitive and non-ASCII input
+checkExec(/^(\w+)\b(.*)$/m, "first line\nsecond line", 0, ["first line", "first", " line"], 0);
+checkExec(/(b|ab)+$/m, "xab\nabab\n", 0, ["ab", "ab"], 1);
+checkExec(/\B(a|b)+\b/, "aab ba", 0, ["ab", "b"], 1);
+checkExec(/(A|b)+C/i, "xaBaBc", 0, ["aBaBc", "B"], 1);
+checkExec(/(\u00e9|e)+\u0100/, "e\u00e9e\u0100", 0, ["e\u00e9e\u0100", "e"], 0);
+checkExec(/(\u00e9|e)+\u0100/, "e\u00e9e\u0101", 0, null);
+
+// Sticky and global
+checkExec(/(a|b)*c/y, "ababcab", 2, ["abc", "b"], 2);
+checkExec(/(a|b)*c/y, "ababcab", 5, null);
+checkExec(/(a|b)*c/g, "acbcxc", 2, ["bc", "b"], 2);
+check("xacbcyc".replace(/(a|b)*c/g, "[$1]"), "x[a][b]y[]", "replace global");
+check(JSON.stringify("acbcxc".match(/(a|b)*c/g)), JSON.stringify(["ac", "bc", "c"]), "match global");
+
+// Exponential when backtracking, linear here. The inputs are kept short when run with the backtracking
+// matcher (-RegexAutomaton- -args small -endargs).
+var small = WScript.Arguments[0] === "small";
+var xs = "x".repeat(small ? 16 : 5000);
+checkExec(/(x+x+)+y/, xs, 0, null);
+checkExec(/(x+x+)+y/, xs.substring(0, 10) + "y", 0, ["xxxxxxxxxxy", "xxxxxxxxxx"], 0);
+check(/(a|aa)*b/.test("a".repeat(small ? 20 : 10000)), false, "(a|aa)*b");
+check(/^(\w+\s?)*$/.test("hello world ".repeat(small ? 1 : 500) + "!"), false, "words then a bang");
+check(/(\d+|\d+\.\d+)*[a-f]{3,6}z/.test("1.2".repeat(small ? 3 : 2000)), false, "numbers then a bad suffix");
+
+if (failed === 0) {
+    WScript.Echo("PASSED");
+}
@@ -0,0 +1,129 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Hot regex programs which never backtrack are compiled to machine code. Run each pattern a few times, so
+// that later runs use the machine code, and check that every run finds the same match and captures.
+
+var failed = 0;
+function check(actual, expected, message) {
+    if (actual !== expected) {
+        WScript.Echo("FAILED: " + message + ": expected " + expected + ", got " + actual);
+        failed++;
+    }
+}
+
+var runs = 4;
+
+function checkExec(re, input, lastIndex, expected, expectedIndex) {
+    var description = re + " on " + JSON.stringify(input) + " @" + lastIndex;
+    for (var i = 0; i < runs; i++) {
+        re.lastIndex = lastIndex;
+        var match = re.exec(input);
+        check(JSON.stringify(match && Array.prototype.slice.call(match)), JSON.stringify(expected), "exec " + description + " run " + i);
+        if (match) {
+            check(match.index, expectedIndex, "index " + description + " run " + i);
+        }
+    }
+}
+
+function checkTest(re, input, expected) {
+    for (var i = 0; i < runs; i++) {
+        re.lastIndex = 0;
+        check(re.test(input), expected, "test " + re + " on " + JSON.stringify(input) + " run " + i);
+    }
+}
+
+// Characters, sets and literals
+checkExec(/ab+c/, "xxabbbcz", 0, ["abbbc"], 2);
+checkExec(/ab+c/, "xxacabc", 0, ["abc"], 4);
+checkExec(/ab+c/, "xxacab", 0, null);
+checkExec(/[a-c\u4e00]+!/, "zz\u4e00ab!x", 0, ["\u4e00ab!"], 2);
+checkExec(/[a-c\u4e00]+!/, "zz\u4e01ab!x", 0, ["ab!"], 3);
+checkExec(/[^a-c\u4e00]+/, "ab\u4e00\u0100x\u00e9c", 0, ["\u0100x\u00e9"], 3);
+checkExec(/x[\u0100-\u0200]y/, "x\u00ffy x\u0150y", 0, ["x\u0150y"], 4);
+checkExec(/hello/, "say hello!", 0, ["hello"], 4);
+checkExec(/hello/, "say hell", 0, null);
+checkExec(/abcdefg/, "abcdefabcdefg", 0, ["abcdefg"], 6);
+checkExec(/abcdefg/g, "abcdefgh", 1, null);
+checkExec(/x(?:ab|cd)y/, "xcdy xaby", 0, ["xcdy"], 0);
+checkExec(/(?:ab|cd|ef)z/, "efz", 0, ["efz"], 0);
+checkExec(/a?b/, "cab cb", 0, ["ab"], 1);
+checkExec(/[ab]?c/, "xbc", 0, ["bc"], 1);
+
+// Sets with characters past the first 256, tested inline against their ranges
+checkExec(/a\s+b/, "ab a\u3000\u2029\u00a0b", 0, ["a\u3000\u2029\u00a0b"], 3);
+checkExec(/a\s+b/, "a\u2027b", 0, null);
+checkExec(/[^\s]+/, "\u2028\u1680x\u4e00\u3000", 0, ["x\u4e00"], 2);
+checkExec(/[\u0100\u0102-\u0105\uffff]+/, "\u0101\u0103\u0100\uffff\u0106", 0, ["\u0103\u0100\uffff"], 1);
+checkExec(/(\S+)\s/, "\u3000ab\ufeffc", 0, ["ab\ufeff", "ab"], 1);
+// More ranges than are tested inline, so the pattern stays in the interpreter
+var manyRanges = "";
+for (var c = 0x4e00; c < 0x4e00 + 2 * 40; c += 2) {
+    manyRanges += String.fromCharCode(c);
+}
+checkExec(new RegExp("[" + manyRanges + "]+"), "\u4e01\u4e02\u4e04\u4e05", 0, ["\u4e02\u4e04"], 1);
+
+// Case insensitive
+checkExec(/HeLLo/i, "say hELlo!", 0, ["hELlo"], 4);
+checkExec(/k/i, "xK", 0, ["K"], 1);
+checkExec(/[a-z]+\d/i, "--ABc9", 0, ["ABc9"], 2);
+
+// Groups
+checkExec(/(\d+)-(\d+)/, "tel 555-1234 x", 0, ["555-1234", "555", "1234"], 4);
+checkExec(/(ab)c/, "xxabcx", 0, ["abc", "ab"], 2);
+checkExec(/a(b*)c/, "xacabbc", 0, ["ac", ""], 1);
+checkExec(/(a+)(b*)(c)/, "zaaac", 0, ["aaac", "aaa", "", "c"], 1);
+
+// Bounded loops
+checkExec(/a{2,3}/, "xaxaaaaa", 0, ["aaa"], 3);
+checkExec(/a{2,3}/, "xaxa", 0, null);
+checkExec(/b[a-c]{3,}d/, "babd bacabd", 0, ["bacabd"], 5);
+checkExec(/x\d{0,2}/, "x1234", 0, ["x12"], 0);
+
+// Assertions
+checkExec(/^abc/, "abcabc", 0, ["abc"], 0);
+checkExec(/^abc/, "xabc", 0, null);
+checkExec(/abc$/, "abcabc", 0, ["abc"], 3);
+checkExec(/abc$/, "abcab", 0, null);
+checkExec(/^b/m, "a\nb", 0, ["b"], 2);
+checkExec(/^b/m, "a\u2028b", 0, ["b"], 2);
+checkExec(/^b/m, "a\u2027b", 0, null);
+checkExec(/a$/m, "ba\r\nc", 0, ["a"], 1);
+checkExec(/\bfoo\b/, "foobar foo_ foo.", 0, ["foo"], 12);
+checkExec(/\Boo\B/, "oo boot", 0, ["oo"], 4);
+checkExec(/\b\u00e9/, "a\u00e9 \u00e9", 0, ["\u00e9"], 1);
+checkExec(/a\b/, "ba", 0, ["a"], 1);
+checkExec(/\Ba/, "a ba", 0, ["a"], 3);
+checkExec(/\B/, "", 0, [""], 0);
+checkExec(/^$/, "", 0, [""], 0);
+checkExec(/$/, "abc", 0, [""], 3);
+
+// Starting offsets, sticky and global
+checkExec(/ab+c/y, "abcabbc", 3, ["abbc"], 3);
+checkExec(/ab+c/y, "abcxabbc", 3, null);
+checkExec(/ab+c/g, "abcabbc", 1, ["abbc"], 3);
+checkExec(/c/g, "abc", 3, null);
+
+// Replace, split and match, which run a pattern many times over one input
+for (var i = 0; i < runs; i++) {
+    check("a1b22c333".replace(/\d+/g, "#"), "a#b#c#", "replace run " + i);
+    check("x-ab-abb-y".replace(/(a)(b+)/g, "[$2$1]"), "x-[ba]-[bba]-y", "replace groups run " + i);
+    check(JSON.stringify("a, b,c ,  d".split(/\s*,\s*/)), JSON.stringify(["a", "b", "c", "d"]), "split run " + i);
+    check(JSON.stringify("one two  three".match(/\w+/g)), JSON.stringify(["one", "two", "three"]), "match run " + i);
+    check("\u4e00\u4e01\u4e00".replace(/\u4e00/g, "x"), "x\u4e01x", "replace non-Latin-1 run " + i);
+}
+
+checkTest(/^[\w.]+@[\w.]+\.\w+$/, "someone@example.com", true);
+checkTest(/^[\w.]+@[\w.]+\.\w+$/, "someone@example", false);
+
+// Long inputs
+var long = "ab".repeat(5000);
+checkExec(/b+c/, long + "bbc", 0, ["bbbc"], 9999);
+checkExec(/(?:ab){3}x/, long + "x", 0, ["ababab" + "x"], 9994);
+checkTest(/^(?:[ab])+$/, long, true);
+
+if (failed === 0) {
+    WScript.Echo("PASSED");
+}
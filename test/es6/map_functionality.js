@@ -819,6 +819,60 @@ var tests = [
             assert.areEqual("test", map.get(key), "1.0 should be equal to the key 1 and map to 'test'");
         }
     },
+
+    {
+        name: "Iterators keep their place while the map's entries are compacted, grown, shrunk or cleared",
+        body: function () {
+            var map = new Map();
+            var i;
+            for (i = 0; i < 100; i++) {
+                map.set(i, "v" + i);
+            }
+
+            // Delete most entries behind and ahead of the iterator so that the map is compacted while iterating
+            var iterator = map.entries();
+            for (i = 0; i < 10; i++) {
+                assert.areEqual([i, "v" + i], iterator.next().value, "first ten entries in insertion order");
+            }
+            for (i = 0; i < 95; i++) {
+                if (i !== 50) {
+                    map.delete(i);
+                }
+            }
+            assert.areEqual(6, map.size, "map has entries 50, 95, 96, 97, 98, 99");
+            assert.areEqual([50, "v50"], iterator.next().value, "iterator continues with the first entry it has not visited");
+            for (i = 100; i < 200; i++) {
+                map.set("k" + i, i);
+            }
+            var rest = [];
+            for (var entry of iterator) {
+                rest.push(entry[0]);
+            }
+            assert.areEqual(105, rest.length, "iterator visits the remaining entries and the ones added while iterating");
+            assert.areEqual([95, 96, 97, 98, 99, "k100"], rest.slice(0, 6), "remaining entries come in insertion order");
+            assert.areEqual("k199", rest[rest.length - 1], "entries added while iterating come last");
+
+            // Clearing restarts a live iterator at the entries added after the clear
+            iterator = map.keys();
+            iterator.next();
+            map.clear();
+            map.set("after", 1);
+            assert.areEqual("after", iterator.next().value, "iterator continues with the entries added after clear");
+            assert.isTrue(iterator.next().done, "iterator is done");
+
+            // Strings and numbers that are equal by value find the same entry whatever their representation
+            map = new Map();
+            var key = "ab";
+            map.set(key + "cd", 1);
+            map.set(2, 2);
+            assert.areEqual(1, map.get("abcd"), "string keys compare by value");
+            assert.areEqual(2, map.get(2.5 - 0.5), "int and double keys compare by value");
+            map.set("a" + "bcd", 3);
+            assert.areEqual(2, map.size, "setting an equal string key replaces the value");
+            assert.areEqual(3, map.get("abcd"), "value was replaced");
+        }
+    },
+
 ];
 
 testRunner.runTests(tests, { verbose: WScript.Arguments[0] != "summary" });
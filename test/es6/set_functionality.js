@@ -742,6 +742,46 @@ var tests = [
             assert.isTrue(set.has(value), "1.0 should be equal to the value 1 and set has it");
         }
     },
+
+    {
+        name: "Iterators keep their place while the set's entries are compacted, grown, shrunk or cleared",
+        body: function () {
+            var set = new Set();
+            var i;
+            for (i = 0; i < 100; i++) {
+                set.add(i);
+            }
+
+            var iterator = set.values();
+            for (i = 0; i < 10; i++) {
+                assert.areEqual(i, iterator.next().value, "first ten values in insertion order");
+            }
+            for (i = 0; i < 95; i++) {
+                if (i !== 50) {
+                    set.delete(i);
+                }
+            }
+            assert.areEqual(6, set.size, "set has values 50, 95, 96, 97, 98, 99");
+            assert.areEqual(50, iterator.next().value, "iterator continues with the first value it has not visited");
+            for (i = 0; i < 10; i++) {
+                set.delete(i + 95);
+                set.add(i + 95);
+            }
+            var rest = [];
+            for (var value of iterator) {
+                rest.push(value);
+            }
+            assert.areEqual([95, 96, 97, 98, 99, 100, 101, 102, 103, 104], rest, "values deleted and re-added come in their new order");
+
+            iterator = set.values();
+            iterator.next();
+            set.clear();
+            set.add("after");
+            assert.areEqual("after", iterator.next().value, "iterator continues with the values added after clear");
+            assert.isTrue(iterator.next().done, "iterator is done");
+        }
+    },
+
 ];
 
 testRunner.runTests(tests, { verbose: WScript.Arguments[0] != "summary" });
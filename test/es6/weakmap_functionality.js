@@ -501,6 +501,82 @@ var tests = [
         }
     },
 
+    {
+        name: "WeakMap values stay alive through chains of keys across garbage collections",
+        body: function () {
+            var wm = new WeakMap();
+            var other = new WeakMap();
+            var first = {};
+            var key = first;
+            for (var i = 0; i < 1000; i++) {
+                // Each value is only reachable through the previous key, and it holds the next key
+                var next = { index: i };
+                wm.set(key, { index: i, next: next, payload: [i, "value" + i] });
+                other.set(next, key);
+                key = next;
+            }
+            key = next = undefined;
+
+            // Entries whose keys are dropped go away without disturbing the others
+            for (var i = 0; i < 1000; i++) {
+                wm.set({}, { dropped: i });
+            }
+
+            CollectGarbage();
+            CollectGarbage();
+
+            key = first;
+            for (var i = 0; i < 1000; i++) {
+                assert.isTrue(wm.has(key), "Key " + i + " is still in the WeakMap");
+                var value = wm.get(key);
+                assert.areEqual(i, value.index, "Value " + i + " survived the collection");
+                assert.areEqual("value" + i, value.payload[1], "Value " + i + " contents survived the collection");
+                assert.areEqual(key, other.get(value.next), "The second WeakMap maps the next key back");
+                key = value.next;
+            }
+            assert.isFalse(wm.has(key), "The last key was never added");
+        }
+    },
+
+    {
+        name: "WeakMap values stay alive through deep chains of keys and WeakMaps only reachable from values",
+        body: function () {
+            var keys = [];
+            for (var i = 0; i < 5000; i++) {
+                keys.push({ index: i });
+            }
+
+            // The chain is added from its end, and every tenth link goes through a WeakMap that is
+            // only reachable from the value of the previous link
+            var wm = new WeakMap();
+            for (var i = 4999; i >= 0; i--) {
+                var value = { index: i, next: keys[i + 1] };
+                if (i % 10 == 0) {
+                    var inner = new WeakMap();
+                    inner.set(keys[i], value);
+                    value = { inner: inner };
+                }
+                wm.set(keys[i], value);
+            }
+            var first = keys[0];
+            keys = inner = value = undefined;
+
+            CollectGarbage();
+            CollectGarbage();
+
+            var key = first;
+            for (var i = 0; i < 5000; i++) {
+                assert.isTrue(wm.has(key), "Key " + i + " is still in the WeakMap");
+                var value = wm.get(key);
+                if (i % 10 == 0) {
+                    value = value.inner.get(key);
+                }
+                assert.areEqual(i, value.index, "Value " + i + " survived the collection");
+                key = value.next;
+            }
+            assert.areEqual(undefined, key, "The chain ends after the last key");
+        }
+    },
 ];
 
 testRunner.runTests(tests, { verbose: WScript.Arguments[0] != "summary" });
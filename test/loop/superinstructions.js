@@ -0,0 +1,102 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Loop increments followed by the back edge are fused into a single IncrBr_A/DecrBr_A
+// when the JIT is disabled. Make sure the fused forms behave like the separate opcodes.
+
+function countUp(n) {
+    var sum = 0;
+    for (var i = 0; i < n; i++) {
+        sum += i;
+    }
+    return sum + ":" + i;
+}
+
+function countDown(n) {
+    var sum = 0;
+    for (var i = n; i > 0; --i) {
+        sum += i;
+    }
+    return sum + ":" + i;
+}
+
+function withContinue(n) {
+    var odd = 0;
+    for (let i = 0; i < n; ++i) {
+        if (i % 2 == 0) {
+            continue;
+        }
+        odd++;
+    }
+    return odd;
+}
+
+function labeledContinue(n) {
+    var count = 0;
+    outer: for (var i = 0; i < n; i++) {
+        for (var j = 0; j < n; j++) {
+            if (j > i) {
+                continue outer;
+            }
+            count++;
+        }
+    }
+    return count;
+}
+
+function whileLoop(n) {
+    var i = 0;
+    var count = 0;
+    while (i < n) {
+        count += 2;
+        i++;
+    }
+    return count + ":" + i;
+}
+
+function overflow() {
+    var i = 0x3fffffff - 2;
+    for (; i < 0x3fffffff + 2; i++) { }
+    var j = -0x40000000 + 2;
+    for (; j > -0x40000000 - 2; j--) { }
+    var k = 0x7ffffffe;
+    for (; k < 0x80000001; k++) { }
+    return i + ":" + j + ":" + k;
+}
+
+function nonNumbers() {
+    var s = "3";
+    var iterations = 0;
+    for (; s < 6; s++) {
+        iterations++;
+    }
+    var calls = 0;
+    var o = { valueOf: function () { calls++; return 10; } };
+    for (var n = 0; n < 2; o--) {
+        n++;
+    }
+    return typeof s + ":" + s + ":" + iterations + ":" + typeof o + ":" + o + ":" + calls;
+}
+
+function throwingIncrement() {
+    var o = { valueOf: function () { throw new Error("valueOf"); } };
+    try {
+        for (var i = 0; i < 1; o++) {
+            i++;
+        }
+    } catch (e) {
+        return e.message + ":" + i;
+    }
+    return "no exception";
+}
+
+WScript.Echo(countUp(10));
+WScript.Echo(countDown(10));
+WScript.Echo(withContinue(10));
+WScript.Echo(labeledContinue(5));
+WScript.Echo(whileLoop(7));
+WScript.Echo(overflow());
+WScript.Echo(nonNumbers());
+WScript.Echo(throwingIncrement());
@@ -0,0 +1,121 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Sorting without a comparer must match sorting with the default comparison:
+// ascending, -0 before +0, NaN last.
+
+var passed = true;
+
+function defaultCompare(x, y) {
+  if (x !== x) {
+    return y !== y ? 0 : 1;
+  }
+  if (y !== y) {
+    return -1;
+  }
+  if (x < y) {
+    return -1;
+  }
+  if (x > y) {
+    return 1;
+  }
+  if (x === 0 && y === 0) {
+    return (1 / x < 0 ? 0 : 1) - (1 / y < 0 ? 0 : 1);
+  }
+  return 0;
+}
+
+function same(x, y) {
+  return x !== x ? y !== y : (x === y && 1 / x === 1 / y);
+}
+
+var seed = 1;
+function random() {
+  seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+  return seed;
+}
+
+function check(name, arr) {
+  var expected = Array.prototype.slice.call(arr).sort(defaultCompare);
+  var result = arr.sort();
+  if (result !== arr) {
+    WScript.Echo(name + ": sort did not return the array");
+    passed = false;
+  }
+  for (var i = 0; i < expected.length; i++) {
+    if (!same(arr[i], expected[i])) {
+      WScript.Echo(name + " " + i + " " + arr[i] + " " + expected[i]);
+      passed = false;
+      return;
+    }
+  }
+}
+
+var types = [Int8Array, Uint8Array, Uint8ClampedArray, Int16Array, Uint16Array, Int32Array, Uint32Array, Float32Array, Float64Array];
+var lengths = [0, 1, 2, 3, 10, 63, 64, 65, 200, 1000, 5000];
+
+types.forEach(function (type) {
+  lengths.forEach(function (length) {
+    // random bits
+    var bytes = new Uint8Array(length * type.BYTES_PER_ELEMENT);
+    for (var i = 0; i < bytes.length; i++) {
+      bytes[i] = random() & 0xff;
+    }
+    check(type.name + " random " + length, new type(bytes.buffer));
+
+    // small values, including negatives, zeros and special floats
+    var small = new type(length);
+    for (var i = 0; i < length; i++) {
+      switch (random() % 8) {
+        case 0: small[i] = -0; break;
+        case 1: small[i] = NaN; break;
+        case 2: small[i] = -Infinity; break;
+        case 3: small[i] = Infinity; break;
+        default: small[i] = (random() % 200) - 100; break;
+      }
+    }
+    check(type.name + " small " + length, small);
+
+    // already sorted and reversed
+    var ascending = new type(length);
+    for (var i = 0; i < length; i++) {
+      ascending[i] = i;
+    }
+    check(type.name + " ascending " + length, ascending);
+    check(type.name + " descending " + length, ascending.reverse());
+  });
+
+  // sorting a view only touches the viewed elements
+  var buffer = new ArrayBuffer(type.BYTES_PER_ELEMENT * 100);
+  var whole = new type(buffer);
+  for (var i = 0; i < whole.length; i++) {
+    whole[i] = 100 - i;
+  }
+  var view = new type(buffer, type.BYTES_PER_ELEMENT * 10, 80);
+  view.sort();
+  if (whole[0] !== 100 || whole[9] !== 91 || whole[10] !== 11 || whole[89] !== 90 || whole[90] !== 10 || whole[99] !== 1) {
+    WScript.Echo(type.name + ": sorting a view changed elements outside of it");
+    passed = false;
+  }
+});
+
+// NaNs with different payloads all sort last
+var f64 = new Float64Array(4);
+var bits = new Uint32Array(f64.buffer);
+f64[0] = 1;
+bits[2] = 0xffffffff; bits[3] = 0xffffffff; // negative NaN
+f64[2] = -1;
+bits[6] = 1; bits[7] = 0x7ff00000; // signaling NaN
+f64.sort();
+if (f64[0] !== -1 || f64[1] !== 1 || f64[2] === f64[2] || f64[3] === f64[3]) {
+  WScript.Echo("NaN payloads: " + Array.prototype.join.call(f64));
+  passed = false;
+}
+
+if (passed) {
+  WScript.Echo("PASSED");
+} else {
+  WScript.Echo("FAILED");
+}